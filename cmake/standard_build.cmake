@@ -1,3 +1,108 @@
+### Performance configuration ###
+# VODDEN_STATIC_LIBRARIES builds the libraries as static archives, so calls
+# between them are direct rather than through the PLT, and VODDEN_LTO then
+# lets the optimizer inline across library boundaries, Renderer::copy into
+# sdl_tools say. VODDEN_PGO selects a stage of a profile guided build, run
+# twice in the same build directory:
+#   GENERATE  instrument every target; building pgo_train then runs the
+#             benchmarks, event replays included, writing a profile to pgo/
+#   USE       reconfigure and build again, optimized with that profile
+# VODDEN_SIMD picks the vector instructions every target is built for, and
+# with them the kernels pixel_kernels.h and viewport_cull.h compile to:
+# SSE4_1, AVX2, or NATIVE for whatever the building machine has. Left
+# empty, x86-64 builds cull with SSE2 but blend with the scalar kernels,
+# and AArch64 builds use NEON for both.
+# The performance, pgo-generate and pgo-use presets set these up.
+
+option(VODDEN_STATIC_LIBRARIES "Build the libraries as static archives rather than shared objects" OFF)
+option(VODDEN_LTO "Build with link time optimization, where the toolchain supports it" OFF)
+set(VODDEN_PGO "" CACHE STRING "Profile guided optimization stage: empty for none, GENERATE or USE")
+set_property(CACHE VODDEN_PGO PROPERTY STRINGS "" GENERATE USE)
+set(VODDEN_SIMD "" CACHE STRING "Vector instructions to build for: empty for the compiler's default, SSE4_1, AVX2 or NATIVE")
+set_property(CACHE VODDEN_SIMD PROPERTY STRINGS "" SSE4_1 AVX2 NATIVE)
+
+function(apply_simd_options TargetName)
+    if(NOT VODDEN_SIMD)
+        return()
+    endif()
+    # applied to every target alike, as inline kernels built for different instructions in two objects break the ODR
+    if(MSVC)
+        if(VODDEN_SIMD STREQUAL "AVX2")
+            set(SimdOptions /arch:AVX2)
+        else()
+            message(FATAL_ERROR "VODDEN_SIMD=${VODDEN_SIMD} isn't supported by MSVC, which only defines __AVX2__ for /arch:AVX2.")
+        endif()
+    elseif(VODDEN_SIMD STREQUAL "SSE4_1")
+        set(SimdOptions -msse4.1)
+    elseif(VODDEN_SIMD STREQUAL "AVX2")
+        set(SimdOptions -mavx2)
+    elseif(VODDEN_SIMD STREQUAL "NATIVE")
+        set(SimdOptions -march=native)
+    else()
+        message(FATAL_ERROR "VODDEN_SIMD must be empty, SSE4_1, AVX2 or NATIVE, not ${VODDEN_SIMD}.")
+    endif()
+    target_compile_options(${TargetName} PRIVATE ${SimdOptions})
+endfunction()
+
+function(apply_performance_options TargetName)
+    apply_simd_options(${TargetName})
+
+    if(VODDEN_LTO)
+        if(NOT DEFINED CACHE{VODDEN_LTO_SUPPORTED})
+            include(CheckIPOSupported)
+            check_ipo_supported(RESULT LtoSupported OUTPUT LtoOutput)
+            set(VODDEN_LTO_SUPPORTED ${LtoSupported} CACHE INTERNAL "")
+            if(NOT LtoSupported)
+                message(WARNING "VODDEN_LTO is set, but link time optimization isn't supported: ${LtoOutput}")
+            endif()
+        endif()
+        if(VODDEN_LTO_SUPPORTED)
+            set_property(TARGET ${TargetName} PROPERTY INTERPROCEDURAL_OPTIMIZATION ON)
+        endif()
+    endif()
+
+    if(NOT VODDEN_PGO)
+        return()
+    endif()
+    # GCC names each object's profile after its path, so both stages must share a build directory
+    set(ProfileDirectory "${CMAKE_BINARY_DIR}/pgo")
+    if(VODDEN_PGO STREQUAL "GENERATE")
+        if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+            set(PgoOptions -fprofile-generate=${ProfileDirectory}/raw -fprofile-update=atomic)
+        else()
+            set(PgoOptions -fprofile-generate=${ProfileDirectory} -fprofile-update=atomic)
+        endif()
+    elseif(VODDEN_PGO STREQUAL "USE")
+        if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+            set(PgoOptions -fprofile-use=${ProfileDirectory}/default.profdata -Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date)
+        else()
+            # code the training run never reached is still optimized as usual, and a stale profile only warns
+            set(PgoOptions -fprofile-use=${ProfileDirectory} -fprofile-partial-training -Wno-missing-profile -Wno-error=coverage-mismatch)
+        endif()
+    else()
+        message(FATAL_ERROR "VODDEN_PGO must be empty, GENERATE or USE, not ${VODDEN_PGO}.")
+    endif()
+    target_compile_options(${TargetName} PRIVATE ${PgoOptions})
+    # public, so that executables linking an instrumented static library link the profiling runtime too
+    target_link_options(${TargetName} PUBLIC ${PgoOptions})
+endfunction()
+
+#! @brief the pgo_train target, which runs every benchmark to collect a profile; call once every benchmark is added
+macro(add_pgo_training_target)
+    if(VODDEN_PGO STREQUAL "GENERATE" AND TARGET benchmarks)
+        get_property(BenchmarkNames GLOBAL PROPERTY VODDEN_BENCHMARKS)
+        set(TrainingCommands)
+        foreach(BenchmarkName ${BenchmarkNames})
+            list(APPEND TrainingCommands COMMAND ${CMAKE_COMMAND} -E env SDL_VIDEODRIVER=dummy $<TARGET_FILE:${BenchmarkName}>)
+        endforeach()
+        if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+            find_program(LlvmProfdata NAMES llvm-profdata REQUIRED)
+            list(APPEND TrainingCommands COMMAND ${LlvmProfdata} merge -output=${CMAKE_BINARY_DIR}/pgo/default.profdata ${CMAKE_BINARY_DIR}/pgo/raw)
+        endif()
+        add_custom_target(pgo_train ${TrainingCommands} DEPENDS benchmarks VERBATIM)
+    endif()
+endmacro()
+
 macro(get_sources)
 
     # Has HEADER Files?
@@ -30,6 +135,7 @@ macro(add_test_target)
             message( "   Adding test source file: ${SOURCE_FILE}" )
         endforeach()
         add_executable( ${TestName} ${TEST_SOURCE_FILES} )
+        apply_performance_options( ${TestName} )
 
         target_link_libraries( ${TestName} PUBLIC ${LibraryName} )
         target_link_libraries( ${TestName} PUBLIC gtest )
@@ -42,6 +148,30 @@ macro(add_test_target)
     endif()
 endmacro()
 
+macro(add_benchmark_target)
+    if( EXISTS ${CMAKE_CURRENT_SOURCE_DIR}/benchmark )
+        set( BenchmarkName "${LibraryName}_benchmark" )
+
+        file( GLOB_RECURSE BENCHMARK_SOURCE_FILES CONFIGURE_DEPENDS ${CMAKE_CURRENT_SOURCE_DIR}/benchmark/*.cpp ${CMAKE_CURRENT_SOURCE_DIR}/benchmark/*.h )
+        foreach( SOURCE_FILE ${BENCHMARK_SOURCE_FILES} )
+            message( "   Adding benchmark source file: ${SOURCE_FILE}" )
+        endforeach()
+        add_executable( ${BenchmarkName} ${BENCHMARK_SOURCE_FILES} )
+        apply_performance_options( ${BenchmarkName} )
+        set_property( GLOBAL APPEND PROPERTY VODDEN_BENCHMARKS ${BenchmarkName} )
+
+        target_link_libraries( ${BenchmarkName} PUBLIC ${LibraryName} )
+        target_link_libraries( ${BenchmarkName} PUBLIC benchmark::benchmark )
+        target_link_libraries( ${BenchmarkName} PUBLIC benchmark::benchmark_main )
+
+        # `cmake --build . --target benchmarks` builds every library's benchmarks
+        if( NOT TARGET benchmarks )
+            add_custom_target( benchmarks )
+        endif()
+        add_dependencies( benchmarks ${BenchmarkName} )
+    endif()
+endmacro()
+
 macro(standard_libarary_build)
 
     ## Library Build
@@ -52,7 +182,12 @@ macro(standard_libarary_build)
     get_sources()
 
     if( SOURCE_FILES )    
-        add_library( ${LibraryName} SHARED ${SOURCE_FILES} )
+        if( VODDEN_STATIC_LIBRARIES )
+            add_library( ${LibraryName} STATIC ${SOURCE_FILES} )
+        else()
+            add_library( ${LibraryName} SHARED ${SOURCE_FILES} )
+        endif()
+        apply_performance_options( ${LibraryName} )
 
         target_include_directories( 
             ${LibraryName}
@@ -65,6 +200,7 @@ macro(standard_libarary_build)
     message( CHECK_PASS "done." )
 
     add_test_target()
+    add_benchmark_target()
 
 endmacro()
 
@@ -79,6 +215,7 @@ macro(standard_executable_build)
 
     if( SOURCE_FILES )    
         add_executable( ${LibraryName} ${SOURCE_FILES} )
+        apply_performance_options( ${LibraryName} )
 
         target_include_directories( 
             ${LibraryName}
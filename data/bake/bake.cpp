@@ -0,0 +1,134 @@
+/**
+ * Bakes one or more images into a single pre-decoded blob which
+ * sdl::Texture can upload without decoding. See sdl/include/baked_image.h
+ * for the layout.
+ *
+ * usage: bake <output> <image>...
+ *
+ * With more than one image, they are packed into a single atlas and the
+ * regions are written in the order the images were given.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include <SDL2/SDL.h>
+#include <SDL_image.h>
+
+#include <baked_image.h>
+#include <skyline_packer.h>
+
+namespace {
+
+// the format SDL's renderers list first, so the upload is a straight copy on most backends
+constexpr uint32_t kBakedPixelFormat = SDL_PIXELFORMAT_ARGB8888;
+constexpr uint32_t kMaxAtlasSize = 4096;
+constexpr uint32_t kPadding = 1;
+
+struct Image {
+  SDL_Surface* surface;
+  sdl::BakedRegion region;
+};
+
+bool packImages(std::vector<Image>& images, uint32_t& width, uint32_t& height) {
+  if(images.size() == 1) {
+    width = images[0].region.width;
+    height = images[0].region.height;
+    return true;
+  }
+
+  std::vector<std::size_t> order(images.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&images](std::size_t a, std::size_t b) {
+    return images[a].region.height > images[b].region.height;
+  });
+
+  vodden::SkylinePacker packer { kMaxAtlasSize, kMaxAtlasSize };
+  width = 0;
+  for(std::size_t index : order) {
+    auto& region = images[index].region;
+    const auto position = packer.insert(region.width + kPadding, region.height + kPadding);
+    if(!position) return false;
+    region.x = position->x;
+    region.y = position->y;
+    width = std::max(width, region.x + region.width);
+  }
+  height = packer.getUsedHeight();
+  return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  if(argc < 3) {
+    std::cerr << "usage: " << argv[0] << " <output> <image>..." << std::endl;
+    return 1;
+  }
+
+  std::vector<Image> images;
+  for(int i = 2; i < argc; ++i) {
+    SDL_Surface* loaded = IMG_Load(argv[i]);
+    if(loaded == nullptr) {
+      std::cerr << argv[i] << ": " << IMG_GetError() << std::endl;
+      return 1;
+    }
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(loaded, kBakedPixelFormat, 0);
+    SDL_FreeSurface(loaded);
+    if(converted == nullptr) {
+      std::cerr << argv[i] << ": " << SDL_GetError() << std::endl;
+      return 1;
+    }
+    SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_NONE);
+    images.push_back({ converted, { 0, 0, static_cast<uint32_t>(converted->w), static_cast<uint32_t>(converted->h) } });
+  }
+
+  uint32_t width, height;
+  if(!packImages(images, width, height)) {
+    std::cerr << argv[1] << ": images do not fit in a " << kMaxAtlasSize << "x" << kMaxAtlasSize << " atlas" << std::endl;
+    return 1;
+  }
+
+  SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, kBakedPixelFormat);
+  if(atlas == nullptr) {
+    std::cerr << SDL_GetError() << std::endl;
+    return 1;
+  }
+  SDL_FillRect(atlas, nullptr, 0);
+  for(auto& image : images) {
+    SDL_Rect destination { static_cast<int>(image.region.x), static_cast<int>(image.region.y), 0, 0 };
+    SDL_BlitSurface(image.surface, nullptr, atlas, &destination);
+    SDL_FreeSurface(image.surface);
+  }
+
+  const std::size_t regionsEnd = sizeof(sdl::BakedImageHeader) + images.size() * sizeof(sdl::BakedRegion);
+  const uint32_t pitch = width * 4;
+  const sdl::BakedImageHeader header {
+    sdl::BakedImage::kMagic,
+    sdl::BakedImage::kVersion,
+    kBakedPixelFormat,
+    width,
+    height,
+    pitch,
+    static_cast<uint32_t>(images.size()),
+    static_cast<uint32_t>((regionsEnd + sdl::BakedImage::kPixelAlignment - 1) / sdl::BakedImage::kPixelAlignment * sdl::BakedImage::kPixelAlignment)
+  };
+
+  std::ofstream output { argv[1], std::ios::binary };
+  output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for(const auto& image : images) output.write(reinterpret_cast<const char*>(&image.region), sizeof(image.region));
+  for(std::size_t i = regionsEnd; i < header.pixelOffset; ++i) output.put(0);
+  for(uint32_t y = 0; y < height; ++y) {
+    output.write(static_cast<const char*>(atlas->pixels) + std::size_t { y } * atlas->pitch, pitch);
+  }
+  SDL_FreeSurface(atlas);
+
+  if(!output) {
+    std::cerr << argv[1] << ": write failed" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,102 @@
+# Writes the assets.h registry of embedded assets.
+#
+# usage: cmake -DOUTPUT=<header> -DASSET_FILES=<file>|<file>... -P generate_asset_registry.cmake
+#
+# Each file is named by its file name, which is also what ld --format binary
+# builds its _binary_<name>_start symbol from. Run at build time, after
+# baking, so that every size is known.
+
+string(REPLACE "|" ";" ASSET_FILES "${ASSET_FILES}")
+list(LENGTH ASSET_FILES AssetCount)
+
+set(Declarations "")
+set(Ids "")
+set(Entries "")
+set(IndexEntries "")
+set(Index 0)
+foreach(AssetFile IN LISTS ASSET_FILES)
+    get_filename_component(AssetName ${AssetFile} NAME)
+    get_filename_component(AssetExtension ${AssetFile} LAST_EXT)
+    file(SIZE ${AssetFile} AssetSize)
+    string(MAKE_C_IDENTIFIER "${AssetName}" SymbolName)
+
+    # tic_tac_toe.png becomes kTicTacToePng
+    string(REGEX MATCHALL "[A-Za-z0-9]+" Words "${AssetName}")
+    set(IdName "k")
+    foreach(Word IN LISTS Words)
+        string(SUBSTRING ${Word} 0 1 First)
+        string(SUBSTRING ${Word} 1 -1 Rest)
+        string(TOUPPER ${First} First)
+        string(APPEND IdName "${First}${Rest}")
+    endforeach()
+
+    if(AssetExtension STREQUAL ".png")
+        set(Format kPng)
+    elseif(AssetExtension STREQUAL ".baked")
+        set(Format kBaked)
+    elseif(AssetExtension STREQUAL ".pack")
+        set(Format kAssetPack)
+    else()
+        set(Format kData)
+    endif()
+
+    string(APPEND Declarations "extern \"C\" const std::byte _binary_${SymbolName}_start[];\n")
+    string(APPEND Ids "  ${IdName},\n")
+    string(APPEND Entries "  Asset { \"${AssetName}\", _binary_${SymbolName}_start, ${AssetSize}, Format::${Format} },\n")
+    string(APPEND IndexEntries "  { vodden::hashAssetName(\"${AssetName}\"), ${Index} },\n")
+    math(EXPR Index "${Index} + 1")
+endforeach()
+
+file(WRITE ${OUTPUT}.tmp
+"// Generated by data/cmake/generate_asset_registry.cmake; do not edit.
+#ifndef __ASSETS_H__
+#define __ASSETS_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+#include <asset_pack.h>
+#include <asset_registry.h>
+#include <constexpr_map.h>
+
+${Declarations}
+namespace assets {
+
+enum class Id : std::size_t {
+${Ids}};
+
+inline constexpr std::array<Asset, ${AssetCount}> kAssets {{
+${Entries}}};
+
+//! @brief name hash to index into kAssets
+inline constexpr vodden::Map<uint64_t, std::size_t, ${AssetCount}> kIndex {{
+${IndexEntries}}};
+
+constexpr const Asset& get(Id id) {
+  return kAssets[static_cast<std::size_t>(id)];
+}
+
+//! @brief the asset with the provided name, or nullptr if none was embedded
+constexpr const Asset* find(std::string_view name) {
+  const auto index = kIndex.find(vodden::hashAssetName(name));
+  if(!index || kAssets[*index].name != name) return nullptr;
+  return &kAssets[*index];
+}
+
+//! @brief the asset with the provided name; a compile error in a constant expression, otherwise std::out_of_range, if none was embedded
+constexpr const Asset& get(std::string_view name) {
+  const Asset* asset = find(name);
+  if(asset == nullptr) throw std::out_of_range(\"assets::get: no embedded asset with that name.\");
+  return *asset;
+}
+
+}
+
+#endif
+")
+# only touch the header when it changes, so that its includers are not rebuilt needlessly
+file(COPY_FILE ${OUTPUT}.tmp ${OUTPUT} ONLY_IF_DIFFERENT)
+file(REMOVE ${OUTPUT}.tmp)
@@ -0,0 +1,40 @@
+#ifndef __ASSET_REGISTRY_H__
+#define __ASSET_REGISTRY_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace assets {
+
+//! @brief what an embedded asset holds, from its file extension
+enum class Format : uint8_t {
+  kData,
+  //! @brief an encoded image, see sdl::Texture and sdl::Surface
+  kPng,
+  //! @brief a pre-decoded image, see sdl::BakedImage
+  kBaked,
+  //! @brief an asset pack, see vodden::AssetPack
+  kAssetPack
+};
+
+/**
+ * @brief An asset linked into the executable by the data target.
+ *
+ * The generated assets.h holds one of these for every file the data target
+ * embeds, in assets::kAssets, along with the Id enumeration indexing them
+ * and get() and find() to look them up by name.
+ */
+struct Asset {
+  std::string_view name;
+  const std::byte* start { nullptr };
+  std::size_t size { 0 };
+  Format format { Format::kData };
+
+  constexpr std::span<const std::byte> getData() const { return { start, size }; };
+};
+
+}
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * Packs files into a single asset pack which vodden::AssetPack can map, or
+ * view in place once linked in. See utils/include/asset_pack.h for the
+ * layout.
+ *
+ * usage: pack <output> <file>...
+ *
+ * Each file is stored under its file name.
+ */
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include <asset_pack.h>
+
+int main(int argc, char* argv[]) {
+  if(argc < 2) {
+    std::cerr << "usage: " << argv[0] << " <output> <file>..." << std::endl;
+    return 1;
+  }
+
+  std::vector<std::vector<std::byte>> contents;
+  contents.reserve(argc - 2);
+  vodden::AssetPackWriter writer;
+  for(int i = 2; i < argc; ++i) {
+    std::ifstream input { argv[i], std::ios::binary };
+    if(!input) {
+      std::cerr << argv[i] << ": could not open" << std::endl;
+      return 1;
+    }
+    const std::vector<char> bytes { std::istreambuf_iterator<char> { input }, std::istreambuf_iterator<char> {} };
+    auto& data = contents.emplace_back(bytes.size());
+    std::memcpy(data.data(), bytes.data(), bytes.size());
+
+    try {
+      writer.add(std::filesystem::path { argv[i] }.filename().string(), data);
+    } catch(const std::invalid_argument& error) {
+      std::cerr << error.what() << std::endl;
+      return 1;
+    }
+  }
+
+  std::ofstream output { argv[1], std::ios::binary };
+  writer.write(output);
+  if(!output) {
+    std::cerr << argv[1] << ": write failed" << std::endl;
+    return 1;
+  }
+  return 0;
+}
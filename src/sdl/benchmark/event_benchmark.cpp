@@ -0,0 +1,71 @@
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <SDL2/SDL.h>
+
+#include <event.h>
+#include <sdl.h>
+
+using namespace sdl;
+
+class MouseButtonEventCounter : public EventHandler<MouseButtonEvent>, public BaseEventHandler {
+  public:
+    virtual void handle([[maybe_unused]] const MouseButtonEvent& mouseButtonEvent) { ++count; };
+    uint64_t count { 0 };
+};
+
+class QuitEventCounter : public EventHandler<QuitEvent>, public BaseEventHandler {
+  public:
+    virtual void handle([[maybe_unused]] const QuitEvent& quitEvent) { ++count; };
+    uint64_t count { 0 };
+};
+
+static MouseButtonEvent makeMouseButtonEvent() {
+  return {
+    std::chrono::milliseconds(0), 1, 0, 64, 64,
+    MouseButtonEvent::Button::kLeft, MouseButtonEvent::State::kPressed, 1
+  };
+}
+
+//! every event visits every handler through castHandler; half of them can't handle it
+static void BM_CastHandlerDispatch(benchmark::State& state) {
+  std::vector<std::unique_ptr<BaseEventHandler>> eventHandlers;
+  for(int64_t i = 0; i < state.range(0); ++i) {
+    if(i % 2 == 0) eventHandlers.push_back(std::make_unique<MouseButtonEventCounter>());
+    else eventHandlers.push_back(std::make_unique<QuitEventCounter>());
+  }
+  auto event = makeMouseButtonEvent();
+
+  for([[maybe_unused]] auto _ : state) {
+    for(auto& eventHandler : eventHandlers) event.handle(*eventHandler);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CastHandlerDispatch)->RangeMultiplier(4)->Range(1, 1024);
+
+//! round trip of one SDL event through the SDL queue and EventProducer::wait
+static void BM_EventProducerWait(benchmark::State& state) {
+  SDL sdl;
+  sdl.initSubSystem(SDL::kEvents);
+  EventProducer eventProducer;
+
+  SDL_Event sdlEvent {};
+  sdlEvent.type = SDL_QUIT;
+  for([[maybe_unused]] auto _ : state) {
+    SDL_PushEvent(&sdlEvent);
+    benchmark::DoNotOptimize(eventProducer.wait());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventProducerWait);
+
+//! allocation and destruction of events alone, without the SDL queue
+static void BM_EventAllocation(benchmark::State& state) {
+  for([[maybe_unused]] auto _ : state) {
+    auto event = std::make_unique<MouseButtonEvent>(makeMouseButtonEvent());
+    benchmark::DoNotOptimize(event.get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventAllocation);
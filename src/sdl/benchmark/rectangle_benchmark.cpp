@@ -0,0 +1,38 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <rectangle.h>
+
+using namespace sdl;
+
+static void BM_RectangleCopy(benchmark::State& state) {
+  std::vector<Rectangle> rectangles(state.range(0), Rectangle { 1, 2, 3, 4 });
+  std::vector<Rectangle> copies(state.range(0));
+
+  for([[maybe_unused]] auto _ : state) {
+    copies = rectangles;
+    benchmark::DoNotOptimize(copies.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RectangleCopy)->RangeMultiplier(8)->Range(8, 8 << 10);
+
+static void BM_RectangleContains(benchmark::State& state) {
+  // a 3x3 board of 128 pixel cells, as in the demo
+  std::vector<Rectangle> cells;
+  for(uint32_t row = 0; row < 3; ++row) {
+    for(uint32_t column = 0; column < 3; ++column) cells.emplace_back(column * 128 + 1, row * 128 + 1, 128, 128);
+  }
+
+  uint32_t x = 0;
+  uint32_t y = 0;
+  for([[maybe_unused]] auto _ : state) {
+    x = (x + 37) % 384;
+    y = (y + 91) % 384;
+    for(const auto& cell : cells) benchmark::DoNotOptimize(cell.contains(x, y));
+  }
+  state.SetItemsProcessed(state.iterations() * cells.size());
+}
+BENCHMARK(BM_RectangleContains);
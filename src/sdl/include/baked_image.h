@@ -0,0 +1,103 @@
+#ifndef __SDL_BAKED_IMAGE_H__
+#define __SDL_BAKED_IMAGE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+#include "rectangle.h"
+
+namespace sdl {
+
+/**
+ * @brief The fixed-size header at the front of a baked image.
+ *
+ * A baked image is written at build time by the data target's bake tool:
+ * this header, then regionCount BakedRegion entries describing the atlas
+ * sub-images, then height rows of pitch bytes of pixels starting at
+ * pixelOffset. The pixels are already in the pixel format given, so they can
+ * be uploaded straight from where the blob is linked or mapped.
+ */
+struct BakedImageHeader {
+  uint32_t magic;
+  uint32_t version;
+  //! @brief an SDL_PixelFormatEnum value
+  uint32_t pixelFormat;
+  uint32_t width;
+  uint32_t height;
+  uint32_t pitch;
+  uint32_t regionCount;
+  uint32_t pixelOffset;
+};
+
+struct BakedRegion {
+  uint32_t x;
+  uint32_t y;
+  uint32_t width;
+  uint32_t height;
+};
+
+//! @brief A read-only view over a baked image held in memory.
+class BakedImage {
+  public:
+    static constexpr uint32_t kMagic = 0x314B4256; // "VBK1"
+    static constexpr uint32_t kVersion = 1;
+    //! @brief the alignment of the pixel data within the blob
+    static constexpr uint32_t kPixelAlignment = 16;
+
+    //! @brief throws std::invalid_argument if data is not a complete baked image, or its regions fall outside it
+    BakedImage(std::span<const std::byte> data) : _data { data } {
+      if(data.size() < sizeof(BakedImageHeader)) throw std::invalid_argument("Baked image is truncated.");
+      // the blob may be linked in at any alignment, so the header is copied out rather than cast
+      std::memcpy(&_header, data.data(), sizeof(_header));
+      if(_header.magic != kMagic || _header.version != kVersion) throw std::invalid_argument("Not a baked image.");
+
+      const std::size_t regionsEnd = sizeof(BakedImageHeader) + std::size_t { _header.regionCount } * sizeof(BakedRegion);
+      const std::size_t pixelsEnd = std::size_t { _header.pixelOffset } + std::size_t { _header.pitch } * _header.height;
+      if(regionsEnd > _header.pixelOffset || pixelsEnd > data.size()) throw std::invalid_argument("Baked image is truncated.");
+      // every baked pixel format is 4 bytes a pixel
+      if(_header.pitch < std::size_t { _header.width } * 4) throw std::invalid_argument("Baked image rows are shorter than its width.");
+      for(std::size_t index = 0; index < _header.regionCount; ++index) {
+        const BakedRegion region = readRegion(index);
+        if(std::size_t { region.x } + region.width > _header.width || std::size_t { region.y } + region.height > _header.height) {
+          throw std::invalid_argument("Baked image region lies outside the image.");
+        }
+      }
+    };
+
+    BakedImage(const void* location, std::size_t size) : BakedImage(std::span { static_cast<const std::byte*>(location), size }) {};
+
+    uint32_t getPixelFormat() const { return _header.pixelFormat; };
+    uint32_t getWidth() const { return _header.width; };
+    uint32_t getHeight() const { return _header.height; };
+    uint32_t getPitch() const { return _header.pitch; };
+
+    std::span<const std::byte> getPixels() const {
+      return _data.subspan(_header.pixelOffset, std::size_t { _header.pitch } * _header.height);
+    };
+
+    //! @brief the number of atlas sub-images; a single image has one region covering it
+    std::size_t getRegionCount() const { return _header.regionCount; };
+
+    Rectangle getRegion(std::size_t index) const {
+      if(index >= _header.regionCount) throw std::out_of_range("Baked image region out of range.");
+      const BakedRegion region = readRegion(index);
+      return Rectangle { region.x, region.y, region.width, region.height };
+    };
+
+  private:
+    BakedRegion readRegion(std::size_t index) const {
+      BakedRegion region;
+      std::memcpy(&region, _data.data() + sizeof(BakedImageHeader) + index * sizeof(BakedRegion), sizeof(region));
+      return region;
+    };
+
+    std::span<const std::byte> _data;
+    BakedImageHeader _header;
+};
+
+}
+
+#endif
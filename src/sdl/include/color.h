@@ -1,41 +1,130 @@
 #ifndef __SDL_COLOR_H__
 #define __SDL_COLOR_H__
 
+#include <bit>
 #include <cstdint>
-#include <tuple>
+#include <cstring>
+#include <span>
+#include <stdexcept>
 
 namespace sdl {
 
 enum class Alpha {
   kOpaque = 255,
-  kTranparent = 0
+  kTransparent = 0,
+  kTranparent [[deprecated("use Alpha::kTransparent")]] = 0
 };
 
+class ColorImpl;
+
+/**
+ * @brief A colour as four bytes, red, green, blue and alpha, in that order.
+ *
+ * Color is laid out as SDL_Color (this is checked in color_impl.h), so
+ * arrays of them are handed to SDL, copied into vertices and converted to
+ * pixels without going a component at a time.
+ */
 class Color {
+  friend ColorImpl;
   public:
-    Color() {};
+    //! @brief one of Texture's pixel formats, which texture.h can't provide here without an include cycle
+    typedef uint8_t PixelFormat;
+
+    constexpr Color() = default;
     constexpr Color(
-      const uint8_t& red, 
-      const uint8_t& green, 
-      const uint8_t& blue, 
-      const uint8_t& alpha) : _color { std::make_tuple(red, green, blue) }, _alpha { alpha } {};
-
-    uint8_t getRed() const { return std::get<0>(_color); };
-    uint8_t getGreen() const { return std::get<1>(_color); };
-    uint8_t getBlue() const { return std::get<2>(_color); };
-    uint8_t getAlpha() const { return _alpha; };
-  
+      const uint8_t& red,
+      const uint8_t& green,
+      const uint8_t& blue,
+      const uint8_t& alpha) : _red { red }, _green { green }, _blue { blue }, _alpha { alpha } {};
+
+    constexpr uint8_t getRed() const { return _red; };
+    constexpr uint8_t getGreen() const { return _green; };
+    constexpr uint8_t getBlue() const { return _blue; };
+    constexpr uint8_t getAlpha() const { return _alpha; };
+
+    constexpr bool operator==(const Color& other) const = default;
+
+    /**
+     * @brief the colour as a pixel value in pixelFormat, a packed 32 bit Texture::PixelFormat.
+     *
+     * Texture::kRGB888 leaves the top byte zero. Texture::kRGB24 is not
+     * packed into a 32 bit value, so it throws std::invalid_argument.
+     */
+    constexpr uint32_t toPixel(PixelFormat pixelFormat) const {
+      // the cases are Texture's pixel formats, each checked against its constant in color_impl.h
+      switch(pixelFormat) {
+        case 0: return pack(_alpha, _red, _green, _blue); // kARGB8888
+        case 1: return pack(_red, _green, _blue, _alpha); // kRGBA8888
+        case 2: return pack(_alpha, _blue, _green, _red); // kABGR8888
+        case 3: return pack(_blue, _green, _red, _alpha); // kBGRA8888
+        case 4: return pack(0, _red, _green, _blue); // kRGB888
+        default: throw std::invalid_argument("Color::toPixel: the pixel format is not packed into 32 bits.");
+      }
+    };
+
+    //! @brief the colour of a pixel value in pixelFormat, as toPixel; Texture::kRGB888 pixels are opaque
+    static constexpr Color fromPixel(uint32_t pixel, PixelFormat pixelFormat) {
+      const uint8_t byte3 = static_cast<uint8_t>(pixel >> 24);
+      const uint8_t byte2 = static_cast<uint8_t>(pixel >> 16);
+      const uint8_t byte1 = static_cast<uint8_t>(pixel >> 8);
+      const uint8_t byte0 = static_cast<uint8_t>(pixel);
+      switch(pixelFormat) {
+        case 0: return { byte2, byte1, byte0, byte3 }; // kARGB8888
+        case 1: return { byte3, byte2, byte1, byte0 }; // kRGBA8888
+        case 2: return { byte0, byte1, byte2, byte3 }; // kABGR8888
+        case 3: return { byte1, byte2, byte3, byte0 }; // kBGRA8888
+        case 4: return { byte2, byte1, byte0, static_cast<uint8_t>(Alpha::kOpaque) }; // kRGB888
+        default: throw std::invalid_argument("Color::fromPixel: the pixel format is not packed into 32 bits.");
+      }
+    };
+
+    /**
+     * @brief convert colors to pixel values in pixelFormat; pixels must be at least as long.
+     *
+     * A Color's bytes already are a Texture::kABGR8888 pixel on little endian
+     * machines, or a kRGBA8888 one on big endian ones, so those are copied
+     * whole rather than converted.
+     */
+    static void toPixels(std::span<const Color> colors, std::span<uint32_t> pixels, PixelFormat pixelFormat) {
+      if(pixels.size() < colors.size()) throw std::out_of_range("Color::toPixels: there are fewer pixels than colors.");
+      if(pixelFormat == kBytewiseFormat) {
+        if(!colors.empty()) std::memcpy(pixels.data(), colors.data(), colors.size_bytes());
+        return;
+      }
+      for(std::size_t i = 0; i < colors.size(); ++i) pixels[i] = colors[i].toPixel(pixelFormat);
+    };
+
+    //! @brief convert pixel values in pixelFormat to colors, which must be at least as long, as toPixels
+    static void fromPixels(std::span<const uint32_t> pixels, std::span<Color> colors, PixelFormat pixelFormat) {
+      if(colors.size() < pixels.size()) throw std::out_of_range("Color::fromPixels: there are fewer colors than pixels.");
+      if(pixelFormat == kBytewiseFormat) {
+        if(!pixels.empty()) std::memcpy(static_cast<void*>(colors.data()), pixels.data(), pixels.size_bytes());
+        return;
+      }
+      for(std::size_t i = 0; i < pixels.size(); ++i) colors[i] = fromPixel(pixels[i], pixelFormat);
+    };
+
   private:
-    std::tuple<uint8_t, uint8_t, uint8_t> _color { 0, 0, 0 };
-    uint8_t _alpha { (uint8_t) Alpha::kOpaque };
+    static constexpr uint32_t pack(uint8_t byte3, uint8_t byte2, uint8_t byte1, uint8_t byte0) {
+      return (uint32_t { byte3 } << 24) | (uint32_t { byte2 } << 16) | (uint32_t { byte1 } << 8) | uint32_t { byte0 };
+    };
 
+    //! @brief the pixel format whose 32 bit values have a Color's byte order in memory, kABGR8888 or kRGBA8888
+    static constexpr PixelFormat kBytewiseFormat = std::endian::native == std::endian::little ? 2 : 1;
+
+    uint8_t _red { 0 };
+    uint8_t _green { 0 };
+    uint8_t _blue { 0 };
+    uint8_t _alpha { static_cast<uint8_t>(Alpha::kOpaque) };
 };
 
+static_assert(sizeof(Color) == 4);
+
 class NamedColor {
   public:
-    static constexpr Color kBlack = Color{ 0, 0, 0, (uint8_t) Alpha::kTranparent };
-    static constexpr Color kWhite = Color{ 255, 255, 255, (uint8_t) Alpha::kTranparent };
-    static constexpr Color kMagenta = Color{ 0xc2, 0x00, 0x78, (uint8_t) Alpha::kTranparent };
+    static constexpr Color kBlack = Color{ 0, 0, 0, (uint8_t) Alpha::kOpaque };
+    static constexpr Color kWhite = Color{ 255, 255, 255, (uint8_t) Alpha::kOpaque };
+    static constexpr Color kMagenta = Color{ 0xc2, 0x00, 0x78, (uint8_t) Alpha::kOpaque };
 };
 
 }
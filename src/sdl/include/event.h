@@ -1,14 +1,18 @@
 #ifndef __SDL_EVENT_H__
 #define __SDL_EVENT_H__
 
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <exception>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <span>
 
 namespace sdl {
 
+//! @brief no longer thrown by EventProducer, which returns a RawEvent for events it doesn't recognise
 class UnknownEventException : public std::runtime_error {
   using std::runtime_error::runtime_error;
 };
@@ -26,31 +30,94 @@ class EventHandler {
     virtual void handle(const EventClass& event) = 0;
 };
 
+class BaseEvent;
+
+//! @brief a dense, process-wide identifier for an event class
+typedef std::size_t EventTypeId;
+
+namespace detail {
+  //! @brief returns the EventHandler<EventClass> within a handler, or nullptr if it has none
+  typedef void* (*HandlerProbe)(BaseEventHandler& baseEventHandler);
+  //! @brief calls a handler previously returned by the matching HandlerProbe
+  typedef void (*HandlerInvoker)(void* eventHandler, const BaseEvent& event);
+
+  struct EventTypeInfo {
+    HandlerProbe probe;
+    HandlerInvoker invoke;
+  };
+
+  EventTypeId registerEventType(EventTypeInfo eventTypeInfo);
+  EventTypeInfo getEventTypeInfo(EventTypeId eventTypeId);
+}
+
+/**
+ * @brief the EventTypeId of the provided event class.
+ *
+ * Ids are handed out on first use, so dispatchers can index handlers by
+ * event type in a dense table rather than testing every handler.
+ */
+template <class EventClass>
+EventTypeId eventTypeId() {
+  static const EventTypeId id = detail::registerEventType({
+    [](BaseEventHandler& baseEventHandler) -> void* {
+      return dynamic_cast<EventHandler<EventClass>*>(&baseEventHandler);
+    },
+    [](void* eventHandler, const BaseEvent& event) {
+      static_cast<EventHandler<EventClass>*>(eventHandler)->handle(static_cast<const EventClass&>(event));
+    }
+  });
+  return id;
+}
+
 //! @brief a superclass for all events
 class BaseEvent {
   public:
     virtual ~BaseEvent() {};
+
+    /**
+     * Events are allocated from recycled, size-classed blocks so that the
+     * steady-state event loop does not touch the heap. Live events are
+     * counted against vodden::memory::Category::kEvents.
+     */
+    static void* operator new(std::size_t size);
+    static void operator delete(void* pointer, std::size_t size) noexcept;
+
     virtual void handle(BaseEventHandler &baseEventHandler) = 0;
+    //! @brief the EventTypeId of the most derived event class
+    virtual EventTypeId typeId() const = 0;
+    //! @brief the id of the window the event happened in, as Window::getId(), or 0 for none in particular
+    virtual uint32_t getWindowId() const { return 0; };
+    //! @brief when the input behind the event happened, on the timeline of getPerformanceTime(), or zero if unknown
+    virtual std::chrono::nanoseconds getInputTime() const { return std::chrono::nanoseconds::zero(); };
 };
 
 template <class EventClass>
 void castHandler(const EventClass& eventClass, BaseEventHandler& baseEventHandler) {
-  try {
-    EventHandler<EventClass> &eventHandler = dynamic_cast<EventHandler<EventClass>&>(baseEventHandler);
-    eventHandler.handle(eventClass);
-  } catch (std::bad_cast &e) { } // bad cast just means this handler can't handle this event
+  // a null result just means this handler can't handle this event
+  auto eventHandler = dynamic_cast<EventHandler<EventClass>*>(&baseEventHandler);
+  if(eventHandler != nullptr) eventHandler->handle(eventClass);
 }
 
 class Event : public BaseEvent {
   public:
     //! @brief constructor
     Event(std::chrono::duration<uint64_t, std::milli> ts) : timestamp{ts} {};
-    //! @brief timestamp of the event
+    //! @brief timestamp of the event; for SDL's events, when SDL queued it, in milliseconds since SDL was initialized
     std::chrono::duration<uint64_t, std::milli> timestamp;
+    /**
+     * @brief when the input happened, to the performance counter's precision, as getInputTime()
+     *
+     * Set by EventProducer on mouse and keyboard events, from the time the
+     * event was taken off SDL's queue less the time it had waited there.
+     */
+    std::chrono::nanoseconds inputTime { 0 };
 
     virtual void handle(BaseEventHandler &baseEventHandler) override {
       castHandler(*this, baseEventHandler);
     };
+
+    virtual EventTypeId typeId() const override { return eventTypeId<Event>(); };
+    virtual std::chrono::nanoseconds getInputTime() const override { return inputTime; };
 };
 
 class QuitEvent : public Event {
@@ -59,6 +126,8 @@ class QuitEvent : public Event {
     virtual void handle(BaseEventHandler &baseEventHandler ) override {
       castHandler(*this, baseEventHandler);
     };
+
+    virtual EventTypeId typeId() const override { return eventTypeId<QuitEvent>(); };
 };
 
 class MouseEvent : public Event {
@@ -73,6 +142,9 @@ class MouseEvent : public Event {
     virtual void handle(BaseEventHandler &baseEventHandler) override {
       castHandler(*this, baseEventHandler);
     };
+
+    virtual EventTypeId typeId() const override { return eventTypeId<MouseEvent>(); };
+    virtual uint32_t getWindowId() const override { return windowId; };
     
     //! @brief the window with mouse focus, if any
     uint32_t windowId;
@@ -94,6 +166,8 @@ class MousePositionEvent : public MouseEvent {
     virtual void handle(BaseEventHandler &baseEventHandler) override {
       castHandler(*this, baseEventHandler);
     };
+
+    virtual EventTypeId typeId() const override { return eventTypeId<MousePositionEvent>(); };
     
     //! @brief x co-ordinate of event relative to window.
     int32_t x;
@@ -130,6 +204,8 @@ class MouseButtonEvent : public MousePositionEvent {
     virtual void handle(BaseEventHandler &baseEventHandler) override {
       castHandler(*this, baseEventHandler);
     };
+
+    virtual EventTypeId typeId() const override { return eventTypeId<MouseButtonEvent>(); };
     
     //! @brief the mouse button which has changed state
     Button button;
@@ -141,16 +217,186 @@ class MouseButtonEvent : public MousePositionEvent {
     uint8_t clicks;
 };
 
+class MouseMotionEvent : public MousePositionEvent {
+  public:
+    MouseMotionEvent(
+      std::chrono::duration<int64_t, std::milli> ts,
+      uint32_t windowId,
+      uint32_t which,
+      int32_t x,
+      int32_t y,
+      int32_t relativeX,
+      int32_t relativeY,
+      uint32_t buttons
+    ) : MousePositionEvent(ts, windowId, which, x, y), relativeX { relativeX }, relativeY { relativeY }, buttons { buttons } {};
+
+    virtual void handle(BaseEventHandler &baseEventHandler) override {
+      castHandler(*this, baseEventHandler);
+    };
+
+    virtual EventTypeId typeId() const override { return eventTypeId<MouseMotionEvent>(); };
+
+    //! @brief motion in the x direction since the previous motion event
+    int32_t relativeX;
+    //! @brief motion in the y direction since the previous motion event
+    int32_t relativeY;
+
+    //! @brief the buttons held during the motion, bit (n - 1) set for SDL button n
+    uint32_t buttons;
+};
+
+class MouseWheelEvent : public MouseEvent {
+  public:
+    MouseWheelEvent(
+      std::chrono::duration<int64_t, std::milli> ts,
+      uint32_t windowId,
+      uint32_t which,
+      int32_t x,
+      int32_t y,
+      bool flipped
+    ) : MouseEvent(ts, windowId, which), x { x }, y { y }, flipped { flipped } {};
+
+    virtual void handle(BaseEventHandler &baseEventHandler) override {
+      castHandler(*this, baseEventHandler);
+    };
+
+    virtual EventTypeId typeId() const override { return eventTypeId<MouseWheelEvent>(); };
+
+    //! @brief amount scrolled horizontally, positive to the right
+    int32_t x;
+    //! @brief amount scrolled vertically, positive away from the user
+    int32_t y;
+
+    //! @brief true when the platform has inverted x and y ("natural" scrolling)
+    bool flipped;
+};
+
+class KeyboardEvent : public Event {
+  public:
+    enum class State {
+      kPressed,
+      kReleased
+    };
+
+    //! @brief a virtual key code, as SDL_Keycode - layout dependent
+    typedef int32_t KeyCode;
+    //! @brief a physical key code, as SDL_Scancode - layout independent
+    typedef uint32_t ScanCode;
+    //! @brief a mask of held modifier keys, as SDL_Keymod
+    typedef uint16_t KeyModifiers;
+
+    KeyboardEvent(
+      std::chrono::duration<int64_t, std::milli> ts,
+      uint32_t windowId,
+      KeyCode keyCode,
+      ScanCode scanCode,
+      KeyModifiers modifiers,
+      State state,
+      bool repeat
+    ) : Event(ts), windowId { windowId }, keyCode { keyCode }, scanCode { scanCode }, modifiers { modifiers }, state { state }, repeat { repeat } {};
+
+    virtual void handle(BaseEventHandler &baseEventHandler) override {
+      castHandler(*this, baseEventHandler);
+    };
+
+    virtual EventTypeId typeId() const override { return eventTypeId<KeyboardEvent>(); };
+    virtual uint32_t getWindowId() const override { return windowId; };
+
+    //! @brief the window with keyboard focus, if any
+    uint32_t windowId;
+
+    //! @brief the key which has changed state
+    KeyCode keyCode;
+    ScanCode scanCode;
+    KeyModifiers modifiers;
+
+    //! @brief the state to which the key has changed
+    State state;
+
+    //! @brief true if this is a key repeat rather than a fresh press
+    bool repeat;
+};
+
+/**
+ * @brief an SDL event which has no class of its own
+ *
+ * The SDL_Event is copied as-is, so a handler which includes SDL can memcpy
+ * data into an SDL_Event to read it. A producer hands these out rather than
+ * throwing, so an event nobody handles costs a pooled allocation and a
+ * table lookup in the dispatcher.
+ */
+class RawEvent : public Event {
+  public:
+    //! @brief sizeof(SDL_Event)
+    static constexpr std::size_t kSize = 56;
+
+    RawEvent(
+      std::chrono::duration<int64_t, std::milli> ts,
+      uint32_t type,
+      const std::array<std::byte, kSize>& data
+    ) : Event(ts), type { type }, data { data } {};
+
+    virtual void handle(BaseEventHandler &baseEventHandler) override {
+      castHandler(*this, baseEventHandler);
+    };
+
+    virtual EventTypeId typeId() const override { return eventTypeId<RawEvent>(); };
+
+    //! @brief the SDL_EventType
+    uint32_t type;
+
+    //! @brief the bytes of the SDL_Event
+    std::array<std::byte, kSize> data;
+};
+
 class BaseEventProducer {
   public:
+    virtual ~BaseEventProducer() {};
+
+    //! @brief block until the next event is available and return it, as a RawEvent if it has no class.
     virtual std::unique_ptr<BaseEvent> wait() = 0;
+
+    //! @brief return the next pending event, or nullptr if there are none, without blocking.
+    virtual std::unique_ptr<BaseEvent> poll() = 0;
+
+    /**
+     * @brief move pending events into the provided buffer without blocking.
+     *
+     * @return the number of events written to the front of the buffer.
+     */
+    virtual std::size_t drain(std::span<std::unique_ptr<BaseEvent>> events) {
+      std::size_t count = 0;
+      while(count < events.size() && (events[count] = poll())) ++count;
+      return count;
+    };
+
     virtual void produce(std::unique_ptr<Event>) {};
 };
 
 class EventProducer : public BaseEventProducer {
   public:
+    enum class MotionPolicy {
+      //! @brief every SDL motion event becomes a MouseMotionEvent
+      kEveryEvent,
+      /**
+       * @brief drain merges runs of consecutive motions from the same mouse
+       *
+       * The merged event has the position and buttons of the last motion in the
+       * run and the sum of their relative motion, so a frame sees one motion
+       * event rather than one per sample the mouse reported.
+       */
+      kCoalesce
+    };
+
+    explicit EventProducer(MotionPolicy motionPolicy = MotionPolicy::kEveryEvent) : _motionPolicy { motionPolicy } {};
+
     virtual std::unique_ptr<BaseEvent> wait();
+    virtual std::unique_ptr<BaseEvent> poll();
+    virtual std::size_t drain(std::span<std::unique_ptr<BaseEvent>> events);
     virtual void produce(std::unique_ptr<Event>) {};
+
+  private:
+    MotionPolicy _motionPolicy;
 };
 
 
@@ -0,0 +1,102 @@
+#ifndef __SDL_EVENT_RECORDING_H__
+#define __SDL_EVENT_RECORDING_H__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "event.h"
+
+namespace sdl {
+
+/**
+ * @brief passes on the events of another producer, writing each to a binary log
+ *
+ * The log starts with a short header and holds one fixed-size, little-endian
+ * record per event, so it reads back identically on any platform. Quit,
+ * mouse, keyboard and raw events are recorded with their timestamps; other
+ * events, such as user events whose payloads can't be written, are passed on
+ * without being recorded.
+ *
+ * Records are written to output as events are produced, and nothing is
+ * thrown if it fails, so check the stream once recording is done.
+ */
+class RecordingEventProducer : public BaseEventProducer {
+  public:
+    RecordingEventProducer(BaseEventProducer& eventProducer, std::ostream& output);
+
+    virtual std::unique_ptr<BaseEvent> wait();
+    virtual std::unique_ptr<BaseEvent> poll();
+    virtual std::size_t drain(std::span<std::unique_ptr<BaseEvent>> events);
+    virtual void produce(std::unique_ptr<Event> event) { _eventProducer.produce(std::move(event)); };
+
+    //! @brief the number of events written to the log so far
+    std::size_t getRecordedCount() const { return _recordedCount; };
+
+  private:
+    void record(const BaseEvent* event);
+
+    BaseEventProducer& _eventProducer;
+    std::ostream& _output;
+    std::size_t _recordedCount { 0 };
+};
+
+/**
+ * @brief produces the events of a log written by RecordingEventProducer
+ *
+ * The log is read and checked up front, so replay itself only decodes
+ * records from memory into pooled events. Events keep their recorded
+ * timestamps, so handlers see exactly what was recorded however fast it is
+ * replayed.
+ *
+ * Once every event has been produced, poll and drain find nothing and wait
+ * returns a QuitEvent, so an EventDispatcher run over a replay ends with it.
+ */
+class ReplayEventProducer : public BaseEventProducer {
+  public:
+    enum class Pacing {
+      //! @brief every event is available at once
+      kAsFastAsPossible,
+      //! @brief each event becomes available as long after the first as it was recorded
+      kRealTime
+    };
+
+    //! @brief read a whole log, throwing std::invalid_argument if it is not one or is cut short
+    explicit ReplayEventProducer(std::istream& input, Pacing pacing = Pacing::kAsFastAsPossible);
+    explicit ReplayEventProducer(std::span<const std::byte> log, Pacing pacing = Pacing::kAsFastAsPossible);
+
+    virtual std::unique_ptr<BaseEvent> wait();
+    virtual std::unique_ptr<BaseEvent> poll();
+
+    //! @brief true once every event in the log has been produced
+    bool isFinished() const { return _offset == _log.size(); };
+    //! @brief the number of events in the log
+    std::size_t size() const { return _eventCount; };
+
+    //! @brief start again from the first event, restarting the clock when pacing in real time
+    void rewind();
+
+  private:
+    void validate();
+    //! @brief the time since the replay started at which the next event is due
+    std::chrono::milliseconds nextDue() const;
+    std::unique_ptr<BaseEvent> next();
+
+    std::vector<std::byte> _log;
+    Pacing _pacing;
+    std::size_t _offset;
+    std::size_t _eventCount { 0 };
+    uint64_t _firstTimestamp { 0 };
+    uint64_t _lastTimestamp { 0 };
+    bool _started { false };
+    std::chrono::steady_clock::time_point _start {};
+};
+
+}
+
+#endif
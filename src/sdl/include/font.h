@@ -0,0 +1,67 @@
+#ifndef __SDL_FONT_H__
+#define __SDL_FONT_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+#include "handle.h"
+#include "surface.h"
+
+namespace sdl {
+
+/**
+ * @brief A TrueType font at one point size, rasterized with SDL_ttf.
+ *
+ * Each Font holds a reference to SDL_ttf, which is initialised by the first
+ * and shut down after the last, so no subsystem needs starting by hand.
+ * Glyphs are addressed by Unicode code point.
+ */
+class Font {
+  public:
+    //! @brief where a glyph's outline lies relative to the pen, in pixels with y up from the baseline
+    struct GlyphMetrics {
+      int32_t minX;
+      int32_t maxX;
+      int32_t minY;
+      int32_t maxY;
+      int32_t advance;
+    };
+
+    Font(std::filesystem::path filePath, uint32_t pointSize);
+    //! @brief opens a font already held in cpu memory, which must outlive the Font.
+    Font(const void* location, std::size_t size, uint32_t pointSize);
+    Font(Font&) = delete;
+    Font(Font&& other) noexcept;
+    ~Font();
+
+    Font& operator=(Font&) = delete;
+    Font& operator=(Font&& other) noexcept;
+
+    //! @brief the height of a line of glyphs
+    uint32_t getHeight() const;
+    //! @brief the distance from the top of a line to its baseline
+    int32_t getAscent() const;
+    //! @brief the distance from one line's top to the next's
+    uint32_t getLineSkip() const;
+
+    bool hasGlyph(char32_t codePoint) const;
+    GlyphMetrics getGlyphMetrics(char32_t codePoint) const;
+    //! @brief the adjustment to the pen between previous and next, usually 0 or negative
+    int32_t getKerning(char32_t previous, char32_t next) const;
+
+    /**
+     * @brief rasterize one glyph, antialiased, in white on transparent.
+     *
+     * The surface is getHeight() tall and starts at the pen position and
+     * the top of the line, so it is drawn there and then tinted to colour.
+     */
+    Surface renderGlyph(char32_t codePoint) const;
+
+  private:
+    detail::Handle<_TTF_Font, detail::FontDeleter> _ttfFont;
+};
+
+}
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef __SDL_FRAME_CLOCK_H__
+#define __SDL_FRAME_CLOCK_H__
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace sdl {
+
+//! @brief Frame times over a rolling window of recent frames.
+class FrameStatistics {
+  public:
+    typedef std::chrono::nanoseconds Duration;
+
+    static constexpr std::size_t kWindowSize = 240;
+
+    void record(Duration frameTime);
+
+    /**
+     * @brief the frame time which fraction of the window's frames took no longer than.
+     *
+     * @param fraction between 0 and 1, e.g. 0.99 for the 99th percentile.
+     */
+    Duration getPercentile(double fraction) const;
+    Duration getMedian() const { return getPercentile(0.5); };
+    Duration getP99() const { return getPercentile(0.99); };
+    Duration getMean() const;
+
+    //! @brief the number of frames in the window
+    std::size_t size() const { return _count; };
+
+  private:
+    std::array<Duration, kWindowSize> _frameTimes {};
+    std::size_t _next { 0 };
+    std::size_t _count { 0 };
+};
+
+/**
+ * @brief Paces a game loop using the high resolution performance counter.
+ *
+ * A typical frame looks like:
+ *
+ *   frameClock.beginFrame();
+ *   while(frameClock.step()) update(frameClock.getFixedTimestep());
+ *   draw(frameClock.getInterpolation());
+ *   frameClock.waitForNextFrame();
+ *
+ * Updates run at a fixed timestep however long frames take, and drawing can
+ * blend between the last two updates by the interpolation factor.
+ * waitForNextFrame() sleeps for most of the remaining frame time and spins
+ * for the last part, learning how late the OS tends to wake it, so the
+ * target frame time is hit without oversleeping or pegging a core.
+ */
+class FrameClock {
+  public:
+    typedef std::chrono::nanoseconds Duration;
+
+    static constexpr Duration kSixtyHertz { 1'000'000'000 / 60 };
+    //! @brief longer frames are clamped, so a stall doesn't trigger a long burst of catch-up updates
+    static constexpr Duration kMaxFrameTime { 250'000'000 };
+
+    FrameClock(Duration targetFrameTime = kSixtyHertz, Duration fixedTimestep = kSixtyHertz);
+
+    //! @brief start a frame, measuring the time since the previous one began
+    void beginFrame();
+    /**
+     * @brief start a frame which took frameTime, rather than measuring it.
+     *
+     * Under vsync, passing Renderer::PresentTiming::interval steps the
+     * simulation in time with the display's refresh instead of with whenever
+     * the loop happened to wake, which keeps motion even.
+     */
+    void beginFrame(Duration frameTime);
+
+    //! @brief true, consuming one fixed timestep, while an update is due
+    bool step();
+
+    //! @brief the fraction of a fixed timestep accumulated but not yet stepped, between 0 and 1
+    double getInterpolation() const;
+
+    //! @brief wait until the target frame time has passed since beginFrame()
+    void waitForNextFrame();
+
+    Duration getTargetFrameTime() const { return _targetFrameTime; };
+    Duration getFixedTimestep() const { return _fixedTimestep; };
+    //! @brief the duration of the previous frame, beginFrame() to beginFrame()
+    Duration getFrameTime() const { return _frameTime; };
+    const FrameStatistics& getStatistics() const { return _statistics; };
+
+  private:
+    Duration toDuration(uint64_t ticks) const;
+    Duration elapsedSince(uint64_t counter) const;
+
+    Duration _targetFrameTime;
+    Duration _fixedTimestep;
+    uint64_t _frequency;
+    uint64_t _frameStart { 0 };
+    Duration _frameTime { 0 };
+    Duration _accumulator { 0 };
+    //! @brief a decaying estimate of how late a sleep returns
+    Duration _sleepOvershoot { 1'000'000 };
+    FrameStatistics _statistics;
+};
+
+/**
+ * @brief the high resolution performance counter, as a duration from an arbitrary origin.
+ *
+ * This is the timeline of Event::inputTime, so subtracting one from a later
+ * reading gives how long ago the input happened.
+ */
+FrameClock::Duration getPerformanceTime();
+
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef __SDL_HANDLE_H__
+#define __SDL_HANDLE_H__
+
+#include <memory>
+
+// opaque here; only the translation units which call SDL include SDL.h
+struct SDL_Renderer;
+struct SDL_Surface;
+struct SDL_Texture;
+struct SDL_Window;
+// SDL_ttf's TTF_Font is a typedef of this
+struct _TTF_Font;
+
+namespace sdl::detail {
+
+/**
+ * @brief Sole owner of an SDL resource, one pointer wide.
+ *
+ * Moving leaves the source empty and destroying an empty handle does
+ * nothing, so a resource is released exactly once however its owner has
+ * been moved. Deleter is stateless and only declared here, so that SDL is
+ * not needed to use the owning class.
+ */
+template <class Resource, class Deleter>
+class Handle {
+  public:
+    constexpr Handle() noexcept = default;
+    explicit Handle(Resource* resource) noexcept : _resource { resource } {};
+    Handle(const Handle&) = delete;
+    Handle(Handle&&) noexcept = default;
+
+    Handle& operator=(const Handle&) = delete;
+    Handle& operator=(Handle&&) noexcept = default;
+
+    Resource* get() const noexcept { return _resource.get(); };
+    explicit operator bool() const noexcept { return static_cast<bool>(_resource); };
+
+    //! @brief take ownership of resource, releasing the one held before
+    void reset(Resource* resource = nullptr) noexcept { _resource.reset(resource); };
+
+  private:
+    std::unique_ptr<Resource, Deleter> _resource;
+};
+
+struct RendererDeleter { void operator()(SDL_Renderer* sdlRenderer) const noexcept; };
+struct SurfaceDeleter { void operator()(SDL_Surface* sdlSurface) const noexcept; };
+struct TextureDeleter { void operator()(SDL_Texture* sdlTexture) const noexcept; };
+struct WindowDeleter { void operator()(SDL_Window* sdlWindow) const noexcept; };
+//! @brief closes the font and releases the reference to SDL_ttf its Font took
+struct FontDeleter { void operator()(_TTF_Font* ttfFont) const noexcept; };
+
+static_assert(sizeof(Handle<SDL_Window, WindowDeleter>) == sizeof(SDL_Window*), "stateless deleters take no space");
+
+}
+
+#endif
@@ -1,49 +1,65 @@
 #ifndef __SDL_RECTANGLE_H__
 #define __SDL_RECTANGLE_H__
 
-#include <memory>
-
-#include "renderer.h"
+#include <cstdint>
 
 namespace sdl {
 
-class Renderer;
 class RectangleImpl;
 
+/**
+ * @brief An axis aligned rectangle.
+ *
+ * Rectangle is a trivially copyable value type with inline storage. Its layout
+ * matches SDL_Rect (this is checked in rectangle_impl.h) so the renderer can
+ * hand it straight to SDL without a conversion or a heap allocation.
+ */
 class Rectangle {
-  friend Renderer;
+  friend RectangleImpl;
   public:
-    Rectangle(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+    constexpr Rectangle() = default;
+    constexpr Rectangle(uint32_t x, uint32_t y, uint32_t width, uint32_t height) :
+      _x { static_cast<int>(x) },
+      _y { static_cast<int>(y) },
+      _width { static_cast<int>(width) },
+      _height { static_cast<int>(height) } {};
 
-    /**
-     * RectangleImpl is incomplete here, so the compiler cannot
-     * construct default move & copy constructors & assignemnt
-     * operators. In rectangle.cpp RectangleImpl is complete so
-     * we just have to type out these methods manually
-    */
+    constexpr uint32_t getX() const { return _x; };
+    constexpr uint32_t getY() const { return _y; };
+    constexpr uint32_t getHeight() const { return _height; };
+    constexpr uint32_t getWidth() const { return _width; };
 
-    //! @brief copy constructor
-    Rectangle(const Rectangle& other);
-    //! @brief move constructor
-    Rectangle(Rectangle&& other);
+    constexpr bool contains(const uint32_t &x, const uint32_t &y) const {
+      if ( x < getX() ) return false;
+      if ( x > getX() + getWidth() ) return false;
+      if ( y < getY() ) return false;
+      if ( y > getY() + getHeight() ) return false;
 
-    ~Rectangle();
+      return true;
+    }
 
-    //! @brief copy assignment operator
-    Rectangle& operator=(const Rectangle& other);
-    
-    //! @brief move assignment operator
-    Rectangle& operator=(Rectangle&& other);
+    //! @brief true if the two rectangles share any area
+    constexpr bool intersects(const Rectangle& other) const {
+      return _x < other._x + other._width && other._x < _x + _width &&
+        _y < other._y + other._height && other._y < _y + _height;
+    }
 
-    uint32_t getX() const;
-    uint32_t getY() const;
-    uint32_t getHeight() const;
-    uint32_t getWidth() const;
+    //! @brief the smallest rectangle containing both rectangles
+    constexpr Rectangle getUnion(const Rectangle& other) const {
+      const int left = _x < other._x ? _x : other._x;
+      const int top = _y < other._y ? _y : other._y;
+      const int right = _x + _width > other._x + other._width ? _x + _width : other._x + other._width;
+      const int bottom = _y + _height > other._y + other._height ? _y + _height : other._y + other._height;
+      return Rectangle(static_cast<uint32_t>(left), static_cast<uint32_t>(top), static_cast<uint32_t>(right - left), static_cast<uint32_t>(bottom - top));
+    }
 
-    bool contains(const uint32_t &x, const uint32_t &y) const;
+    constexpr bool operator==(const Rectangle& other) const = default;
 
   private:
-    std::unique_ptr<RectangleImpl> _rectangleImpl;
+    int _x { 0 };
+    int _y { 0 };
+    int _width { 0 };
+    int _height { 0 };
 };
 
 }
@@ -1,17 +1,27 @@
 #ifndef __SDL_RENDERER_H__
 #define __SDL_RENDERER_H__
 
+#include <chrono>
+#include <functional>
 #include <optional>
 #include <memory>
-#include <unordered_set>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <flags.h>
+#include <pixel_kernels.h>
 
 #include "color.h"
+#include "handle.h"
 #include "rectangle.h"
 #include "texture.h"
+#include "vertex.h"
 
 namespace sdl {
 
 class Rectangle;
+class Surface;
 class Texture;
 class Window;
 class RendererImpl;
@@ -21,11 +31,21 @@ class Renderer {
   friend Texture;
   public:
     typedef uint8_t RendererFlag;
+    typedef uint8_t VSyncMode;
     
     /**
      * @brief Construct a renderer associated with the provided window
      */
-    Renderer( Window& window, int16_t index, const std::unordered_set<RendererFlag> flags );
+    Renderer( Window& window, int16_t index, const vodden::Flags<RendererFlag> flags );
+    /**
+     * @brief Construct a software renderer which draws into the provided surface.
+     *
+     * No window or display is involved, so this renders the same frames on a
+     * machine without one. The surface must outlive the renderer, and holds
+     * what has been drawn without needing present(). getInfo() reports an
+     * index of -1.
+     */
+    explicit Renderer( Surface& surface );
     //! @brief move constructor
     Renderer( Renderer&& other ) noexcept;
     //! @brief Renderer cannot be copied
@@ -38,9 +58,63 @@ class Renderer {
     //! @brief Renderer cannot be copied
     Renderer& operator= ( const Renderer& other ) = delete;
 
-    //! @brief Set the color used for drawing operations (Rect, Line and Clear).
+    //! @brief What a render driver, or a renderer created from one, supports.
+    struct Info {
+      //! @brief the driver's index, as passed to the constructor
+      int16_t index;
+      std::string name;
+      vodden::Flags<RendererFlag> flags;
+      //! @brief the Texture::PixelFormat values the driver uploads without converting, best first
+      std::vector<uint8_t> pixelFormats;
+      //! @brief the largest texture the driver can create; zero if it does not say
+      uint32_t maxTextureWidth;
+      uint32_t maxTextureHeight;
+    };
+
+    //! @brief What create needs a driver to support.
+    struct Requirements {
+      //! @brief the flags a driver must report, which are also requested of the renderer
+      vodden::Flags<RendererFlag> flags;
+      //! @brief the smallest acceptable maximum texture width and height
+      uint32_t minTextureSize { 0 };
+    };
+
+    //! @brief Describe every render driver compiled into SDL, in SDL's order of preference.
+    static std::vector<Info> getDriverInfo();
+
+    /**
+     * @brief Construct a renderer on the best driver meeting the requirements.
+     *
+     * Accelerated drivers are tried first, in SDL's order of preference, and
+     * the software renderer only when none of them can be created. Throws the
+     * last creation failure, or std::runtime_error if no driver qualifies.
+     */
+    static Renderer create( Window& window, const Requirements& requirements );
+    //! @brief Construct a renderer on the best driver, with no further requirements.
+    static Renderer create( Window& window );
+
+    //! @brief Describe the driver this renderer was created on.
+    const Info& getInfo() const;
+
+    /**
+     * @brief The Texture::PixelFormat a texture should use to be uploaded and drawn without conversion.
+     *
+     * This is the driver's first native format with an alpha channel, falling
+     * back to its first native format and then to Texture::kARGB8888.
+     */
+    uint8_t getPreferredPixelFormat() const;
+
+    /**
+     * @brief Set the color used for drawing operations (Rect, Line and Clear).
+     *
+     * Like the other state setters this remembers what it last set, and
+     * setting the same state again makes no SDL call.
+     */
     void setRenderDrawColour(const Color& color);
 
+    //! @brief Set how fillRectangle and clear blend, as a Texture::BlendMode.
+    void setRenderDrawBlendMode(const uint8_t& blendMode);
+
     //! @brief Copy a region of the texture to a region of the renderer.
     const Renderer &copy(
       const Texture& texture
@@ -53,9 +127,130 @@ class Renderer {
       const Rectangle &destination
     ) const;
 
+    /**
+     * @brief Copy many regions of the texture to regions of the renderer.
+     *
+     * sources[i] is copied to destinations[i]; both spans must be the same length.
+     */
+    const Renderer &copy(
+      const Texture& texture,
+      std::span<const Rectangle> sources,
+      std::span<const Rectangle> destinations
+    ) const;
+
+    /**
+     * @brief Copy a region of the texture with the provided Texture::BlendMode.
+     *
+     * SDL keeps the blend mode on the texture, so this sets it there when
+     * it differs, and leaves it set. Draws grouped by blend mode change it
+     * once per group.
+     */
+    const Renderer &copy(
+      const Texture& texture,
+      const Rectangle &source,
+      const Rectangle &destination,
+      uint8_t blendMode
+    ) const;
+
+    //! @brief Copy many regions of the texture with the provided Texture::BlendMode, as above.
+    const Renderer &copy(
+      const Texture& texture,
+      std::span<const Rectangle> sources,
+      std::span<const Rectangle> destinations,
+      uint8_t blendMode
+    ) const;
+
+    /**
+     * @brief Draw triangles, optionally textured, in a single call.
+     *
+     * Each consecutive three indices name the vertices of one triangle. If
+     * indices is empty, each consecutive three vertices form a triangle.
+     */
+    const Renderer &renderGeometry(
+      const Texture* texture,
+      std::span<const Vertex> vertices,
+      std::span<const int> indices = {}
+    ) const;
+
     //! @brief Clear the renderer with the drawing color.
     void clear() const;
 
+    //! @brief Fill a rectangle with the drawing color; unlike clear() this respects the clip rectangle.
+    void fillRectangle(const Rectangle& rectangle) const;
+
+    //! @brief Restrict drawing to the provided rectangle of the current target.
+    void setClipRectangle(const Rectangle& rectangle) const;
+    //! @brief Allow drawing anywhere on the current target.
+    void resetClipRectangle() const;
+
+    class TargetScope;
+
+    /**
+     * @brief Draw into the provided texture, which must have been created with Texture::kTarget, instead of the window.
+     *
+     * The previous target is restored when the returned scope ends.
+     */
+    [[nodiscard]] TargetScope setTarget(const Texture& texture) const;
+    //! @brief Draw into the window until the returned scope ends.
+    [[nodiscard]] TargetScope resetTarget() const;
+
+    //! @brief true if this renderer can draw into textures.
+    bool isTargetSupported() const;
+
+    /**
+     * @brief Copy the top left of the current target into destination, converted to the provided Texture::PixelFormat.
+     *
+     * As much as destination's width and height covers is read, row by row at
+     * its pitch, so the same buffer can be read into frame after frame. The
+     * format must be a 32 bit one, and the view's bytes must hold every row,
+     * or std::invalid_argument is thrown. This
+     * stalls until drawing so far has finished, which is slow on accelerated
+     * renderers.
+     */
+    void readPixels(vodden::PixelView destination, uint8_t pixelFormat) const;
+    //! @brief Copy the top left of the current target into surface, in the surface's own format.
+    void readPixels(Surface& surface) const;
+
+    //! @brief When a present returned, for aligning simulation to the display.
+    struct PresentTiming {
+      //! @brief the number of presents before this one
+      uint64_t frame;
+      //! @brief when the present returned, on the timeline of getPerformanceTime()
+      std::chrono::nanoseconds presentTime;
+      //! @brief the time since the previous present returned, zero for the first; the refresh interval under vsync
+      std::chrono::nanoseconds interval;
+    };
+    typedef std::function<void(const PresentTiming&)> PresentCallback;
+
+    /**
+     * @brief Change whether present() waits for the display's vertical blank.
+     *
+     * Returns the mode now in effect: kVSyncAdaptive, which skips the wait
+     * for frames that miss a blank rather than halving the frame rate, falls
+     * back to kVSyncOn where it isn't offered. SDL 2.28's SDL_RenderSetVSync
+     * rejects everything but off and on, so with it kVSyncAdaptive always
+     * falls back; it is still asked for, for an SDL which accepts it. Throws
+     * sdl::Exception if the driver can't change vsync at all.
+     */
+    VSyncMode setVSync(VSyncMode vSyncMode);
+    VSyncMode getVSync() const;
+
+    /**
+     * @brief Limit how many presented frames the GPU may still be working on, or kUnlimitedFramesInFlight.
+     *
+     * Every queued frame is a frame of input latency. SDL has no fences, so
+     * the limit is kept by waiting for the GPU, through a one pixel read back,
+     * once in every maxFramesInFlight presents; 1 waits on every frame, which
+     * gives the least latency at the cost of CPU and GPU overlap.
+     */
+    void setMaxFramesInFlight(uint32_t maxFramesInFlight);
+    uint32_t getMaxFramesInFlight() const;
+    //! @brief the number of presents which waited for the GPU to keep within the frames in flight limit
+    uint64_t getSyncCount() const;
+
+    //! @brief Called on the rendering thread after every present(); an empty callback removes it.
+    void setPresentCallback(PresentCallback presentCallback);
+
     //! @brief Update the screen with any rendering performed since the previous call.
     void present() const;
 
@@ -64,10 +259,42 @@ class Renderer {
     static constexpr RendererFlag kPresentVSync = 2;
     static constexpr RendererFlag kTargetTexture = 3;
 
+    static constexpr VSyncMode kVSyncOff = 0;
+    static constexpr VSyncMode kVSyncOn = 1;
+    static constexpr VSyncMode kVSyncAdaptive = 2;
+
+    //! @brief the driver's own queueing, which is the default
+    static constexpr uint32_t kUnlimitedFramesInFlight = 0;
+
   private:
+    detail::Handle<SDL_Renderer, detail::RendererDeleter> _sdlRenderer;
+    // render target and profiling state, which draws rarely touch
     std::unique_ptr<RendererImpl> _rendererImpl;
 };
 
+/**
+ * @brief Redirects a renderer's drawing for as long as it is alive.
+ *
+ * Scopes nest: each restores whatever target was current when it began.
+ */
+class Renderer::TargetScope {
+  friend Renderer;
+  public:
+    TargetScope(const Renderer& renderer, const Texture& texture);
+    TargetScope(const TargetScope&) = delete;
+    TargetScope(TargetScope&&) = delete;
+    ~TargetScope() noexcept;
+
+    TargetScope& operator=(const TargetScope&) = delete;
+    TargetScope& operator=(TargetScope&&) = delete;
+
+  private:
+    //! @brief target the window when texture is nullptr
+    TargetScope(const Renderer& renderer, const Texture* texture);
+
+    const Renderer& _renderer;
+};
+
 }
 
 #endif
@@ -3,6 +3,9 @@
 
 #include <chrono>
 #include <memory>
+#include <string_view>
+
+#include <flags.h>
 
 namespace sdl {
 
@@ -26,6 +29,25 @@ class SDL {
 
     //! @brief Initialize the SubSystems of the SDL library.
     void initSubSystem(const SubSystem& subSystem );
+    //! @brief Initialize several SubSystems with a single call into SDL.
+    void initSubSystem(const vodden::Flags<SubSystem>& subSystems );
+
+    /**
+     * @brief Choose the video driver kVideo is initialized with, such as kDummyVideoDriver.
+     *
+     * This only takes effect if called before the video SubSystem is
+     * initialized, whether by initSubSystem or by creating the first Window.
+     * Returns false, changing nothing, if the SDL_VIDEODRIVER environment
+     * variable already chooses a driver, so a user's choice wins.
+     */
+    static bool setVideoDriver(std::string_view driver);
+    //! @brief The name of the video driver in use, or an empty view if video is not initialized.
+    static std::string_view getVideoDriver();
+
+    //! @brief creates windows which are never shown, needing no display at all
+    static constexpr std::string_view kDummyVideoDriver = "dummy";
+    //! @brief renders windows offscreen through EGL, for accelerated rendering without a display
+    static constexpr std::string_view kOffscreenVideoDriver = "offscreen";
 
   private:
     std::unique_ptr<SDLImpl> _sdlImpl;
@@ -33,7 +55,7 @@ class SDL {
 
 void delay_ms(uint32_t duration);
 
-//! @brief Wait a specified duration before returning
+//! @brief Wait a specified duration before returning, to millisecond granularity. For pacing frames see FrameClock.
 template<class T>
 void delay(std::chrono::duration<T> duration) {
   delay_ms((std::chrono::duration_cast<std::chrono::milliseconds>(duration)).count());
@@ -0,0 +1,52 @@
+#ifndef __SDL_STREAMING_TEXTURE_H__
+#define __SDL_STREAMING_TEXTURE_H__
+
+#include <cstddef>
+#include <span>
+
+#include "rectangle.h"
+#include "surface.h"
+#include "texture.h"
+
+namespace sdl {
+
+/**
+ * @brief A texture whose pixels are rewritten from the cpu, e.g. every frame.
+ *
+ * Either lock() a region, write its pixels and unlock() it, or update() a
+ * region from a surface. Only the regions touched are sent to the GPU.
+ */
+class StreamingTexture : public Texture {
+  public:
+    //! @brief pixels of a locked region; row y starts at pixels[y * pitch]
+    struct LockedPixels {
+      std::span<std::byte> pixels;
+      std::size_t pitch;
+    };
+
+    StreamingTexture(const Renderer& renderer, uint32_t width, uint32_t height, PixelFormat pixelFormat = kPreferred);
+
+    /**
+     * @brief lock the whole texture for writing.
+     *
+     * The pixels are write-only: their contents are undefined until written.
+     */
+    LockedPixels lock();
+    //! @brief lock a region of the texture for writing; std::invalid_argument if it isn't inside the texture
+    LockedPixels lock(const Rectangle& region);
+    //! @brief upload the pixels written since lock()
+    void unlock();
+
+    /**
+     * @brief upload the top left destination-sized part of surface to destination.
+     *
+     * The surface is converted if it isn't in the texture's pixel format.
+     * std::invalid_argument is thrown if destination isn't inside the
+     * texture or the surface is smaller than it.
+     */
+    void update(const Surface& surface, const Rectangle& destination);
+};
+
+}
+
+#endif
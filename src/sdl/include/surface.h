@@ -2,18 +2,38 @@
 #define __SDL_SURFACE_H__
 
 #include <cinttypes>
+#include <cstddef>
 #include <filesystem>
-#include <memory>
+
+#include <pixel_kernels.h>
+
+#include "color.h"
+#include "handle.h"
+#include "rectangle.h"
 
 namespace sdl {
 
-class SurfaceImpl;
+class Font;
+class Renderer;
+class StreamingTexture;
+class Texture;
 
 //! A class which holds a collection of pixels to be used in software blitting.
 class Surface {
+  friend Font;
+  friend Renderer;
+  friend StreamingTexture;
+  friend Texture;
   public:
+    //! @brief one of Texture's pixel formats, which texture.h can't provide here without an include cycle
+    typedef uint8_t PixelFormat;
+
     Surface(uint32_t width, uint32_t height, uint8_t depth, uint32_t redMask, uint32_t greenMask, uint32_t blueMask, uint32_t alphaMask );
+    //! @brief creates a blank, fully transparent, 32 bit RGBA surface.
+    Surface(uint32_t width, uint32_t height);
     Surface(std::filesystem::path filePath);
+    //! @brief decodes an image already held in cpu memory.
+    Surface(const void* location, std::size_t size);
     Surface(Surface&) = delete;
     Surface(Surface&& other) noexcept;
     ~Surface();
@@ -21,9 +41,63 @@ class Surface {
     Surface& operator=(Surface&) = delete;
     Surface& operator=(Surface&& other) noexcept;
 
+    uint32_t getWidth() const;
+    uint32_t getHeight() const;
+    PixelFormat getPixelFormat() const;
+
+    /**
+     * @brief the surface's pixels, for CPU side composition.
+     *
+     * Throws std::logic_error unless the surface has 4 bytes per pixel and
+     * needs no locking, as is the case for every surface made here. The view
+     * is valid while the surface lives.
+     */
+    vodden::PixelView getPixels();
+    vodden::ConstPixelView getPixels() const;
+
+    /**
+     * @brief copy the whole of source onto this surface with its top left corner at x, y.
+     *
+     * Pixels are copied as they are, alpha included, rather than blended.
+     */
+    void blit(const Surface& source, uint32_t x, uint32_t y);
+
+    /**
+     * @brief draw source over this surface with its top left corner at x, y, treating its colours as premultiplied by alpha.
+     *
+     * Both surfaces need their alpha in the top byte, as in
+     * Texture::kARGB8888 and kABGR8888, or std::invalid_argument is thrown. A
+     * source in the other of the two is converted first. Whatever falls
+     * outside this surface is clipped.
+     */
+    void blend(const Surface& source, uint32_t x, uint32_t y);
+
+    /**
+     * @brief copy source onto this surface with its top left corner at x, y, leaving out pixels of colour key.
+     *
+     * Alpha is ignored when matching key. This surface must be
+     * Texture::kARGB8888, kABGR8888 or kRGB888, or std::invalid_argument is
+     * thrown, and a source in another format is converted first.
+     */
+    void blitColorKeyed(const Surface& source, uint32_t x, uint32_t y, const Color& key);
+
+    void fill(const Color& color);
+    void fill(const Rectangle& area, const Color& color);
+
+    //! @brief scale every pixel's colour by its alpha, as blend expects of its source
+    void premultiplyAlpha();
+
+    //! @brief a copy in pixelFormat; Texture::kARGB8888 to kABGR8888 and back is a single swizzle pass
+    Surface convert(PixelFormat pixelFormat) const;
+
+    //! @brief encode the surface as a PNG file at filePath, replacing any file already there.
+    void savePNG(const std::filesystem::path& filePath) const;
 
   private:
-    std::unique_ptr<SurfaceImpl> _surfaceImpl;
+    //! @brief take ownership of sdlSurface, throwing sdl::Exception(function) if it is null
+    Surface(SDL_Surface* sdlSurface, const char* function);
+
+    detail::Handle<SDL_Surface, detail::SurfaceDeleter> _sdlSurface;
 };
 
 }
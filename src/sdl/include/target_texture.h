@@ -0,0 +1,23 @@
+#ifndef __SDL_TARGET_TEXTURE_H__
+#define __SDL_TARGET_TEXTURE_H__
+
+#include "renderer.h"
+#include "texture.h"
+
+namespace sdl {
+
+/**
+ * @brief A texture which can be drawn into, see Renderer::setTarget.
+ *
+ * Useful for caching static layers: render them once and then draw the whole
+ * layer each frame with a single copy.
+ */
+class TargetTexture : public Texture {
+  public:
+    TargetTexture(const Renderer& renderer, uint32_t width, uint32_t height, PixelFormat pixelFormat = kPreferred) :
+      Texture(renderer, pixelFormat, kTarget, width, height) {};
+};
+
+}
+
+#endif
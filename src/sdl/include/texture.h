@@ -3,19 +3,25 @@
 
 #include <filesystem>
 
+#include "handle.h"
 #include "renderer.h"
 
 namespace sdl {
 
+class BakedImage;
 class Renderer;
-class TextureImpl;
+class StreamingTexture;
+class Surface;
 
 //! @brief Image stored in the graphics card memory that can be used for fast drawing
 class Texture {
   friend Renderer;
+  friend StreamingTexture;
   public:
     typedef uint8_t BlendMode;
-    
+    typedef uint8_t PixelFormat;
+    typedef uint8_t Access;
+
     //! @brief creates a texture from a file on disk.
     Texture(const Renderer& renderer, std::filesystem::path filePath);
 
@@ -23,6 +29,24 @@ class Texture {
     Texture(const Renderer& renderer, const void* location, std::size_t size);
     Texture(const Renderer& renderer, void* location, std::size_t size);
 
+    //! @brief uploads the pixels of a surface.
+    Texture(const Renderer& renderer, const Surface& surface);
+
+    /**
+     * @brief uploads the pixels of a surface, to be drawn with blendMode.
+     *
+     * For kPremultiplied the surface's colours are first multiplied by its
+     * alpha, converting it to kABGR8888 if its alpha isn't in the top byte,
+     * so the work is done once at load rather than by every draw.
+     */
+    Texture(const Renderer& renderer, Surface&& surface, BlendMode blendMode);
+
+    //! @brief creates a blank texture with the provided pixel format, or kPreferred for the renderer's, and access pattern.
+    Texture(const Renderer& renderer, PixelFormat pixelFormat, Access access, uint32_t width, uint32_t height);
+
+    //! @brief uploads pre-decoded pixels produced by the data target's bake tool, without decoding.
+    Texture(const Renderer& renderer, const BakedImage& bakedImage);
+
     Texture(Texture& other) = delete;
     Texture(Texture&& other) noexcept;
     ~Texture();
@@ -30,18 +54,40 @@ class Texture {
     Texture& operator=(Texture& other) = delete;
     Texture& operator=(Texture&& other) noexcept;
 
+    uint32_t getWidth() const;
+    uint32_t getHeight() const;
+
     void setTextureBlendMode(const BlendMode& blendMode);
-    BlendMode getTextureBlendMode();
+    //! @brief the texture's blend mode; throws std::out_of_range if it was set to a custom mode outside this library
+    BlendMode getTextureBlendMode() const;
     
     static constexpr BlendMode kNone = 0;
     static constexpr BlendMode kBlend = 1;
     static constexpr BlendMode kAdd = 2;
     static constexpr BlendMode kMod = 3;
     static constexpr BlendMode kMul = 4;
+    //! @brief like kBlend, for colours already multiplied by their alpha, see Surface::premultiplyAlpha
+    static constexpr BlendMode kPremultiplied = 5;
+
+    static constexpr PixelFormat kARGB8888 = 0;
+    static constexpr PixelFormat kRGBA8888 = 1;
+    static constexpr PixelFormat kABGR8888 = 2;
+    static constexpr PixelFormat kBGRA8888 = 3;
+    static constexpr PixelFormat kRGB888 = 4;
+    static constexpr PixelFormat kRGB24 = 5;
+    //! @brief whichever format the renderer draws without converting, see Renderer::getPreferredPixelFormat
+    static constexpr PixelFormat kPreferred = 0xff;
+
+    //! @brief rarely changed, uploaded whole
+    static constexpr Access kStatic = 0;
+    //! @brief changed frequently, see StreamingTexture
+    static constexpr Access kStreaming = 1;
+    //! @brief can be used as a render target
+    static constexpr Access kTarget = 2;
 
 
   private:
-    std::unique_ptr<TextureImpl> _textureImpl;
+    detail::Handle<SDL_Texture, detail::TextureDeleter> _sdlTexture;
 };
 
 
@@ -1,26 +1,104 @@
 #ifndef __SDL_USER_EVENT_H__
 #define __SDL_USER_EVENT_H__
 
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
 #include "event.h"
 
 namespace sdl {
 
-class UserEventImpl;
+namespace detail {
+  //! @brief hands out the index of the next UserEvent payload type, throwing std::length_error when there are none left
+  std::size_t nextUserEventTypeIndex();
+  //! @brief the SDL event type at index within the block reserved for user events
+  uint32_t userEventType(std::size_t index);
+
+  //! @brief the index of Payload within the user event block, fixed once first used
+  template <class Payload>
+  std::size_t userEventTypeIndex() {
+    static const std::size_t index = nextUserEventTypeIndex();
+    return index;
+  }
+}
 
-class UserEvent: public Event {
+/**
+ * @brief an event posted by the application through the SDL event queue
+ *
+ * Post events from any thread with push. The SDL_Event pushed only carries
+ * the index of the slot holding the event, and EventProducer takes the
+ * event back out of that slot. Events of up to kPooledEventSize bytes are
+ * built in a pool shared by every thread, so pushing from one thread and
+ * destroying on another allocates nothing; larger ones come from the heap.
+ *
+ * Prefer UserEvent<Payload>, which gives each payload its own SDL event type.
+ */
+class BaseUserEvent: public Event {
   public:
-    UserEvent();
-    UserEvent(const UserEvent &userEvent);
-    UserEvent(UserEvent &&userEvent);
-    UserEvent& operator=(const UserEvent &userEvent);
-    UserEvent& operator=(UserEvent &&userEvent);
-    virtual ~UserEvent();
-    // virtual void handle(BaseEventHandler &baseEventHandler) override {
-    //   castHandler(*this, baseEventHandler);
-    // };
-
-  private:
-    std::unique_ptr<UserEventImpl> _userEventImpl;
+    //! @brief the number of user events which may be waiting in the SDL queue at once
+    static constexpr std::size_t kSlotCount = 4096;
+    //! @brief the number of SDL event types reserved, the first of which is shared by direct subclasses
+    static constexpr std::size_t kTypeCount = 64;
+    //! @brief the largest event, payload included, which is built in the shared event pool
+    static constexpr std::size_t kPooledEventSize = 128;
+
+    BaseUserEvent();
+    virtual ~BaseUserEvent() {};
+
+    //! @brief from the shared event pool while it has room, else as BaseEvent allocates
+    static void* operator new(std::size_t size);
+    static void operator delete(void* pointer, std::size_t size) noexcept;
+    virtual void handle(BaseEventHandler &baseEventHandler) override {
+      castHandler(*this, baseEventHandler);
+    };
+
+    virtual EventTypeId typeId() const override { return eventTypeId<BaseUserEvent>(); };
+
+    //! @brief the SDL event type this event is pushed as
+    virtual uint32_t getSDLEventType() const { return detail::userEventType(0); };
+
+    /**
+     * @brief post an event to the SDL event queue. Safe to call from any thread.
+     *
+     * @return false, dropping the event, if every slot is taken or SDL refused
+     * it (SDL_GetError says why).
+     */
+    static bool push(std::unique_ptr<BaseUserEvent> userEvent);
+
+    /**
+     * @brief drop every user event waiting in the SDL queue, freeing their slots.
+     *
+     * Call it on the thread which runs the EventProducer. Slots of events
+     * SDL drops by itself are freed once a push finds them all taken.
+     */
+    static void flush();
+};
+
+/**
+ * @brief a user event carrying a Payload, with an SDL event type of its own
+ *
+ * Handle these with an EventHandler<UserEvent<Payload>>.
+ */
+template <class Payload>
+class UserEvent: public BaseUserEvent {
+  public:
+    template <class... Args> requires std::constructible_from<Payload, Args...>
+    explicit UserEvent(Args&&... args) : payload { std::forward<Args>(args)... } {};
+
+    virtual void handle(BaseEventHandler &baseEventHandler) override {
+      castHandler(*this, baseEventHandler);
+    };
+
+    virtual EventTypeId typeId() const override { return eventTypeId<UserEvent<Payload>>(); };
+
+    virtual uint32_t getSDLEventType() const override { return sdlEventType(); };
+
+    //! @brief the SDL event type of every UserEvent<Payload>
+    static uint32_t sdlEventType() { return detail::userEventType(detail::userEventTypeIndex<Payload>()); };
+
+    Payload payload;
 };
 
 }
@@ -0,0 +1,32 @@
+#ifndef __SDL_VERTEX_H__
+#define __SDL_VERTEX_H__
+
+#include <cstdint>
+
+#include "color.h"
+
+namespace sdl {
+
+/**
+ * @brief A corner of a triangle passed to Renderer::renderGeometry.
+ *
+ * Vertex is laid out as SDL_Vertex (this is checked in vertex_impl.h) so
+ * batches of them are handed to SDL without conversion.
+ */
+struct Vertex {
+  constexpr Vertex() = default;
+  constexpr Vertex(float x, float y, const Color& color, float u = 0.0f, float v = 0.0f) :
+    x { x }, y { y }, color { color }, u { u }, v { v } {};
+
+  float x { 0.0f };
+  float y { 0.0f };
+  //! @brief laid out as SDL_Color, so setting it is a single four byte copy
+  Color color { 255, 255, 255, 255 };
+  //! @brief texture co-ordinates, normalised to 0..1
+  float u { 0.0f };
+  float v { 0.0f };
+};
+
+}
+
+#endif
@@ -2,12 +2,14 @@
 #define __SDL_WINDOW_H__
 
 #include <string>
-#include <memory>
+
+#include <flags.h>
+
+#include "handle.h"
 
 namespace sdl {
 
 class Renderer;
-class WindowImpl;
 
 /**!
  * @brief A window with
@@ -15,7 +17,11 @@ class WindowImpl;
 class Window {
   friend Renderer;
   public:
-    Window(std::string title, uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint32_t flags);
+    typedef uint8_t WindowFlag;
+    //! @brief identifies the window in the events which happen in it
+    typedef uint32_t WindowId;
+
+    Window(std::string title, uint16_t x, uint16_t y, uint16_t width, uint16_t height, vodden::Flags<WindowFlag> flags);
     Window(Window&& other) noexcept;
     Window(const Window& other) = delete;
     ~Window();
@@ -29,9 +35,25 @@ class Window {
     //! @brief Set the title of the window.
     void setTitle(std::string newTitle);
 
+    //! @brief Get the id which events in this window carry as their windowId.
+    WindowId getId() const;
+
+    static constexpr WindowFlag kFullscreen = 0;
+    //! @brief fullscreen at the desktop's resolution
+    static constexpr WindowFlag kFullscreenDesktop = 1;
+    static constexpr WindowFlag kOpenGL = 2;
+    static constexpr WindowFlag kVulkan = 3;
+    static constexpr WindowFlag kMetal = 4;
+    static constexpr WindowFlag kHidden = 5;
+    static constexpr WindowFlag kBorderless = 6;
+    static constexpr WindowFlag kResizable = 7;
+    static constexpr WindowFlag kMinimized = 8;
+    static constexpr WindowFlag kMaximized = 9;
+    static constexpr WindowFlag kAllowHighDPI = 10;
+
   private:
     std::string _title;
-    std::unique_ptr<WindowImpl> _windowImpl;
+    detail::Handle<SDL_Window, detail::WindowDeleter> _sdlWindow;
 };
 
 }
@@ -0,0 +1,42 @@
+#ifndef __SDL_COLOR_IMPL_H__
+#define __SDL_COLOR_IMPL_H__
+
+#include <SDL2/SDL.h>
+
+#include <cstddef>
+#include <type_traits>
+
+#include "color.h"
+#include "texture.h"
+
+namespace sdl {
+
+//! @brief gives the library access to a Color as the SDL_Color it is laid out as.
+class ColorImpl {
+  public:
+    static const SDL_Color* getSDLColor(const Color& color) {
+      return reinterpret_cast<const SDL_Color*>(&color);
+    };
+
+    static_assert(std::is_trivially_copyable_v<Color>);
+    static_assert(std::is_standard_layout_v<Color>);
+    static_assert(sizeof(Color) == sizeof(SDL_Color));
+    static_assert(alignof(Color) == alignof(SDL_Color));
+    static_assert(offsetof(Color, _red) == offsetof(SDL_Color, r));
+    static_assert(offsetof(Color, _green) == offsetof(SDL_Color, g));
+    static_assert(offsetof(Color, _blue) == offsetof(SDL_Color, b));
+    static_assert(offsetof(Color, _alpha) == offsetof(SDL_Color, a));
+
+    // Color::toPixel switches on Texture's pixel formats by value
+    static constexpr Color kProbe { 0x11, 0x22, 0x33, 0x44 };
+    static_assert(kProbe.toPixel(Texture::kARGB8888) == 0x44112233);
+    static_assert(kProbe.toPixel(Texture::kRGBA8888) == 0x11223344);
+    static_assert(kProbe.toPixel(Texture::kABGR8888) == 0x44332211);
+    static_assert(kProbe.toPixel(Texture::kBGRA8888) == 0x33221144);
+    static_assert(kProbe.toPixel(Texture::kRGB888) == 0x00112233);
+    static_assert(Color::fromPixel(kProbe.toPixel(Texture::kBGRA8888), Texture::kBGRA8888) == kProbe);
+};
+
+}
+
+#endif
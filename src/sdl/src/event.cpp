@@ -1,43 +1,234 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <SDL2/SDL.h>
 
 #include <constexpr_map.h>
+#include <free_list_pool.h>
+#include <memory_tracker.h>
+#include <profiler.h>
 
 #include "event.h"
 #include "event_impl.h"
+#include "exception.h"
+#include "frame_clock.h"
+#include "user_event_impl.h"
 
 namespace sdl {
 
+namespace detail {
+
+struct EventTypeRegistry {
+  std::mutex mutex;
+  std::vector<EventTypeInfo> eventTypes;
+};
+
+// function local so that ids may be handed out during static initialisation
+static EventTypeRegistry& eventTypeRegistry() {
+  static EventTypeRegistry registry;
+  return registry;
+}
+
+EventTypeId registerEventType(EventTypeInfo eventTypeInfo) {
+  auto& registry = eventTypeRegistry();
+  std::scoped_lock lock { registry.mutex };
+  registry.eventTypes.push_back(eventTypeInfo);
+  return registry.eventTypes.size() - 1;
+}
+
+EventTypeInfo getEventTypeInfo(EventTypeId eventTypeId) {
+  auto& registry = eventTypeRegistry();
+  std::scoped_lock lock { registry.mutex };
+  return registry.eventTypes.at(eventTypeId);
+}
+
+}
+
+void* BaseEvent::operator new(std::size_t size) {
+  void* pointer = vodden::FreeListPool::allocate(size);
+  vodden::memory::MemoryTracker::instance().record(vodden::memory::Category::kEvents, size);
+  return pointer;
+}
+
+void BaseEvent::operator delete(void* pointer, std::size_t size) noexcept {
+  vodden::FreeListPool::deallocate(pointer, size);
+  vodden::memory::MemoryTracker::instance().release(vodden::memory::Category::kEvents, size);
+}
+
 std::unique_ptr<BaseEvent> EventProducer::wait() {
+  VODDEN_PROFILE_ZONE("EventProducer::wait");
+  UserEventImpl::reclaimIfRequested();
   SDL_Event event;
   SDL_WaitEvent(&event);
-  switch (event.type) {
+  return createEvent(&event);
+}
+
+std::unique_ptr<BaseEvent> EventProducer::poll() {
+  UserEventImpl::reclaimIfRequested();
+  SDL_Event event;
+  if(SDL_PollEvent(&event) == 0) return nullptr;
+  return createEvent(&event);
+}
+
+std::size_t EventProducer::drain(std::span<std::unique_ptr<BaseEvent>> events) {
+  std::array<SDL_Event, kDrainBatchSize> sdlEvents;
+  std::size_t count = 0;
+  // the motion event at the back of the buffer, which a following motion may merge into
+  MouseMotionEvent* lastMotion = nullptr;
+
+  UserEventImpl::reclaimIfRequested();
+  SDL_PumpEvents();
+  while(count < events.size()) {
+    const int requested = static_cast<int>(std::min(sdlEvents.size(), events.size() - count));
+    const int peeked = SDL_PeepEvents(sdlEvents.data(), requested, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+    if(peeked < 0) throw Exception("SDL_PeepEvents");
+
+    for(int i = 0; i < peeked; ++i) {
+      const SDL_Event& sdlEvent = sdlEvents[i];
+      const bool isMotion = sdlEvent.type == SDL_EventType::SDL_MOUSEMOTION;
+      if(isMotion && lastMotion != nullptr
+          && lastMotion->windowId == sdlEvent.motion.windowID && lastMotion->which == sdlEvent.motion.which) {
+        coalesceMouseMotionEvent(*lastMotion, &sdlEvent.motion);
+        continue;
+      }
+
+      auto baseEvent = createEvent(&sdlEvent);
+      lastMotion = isMotion && _motionPolicy == MotionPolicy::kCoalesce
+        ? static_cast<MouseMotionEvent*>(baseEvent.get())
+        : nullptr;
+      events[count++] = std::move(baseEvent);
+    }
+    if(peeked < requested) break;
+  }
+  return count;
+}
+
+std::chrono::milliseconds widenTimestamp(uint32_t sdlTimestamp) {
+  // SDL's timestamps wrap every 49 days, so they are taken as the most recent time with those low 32 bits
+  const uint64_t now = SDL_GetTicks64();
+  return std::chrono::milliseconds { now - static_cast<uint32_t>(static_cast<uint32_t>(now) - sdlTimestamp) };
+}
+
+//! @brief set the inputTime of a newly converted input event, passing it on
+template <class EventClass>
+static std::unique_ptr<EventClass> stampInputTime(std::unique_ptr<EventClass> event, uint32_t sdlTimestamp) {
+  if(!event) return event;
+  // the millisecond time the event waited in the queue, placed on the finer timeline of the performance counter
+  const std::chrono::milliseconds queued { static_cast<uint32_t>(static_cast<uint32_t>(SDL_GetTicks64()) - sdlTimestamp) };
+  event->inputTime = getPerformanceTime() - queued;
+  return event;
+}
+
+std::unique_ptr<BaseEvent> createEvent(const SDL_Event* sdlEvent) {
+  std::unique_ptr<BaseEvent> event;
+  switch (sdlEvent->type) {
     case SDL_EventType::SDL_MOUSEBUTTONDOWN:
     case SDL_EventType::SDL_MOUSEBUTTONUP:
-      return createMouseButtonEvent((SDL_MouseButtonEvent*)(&event));
+      event = stampInputTime(createMouseButtonEvent(&sdlEvent->button), sdlEvent->common.timestamp);
+      break;
+    case SDL_EventType::SDL_MOUSEMOTION:
+      event = stampInputTime(createMouseMotionEvent(&sdlEvent->motion), sdlEvent->common.timestamp);
+      break;
+    case SDL_EventType::SDL_MOUSEWHEEL:
+      event = stampInputTime(createMouseWheelEvent(&sdlEvent->wheel), sdlEvent->common.timestamp);
+      break;
+    case SDL_EventType::SDL_KEYDOWN:
+    case SDL_EventType::SDL_KEYUP:
+      event = stampInputTime(createKeyboardEvent(&sdlEvent->key), sdlEvent->common.timestamp);
+      break;
     case SDL_EventType::SDL_QUIT:
-      return createQuitEvent((SDL_QuitEvent*)(&event));
+      event = createQuitEvent(&sdlEvent->quit);
+      break;
     default:
-      throw UnknownEventException("I don't know what this event is!");
+      // user event types are registered at runtime, so can't be case labels
+      if(UserEventImpl::isEventType(sdlEvent->type)) event = UserEventImpl::claim(&sdlEvent->user);
+      break;
   }
+  if(!event) event = createRawEvent(sdlEvent);
+  return event;
 }
 
-std::unique_ptr<QuitEvent> createQuitEvent([[maybe_unused]] const SDL_QuitEvent* sdlQuitEvent) {
-  return std::make_unique<QuitEvent>( std::chrono::milliseconds( SDL_GetTicks64() ) );
+static_assert(sizeof(SDL_Event) == RawEvent::kSize, "RawEvent must hold a whole SDL_Event");
+
+std::unique_ptr<RawEvent> createRawEvent(const SDL_Event* sdlEvent) {
+  std::array<std::byte, RawEvent::kSize> data;
+  std::memcpy(data.data(), sdlEvent, RawEvent::kSize);
+  return std::make_unique<RawEvent>( widenTimestamp(sdlEvent->common.timestamp), sdlEvent->type, data );
+}
+
+std::unique_ptr<QuitEvent> createQuitEvent(const SDL_QuitEvent* sdlQuitEvent) {
+  return std::make_unique<QuitEvent>( widenTimestamp(sdlQuitEvent->timestamp) );
 }
 
 std::unique_ptr<MouseButtonEvent> createMouseButtonEvent(const SDL_MouseButtonEvent* sdlMouseButtonEvent) {
+  // buttons beyond the five SDL names are passed on as a RawEvent like any other unknown event
+  const auto button = sdlMouseButtonEventButtonMap.find(sdlMouseButtonEvent->button);
+  const auto state = sdlMouseButtonEventStateMap.find(sdlMouseButtonEvent->state);
+  if(!button || !state) return nullptr;
+
   return std::make_unique<MouseButtonEvent>(
-    std::chrono::milliseconds( SDL_GetTicks64() ),
+    widenTimestamp(sdlMouseButtonEvent->timestamp),
     sdlMouseButtonEvent->windowID,
     sdlMouseButtonEvent->which,
     sdlMouseButtonEvent->x,
     sdlMouseButtonEvent->y,
-    sdlMouseButtonEventButtonMap[sdlMouseButtonEvent->button],
-    sdlMouseButtonEventStateMap[sdlMouseButtonEvent->state],
+    *button,
+    *state,
     sdlMouseButtonEvent->clicks
   );
 }
 
+std::unique_ptr<MouseMotionEvent> createMouseMotionEvent(const SDL_MouseMotionEvent* sdlMouseMotionEvent) {
+  return std::make_unique<MouseMotionEvent>(
+    widenTimestamp(sdlMouseMotionEvent->timestamp),
+    sdlMouseMotionEvent->windowID,
+    sdlMouseMotionEvent->which,
+    sdlMouseMotionEvent->x,
+    sdlMouseMotionEvent->y,
+    sdlMouseMotionEvent->xrel,
+    sdlMouseMotionEvent->yrel,
+    sdlMouseMotionEvent->state
+  );
+}
+
+void coalesceMouseMotionEvent(MouseMotionEvent& mouseMotionEvent, const SDL_MouseMotionEvent* sdlMouseMotionEvent) {
+  // inputTime stays that of the first motion, so latency is measured from the oldest input folded in
+  mouseMotionEvent.timestamp = widenTimestamp(sdlMouseMotionEvent->timestamp);
+  mouseMotionEvent.x = sdlMouseMotionEvent->x;
+  mouseMotionEvent.y = sdlMouseMotionEvent->y;
+  mouseMotionEvent.relativeX += sdlMouseMotionEvent->xrel;
+  mouseMotionEvent.relativeY += sdlMouseMotionEvent->yrel;
+  mouseMotionEvent.buttons = sdlMouseMotionEvent->state;
+}
+
+std::unique_ptr<MouseWheelEvent> createMouseWheelEvent(const SDL_MouseWheelEvent* sdlMouseWheelEvent) {
+  return std::make_unique<MouseWheelEvent>(
+    widenTimestamp(sdlMouseWheelEvent->timestamp),
+    sdlMouseWheelEvent->windowID,
+    sdlMouseWheelEvent->which,
+    sdlMouseWheelEvent->x,
+    sdlMouseWheelEvent->y,
+    sdlMouseWheelEvent->direction == SDL_MOUSEWHEEL_FLIPPED
+  );
+}
+
+std::unique_ptr<KeyboardEvent> createKeyboardEvent(const SDL_KeyboardEvent* sdlKeyboardEvent) {
+  const auto state = sdlKeyboardEventStateMap.find(sdlKeyboardEvent->state);
+  if(!state) return nullptr;
+
+  return std::make_unique<KeyboardEvent>(
+    widenTimestamp(sdlKeyboardEvent->timestamp),
+    sdlKeyboardEvent->windowID,
+    sdlKeyboardEvent->keysym.sym,
+    sdlKeyboardEvent->keysym.scancode,
+    sdlKeyboardEvent->keysym.mod,
+    *state,
+    sdlKeyboardEvent->repeat != 0
+  );
+}
+
 }
@@ -22,7 +22,27 @@ static constexpr vodden::Map<uint32_t, MouseButtonEvent::State, 2> sdlMouseButto
   { SDL_RELEASED, MouseButtonEvent::State::kReleased },
 }};
 
+static constexpr vodden::Map<uint32_t, KeyboardEvent::State, 2> sdlKeyboardEventStateMap {{
+  { SDL_PRESSED, KeyboardEvent::State::kPressed },
+  { SDL_RELEASED, KeyboardEvent::State::kReleased },
+}};
+
+//! @brief the number of SDL events EventProducer::drain takes from the queue at a time
+static constexpr std::size_t kDrainBatchSize = 64;
+
+//! @brief widen an SDL event timestamp, which is milliseconds since initialization in 32 bits
+std::chrono::milliseconds widenTimestamp(uint32_t sdlTimestamp);
+
+//! @brief converts an SDL event, returning a RawEvent for event types we don't recognise
+std::unique_ptr<BaseEvent> createEvent(const SDL_Event* sdlEvent);
+std::unique_ptr<RawEvent> createRawEvent(const SDL_Event* sdlEvent);
 std::unique_ptr<QuitEvent> createQuitEvent(const SDL_QuitEvent* sdlQuitEvent);
 std::unique_ptr<MouseButtonEvent> createMouseButtonEvent(const SDL_MouseButtonEvent* sdlMouseButtonEvent);
+std::unique_ptr<MouseMotionEvent> createMouseMotionEvent(const SDL_MouseMotionEvent* sdlMouseMotionEvent);
+std::unique_ptr<MouseWheelEvent> createMouseWheelEvent(const SDL_MouseWheelEvent* sdlMouseWheelEvent);
+std::unique_ptr<KeyboardEvent> createKeyboardEvent(const SDL_KeyboardEvent* sdlKeyboardEvent);
+
+//! @brief fold a later motion from the same mouse into mouseMotionEvent
+void coalesceMouseMotionEvent(MouseMotionEvent& mouseMotionEvent, const SDL_MouseMotionEvent* sdlMouseMotionEvent);
 
 }
@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+
+#include "event_recording.h"
+
+namespace sdl {
+
+namespace {
+  constexpr std::array<std::byte, 4> kMagic { std::byte { 'S' }, std::byte { 'E' }, std::byte { 'V' }, std::byte { 'L' } };
+  constexpr uint32_t kVersion = 1;
+  constexpr std::size_t kHeaderSize = kMagic.size() + 4;
+
+  enum class RecordKind : uint8_t {
+    kQuit,
+    kMouseButton,
+    kMouseMotion,
+    kMouseWheel,
+    kKeyboard,
+    kRaw
+  };
+
+  constexpr std::size_t kTimestampSize = 8;
+
+  //! @brief the payload bytes following a record's kind and timestamp
+  std::size_t payloadSize(RecordKind kind) {
+    switch(kind) {
+      case RecordKind::kQuit: return 0;
+      case RecordKind::kMouseButton: return 4 + 4 + 4 + 4 + 1 + 1 + 1;
+      case RecordKind::kMouseMotion: return 4 + 4 + 4 + 4 + 4 + 4 + 4;
+      case RecordKind::kMouseWheel: return 4 + 4 + 4 + 4 + 1;
+      case RecordKind::kKeyboard: return 4 + 4 + 4 + 2 + 1 + 1;
+      case RecordKind::kRaw: return 4 + RawEvent::kSize;
+    }
+    return 0;
+  }
+
+  //! @brief builds one record, little-endian, on the stack
+  class RecordWriter {
+    public:
+      void put(uint64_t value, std::size_t bytes) {
+        for(std::size_t i = 0; i < bytes; ++i) _bytes[_size++] = static_cast<std::byte>(value >> (8 * i));
+      }
+      void put(std::span<const std::byte> bytes) {
+        std::copy(bytes.begin(), bytes.end(), _bytes.begin() + _size);
+        _size += bytes.size();
+      }
+      void write(std::ostream& output) const {
+        output.write(reinterpret_cast<const char*>(_bytes.data()), static_cast<std::streamsize>(_size));
+      }
+
+    private:
+      std::array<std::byte, 1 + kTimestampSize + 4 + RawEvent::kSize> _bytes;
+      std::size_t _size { 0 };
+  };
+
+  //! @brief reads fields back out of a record which validate() has already checked is complete
+  class RecordReader {
+    public:
+      RecordReader(const std::byte* bytes) : _bytes { bytes } {};
+      uint64_t get(std::size_t bytes) {
+        uint64_t value = 0;
+        for(std::size_t i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(_bytes[i]) << (8 * i);
+        _bytes += bytes;
+        return value;
+      }
+      uint32_t get32() { return static_cast<uint32_t>(get(4)); }
+      int32_t getSigned32() { return static_cast<int32_t>(get32()); }
+      void get(std::span<std::byte> bytes) {
+        std::copy(_bytes, _bytes + bytes.size(), bytes.begin());
+        _bytes += bytes.size();
+      }
+
+    private:
+      const std::byte* _bytes;
+  };
+
+  std::chrono::duration<int64_t, std::milli> toTimestamp(uint64_t milliseconds) {
+    return std::chrono::duration<int64_t, std::milli>(static_cast<int64_t>(milliseconds));
+  }
+}
+
+RecordingEventProducer::RecordingEventProducer(BaseEventProducer& eventProducer, std::ostream& output) :
+  _eventProducer { eventProducer }, _output { output } {
+  RecordWriter header;
+  header.put(kMagic);
+  header.put(kVersion, 4);
+  header.write(_output);
+}
+
+std::unique_ptr<BaseEvent> RecordingEventProducer::wait() {
+  std::unique_ptr<BaseEvent> event = _eventProducer.wait();
+  record(event.get());
+  return event;
+}
+
+std::unique_ptr<BaseEvent> RecordingEventProducer::poll() {
+  std::unique_ptr<BaseEvent> event = _eventProducer.poll();
+  record(event.get());
+  return event;
+}
+
+std::size_t RecordingEventProducer::drain(std::span<std::unique_ptr<BaseEvent>> events) {
+  const std::size_t count = _eventProducer.drain(events);
+  for(std::size_t i = 0; i < count; ++i) record(events[i].get());
+  return count;
+}
+
+void RecordingEventProducer::record(const BaseEvent* baseEvent) {
+  if(baseEvent == nullptr) return;
+  const EventTypeId typeId = baseEvent->typeId();
+  const Event& event = static_cast<const Event&>(*baseEvent);
+
+  RecordWriter recordWriter;
+  const auto begin = [&recordWriter, &event](RecordKind kind) {
+    recordWriter.put(static_cast<uint8_t>(kind), 1);
+    recordWriter.put(event.timestamp.count(), kTimestampSize);
+  };
+
+  // exact type ids, as a subclass may carry state a record of its base would lose
+  if(typeId == eventTypeId<QuitEvent>()) {
+    begin(RecordKind::kQuit);
+  } else if(typeId == eventTypeId<MouseButtonEvent>()) {
+    const auto& mouseButtonEvent = static_cast<const MouseButtonEvent&>(event);
+    begin(RecordKind::kMouseButton);
+    recordWriter.put(mouseButtonEvent.windowId, 4);
+    recordWriter.put(mouseButtonEvent.which, 4);
+    recordWriter.put(static_cast<uint32_t>(mouseButtonEvent.x), 4);
+    recordWriter.put(static_cast<uint32_t>(mouseButtonEvent.y), 4);
+    recordWriter.put(static_cast<uint8_t>(mouseButtonEvent.button), 1);
+    recordWriter.put(static_cast<uint8_t>(mouseButtonEvent.state), 1);
+    recordWriter.put(mouseButtonEvent.clicks, 1);
+  } else if(typeId == eventTypeId<MouseMotionEvent>()) {
+    const auto& mouseMotionEvent = static_cast<const MouseMotionEvent&>(event);
+    begin(RecordKind::kMouseMotion);
+    recordWriter.put(mouseMotionEvent.windowId, 4);
+    recordWriter.put(mouseMotionEvent.which, 4);
+    recordWriter.put(static_cast<uint32_t>(mouseMotionEvent.x), 4);
+    recordWriter.put(static_cast<uint32_t>(mouseMotionEvent.y), 4);
+    recordWriter.put(static_cast<uint32_t>(mouseMotionEvent.relativeX), 4);
+    recordWriter.put(static_cast<uint32_t>(mouseMotionEvent.relativeY), 4);
+    recordWriter.put(mouseMotionEvent.buttons, 4);
+  } else if(typeId == eventTypeId<MouseWheelEvent>()) {
+    const auto& mouseWheelEvent = static_cast<const MouseWheelEvent&>(event);
+    begin(RecordKind::kMouseWheel);
+    recordWriter.put(mouseWheelEvent.windowId, 4);
+    recordWriter.put(mouseWheelEvent.which, 4);
+    recordWriter.put(static_cast<uint32_t>(mouseWheelEvent.x), 4);
+    recordWriter.put(static_cast<uint32_t>(mouseWheelEvent.y), 4);
+    recordWriter.put(mouseWheelEvent.flipped, 1);
+  } else if(typeId == eventTypeId<KeyboardEvent>()) {
+    const auto& keyboardEvent = static_cast<const KeyboardEvent&>(event);
+    begin(RecordKind::kKeyboard);
+    recordWriter.put(keyboardEvent.windowId, 4);
+    recordWriter.put(static_cast<uint32_t>(keyboardEvent.keyCode), 4);
+    recordWriter.put(keyboardEvent.scanCode, 4);
+    recordWriter.put(keyboardEvent.modifiers, 2);
+    recordWriter.put(static_cast<uint8_t>(keyboardEvent.state), 1);
+    recordWriter.put(keyboardEvent.repeat, 1);
+  } else if(typeId == eventTypeId<RawEvent>()) {
+    const auto& rawEvent = static_cast<const RawEvent&>(event);
+    begin(RecordKind::kRaw);
+    recordWriter.put(rawEvent.type, 4);
+    recordWriter.put(rawEvent.data);
+  } else {
+    return;
+  }
+
+  recordWriter.write(_output);
+  ++_recordedCount;
+}
+
+ReplayEventProducer::ReplayEventProducer(std::istream& input, Pacing pacing) : _pacing { pacing }, _offset { kHeaderSize } {
+  std::transform(
+    std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>(),
+    std::back_inserter(_log), [](char c) { return static_cast<std::byte>(c); }
+  );
+  validate();
+}
+
+ReplayEventProducer::ReplayEventProducer(std::span<const std::byte> log, Pacing pacing) :
+  _log { log.begin(), log.end() }, _pacing { pacing }, _offset { kHeaderSize } {
+  validate();
+}
+
+void ReplayEventProducer::validate() {
+  if(_log.size() < kHeaderSize || !std::equal(kMagic.begin(), kMagic.end(), _log.begin())) {
+    throw std::invalid_argument("ReplayEventProducer: not an event log.");
+  }
+  if(RecordReader { _log.data() + kMagic.size() }.get32() != kVersion) {
+    throw std::invalid_argument("ReplayEventProducer: unsupported event log version.");
+  }
+
+  for(std::size_t offset = kHeaderSize; offset < _log.size(); ++_eventCount) {
+    const auto kind = static_cast<RecordKind>(_log[offset]);
+    if(kind > RecordKind::kRaw) throw std::invalid_argument("ReplayEventProducer: unknown event record.");
+    const std::size_t recordSize = 1 + kTimestampSize + payloadSize(kind);
+    if(_log.size() - offset < recordSize) throw std::invalid_argument("ReplayEventProducer: truncated event record.");
+
+    const uint64_t timestamp = RecordReader { _log.data() + offset + 1 }.get(kTimestampSize);
+    if(_eventCount == 0) _firstTimestamp = timestamp;
+    _lastTimestamp = timestamp;
+    offset += recordSize;
+  }
+}
+
+void ReplayEventProducer::rewind() {
+  _offset = kHeaderSize;
+  _started = false;
+}
+
+std::chrono::milliseconds ReplayEventProducer::nextDue() const {
+  const uint64_t timestamp = RecordReader { _log.data() + _offset + 1 }.get(kTimestampSize);
+  // recorded timestamps may step backwards across producers, which makes those events due at once
+  return std::chrono::milliseconds(timestamp > _firstTimestamp ? timestamp - _firstTimestamp : 0);
+}
+
+std::unique_ptr<BaseEvent> ReplayEventProducer::wait() {
+  if(isFinished()) return std::make_unique<QuitEvent>(std::chrono::duration<uint64_t, std::milli>(_lastTimestamp));
+  if(_pacing == Pacing::kRealTime) {
+    if(!_started) {
+      _start = std::chrono::steady_clock::now();
+      _started = true;
+    }
+    std::this_thread::sleep_until(_start + nextDue());
+  }
+  return next();
+}
+
+std::unique_ptr<BaseEvent> ReplayEventProducer::poll() {
+  if(isFinished()) return nullptr;
+  if(_pacing == Pacing::kRealTime) {
+    const auto now = std::chrono::steady_clock::now();
+    if(!_started) {
+      _start = now;
+      _started = true;
+    }
+    if(now - _start < nextDue()) return nullptr;
+  }
+  return next();
+}
+
+std::unique_ptr<BaseEvent> ReplayEventProducer::next() {
+  RecordReader recordReader { _log.data() + _offset };
+  const auto kind = static_cast<RecordKind>(recordReader.get(1));
+  const auto timestamp = toTimestamp(recordReader.get(kTimestampSize));
+  _offset += 1 + kTimestampSize + payloadSize(kind);
+
+  switch(kind) {
+    case RecordKind::kQuit:
+      return std::make_unique<QuitEvent>(std::chrono::duration<uint64_t, std::milli>(timestamp.count()));
+    case RecordKind::kMouseButton: {
+      const uint32_t windowId = recordReader.get32();
+      const uint32_t which = recordReader.get32();
+      const int32_t x = recordReader.getSigned32();
+      const int32_t y = recordReader.getSigned32();
+      const auto button = static_cast<MouseButtonEvent::Button>(recordReader.get(1));
+      const auto state = static_cast<MouseButtonEvent::State>(recordReader.get(1));
+      const auto clicks = static_cast<uint8_t>(recordReader.get(1));
+      return std::make_unique<MouseButtonEvent>(timestamp, windowId, which, x, y, button, state, clicks);
+    }
+    case RecordKind::kMouseMotion: {
+      const uint32_t windowId = recordReader.get32();
+      const uint32_t which = recordReader.get32();
+      const int32_t x = recordReader.getSigned32();
+      const int32_t y = recordReader.getSigned32();
+      const int32_t relativeX = recordReader.getSigned32();
+      const int32_t relativeY = recordReader.getSigned32();
+      const uint32_t buttons = recordReader.get32();
+      return std::make_unique<MouseMotionEvent>(timestamp, windowId, which, x, y, relativeX, relativeY, buttons);
+    }
+    case RecordKind::kMouseWheel: {
+      const uint32_t windowId = recordReader.get32();
+      const uint32_t which = recordReader.get32();
+      const int32_t x = recordReader.getSigned32();
+      const int32_t y = recordReader.getSigned32();
+      const bool flipped = recordReader.get(1) != 0;
+      return std::make_unique<MouseWheelEvent>(timestamp, windowId, which, x, y, flipped);
+    }
+    case RecordKind::kKeyboard: {
+      const uint32_t windowId = recordReader.get32();
+      const auto keyCode = static_cast<KeyboardEvent::KeyCode>(recordReader.getSigned32());
+      const KeyboardEvent::ScanCode scanCode = recordReader.get32();
+      const auto modifiers = static_cast<KeyboardEvent::KeyModifiers>(recordReader.get(2));
+      const auto state = static_cast<KeyboardEvent::State>(recordReader.get(1));
+      const bool repeat = recordReader.get(1) != 0;
+      return std::make_unique<KeyboardEvent>(timestamp, windowId, keyCode, scanCode, modifiers, state, repeat);
+    }
+    case RecordKind::kRaw: {
+      const uint32_t type = recordReader.get32();
+      std::array<std::byte, RawEvent::kSize> data;
+      recordReader.get(data);
+      return std::make_unique<RawEvent>(timestamp, type, data);
+    }
+  }
+  return nullptr;
+}
+
+}
@@ -0,0 +1,74 @@
+#include <SDL2/SDL.h>
+#include <SDL_ttf.h>
+
+#include "color_impl.h"
+#include "exception.h"
+
+#include "font.h"
+#include "surface.h"
+
+namespace sdl {
+
+void detail::FontDeleter::operator()(TTF_Font* ttfFont) const noexcept {
+  TTF_CloseFont(ttfFont);
+  TTF_Quit();
+}
+
+Font::Font(std::filesystem::path filePath, uint32_t pointSize) {
+  if(TTF_Init() < 0) throw Exception("TTF_Init");
+  _ttfFont.reset(TTF_OpenFont(filePath.c_str(), static_cast<int>(pointSize)));
+  if(!_ttfFont) {
+    // the deleter only releases SDL_ttf for fonts which opened
+    Exception exception { "TTF_OpenFont" };
+    TTF_Quit();
+    throw exception;
+  }
+}
+
+Font::Font(const void* location, std::size_t size, uint32_t pointSize) {
+  if(TTF_Init() < 0) throw Exception("TTF_Init");
+  _ttfFont.reset(TTF_OpenFontRW(SDL_RWFromConstMem(location, static_cast<int>(size)), 1, static_cast<int>(pointSize)));
+  if(!_ttfFont) {
+    Exception exception { "TTF_OpenFontRW" };
+    TTF_Quit();
+    throw exception;
+  }
+}
+
+Font::Font(Font&& other) noexcept = default;
+
+Font::~Font() {}
+
+Font& Font::operator=(Font&& other) noexcept = default;
+
+uint32_t Font::getHeight() const {
+  return static_cast<uint32_t>(TTF_FontHeight(_ttfFont.get()));
+}
+
+int32_t Font::getAscent() const {
+  return TTF_FontAscent(_ttfFont.get());
+}
+
+uint32_t Font::getLineSkip() const {
+  return static_cast<uint32_t>(TTF_FontLineSkip(_ttfFont.get()));
+}
+
+bool Font::hasGlyph(char32_t codePoint) const {
+  return TTF_GlyphIsProvided32(_ttfFont.get(), codePoint) != 0;
+}
+
+Font::GlyphMetrics Font::getGlyphMetrics(char32_t codePoint) const {
+  int minX, maxX, minY, maxY, advance;
+  if(TTF_GlyphMetrics32(_ttfFont.get(), codePoint, &minX, &maxX, &minY, &maxY, &advance) < 0) throw Exception("TTF_GlyphMetrics32");
+  return { minX, maxX, minY, maxY, advance };
+}
+
+int32_t Font::getKerning(char32_t previous, char32_t next) const {
+  return TTF_GetFontKerningSizeGlyphs32(_ttfFont.get(), previous, next);
+}
+
+Surface Font::renderGlyph(char32_t codePoint) const {
+  return Surface { TTF_RenderGlyph32_Blended(_ttfFont.get(), codePoint, *ColorImpl::getSDLColor(NamedColor::kWhite)), "TTF_RenderGlyph32_Blended" };
+}
+
+}
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+#include <SDL2/SDL.h>
+
+#include "frame_clock.h"
+
+namespace sdl {
+
+void FrameStatistics::record(Duration frameTime) {
+  _frameTimes[_next] = frameTime;
+  _next = (_next + 1) % kWindowSize;
+  _count = std::min(_count + 1, kWindowSize);
+}
+
+FrameStatistics::Duration FrameStatistics::getPercentile(double fraction) const {
+  if(_count == 0) return Duration { 0 };
+
+  std::array<Duration, kWindowSize> sorted;
+  std::copy_n(_frameTimes.cbegin(), _count, sorted.begin());
+  // nearest rank
+  const auto rank = static_cast<std::size_t>(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(_count - 1) + 0.5);
+  std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + _count);
+  return sorted[rank];
+}
+
+FrameStatistics::Duration FrameStatistics::getMean() const {
+  if(_count == 0) return Duration { 0 };
+  return std::accumulate(_frameTimes.cbegin(), _frameTimes.cbegin() + _count, Duration { 0 }) / _count;
+}
+
+FrameClock::FrameClock(Duration targetFrameTime, Duration fixedTimestep) :
+  _targetFrameTime { targetFrameTime },
+  _fixedTimestep { fixedTimestep },
+  _frequency { SDL_GetPerformanceFrequency() },
+  _frameStart { SDL_GetPerformanceCounter() } { }
+
+FrameClock::Duration FrameClock::toDuration(uint64_t ticks) const {
+  // split so the multiplication can't overflow for any realistic frequency
+  return Duration { static_cast<int64_t>((ticks / _frequency) * 1'000'000'000 + (ticks % _frequency) * 1'000'000'000 / _frequency) };
+}
+
+FrameClock::Duration FrameClock::elapsedSince(uint64_t counter) const {
+  return toDuration(SDL_GetPerformanceCounter() - counter);
+}
+
+void FrameClock::beginFrame() {
+  beginFrame(elapsedSince(_frameStart));
+}
+
+void FrameClock::beginFrame(Duration frameTime) {
+  _frameStart = SDL_GetPerformanceCounter();
+  _frameTime = frameTime;
+
+  _statistics.record(_frameTime);
+  _accumulator += std::min(_frameTime, kMaxFrameTime);
+}
+
+bool FrameClock::step() {
+  if(_accumulator < _fixedTimestep) return false;
+  _accumulator -= _fixedTimestep;
+  return true;
+}
+
+double FrameClock::getInterpolation() const {
+  return std::chrono::duration<double>(_accumulator) / std::chrono::duration<double>(_fixedTimestep);
+}
+
+void FrameClock::waitForNextFrame() {
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+
+  // sleep in whole milliseconds while the expected wake-up is comfortably early
+  for(Duration remaining = _targetFrameTime - elapsedSince(_frameStart); remaining > _sleepOvershoot; remaining = _targetFrameTime - elapsedSince(_frameStart)) {
+    const auto request = duration_cast<milliseconds>(remaining - _sleepOvershoot);
+    if(request.count() <= 0) break;
+
+    const uint64_t sleepStart = SDL_GetPerformanceCounter();
+    SDL_Delay(static_cast<uint32_t>(request.count()));
+    const Duration overshoot = elapsedSince(sleepStart) - request;
+
+    // jump up to a late wake-up straight away, but only relax slowly
+    _sleepOvershoot = std::max(overshoot, _sleepOvershoot - _sleepOvershoot / 16);
+  }
+
+  while(elapsedSince(_frameStart) < _targetFrameTime) std::this_thread::yield();
+}
+
+FrameClock::Duration getPerformanceTime() {
+  static const uint64_t frequency = SDL_GetPerformanceFrequency();
+  const uint64_t counter = SDL_GetPerformanceCounter();
+  return FrameClock::Duration { static_cast<int64_t>((counter / frequency) * 1'000'000'000 + (counter % frequency) * 1'000'000'000 / frequency) };
+}
+
+}
@@ -3,21 +3,32 @@
 
 #include <SDL2/SDL.h>
 
-#include <cinttypes>
+#include <cstddef>
+#include <type_traits>
 
 #include "rectangle.h"
 
 namespace sdl {
 
-class RectangleImpl{
-  friend Rectangle;
+//! @brief gives the library access to a Rectangle as the SDL_Rect it is laid out as.
+class RectangleImpl {
   public:
-    RectangleImpl() = default;
-    RectangleImpl(SDL_Rect sdlRect) : _sdlRect { sdlRect } {};
-    SDL_Rect* getSDLRect() { return &_sdlRect; };
-
-  private:
-    SDL_Rect _sdlRect;
+    static const SDL_Rect* getSDLRect(const Rectangle& rectangle) {
+      return reinterpret_cast<const SDL_Rect*>(&rectangle);
+    };
+
+    static SDL_Rect* getSDLRect(Rectangle& rectangle) {
+      return reinterpret_cast<SDL_Rect*>(&rectangle);
+    };
+
+    static_assert(std::is_trivially_copyable_v<Rectangle>);
+    static_assert(std::is_standard_layout_v<Rectangle>);
+    static_assert(sizeof(Rectangle) == sizeof(SDL_Rect));
+    static_assert(alignof(Rectangle) == alignof(SDL_Rect));
+    static_assert(offsetof(Rectangle, _x) == offsetof(SDL_Rect, x));
+    static_assert(offsetof(Rectangle, _y) == offsetof(SDL_Rect, y));
+    static_assert(offsetof(Rectangle, _width) == offsetof(SDL_Rect, w));
+    static_assert(offsetof(Rectangle, _height) == offsetof(SDL_Rect, h));
 };
 
 }
@@ -1,79 +1,380 @@
+#include <algorithm>
 #include <cinttypes>
+#include <exception>
 #include <memory>
+#include <stdexcept>
 
 #include <SDL2/SDL.h>
 
+#include <pixel_kernels.h>
+#include <profiler.h>
+
 #include "exception.h"
+#include "frame_clock.h"
+#include "surface.h"
 #include "window.h"
 
 #include "renderer.h"
 
-#include "window_impl.h"
+#include "color_impl.h"
 #include "rectangle_impl.h"
 #include "renderer_impl.h"
 #include "texture_impl.h"
+#include "vertex_impl.h"
 
 namespace sdl {
 
-Renderer::Renderer(Window& window, int16_t index, std::unordered_set<RendererFlag> flags) 
+void detail::RendererDeleter::operator()(SDL_Renderer* sdlRenderer) const noexcept {
+  SDL_DestroyRenderer(sdlRenderer);
+}
+
+Renderer::Renderer(Window& window, int16_t index, vodden::Flags<RendererFlag> flags) 
   : _rendererImpl { std::make_unique<RendererImpl>() } {
-  
-  _rendererImpl->_sdlWindow = window._windowImpl->_sdlWindow;
 
-  uint32_t flagValue = 0;
-  for(const RendererFlag& flag : flags) flagValue |= sdlRendererFlagMap[flag];
+  _sdlRenderer.reset(SDL_CreateRenderer(window._sdlWindow.get(), index, flags.translate(sdlRendererFlagMap)));
+  if(!_sdlRenderer) throw Exception("SDL_CreateRenderer");
+  _rendererImpl->describe(_sdlRenderer.get(), index);
+}
+
+Renderer::Renderer(Surface& surface)
+  : _rendererImpl { std::make_unique<RendererImpl>() } {
 
-  _rendererImpl->_sdlRenderer = SDL_CreateRenderer(_rendererImpl->_sdlWindow, index, flagValue);
-  if(_rendererImpl->_sdlRenderer == nullptr) throw Exception("SDL_CreateRendere");
+  _sdlRenderer.reset(SDL_CreateSoftwareRenderer(surface._sdlSurface.get()));
+  if(!_sdlRenderer) throw Exception("SDL_CreateSoftwareRenderer");
+  _rendererImpl->describe(_sdlRenderer.get(), -1);
 }
 
-Renderer::Renderer(Renderer&& other) noexcept : _rendererImpl { std::move(other._rendererImpl) } { };
+void RendererImpl::describe(SDL_Renderer* sdlRenderer, int16_t index) {
+  SDL_RendererInfo sdlInfo;
+  if(SDL_GetRendererInfo(sdlRenderer, &sdlInfo) < 0) throw Exception("SDL_GetRendererInfo");
+  _info = createInfo(sdlInfo, index);
+  _vSyncMode = _info.flags.contains(Renderer::kPresentVSync) ? Renderer::kVSyncOn : Renderer::kVSyncOff;
 
-Renderer::~Renderer() noexcept {
-  SDL_DestroyRenderer(_rendererImpl->_sdlRenderer);
+  // the first native format with alpha, so that blended textures keep their transparency
+  std::optional<uint8_t> opaqueFormat;
+  for(uint32_t i = 0; i < sdlInfo.num_texture_formats; ++i) {
+    const auto pixelFormat = sdlTexturePixelFormatMap.find(sdlInfo.texture_formats[i]);
+    if(!pixelFormat) continue;
+    if(SDL_ISPIXELFORMAT_ALPHA(sdlInfo.texture_formats[i])) {
+      _preferredPixelFormat = *pixelFormat;
+      return;
+    }
+    if(!opaqueFormat) opaqueFormat = *pixelFormat;
+  }
+  if(opaqueFormat) _preferredPixelFormat = *opaqueFormat;
 }
 
-Renderer& Renderer::operator=(Renderer&& other) noexcept {
-  if(this == &other) return *this;
-  if(_rendererImpl->_sdlRenderer != nullptr) SDL_DestroyRenderer(_rendererImpl->_sdlRenderer);
-  _rendererImpl = std::move(other._rendererImpl);
-  return *this;
+Renderer::Renderer(Renderer&& other) noexcept = default;
+
+Renderer::~Renderer() noexcept {}
+
+Renderer& Renderer::operator=(Renderer&& other) noexcept = default;
+
+Renderer::Info RendererImpl::createInfo(const SDL_RendererInfo& sdlInfo, int16_t index) {
+  Renderer::Info info { index, sdlInfo.name != nullptr ? sdlInfo.name : "", {}, {},
+    static_cast<uint32_t>(std::max(sdlInfo.max_texture_width, 0)),
+    static_cast<uint32_t>(std::max(sdlInfo.max_texture_height, 0)) };
+  for(const Renderer::RendererFlag flag : { Renderer::kSoftware, Renderer::kAccelerated, Renderer::kPresentVSync, Renderer::kTargetTexture }) {
+    if(sdlInfo.flags & sdlRendererFlagMap[flag]) info.flags.insert(flag);
+  }
+  for(uint32_t i = 0; i < sdlInfo.num_texture_formats; ++i) {
+    const auto pixelFormat = sdlTexturePixelFormatMap.find(sdlInfo.texture_formats[i]);
+    if(pixelFormat) info.pixelFormats.push_back(*pixelFormat);
+  }
+  return info;
+}
+
+std::vector<Renderer::Info> Renderer::getDriverInfo() {
+  const int driverCount = SDL_GetNumRenderDrivers();
+  if(driverCount < 0) throw Exception("SDL_GetNumRenderDrivers");
+
+  std::vector<Info> drivers;
+  drivers.reserve(driverCount);
+  for(int index = 0; index < driverCount; ++index) {
+    SDL_RendererInfo sdlInfo;
+    if(SDL_GetRenderDriverInfo(index, &sdlInfo) < 0) throw Exception("SDL_GetRenderDriverInfo");
+    drivers.push_back(RendererImpl::createInfo(sdlInfo, static_cast<int16_t>(index)));
+  }
+  return drivers;
+}
+
+Renderer Renderer::create(Window& window, const Requirements& requirements) {
+  std::vector<Info> drivers = getDriverInfo();
+  // stable, so each group keeps SDL's order of preference
+  std::stable_partition(drivers.begin(), drivers.end(), [](const Info& info) { return info.flags.contains(kAccelerated); });
+
+  std::exception_ptr lastFailure;
+  for(const Info& info : drivers) {
+    const bool qualifies = info.flags.containsAll(requirements.flags);
+    // zero means the driver does not say, so it is given the benefit of the doubt
+    const bool largeEnough =
+      (info.maxTextureWidth == 0 || info.maxTextureWidth >= requirements.minTextureSize) &&
+      (info.maxTextureHeight == 0 || info.maxTextureHeight >= requirements.minTextureSize);
+    if(!qualifies || !largeEnough) continue;
+
+    vodden::Flags<RendererFlag> flags = requirements.flags;
+    flags.insert(info.flags.contains(kAccelerated) ? kAccelerated : kSoftware);
+    try {
+      return Renderer { window, info.index, flags };
+    } catch(const Exception&) {
+      lastFailure = std::current_exception();
+    }
+  }
+  if(lastFailure) std::rethrow_exception(lastFailure);
+  throw std::runtime_error("Renderer::create: no render driver meets the requirements.");
+}
+
+Renderer Renderer::create(Window& window) {
+  return create(window, Requirements {});
+}
+
+const Renderer::Info& Renderer::getInfo() const {
+  return _rendererImpl->_info;
+}
+
+uint8_t Renderer::getPreferredPixelFormat() const {
+  return _rendererImpl->_preferredPixelFormat;
 }
 
 void Renderer::setRenderDrawColour(const Color& color) {
+  if(_rendererImpl->_drawColor == color) return _rendererImpl->skipStateCall();
   auto retVal = SDL_SetRenderDrawColor(
-    _rendererImpl->_sdlRenderer, 
+    _sdlRenderer.get(), 
     color.getRed(), 
     color.getGreen(), 
     color.getBlue(), 
     color.getAlpha() );
   if (retVal < 0) throw Exception("SDL_SetRenderDrawColor");
+  _rendererImpl->_drawColor = color;
+}
+
+void Renderer::setRenderDrawBlendMode(const uint8_t& blendMode) {
+  const SDL_BlendMode sdlBlendMode = getSDLBlendMode(blendMode);
+  if(_rendererImpl->_drawBlendMode == sdlBlendMode) return _rendererImpl->skipStateCall();
+  auto retVal = SDL_SetRenderDrawBlendMode(_sdlRenderer.get(), sdlBlendMode);
+  if (retVal < 0) throw Exception("SDL_SetRenderDrawBlendMode");
+  _rendererImpl->_drawBlendMode = sdlBlendMode;
 }
 
 const Renderer &Renderer::copy(const Texture &texture) const {
-  auto returnValue = SDL_RenderCopy(_rendererImpl->_sdlRenderer, texture._textureImpl->_sdlTexture, nullptr, nullptr);
+  VODDEN_PROFILE_ZONE("Renderer::copy");
+  _rendererImpl->profileDraw(texture._sdlTexture.get(), 1);
+  auto returnValue = SDL_RenderCopy(_sdlRenderer.get(), texture._sdlTexture.get(), nullptr, nullptr);
   if(returnValue < 0) throw Exception("SDL_RenderCopy");
 
   return *this;
 }
 
 const Renderer &Renderer::copy(const Texture &texture, const Rectangle &source, const Rectangle &destination) const {
-  SDL_Rect* sourceRect = source._rectangleImpl->getSDLRect();
-  SDL_Rect* destRect = destination._rectangleImpl->getSDLRect();
+  VODDEN_PROFILE_ZONE("Renderer::copy");
+  _rendererImpl->profileDraw(texture._sdlTexture.get(), 1);
+  const SDL_Rect* sourceRect = RectangleImpl::getSDLRect(source);
+  const SDL_Rect* destRect = RectangleImpl::getSDLRect(destination);
 
-  auto returnValue = SDL_RenderCopy(_rendererImpl->_sdlRenderer, texture._textureImpl->_sdlTexture, sourceRect, destRect);
+  auto returnValue = SDL_RenderCopy(_sdlRenderer.get(), texture._sdlTexture.get(), sourceRect, destRect);
   if(returnValue < 0) throw Exception("SDL_RenderCopy");
 
   return *this;
 }
 
+const Renderer &Renderer::copy(const Texture &texture, std::span<const Rectangle> sources, std::span<const Rectangle> destinations) const {
+  if(sources.size() != destinations.size()) throw std::invalid_argument("Renderer::copy: sources and destinations differ in length");
+  VODDEN_PROFILE_ZONE("Renderer::copy");
+  _rendererImpl->profileDraw(texture._sdlTexture.get(), sources.size());
+
+  SDL_Renderer* sdlRenderer = _sdlRenderer.get();
+  SDL_Texture* sdlTexture = texture._sdlTexture.get();
+  for(std::size_t i = 0; i < sources.size(); ++i) {
+    auto returnValue = SDL_RenderCopy(sdlRenderer, sdlTexture, RectangleImpl::getSDLRect(sources[i]), RectangleImpl::getSDLRect(destinations[i]));
+    if(returnValue < 0) throw Exception("SDL_RenderCopy");
+  }
+
+  return *this;
+}
+
+const Renderer &Renderer::copy(const Texture &texture, const Rectangle &source, const Rectangle &destination, uint8_t blendMode) const {
+  _rendererImpl->setTextureBlendMode(texture._sdlTexture.get(), blendMode);
+  return copy(texture, source, destination);
+}
+
+const Renderer &Renderer::copy(const Texture &texture, std::span<const Rectangle> sources, std::span<const Rectangle> destinations, uint8_t blendMode) const {
+  _rendererImpl->setTextureBlendMode(texture._sdlTexture.get(), blendMode);
+  return copy(texture, sources, destinations);
+}
+
+const Renderer &Renderer::renderGeometry(const Texture* texture, std::span<const Vertex> vertices, std::span<const int> indices) const {
+  VODDEN_PROFILE_ZONE("Renderer::renderGeometry");
+  _rendererImpl->profileDraw(texture != nullptr ? texture->_sdlTexture.get() : nullptr, 1);
+  auto returnValue = SDL_RenderGeometry(
+    _sdlRenderer.get(),
+    texture != nullptr ? texture->_sdlTexture.get() : nullptr,
+    VertexImpl::getSDLVertices(vertices.data()),
+    static_cast<int>(vertices.size()),
+    indices.empty() ? nullptr : indices.data(),
+    static_cast<int>(indices.size())
+  );
+  if(returnValue < 0) throw Exception("SDL_RenderGeometry");
+
+  return *this;
+}
+
 void Renderer::clear() const {
-  auto retVal = SDL_RenderClear(_rendererImpl->_sdlRenderer);
+  auto retVal = SDL_RenderClear(_sdlRenderer.get());
   if (retVal < 0) throw Exception("SDL_SetRenderClear");
 }
 
+void Renderer::fillRectangle(const Rectangle& rectangle) const {
+  _rendererImpl->profileDraw(nullptr, 1);
+  auto retVal = SDL_RenderFillRect(_sdlRenderer.get(), RectangleImpl::getSDLRect(rectangle));
+  if (retVal < 0) throw Exception("SDL_RenderFillRect");
+}
+
+void Renderer::setClipRectangle(const Rectangle& rectangle) const {
+  auto& impl = *_rendererImpl;
+  if(impl._clipKnown && impl._clipRectangle == rectangle) return impl.skipStateCall();
+  auto retVal = SDL_RenderSetClipRect(_sdlRenderer.get(), RectangleImpl::getSDLRect(rectangle));
+  if (retVal < 0) throw Exception("SDL_RenderSetClipRect");
+  impl._clipKnown = true;
+  impl._clipRectangle = rectangle;
+}
+
+void Renderer::resetClipRectangle() const {
+  auto& impl = *_rendererImpl;
+  if(impl._clipKnown && !impl._clipRectangle) return impl.skipStateCall();
+  auto retVal = SDL_RenderSetClipRect(_sdlRenderer.get(), nullptr);
+  if (retVal < 0) throw Exception("SDL_RenderSetClipRect");
+  impl._clipKnown = true;
+  impl._clipRectangle.reset();
+}
+
+Renderer::TargetScope Renderer::setTarget(const Texture& texture) const {
+  return TargetScope { *this, &texture };
+}
+
+Renderer::TargetScope Renderer::resetTarget() const {
+  return TargetScope { *this, nullptr };
+}
+
+bool Renderer::isTargetSupported() const {
+  return SDL_RenderTargetSupported(_sdlRenderer.get()) == SDL_TRUE;
+}
+
+Renderer::TargetScope::TargetScope(const Renderer& renderer, const Texture& texture) : TargetScope(renderer, &texture) { }
+
+Renderer::TargetScope::TargetScope(const Renderer& renderer, const Texture* texture) : _renderer { renderer } {
+  auto& impl = *_renderer._rendererImpl;
+  SDL_Texture* previous = impl._target;
+  if(!impl.setTarget(_renderer._sdlRenderer.get(), texture != nullptr ? texture->_sdlTexture.get() : nullptr)) {
+    throw Exception("SDL_SetRenderTarget");
+  }
+  impl._previousTargets.push_back(previous);
+}
+
+Renderer::TargetScope::~TargetScope() noexcept {
+  auto& impl = *_renderer._rendererImpl;
+  impl.setTarget(_renderer._sdlRenderer.get(), impl._previousTargets.back());
+  impl._previousTargets.pop_back();
+}
+
+void RendererImpl::setTextureBlendMode(SDL_Texture* sdlTexture, uint8_t blendMode) {
+  const SDL_BlendMode sdlBlendMode = getSDLBlendMode(blendMode);
+  SDL_BlendMode current;
+  if(SDL_GetTextureBlendMode(sdlTexture, &current) < 0) throw Exception("SDL_GetTextureBlendMode");
+  if(current == sdlBlendMode) return skipStateCall();
+  if(SDL_SetTextureBlendMode(sdlTexture, sdlBlendMode) < 0) throw Exception("SDL_SetTextureBlendMode");
+}
+
+bool RendererImpl::setTarget(SDL_Renderer* sdlRenderer, SDL_Texture* target) {
+  if(target == _target) {
+    skipStateCall();
+    return true;
+  }
+  if(SDL_SetRenderTarget(sdlRenderer, target) < 0) return false;
+  _target = target;
+  _clipKnown = false;
+  return true;
+}
+
+void Renderer::readPixels(vodden::PixelView destination, uint8_t pixelFormat) const {
+  if(pixelFormat == Texture::kPreferred) pixelFormat = getPreferredPixelFormat();
+  if(pixelFormat == Texture::kRGB24) throw std::invalid_argument("Renderer::readPixels: a pixel view holds 32 bit pixels.");
+  // SDL writes height rows at pitch into the bytes, trusting them to be long enough
+  vodden::detail::checkView(destination, "Renderer::readPixels: rows overrun the view's bytes.");
+  if(destination.width == 0 || destination.height == 0) return;
+  const Rectangle area { 0, 0, destination.width, destination.height };
+  const int retVal = SDL_RenderReadPixels(
+    _sdlRenderer.get(),
+    RectangleImpl::getSDLRect(area),
+    sdlPixelFormatMap[pixelFormat],
+    destination.bytes.data(),
+    static_cast<int>(destination.pitch)
+  );
+  if(retVal < 0) throw Exception("SDL_RenderReadPixels");
+}
+
+void Renderer::readPixels(Surface& surface) const {
+  readPixels(surface.getPixels(), surface.getPixelFormat());
+}
+
+Renderer::VSyncMode Renderer::setVSync(VSyncMode vSyncMode) {
+  if(SDL_RenderSetVSync(_sdlRenderer.get(), sdlVSyncMap[vSyncMode]) < 0) {
+    if(vSyncMode != kVSyncAdaptive) throw Exception("SDL_RenderSetVSync");
+    return setVSync(kVSyncOn);
+  }
+  _rendererImpl->_vSyncMode = vSyncMode;
+  return vSyncMode;
+}
+
+Renderer::VSyncMode Renderer::getVSync() const {
+  return _rendererImpl->_vSyncMode;
+}
+
+void Renderer::setMaxFramesInFlight(uint32_t maxFramesInFlight) {
+  _rendererImpl->_maxFramesInFlight = maxFramesInFlight;
+  _rendererImpl->_framesSinceSync = 0;
+}
+
+uint32_t Renderer::getMaxFramesInFlight() const {
+  return _rendererImpl->_maxFramesInFlight;
+}
+
+uint64_t Renderer::getSyncCount() const {
+  return _rendererImpl->_syncCount;
+}
+
+void Renderer::setPresentCallback(PresentCallback presentCallback) {
+  _rendererImpl->_presentCallback = std::move(presentCallback);
+}
+
+void RendererImpl::limitFramesInFlight(SDL_Renderer* sdlRenderer) {
+  if(_maxFramesInFlight == Renderer::kUnlimitedFramesInFlight || ++_framesSinceSync < _maxFramesInFlight) return;
+  _framesSinceSync = 0;
+  ++_syncCount;
+  // reading a pixel back can't return until the GPU has drawn everything before it
+  VODDEN_PROFILE_ZONE("Renderer::limitFramesInFlight");
+  const SDL_Rect pixel { 0, 0, 1, 1 };
+  uint32_t value;
+  if(SDL_RenderReadPixels(sdlRenderer, &pixel, SDL_PIXELFORMAT_ARGB8888, &value, sizeof(value)) < 0) throw Exception("SDL_RenderReadPixels");
+}
+
+void RendererImpl::timePresent() {
+  const std::chrono::nanoseconds presentTime = getPerformanceTime();
+  const uint64_t frame = _presentCount++;
+  const Renderer::PresentTiming presentTiming { frame, presentTime, frame > 0 ? presentTime - _lastPresent : std::chrono::nanoseconds { 0 } };
+  _lastPresent = presentTime;
+  // a present closes the profiler's frame, and the input latency of everything dispatched during it
+  VODDEN_PROFILE_PRESENT(presentTime);
+  if(_presentCallback) _presentCallback(presentTiming);
+}
+
 void Renderer::present() const {
-  SDL_RenderPresent(_rendererImpl->_sdlRenderer);
+  _rendererImpl->limitFramesInFlight(_sdlRenderer.get());
+  {
+    VODDEN_PROFILE_ZONE("Renderer::present");
+    SDL_RenderPresent(_sdlRenderer.get());
+  }
+  _rendererImpl->timePresent();
+  VODDEN_PROFILE_END_FRAME();
 }
 
 }
@@ -1,11 +1,19 @@
 #ifndef __RENDERER_IMPL_H__
 #define __RENDERER_IMPL_H__
 
+#include <chrono>
+#include <optional>
+#include <vector>
+
 #include <SDL2/SDL.h>
 
+#include "color.h"
+#include "rectangle.h"
 #include "texture.h"
 #include "renderer.h"
 #include "constexpr_map.h"
+#include "memory_tracker.h"
+#include "profiler.h"
 
 namespace sdl {
 
@@ -16,14 +24,76 @@ static constexpr vodden::Map<Renderer::RendererFlag, uint32_t, 4> sdlRendererFla
     {Renderer::kTargetTexture, SDL_RENDERER_TARGETTEXTURE}
 }};
 
-class RendererImpl {
+// the value SDL_RenderSetVSync takes for each mode; SDL only accepts -1, adaptive, from some drivers
+static constexpr vodden::Map<Renderer::VSyncMode, int, 3> sdlVSyncMap {{
+    {Renderer::kVSyncOff, 0},
+    {Renderer::kVSyncOn, 1},
+    {Renderer::kVSyncAdaptive, -1}
+}};
+
+class RendererImpl : public vodden::memory::Tracked<vodden::memory::Category::kOther> {
   friend Renderer;
-  friend Texture;
+  friend Renderer::TargetScope;
   private:
-    // This is ownned by the Window which was passed in - i.e. not us or the Renderer
-    SDL_Window* _sdlWindow;
-    // Owning Renderer class owns the SDL_Renderer
-    SDL_Renderer* _sdlRenderer;
+    //! @brief count drawCalls draws from sdlTexture, and a bind if it differs from the previous draw's
+    void profileDraw([[maybe_unused]] SDL_Texture* sdlTexture, [[maybe_unused]] std::size_t drawCalls) {
+#ifdef VODDEN_PROFILE
+      VODDEN_PROFILE_COUNT(kDrawCalls, drawCalls);
+      if(sdlTexture != _lastDrawnTexture) VODDEN_PROFILE_COUNT(kTextureBinds, 1);
+      _lastDrawnTexture = sdlTexture;
+#endif
+    }
+
+    //! @brief set sdlTexture to draw with blendMode, a Texture::BlendMode, unless it already does
+    void setTextureBlendMode(SDL_Texture* sdlTexture, uint8_t blendMode);
+
+    //! @brief make target, or the window if nullptr, the render target unless it already is; false if SDL failed
+    bool setTarget(SDL_Renderer* sdlRenderer, SDL_Texture* target);
+
+    //! @brief count a state change skipped because the state was already set
+    void skipStateCall() {
+      VODDEN_PROFILE_COUNT(kRedundantStateCalls, 1);
+    }
+
+    //! @brief fill in _info and _preferredPixelFormat from the newly created sdlRenderer
+    void describe(SDL_Renderer* sdlRenderer, int16_t index);
+
+    //! @brief describe a driver, or the renderer created from it; index is the driver's
+    static Renderer::Info createInfo(const SDL_RendererInfo& sdlInfo, int16_t index);
+
+    // the driver this renderer was created on, and what it should upload textures as
+    Renderer::Info _info;
+    uint8_t _preferredPixelFormat { Texture::kARGB8888 };
+
+    //! @brief wait for the GPU to finish what has been submitted, if the frames in flight limit calls for it
+    void limitFramesInFlight(SDL_Renderer* sdlRenderer);
+
+    //! @brief time the present which just returned, and tell the present callback
+    void timePresent();
+
+    Renderer::VSyncMode _vSyncMode { Renderer::kVSyncOff };
+    uint32_t _maxFramesInFlight { Renderer::kUnlimitedFramesInFlight };
+    uint32_t _framesSinceSync { 0 };
+    uint64_t _syncCount { 0 };
+    Renderer::PresentCallback _presentCallback;
+    uint64_t _presentCount { 0 };
+    std::chrono::nanoseconds _lastPresent { 0 };
+
+    // the targets to restore as each active Renderer::TargetScope ends
+    std::vector<SDL_Texture*> _previousTargets;
+
+    // shadows of the SDL renderer's state, so setting it again can be skipped; nullopt until first set
+    std::optional<Color> _drawColor;
+    std::optional<SDL_BlendMode> _drawBlendMode;
+    // nullptr while drawing to the window
+    SDL_Texture* _target { nullptr };
+    // SDL swaps the clip rectangle along with the target, so it is unknown after a target change
+    bool _clipKnown { true };
+    std::optional<Rectangle> _clipRectangle;
+#ifdef VODDEN_PROFILE
+    // the texture of the last draw, so that texture binds can be counted
+    SDL_Texture* _lastDrawnTexture { nullptr };
+#endif
 
 };
 
@@ -1,10 +1,12 @@
 #include <memory>
+#include <string>
 #include <SDL2/SDL.h>
 
 #include "exception.h"
 
 #include "sdl.h"
 #include "sdl_impl.h"
+#include "user_event_impl.h"
 
 namespace sdl {
 
@@ -13,15 +15,30 @@ SDL::SDL() {
 }
 
 SDL::~SDL() noexcept {
-  for (const auto& subSystem : _sdlImpl->subSystemInitializationStatus) {
-    SDL_QuitSubSystem( sdlSubSystemMap[subSystem] );
-  }
+  if(_sdlImpl->subSystemInitializationStatus.empty()) return;
+  SDL_QuitSubSystem( _sdlImpl->subSystemInitializationStatus.translate(sdlSubSystemMap) );
+  // shutting the events down empties the queue, so no pushed user event is left to claim
+  if(SDL_WasInit(SDL_INIT_EVENTS) == 0) UserEventImpl::reclaimAll();
 }
 
 void SDL::initSubSystem(const SubSystem &subSystem) {
-auto retVal = SDL_InitSubSystem(sdlSubSystemMap[subSystem]);
+  initSubSystem(vodden::Flags<SubSystem> { subSystem });
+}
+
+void SDL::initSubSystem(const vodden::Flags<SubSystem> &subSystems) {
+  auto retVal = SDL_InitSubSystem(subSystems.translate(sdlSubSystemMap));
   if(retVal < 0) throw Exception("SDL_InitSubSystem");
-  _sdlImpl->subSystemInitializationStatus.insert(subSystem);
+  _sdlImpl->subSystemInitializationStatus |= subSystems;
+}
+
+bool SDL::setVideoDriver(std::string_view driver) {
+  const std::string name { driver };
+  return SDL_SetHint(SDL_HINT_VIDEODRIVER, name.c_str()) == SDL_TRUE;
+}
+
+std::string_view SDL::getVideoDriver() {
+  const char* driver = SDL_GetCurrentVideoDriver();
+  return driver != nullptr ? driver : std::string_view {};
 }
 
 void delay_ms(uint32_t duration) {
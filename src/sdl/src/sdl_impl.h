@@ -3,8 +3,8 @@
 
 #include "sdl.h"
 #include "constexpr_map.h"
-
-#include <unordered_set>
+#include "flags.h"
+#include "memory_tracker.h"
 
 namespace sdl {
 
@@ -20,10 +20,10 @@ static constexpr vodden::Map<SDL::SubSystem, uint32_t, 9> sdlSubSystemMap {{
   { SDL::kVideo, SDL_INIT_VIDEO }
 }};
 
-class SDLImpl {
+class SDLImpl : public vodden::memory::Tracked<vodden::memory::Category::kOther> {
   friend SDL;
   private:
-    std::unordered_set<SDL::SubSystem> subSystemInitializationStatus {  };
+    vodden::Flags<SDL::SubSystem> subSystemInitializationStatus {  };
 };
 
 }
@@ -0,0 +1,67 @@
+#include <cstdint>
+#include <stdexcept>
+
+#include <SDL2/SDL.h>
+
+#include "exception.h"
+#include "rectangle_impl.h"
+#include "texture_impl.h"
+#include "streaming_texture.h"
+
+namespace sdl {
+
+//! @brief true if region lies within a width by height area at the origin; widened, as the edges may overflow
+static bool isWithin(const Rectangle& region, uint32_t width, uint32_t height) {
+  return uint64_t { region.getX() } + region.getWidth() <= width && uint64_t { region.getY() } + region.getHeight() <= height;
+}
+
+StreamingTexture::StreamingTexture(const Renderer& renderer, uint32_t width, uint32_t height, PixelFormat pixelFormat) :
+  Texture(renderer, pixelFormat, kStreaming, width, height) { }
+
+StreamingTexture::LockedPixels StreamingTexture::lock() {
+  return lock({ 0, 0, getWidth(), getHeight() });
+}
+
+StreamingTexture::LockedPixels StreamingTexture::lock(const Rectangle& region) {
+  // SDL doesn't clip the region, so the pixels handed back would run past the texture
+  if(!isWithin(region, getWidth(), getHeight())) throw std::invalid_argument("StreamingTexture::lock: the region isn't inside the texture.");
+  uint32_t format;
+  if( SDL_QueryTexture(_sdlTexture.get(), &format, nullptr, nullptr, nullptr) < 0 ) throw Exception("SDL_QueryTexture");
+
+  void* pixels;
+  int pitch;
+  if( SDL_LockTexture(_sdlTexture.get(), RectangleImpl::getSDLRect(region), &pixels, &pitch) < 0 ) throw Exception("SDL_LockTexture");
+
+  // the final row ends at the region's right edge rather than a full pitch later
+  const std::size_t rowBytes = std::size_t { region.getWidth() } * SDL_BYTESPERPIXEL(format);
+  const std::size_t size = region.getHeight() == 0 ? 0 : (region.getHeight() - 1) * static_cast<std::size_t>(pitch) + rowBytes;
+  return { { static_cast<std::byte*>(pixels), size }, static_cast<std::size_t>(pitch) };
+}
+
+void StreamingTexture::unlock() {
+  SDL_UnlockTexture(_sdlTexture.get());
+}
+
+void StreamingTexture::update(const Surface& surface, const Rectangle& destination) {
+  if(!isWithin(destination, getWidth(), getHeight())) throw std::invalid_argument("StreamingTexture::update: the destination isn't inside the texture.");
+  // SDL reads destination-sized rows from the surface, however small it is
+  if(!isWithin({ 0, 0, destination.getWidth(), destination.getHeight() }, surface.getWidth(), surface.getHeight())) {
+    throw std::invalid_argument("StreamingTexture::update: the surface is smaller than the destination.");
+  }
+  uint32_t format;
+  if( SDL_QueryTexture(_sdlTexture.get(), &format, nullptr, nullptr, nullptr) < 0 ) throw Exception("SDL_QueryTexture");
+
+  SDL_Surface* sdlSurface = surface._sdlSurface.get();
+  SDL_Surface* converted = nullptr;
+  if(sdlSurface->format->format != format) {
+    converted = SDL_ConvertSurfaceFormat(sdlSurface, format, 0);
+    if(converted == nullptr) throw Exception("SDL_ConvertSurfaceFormat");
+    sdlSurface = converted;
+  }
+
+  const int returnValue = SDL_UpdateTexture(_sdlTexture.get(), RectangleImpl::getSDLRect(destination), sdlSurface->pixels, sdlSurface->pitch);
+  if(converted != nullptr) SDL_FreeSurface(converted);
+  if( returnValue < 0 ) throw Exception("SDL_UpdateTexture");
+}
+
+}
@@ -1,35 +1,183 @@
 #include <SDL2/SDL.h>
 #include <SDL_image.h>
 
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include <memory_tracker.h>
+
 #include "exception.h"
 
-#include "surface_impl.h"
+#include "color_impl.h"
+#include "rectangle_impl.h"
 #include "surface.h"
+#include "texture_impl.h"
 
 namespace sdl {
 
+namespace {
+
+//! @brief whether pixels of sdlFormat are 32 bit with alpha in the top byte, as the blend kernel expects
+bool hasTopAlpha(uint32_t sdlFormat) {
+  return sdlFormat == SDL_PIXELFORMAT_ARGB8888 || sdlFormat == SDL_PIXELFORMAT_ABGR8888;
+}
+
+vodden::PixelView viewOf(SDL_Surface* sdlSurface) {
+  if(SDL_MUSTLOCK(sdlSurface) || sdlSurface->format->BytesPerPixel != 4) throw std::logic_error("Surface::getPixels: only unlocked 32 bit surfaces can be viewed.");
+  const std::span bytes { static_cast<std::byte*>(sdlSurface->pixels), static_cast<std::size_t>(sdlSurface->pitch) * static_cast<std::size_t>(sdlSurface->h) };
+  return { bytes, static_cast<uint32_t>(sdlSurface->w), static_cast<uint32_t>(sdlSurface->h), static_cast<uint32_t>(sdlSurface->pitch) };
+}
+
+//! @brief the bytes of pixels SDL allocated for the surface; none if they were handed to it
+uint64_t getPixelBytes(SDL_Surface* sdlSurface) noexcept {
+  if(sdlSurface->flags & SDL_PREALLOC) return 0;
+  return static_cast<uint64_t>(sdlSurface->pitch) * static_cast<uint64_t>(sdlSurface->h);
+}
+
+//! @brief count a surface just created against cpu-side texture memory, until SurfaceDeleter releases it
+void recordPixels(SDL_Surface* sdlSurface) {
+  vodden::memory::MemoryTracker::instance().record(vodden::memory::Category::kTextures, getPixelBytes(sdlSurface));
+}
+
+//! @brief the parts of source and destination which overlap once source is placed at x, y
+std::pair<vodden::ConstPixelView, vodden::PixelView> overlap(const vodden::ConstPixelView& source, const vodden::PixelView& destination, uint32_t x, uint32_t y) {
+  const uint32_t width = x < destination.width ? std::min(source.width, destination.width - x) : 0;
+  const uint32_t height = y < destination.height ? std::min(source.height, destination.height - y) : 0;
+  return {
+    source.region(0, 0, width, height),
+    destination.region(std::min(x, destination.width), std::min(y, destination.height), width, height)
+  };
+}
+
+}
+
+
+void detail::SurfaceDeleter::operator()(SDL_Surface* sdlSurface) const noexcept {
+  vodden::memory::MemoryTracker::instance().release(vodden::memory::Category::kTextures, getPixelBytes(sdlSurface));
+  SDL_FreeSurface(sdlSurface);
+}
 
-Surface::Surface(uint32_t width, uint32_t height, uint8_t depth, uint32_t redMask, uint32_t greenMask, uint32_t blueMask, uint32_t alphaMask) {
-  _surfaceImpl->_sdlSurface = SDL_CreateRGBSurface(0, width, height, depth, redMask, greenMask, blueMask, alphaMask);
-  if (_surfaceImpl->_sdlSurface == nullptr) throw Exception("SDL_CreateRGBSurface");
+Surface::Surface(uint32_t width, uint32_t height, uint8_t depth, uint32_t redMask, uint32_t greenMask, uint32_t blueMask, uint32_t alphaMask) :
+  _sdlSurface { SDL_CreateRGBSurface(0, width, height, depth, redMask, greenMask, blueMask, alphaMask) } {
+  if (!_sdlSurface) throw Exception("SDL_CreateRGBSurface");
+  recordPixels(_sdlSurface.get());
 }
 
-Surface::Surface(std::filesystem::path filePath) {
-  _surfaceImpl->_sdlSurface = IMG_Load(filePath.c_str());
+Surface::Surface(uint32_t width, uint32_t height) : _sdlSurface { SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32) } {
+  if (!_sdlSurface) throw Exception("SDL_CreateRGBSurfaceWithFormat");
+  recordPixels(_sdlSurface.get());
 }
 
-Surface::Surface(Surface&& other) noexcept : _surfaceImpl( std::move(other._surfaceImpl) ) {}
+Surface::Surface(std::filesystem::path filePath) : _sdlSurface { IMG_Load(filePath.c_str()) } {
+  if (!_sdlSurface) throw Exception("IMG_Load");
+  recordPixels(_sdlSurface.get());
+}
+
+Surface::Surface(const void* location, std::size_t size) : _sdlSurface { IMG_Load_RW(SDL_RWFromConstMem(location, size), 1) } {
+  if (!_sdlSurface) throw Exception("IMG_Load_RW");
+  recordPixels(_sdlSurface.get());
+}
+
+Surface::Surface(SDL_Surface* sdlSurface, const char* function) : _sdlSurface { sdlSurface } {
+  if (!_sdlSurface) throw Exception(function);
+  recordPixels(_sdlSurface.get());
+}
+
+Surface::Surface(Surface&& other) noexcept = default;
+
+Surface::~Surface() {}
+
+Surface &Surface::operator=(Surface &&other) noexcept = default;
+
+uint32_t Surface::getWidth() const {
+  return static_cast<uint32_t>(_sdlSurface.get()->w);
+}
+
+uint32_t Surface::getHeight() const {
+  return static_cast<uint32_t>(_sdlSurface.get()->h);
+}
+
+Surface::PixelFormat Surface::getPixelFormat() const {
+  const auto pixelFormat = sdlTexturePixelFormatMap.find(_sdlSurface.get()->format->format);
+  if(!pixelFormat) throw std::out_of_range("Surface::getPixelFormat: the surface's format is not one of Texture's.");
+  return *pixelFormat;
+}
+
+vodden::PixelView Surface::getPixels() {
+  return viewOf(_sdlSurface.get());
+}
+
+vodden::ConstPixelView Surface::getPixels() const {
+  return viewOf(_sdlSurface.get());
+}
+
+void Surface::blit(const Surface& source, uint32_t x, uint32_t y) {
+  SDL_Surface* sdlSource = source._sdlSurface.get();
+
+  SDL_BlendMode blendMode;
+  if(SDL_GetSurfaceBlendMode(sdlSource, &blendMode) < 0) throw Exception("SDL_GetSurfaceBlendMode");
+  if(SDL_SetSurfaceBlendMode(sdlSource, SDL_BLENDMODE_NONE) < 0) throw Exception("SDL_SetSurfaceBlendMode");
+
+  Rectangle destination { x, y, source.getWidth(), source.getHeight() };
+  const int returnValue = SDL_BlitSurface(sdlSource, nullptr, _sdlSurface.get(), RectangleImpl::getSDLRect(destination));
+  SDL_SetSurfaceBlendMode(sdlSource, blendMode);
+  if(returnValue < 0) throw Exception("SDL_BlitSurface");
+}
+
+void Surface::blend(const Surface& source, uint32_t x, uint32_t y) {
+  SDL_Surface* sdlSurface = _sdlSurface.get();
+  SDL_Surface* sdlSource = source._sdlSurface.get();
+  if(!hasTopAlpha(sdlSurface->format->format) || !hasTopAlpha(sdlSource->format->format)) throw std::invalid_argument("Surface::blend: both surfaces need alpha in the top byte.");
+
+  std::optional<Surface> converted;
+  if(sdlSource->format->format != sdlSurface->format->format) converted.emplace(source.convert(getPixelFormat()));
+  const auto [from, to] = overlap((converted ? *converted : source).getPixels(), getPixels(), x, y);
+  vodden::blendPremultiplied(from, to);
+}
+
+void Surface::blitColorKeyed(const Surface& source, uint32_t x, uint32_t y, const Color& key) {
+  SDL_Surface* sdlSurface = _sdlSurface.get();
+  const uint32_t sdlFormat = sdlSurface->format->format;
+  if(!hasTopAlpha(sdlFormat) && sdlFormat != SDL_PIXELFORMAT_RGB888) throw std::invalid_argument("Surface::blitColorKeyed: the surface must be 32 bit with any alpha in the top byte.");
+
+  std::optional<Surface> converted;
+  if(source._sdlSurface.get()->format->format != sdlFormat) converted.emplace(source.convert(getPixelFormat()));
+  const auto [from, to] = overlap((converted ? *converted : source).getPixels(), getPixels(), x, y);
+  vodden::copyColorKeyed(from, to, SDL_MapRGB(sdlSurface->format, key.getRed(), key.getGreen(), key.getBlue()));
+}
+
+void Surface::fill(const Color& color) {
+  SDL_Surface* sdlSurface = _sdlSurface.get();
+  const uint32_t pixel = SDL_MapRGBA(sdlSurface->format, color.getRed(), color.getGreen(), color.getBlue(), color.getAlpha());
+  if(SDL_FillRect(sdlSurface, nullptr, pixel) < 0) throw Exception("SDL_FillRect");
+}
+
+void Surface::fill(const Rectangle& area, const Color& color) {
+  SDL_Surface* sdlSurface = _sdlSurface.get();
+  const uint32_t pixel = SDL_MapRGBA(sdlSurface->format, color.getRed(), color.getGreen(), color.getBlue(), color.getAlpha());
+  if(SDL_FillRect(sdlSurface, RectangleImpl::getSDLRect(area), pixel) < 0) throw Exception("SDL_FillRect");
+}
+
+void Surface::premultiplyAlpha() {
+  if(!hasTopAlpha(_sdlSurface.get()->format->format)) throw std::invalid_argument("Surface::premultiplyAlpha: the surface needs alpha in the top byte.");
+  vodden::premultiplyAlpha(getPixels());
+}
 
-Surface::~Surface() {
-  if(_surfaceImpl->_sdlSurface != nullptr)
-    SDL_FreeSurface(_surfaceImpl->_sdlSurface);
+Surface Surface::convert(PixelFormat pixelFormat) const {
+  SDL_Surface* sdlSurface = _sdlSurface.get();
+  const uint32_t sdlFormat = sdlPixelFormatMap[pixelFormat];
+  if(hasTopAlpha(sdlFormat) && hasTopAlpha(sdlSurface->format->format) && sdlFormat != sdlSurface->format->format && !SDL_MUSTLOCK(sdlSurface)) {
+    Surface converted { SDL_CreateRGBSurfaceWithFormat(0, sdlSurface->w, sdlSurface->h, 32, sdlFormat), "SDL_CreateRGBSurfaceWithFormat" };
+    vodden::swapRedBlue(getPixels(), converted.getPixels());
+    return converted;
+  }
+  return Surface { SDL_ConvertSurfaceFormat(sdlSurface, sdlFormat, 0), "SDL_ConvertSurfaceFormat" };
 }
 
-Surface &Surface::operator=(Surface &&other) noexcept {
-  if(this == &other) return *this;
-  if(_surfaceImpl->_sdlSurface != nullptr) SDL_FreeSurface(_surfaceImpl->_sdlSurface);
-  _surfaceImpl = std::move(other._surfaceImpl);
-  return *this;
+void Surface::savePNG(const std::filesystem::path& filePath) const {
+  if(IMG_SavePNG(_sdlSurface.get(), filePath.c_str()) < 0) throw Exception("IMG_SavePNG");
 }
 
 }
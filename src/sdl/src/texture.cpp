@@ -1,48 +1,149 @@
 #include <SDL2/SDL.h>
 #include <SDL_image.h>
 
+#include <stdexcept>
+
+#include <memory_tracker.h>
+#include <profiler.h>
+
+#include "baked_image.h"
 #include "exception.h"
-#include "renderer_impl.h"
+#include "surface.h"
 #include "texture_impl.h"
 #include "texture.h"
 
 namespace sdl {
 
-Texture::Texture(const Renderer& renderer, std::filesystem::path filePath) : _textureImpl { std::make_unique<TextureImpl>() } {
-  _textureImpl->_sdlTexture = IMG_LoadTexture(renderer._rendererImpl->_sdlRenderer, filePath.c_str());
-  if  (_textureImpl->_sdlTexture == nullptr ) throw Exception("IMG_LoadTexture");
+namespace {
+
+//! @brief the video memory a texture is estimated to take, from its format and size
+uint64_t estimateVideoMemory(SDL_Texture* sdlTexture) noexcept {
+  uint32_t pixelFormat;
+  int width, height;
+  if( SDL_QueryTexture(sdlTexture, &pixelFormat, nullptr, &width, &height) < 0 ) return 0;
+  return uint64_t { SDL_BYTESPERPIXEL(pixelFormat) } * static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+}
+
+//! @brief count a texture just created against video memory, until TextureDeleter releases it
+void recordVideoMemory(SDL_Texture* sdlTexture) {
+  vodden::memory::MemoryTracker::instance().record(vodden::memory::Category::kVideoMemory, estimateVideoMemory(sdlTexture));
+}
+
 }
 
-Texture::Texture(const Renderer &renderer, const void *location, std::size_t size) : _textureImpl { std::make_unique<TextureImpl>() } {
+void detail::TextureDeleter::operator()(SDL_Texture* sdlTexture) const noexcept {
+  vodden::memory::MemoryTracker::instance().release(vodden::memory::Category::kVideoMemory, estimateVideoMemory(sdlTexture));
+  SDL_DestroyTexture(sdlTexture);
+}
+
+Texture::Texture(const Renderer& renderer, std::filesystem::path filePath) {
+  VODDEN_PROFILE_ZONE("Texture::load");
+  _sdlTexture.reset(IMG_LoadTexture(renderer._sdlRenderer.get(), filePath.c_str()));
+  if  (!_sdlTexture) throw Exception("IMG_LoadTexture");
+  recordVideoMemory(_sdlTexture.get());
+}
+
+Texture::Texture(const Renderer &renderer, const void *location, std::size_t size) {
+  VODDEN_PROFILE_ZONE("Texture::load");
   SDL_RWops* rwOps = SDL_RWFromConstMem(location, size);
   
-  _textureImpl->_sdlTexture = IMG_LoadTexture_RW(renderer._rendererImpl->_sdlRenderer, rwOps, 1);
-  if  (_textureImpl->_sdlTexture == nullptr ) throw Exception("IMG_LoadTexture");
+  _sdlTexture.reset(IMG_LoadTexture_RW(renderer._sdlRenderer.get(), rwOps, 1));
+  if  (!_sdlTexture) throw Exception("IMG_LoadTexture");
+  recordVideoMemory(_sdlTexture.get());
 }
 
-Texture::Texture(const Renderer &renderer, void *location, std::size_t size) : _textureImpl { std::make_unique<TextureImpl>() } {
+Texture::Texture(const Renderer &renderer, void *location, std::size_t size) {
+  VODDEN_PROFILE_ZONE("Texture::load");
   SDL_RWops* rwOps = SDL_RWFromMem(location, size);
   
-  _textureImpl->_sdlTexture = IMG_LoadTexture_RW(renderer._rendererImpl->_sdlRenderer, rwOps, 1);
-  if  (_textureImpl->_sdlTexture == nullptr ) throw Exception("IMG_LoadTexture");
+  _sdlTexture.reset(IMG_LoadTexture_RW(renderer._sdlRenderer.get(), rwOps, 1));
+  if  (!_sdlTexture) throw Exception("IMG_LoadTexture");
+  recordVideoMemory(_sdlTexture.get());
+}
+
+Texture::Texture(const Renderer &renderer, const Surface &surface) {
+  VODDEN_PROFILE_ZONE("Texture::load");
+  _sdlTexture.reset(SDL_CreateTextureFromSurface(renderer._sdlRenderer.get(), surface._sdlSurface.get()));
+  if  (!_sdlTexture) throw Exception("SDL_CreateTextureFromSurface");
+  recordVideoMemory(_sdlTexture.get());
 }
 
-Texture::Texture(Texture &&other) noexcept : _textureImpl { std::move(other._textureImpl) } { }
+Texture::Texture(const Renderer &renderer, Surface &&surface, BlendMode blendMode) {
+  VODDEN_PROFILE_ZONE("Texture::load");
+  if(blendMode == kPremultiplied) {
+    const auto pixelFormat = surface._sdlSurface.get()->format->format;
+    if(pixelFormat != SDL_PIXELFORMAT_ARGB8888 && pixelFormat != SDL_PIXELFORMAT_ABGR8888) surface = surface.convert(kABGR8888);
+    surface.premultiplyAlpha();
+  }
 
-Texture::~Texture() {
-  if(_textureImpl->_sdlTexture != nullptr) SDL_DestroyTexture(_textureImpl->_sdlTexture);
+  _sdlTexture.reset(SDL_CreateTextureFromSurface(renderer._sdlRenderer.get(), surface._sdlSurface.get()));
+  if  (!_sdlTexture) throw Exception("SDL_CreateTextureFromSurface");
+  recordVideoMemory(_sdlTexture.get());
+  setTextureBlendMode(blendMode);
 }
 
-Texture &Texture::operator=(Texture &&other) noexcept {
-  if(&other == this) return *this;
-  if(_textureImpl->_sdlTexture != nullptr) SDL_DestroyTexture(_textureImpl->_sdlTexture);
-  _textureImpl = std::move(other._textureImpl);
-  return *this;
+Texture::Texture(const Renderer &renderer, PixelFormat pixelFormat, Access access, uint32_t width, uint32_t height) {
+  _sdlTexture.reset(SDL_CreateTexture(
+    renderer._sdlRenderer.get(),
+    sdlPixelFormatMap[pixelFormat == kPreferred ? renderer.getPreferredPixelFormat() : pixelFormat],
+    sdlTextureAccessMap[access],
+    static_cast<int>(width),
+    static_cast<int>(height)
+  ));
+  if  (!_sdlTexture) throw Exception("SDL_CreateTexture");
+  recordVideoMemory(_sdlTexture.get());
+}
+
+Texture::Texture(const Renderer &renderer, const BakedImage &bakedImage) {
+  VODDEN_PROFILE_ZONE("Texture::load");
+  _sdlTexture.reset(SDL_CreateTexture(
+    renderer._sdlRenderer.get(),
+    bakedImage.getPixelFormat(),
+    SDL_TEXTUREACCESS_STATIC,
+    static_cast<int>(bakedImage.getWidth()),
+    static_cast<int>(bakedImage.getHeight())
+  ));
+  if  (!_sdlTexture) throw Exception("SDL_CreateTexture");
+  recordVideoMemory(_sdlTexture.get());
+
+  // _sdlTexture is destroyed with the rest of the partly built object if either of these throws
+  // match the blend mode IMG_LoadTexture gives images with an alpha channel
+  if( SDL_SetTextureBlendMode(_sdlTexture.get(), SDL_BLENDMODE_BLEND) < 0 ) throw Exception("SDL_SetTextureBlendMode");
+  if( SDL_UpdateTexture(_sdlTexture.get(), nullptr, bakedImage.getPixels().data(), static_cast<int>(bakedImage.getPitch())) < 0 ) {
+    throw Exception("SDL_UpdateTexture");
+  }
+}
+
+Texture::Texture(Texture &&other) noexcept = default;
+
+Texture::~Texture() {}
+
+Texture &Texture::operator=(Texture &&other) noexcept = default;
+
+uint32_t Texture::getWidth() const {
+  int width;
+  if( SDL_QueryTexture(_sdlTexture.get(), nullptr, nullptr, &width, nullptr) < 0 ) throw Exception("SDL_QueryTexture");
+  return static_cast<uint32_t>(width);
+}
+
+uint32_t Texture::getHeight() const {
+  int height;
+  if( SDL_QueryTexture(_sdlTexture.get(), nullptr, nullptr, nullptr, &height) < 0 ) throw Exception("SDL_QueryTexture");
+  return static_cast<uint32_t>(height);
 }
 
 void Texture::setTextureBlendMode(const BlendMode &blendMode) {
-  int returnValue = SDL_SetTextureBlendMode(_textureImpl->_sdlTexture, sdlBlendModeMap[blendMode]);
+  int returnValue = SDL_SetTextureBlendMode(_sdlTexture.get(), getSDLBlendMode(blendMode));
   if( returnValue < 0 ) throw Exception("SDL_SetTextureBlendMode");
 }
 
+Texture::BlendMode Texture::getTextureBlendMode() const {
+  SDL_BlendMode sdlBlendMode;
+  if( SDL_GetTextureBlendMode(_sdlTexture.get(), &sdlBlendMode) < 0 ) throw Exception("SDL_GetTextureBlendMode");
+  for(BlendMode blendMode = kNone; blendMode <= kPremultiplied; ++blendMode) {
+    if(getSDLBlendMode(blendMode) == sdlBlendMode) return blendMode;
+  }
+  throw std::out_of_range("Texture::getTextureBlendMode: the texture has a blend mode this library doesn't set.");
+}
+
 }
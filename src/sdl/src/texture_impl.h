@@ -3,6 +3,7 @@
 
 #include <SDL2/SDL.h>
 
+#include "constexpr_map.h"
 #include "renderer.h"
 #include "texture.h"
 
@@ -16,12 +17,39 @@ static constexpr vodden::Map<Texture::BlendMode, SDL_BlendMode, 5> sdlBlendModeM
     {Texture::kMul, SDL_BLENDMODE_MUL}
 }};
 
-class TextureImpl {
-  friend Renderer;
-  friend Texture;
-  private:
-    SDL_Texture* _sdlTexture;
-};
+//! @brief the SDL_BlendMode for blendMode; kPremultiplied is a custom mode, so it can't live in the map above
+inline SDL_BlendMode getSDLBlendMode(Texture::BlendMode blendMode) {
+  if(blendMode != Texture::kPremultiplied) return sdlBlendModeMap[blendMode];
+  static const SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+    SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+    SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD
+  );
+  return premultiplied;
+}
+
+static constexpr vodden::Map<Texture::PixelFormat, uint32_t, 6> sdlPixelFormatMap {{
+    {Texture::kARGB8888, SDL_PIXELFORMAT_ARGB8888},
+    {Texture::kRGBA8888, SDL_PIXELFORMAT_RGBA8888},
+    {Texture::kABGR8888, SDL_PIXELFORMAT_ABGR8888},
+    {Texture::kBGRA8888, SDL_PIXELFORMAT_BGRA8888},
+    {Texture::kRGB888, SDL_PIXELFORMAT_RGB888},
+    {Texture::kRGB24, SDL_PIXELFORMAT_RGB24}
+}};
+
+static constexpr vodden::Map<uint32_t, Texture::PixelFormat, 6> sdlTexturePixelFormatMap {{
+    {SDL_PIXELFORMAT_ARGB8888, Texture::kARGB8888},
+    {SDL_PIXELFORMAT_RGBA8888, Texture::kRGBA8888},
+    {SDL_PIXELFORMAT_ABGR8888, Texture::kABGR8888},
+    {SDL_PIXELFORMAT_BGRA8888, Texture::kBGRA8888},
+    {SDL_PIXELFORMAT_RGB888, Texture::kRGB888},
+    {SDL_PIXELFORMAT_RGB24, Texture::kRGB24}
+}};
+
+static constexpr vodden::Map<Texture::Access, int, 3> sdlTextureAccessMap {{
+    {Texture::kStatic, SDL_TEXTUREACCESS_STATIC},
+    {Texture::kStreaming, SDL_TEXTUREACCESS_STREAMING},
+    {Texture::kTarget, SDL_TEXTUREACCESS_TARGET}
+}};
 
 }
 
@@ -1,47 +1,198 @@
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <memory_tracker.h>
+
 #include "exception.h"
 #include "user_event_impl.h"
 
 namespace sdl {
 
-UserEvent::UserEvent() : 
-  Event( std::chrono::duration<int64_t, std::milli>(SDL_GetTicks64()) ),  
-  _userEventImpl{ std::make_unique<UserEventImpl>() } {
-    _userEventImpl->_userEvent = this;
-  };
+namespace detail {
 
-UserEvent::UserEvent( const UserEvent& other ) : 
-  Event( other.timestamp ), 
-  _userEventImpl( std::make_unique<UserEventImpl>(*other._userEventImpl)) {
-    _userEventImpl->_userEvent = this;
-  };
+std::size_t nextUserEventTypeIndex() {
+  // index 0 belongs to direct subclasses of BaseUserEvent
+  static std::atomic<std::size_t> nextIndex { 1 };
+  const std::size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+  if(index >= BaseUserEvent::kTypeCount) throw std::length_error("more UserEvent payload types than BaseUserEvent::kTypeCount");
+  return index;
+}
+
+uint32_t userEventType(std::size_t index) {
+  return UserEventImpl::getFirstEventType() + static_cast<uint32_t>(index);
+}
+
+}
 
-UserEvent::UserEvent( UserEvent&& other ) : 
-  Event( other.timestamp ), 
-  _userEventImpl( std::move(other._userEventImpl) ) {
-    _userEventImpl->_userEvent = this;
+BaseUserEvent::BaseUserEvent() : 
+  Event( std::chrono::duration<int64_t, std::milli>(SDL_GetTicks64()) ) {
+    UserEventImpl::getFirstEventType();
   };
 
-UserEvent::~UserEvent() {};
+void* BaseUserEvent::operator new(std::size_t size) {
+  void* pointer = UserEventImpl::allocateEvent(size);
+  if(pointer == nullptr) return BaseEvent::operator new(size);
+  vodden::memory::MemoryTracker::instance().record(vodden::memory::Category::kEvents, size);
+  return pointer;
+}
 
-UserEventImpl::UserEventImpl() {
-  if(! _eventType) {
-    _eventType = SDL_RegisterEvents(1);
-    if(_eventType == -1) throw Exception("SDL_RegisterEvents");
-  }
+void BaseUserEvent::operator delete(void* pointer, std::size_t size) noexcept {
+  if(!UserEventImpl::deallocateEvent(pointer)) return BaseEvent::operator delete(pointer, size);
+  vodden::memory::MemoryTracker::instance().release(vodden::memory::Category::kEvents, size);
 }
 
-std::unique_ptr<SDL_Event> UserEventImpl::_createSDLUserEvent()
-{
-  return std::unique_ptr<SDL_Event>(new SDL_Event{ .user={
-    *_eventType,
-    static_cast<uint32_t>(_userEvent->timestamp.count()),
+bool BaseUserEvent::push(std::unique_ptr<BaseUserEvent> userEvent) {
+  // filled in first, as once queued the event may be claimed and destroyed at any moment
+  SDL_Event sdlEvent;
+  sdlEvent.user = {
+    userEvent->getSDLEventType(),
+    static_cast<uint32_t>(userEvent->timestamp.count()),
     0,
     0,
-    _userEvent,
+    nullptr,
     nullptr
-  }});
+  };
+
+  const auto slot = UserEventImpl::acquireSlot(userEvent.get());
+  if(!slot) return false;
+  const auto [index, state] = *slot;
+  sdlEvent.user.data1 = reinterpret_cast<void*>(static_cast<std::uintptr_t>(index));
+  // the occupant's state, so that claiming an event whose slot has since been reclaimed finds nothing
+  sdlEvent.user.data2 = reinterpret_cast<void*>(static_cast<std::uintptr_t>(state));
+
+  UserEventImpl::Slot& eventSlot = UserEventImpl::_slots[index];
+  if(SDL_PushEvent(&sdlEvent) != 1) {
+    UserEventImpl::releaseSlot(eventSlot, state);
+    return false;
+  }
+  // the slot owns the event until the event loop claims it
+  userEvent.release();
+  // fails if the event has already been claimed, which is fine
+  uint32_t expected = state;
+  eventSlot.state.compare_exchange_strong(expected, (state & ~UserEventImpl::kStateMask) | UserEventImpl::kQueued,
+    std::memory_order_release, std::memory_order_relaxed);
+  return true;
+}
+
+void BaseUserEvent::flush() {
+  const uint32_t firstEventType = UserEventImpl::getFirstEventType();
+  SDL_FlushEvents(firstEventType, firstEventType + kTypeCount - 1);
+  UserEventImpl::reclaim();
+}
+
+uint32_t UserEventImpl::getFirstEventType() {
+  // events may be created on several threads at once
+  std::call_once(_reserveEventTypes, []() {
+    const uint32_t firstEventType = SDL_RegisterEvents(BaseUserEvent::kTypeCount);
+    if(firstEventType == static_cast<uint32_t>(-1)) throw Exception("SDL_RegisterEvents");
+    _firstEventType.store(firstEventType, std::memory_order_release);
+  });
+  return _firstEventType.load(std::memory_order_acquire);
+}
+
+bool UserEventImpl::isEventType(uint32_t type) {
+  const uint32_t firstEventType = _firstEventType.load(std::memory_order_acquire);
+  return firstEventType != 0 && type - firstEventType < BaseUserEvent::kTypeCount;
+}
+
+std::unique_ptr<BaseUserEvent> UserEventImpl::claim(const SDL_UserEvent* sdlUserEvent) {
+  const auto index = reinterpret_cast<std::uintptr_t>(sdlUserEvent->data1);
+  if(index >= _slots.size()) return nullptr;
+  Slot& slot = _slots[index];
+  const uint32_t state = slot.state.load(std::memory_order_acquire);
+  const auto pushedState = static_cast<uint32_t>(reinterpret_cast<std::uintptr_t>(sdlUserEvent->data2));
+  if((state & kStateMask) == kFree || (state & ~kStateMask) != (pushedState & ~kStateMask)) return nullptr;
+  return std::unique_ptr<BaseUserEvent>(releaseSlot(slot, state));
+}
+
+void UserEventImpl::reclaim() {
+  _reclaimRequested.store(false, std::memory_order_relaxed);
+  const uint32_t firstEventType = _firstEventType.load(std::memory_order_acquire);
+  if(firstEventType == 0) return;
+
+  // taken before peeking, so that every slot still queued was in the queue when it was peeked at, unless SDL dropped it
+  std::vector<uint32_t> queuedStates(_slots.size(), kFree);
+  for(std::size_t index = 0; index < _slots.size(); ++index) {
+    const uint32_t state = _slots[index].state.load(std::memory_order_acquire);
+    if((state & kStateMask) == kQueued) queuedStates[index] = state;
+  }
+
+  std::vector<SDL_Event> sdlEvents(_slots.size());
+  const int peeked = SDL_PeepEvents(sdlEvents.data(), static_cast<int>(sdlEvents.size()), SDL_PEEKEVENT,
+    firstEventType, firstEventType + BaseUserEvent::kTypeCount - 1);
+  if(peeked < 0) return;
+  for(int i = 0; i < peeked; ++i) {
+    const auto index = reinterpret_cast<std::uintptr_t>(sdlEvents[i].user.data1);
+    const auto pushedState = static_cast<uint32_t>(reinterpret_cast<std::uintptr_t>(sdlEvents[i].user.data2));
+    if(index < queuedStates.size() && (queuedStates[index] & ~kStateMask) == (pushedState & ~kStateMask)) queuedStates[index] = kFree;
+  }
+
+  // a queued slot only changes hands on this thread, so each still holds the event that was dropped
+  for(std::size_t index = 0; index < _slots.size(); ++index) {
+    if(queuedStates[index] != kFree) delete releaseSlot(_slots[index], queuedStates[index]);
+  }
+}
+
+void UserEventImpl::reclaimIfRequested() {
+  if(_reclaimRequested.load(std::memory_order_relaxed)) reclaim();
+}
+
+void UserEventImpl::reclaimAll() {
+  for(Slot& slot : _slots) {
+    const uint32_t state = slot.state.load(std::memory_order_acquire);
+    if((state & kStateMask) == kQueued) delete releaseSlot(slot, state);
+  }
+}
+
+std::optional<std::pair<std::size_t, uint32_t>> UserEventImpl::acquireSlot(BaseUserEvent* userEvent) {
+  for(std::size_t attempt = 0; attempt < _slots.size(); ++attempt) {
+    const std::size_t index = _nextSlot.fetch_add(1, std::memory_order_relaxed) % _slots.size();
+    Slot& slot = _slots[index];
+    uint32_t state = slot.state.load(std::memory_order_relaxed);
+    if((state & kStateMask) != kFree) continue;
+    const uint32_t pushing = state | kPushing;
+    if(slot.state.compare_exchange_strong(state, pushing, std::memory_order_acquire, std::memory_order_relaxed)) {
+      slot.event.store(userEvent, std::memory_order_release);
+      return std::pair { index, pushing };
+    }
+  }
+  // the event loop frees the slots of any events SDL has dropped
+  _reclaimRequested.store(true, std::memory_order_relaxed);
+  return std::nullopt;
+}
+
+BaseUserEvent* UserEventImpl::releaseSlot(Slot& slot, uint32_t state) {
+  BaseUserEvent* userEvent = slot.event.exchange(nullptr, std::memory_order_acquire);
+  slot.state.store((state & ~kStateMask) + kGeneration, std::memory_order_release);
+  return userEvent;
+}
+
+void* UserEventImpl::allocateEvent(std::size_t size) {
+  if(size > BaseUserEvent::kPooledEventSize) return nullptr;
+  for(std::size_t attempt = 0; attempt < _eventStorage.size(); ++attempt) {
+    const std::size_t index = _nextEventStorage.fetch_add(1, std::memory_order_relaxed) % _eventStorage.size();
+    std::atomic<bool>& used = _eventStorageUsed[index];
+    if(!used.load(std::memory_order_relaxed) && !used.exchange(true, std::memory_order_acquire)) return _eventStorage[index].bytes;
+  }
+  return nullptr;
+}
+
+bool UserEventImpl::deallocateEvent(void* pointer) {
+  const auto address = reinterpret_cast<std::uintptr_t>(pointer);
+  const auto first = reinterpret_cast<std::uintptr_t>(_eventStorage.data());
+  if(address < first || address >= first + sizeof(_eventStorage)) return false;
+  _eventStorageUsed[(address - first) / sizeof(EventStorage)].store(false, std::memory_order_release);
+  return true;
 }
 
 
-std::optional<uint32_t> UserEventImpl::_eventType = std::nullopt;
+std::atomic<uint32_t> UserEventImpl::_firstEventType { 0 };
+std::once_flag UserEventImpl::_reserveEventTypes;
+std::array<UserEventImpl::Slot, BaseUserEvent::kSlotCount> UserEventImpl::_slots {};
+std::atomic<std::size_t> UserEventImpl::_nextSlot { 0 };
+std::atomic<bool> UserEventImpl::_reclaimRequested { false };
+std::array<UserEventImpl::EventStorage, BaseUserEvent::kSlotCount> UserEventImpl::_eventStorage;
+std::array<std::atomic<bool>, BaseUserEvent::kSlotCount> UserEventImpl::_eventStorageUsed {};
+std::atomic<std::size_t> UserEventImpl::_nextEventStorage { 0 };
 }
@@ -3,23 +3,90 @@
 
 #include <SDL2/SDL.h>
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <utility>
 
 #include "user_event.h"
 
 namespace sdl {
 
-class UserEvent;
-
 class UserEventImpl {
-  friend UserEvent;
+  friend BaseUserEvent;
   public:
-    UserEventImpl();
-    std::unique_ptr<SDL_Event> _createSDLUserEvent();
-  
+    //! @brief the first of the SDL event types reserved for user events, reserving them on first use
+    static uint32_t getFirstEventType();
+    //! @brief true if type is one of the user event types, without reserving them
+    static bool isEventType(uint32_t type);
+
+    //! @brief takes the event out of the slot named by a pushed SDL_UserEvent
+    static std::unique_ptr<BaseUserEvent> claim(const SDL_UserEvent* sdlUserEvent);
+
+    /**
+     * @brief free the slots of events which are no longer in the SDL queue.
+     *
+     * SDL drops queued events without telling anyone when they are flushed
+     * or the events subsystem shuts down, so the slots holding them have to
+     * be found by peeking at the queue. Only the thread which takes events
+     * off the queue may call this, as an event it has taken off but not yet
+     * claimed would look dropped.
+     */
+    static void reclaim();
+    //! @brief reclaim, if a push has found every slot taken since the last reclaim
+    static void reclaimIfRequested();
+    //! @brief free every queued slot, once the events subsystem is shut down and so nothing can claim them
+    static void reclaimAll();
+
   private:
-    static std::optional<uint32_t> _eventType;
-    UserEvent* _userEvent;
+    //! @brief the low bits of a slot's state; the rest count its occupants, so that a stale state never matches
+    enum SlotState : uint32_t {
+      kFree = 0,
+      // taken by a push which hasn't reached the SDL queue yet
+      kPushing = 1,
+      kQueued = 2,
+      kStateMask = 3,
+      kGeneration = 4
+    };
+
+    struct Slot {
+      std::atomic<BaseUserEvent*> event { nullptr };
+      std::atomic<uint32_t> state { kFree };
+    };
+
+    //! @brief take a free slot for userEvent, returning its index and the state it now has
+    static std::optional<std::pair<std::size_t, uint32_t>> acquireSlot(BaseUserEvent* userEvent);
+    //! @brief empty a slot, returning the event it held
+    static BaseUserEvent* releaseSlot(Slot& slot, uint32_t state);
+
+    //! @brief storage from the event pool for size bytes, or nullptr if it is too large or the pool is used up
+    static void* allocateEvent(std::size_t size);
+    //! @brief true, returning pointer to the event pool, if it came from there
+    static bool deallocateEvent(void* pointer);
+
+    // 0 until reserved, as SDL never hands out SDL_FIRSTEVENT
+    static std::atomic<uint32_t> _firstEventType;
+    static std::once_flag _reserveEventTypes;
+    // each slot holds a pushed event until the event loop claims it
+    static std::array<Slot, BaseUserEvent::kSlotCount> _slots;
+    // where the next search for a free slot starts, so that pushes rarely collide
+    static std::atomic<std::size_t> _nextSlot;
+    static std::atomic<bool> _reclaimRequested;
+
+    struct alignas(std::max_align_t) EventStorage {
+      std::byte bytes[BaseUserEvent::kPooledEventSize];
+    };
+    /*
+     * Events are built on the pushing thread and destroyed on the event
+     * loop's, so a thread local free list would never get them back; this
+     * pool is shared, each block free unless its flag is set.
+     */
+    static std::array<EventStorage, BaseUserEvent::kSlotCount> _eventStorage;
+    static std::array<std::atomic<bool>, BaseUserEvent::kSlotCount> _eventStorageUsed;
+    static std::atomic<std::size_t> _nextEventStorage;
 };
 
 }
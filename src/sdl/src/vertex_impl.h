@@ -0,0 +1,33 @@
+#ifndef __SDL_VERTEX_IMPL_H__
+#define __SDL_VERTEX_IMPL_H__
+
+#include <SDL2/SDL.h>
+
+#include <cstddef>
+#include <type_traits>
+
+#include "vertex.h"
+
+namespace sdl {
+
+//! @brief gives the library access to a Vertex as the SDL_Vertex it is laid out as.
+class VertexImpl {
+  public:
+    static const SDL_Vertex* getSDLVertices(const Vertex* vertices) {
+      return reinterpret_cast<const SDL_Vertex*>(vertices);
+    };
+
+    static_assert(std::is_trivially_copyable_v<Vertex>);
+    static_assert(std::is_standard_layout_v<Vertex>);
+    static_assert(sizeof(Vertex) == sizeof(SDL_Vertex));
+    static_assert(alignof(Vertex) == alignof(SDL_Vertex));
+    static_assert(offsetof(Vertex, x) == offsetof(SDL_Vertex, position.x));
+    static_assert(offsetof(Vertex, y) == offsetof(SDL_Vertex, position.y));
+    static_assert(offsetof(Vertex, color) == offsetof(SDL_Vertex, color));
+    static_assert(offsetof(Vertex, u) == offsetof(SDL_Vertex, tex_coord.x));
+    static_assert(offsetof(Vertex, v) == offsetof(SDL_Vertex, tex_coord.y));
+};
+
+}
+
+#endif
@@ -10,40 +10,42 @@
 
 namespace sdl {
 
+void detail::WindowDeleter::operator()(SDL_Window* sdlWindow) const noexcept {
+  SDL_DestroyWindow(sdlWindow);
+}
+
 Window::Window(
   std::string title, 
   uint16_t x, 
   uint16_t y, 
   uint16_t width, 
   uint16_t height, 
-  uint32_t flags
-): _title { std::move(title) }, _windowImpl { std::make_unique<WindowImpl>() } {
-
-    _windowImpl->_sdlWindow = SDL_CreateWindow(_title.c_str(), x, y, width, height, flags);
-    if (_windowImpl->_sdlWindow == nullptr) throw Exception( "SDL_CreateWindow" );
+  vodden::Flags<WindowFlag> flags
+): _title { std::move(title) }, _sdlWindow { SDL_CreateWindow(_title.c_str(), x, y, width, height, flags.translate(sdlWindowFlagMap)) } {
+    if (!_sdlWindow) throw Exception( "SDL_CreateWindow" );
 }
 
-Window::Window(Window&& other) noexcept : _windowImpl { std::move(other._windowImpl ) } { }
+Window::Window(Window&& other) noexcept = default;
 
-Window::~Window() {
-  if(_windowImpl->_sdlWindow != nullptr) SDL_DestroyWindow( _windowImpl->_sdlWindow );
-}
+Window::~Window() {}
 
-Window& Window::operator=(Window &&other) noexcept {
-  if(&other == this) return *this;
-  if(_windowImpl->_sdlWindow != nullptr) SDL_DestroyWindow( _windowImpl->_sdlWindow );
-  _windowImpl = std::move(other._windowImpl);
-  return *this;
-}
+Window& Window::operator=(Window &&other) noexcept = default;
 
 std::string_view Window::getTitle()
 {
-  return std::string_view(SDL_GetWindowTitle( _windowImpl->_sdlWindow ));
+  return std::string_view(SDL_GetWindowTitle( _sdlWindow.get() ));
 }
 
 void Window::setTitle(std::string newTitle)
 {
-  SDL_SetWindowTitle(_windowImpl->_sdlWindow, newTitle.c_str());
+  SDL_SetWindowTitle(_sdlWindow.get(), newTitle.c_str());
+}
+
+Window::WindowId Window::getId() const
+{
+  const WindowId windowId = SDL_GetWindowID(_sdlWindow.get());
+  if(windowId == 0) throw Exception("SDL_GetWindowID");
+  return windowId;
 }
 
 }
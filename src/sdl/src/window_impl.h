@@ -3,18 +3,24 @@
 
 #include <SDL2/SDL.h>
 
-namespace sdl {
-
-class Window;
-class Renderer;
+#include "constexpr_map.h"
+#include "window.h"
 
-class WindowImpl {
-  friend Window;
-  friend Renderer;
+namespace sdl {
 
-  private:
-    SDL_Window *_sdlWindow { nullptr };
-};
+static constexpr vodden::Map<Window::WindowFlag, uint32_t, 11> sdlWindowFlagMap {{
+    {Window::kFullscreen, SDL_WINDOW_FULLSCREEN},
+    {Window::kFullscreenDesktop, SDL_WINDOW_FULLSCREEN_DESKTOP},
+    {Window::kOpenGL, SDL_WINDOW_OPENGL},
+    {Window::kVulkan, SDL_WINDOW_VULKAN},
+    {Window::kMetal, SDL_WINDOW_METAL},
+    {Window::kHidden, SDL_WINDOW_HIDDEN},
+    {Window::kBorderless, SDL_WINDOW_BORDERLESS},
+    {Window::kResizable, SDL_WINDOW_RESIZABLE},
+    {Window::kMinimized, SDL_WINDOW_MINIMIZED},
+    {Window::kMaximized, SDL_WINDOW_MAXIMIZED},
+    {Window::kAllowHighDPI, SDL_WINDOW_ALLOW_HIGHDPI}
+}};
 
 }
 
@@ -0,0 +1,62 @@
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <baked_image.h>
+
+namespace {
+
+std::vector<std::byte> bake(uint32_t width, uint32_t height, std::vector<sdl::BakedRegion> regions) {
+  const uint32_t pixelOffset = 64;
+  const sdl::BakedImageHeader header {
+    sdl::BakedImage::kMagic, sdl::BakedImage::kVersion, 0,
+    width, height, width * 4, static_cast<uint32_t>(regions.size()), pixelOffset
+  };
+  std::vector<std::byte> blob(pixelOffset + width * 4 * height);
+  std::memcpy(blob.data(), &header, sizeof(header));
+  std::memcpy(blob.data() + sizeof(header), regions.data(), regions.size() * sizeof(sdl::BakedRegion));
+  return blob;
+}
+
+}
+
+TEST(BakedImageTest, readsTheHeaderAndRegions) {
+  const auto blob = bake(8, 4, { { 0, 0, 4, 4 }, { 4, 0, 4, 2 } });
+  const sdl::BakedImage bakedImage { blob };
+
+  ASSERT_EQ(bakedImage.getWidth(), 8u);
+  ASSERT_EQ(bakedImage.getHeight(), 4u);
+  ASSERT_EQ(bakedImage.getPixels().size(), 8u * 4 * 4);
+  ASSERT_EQ(bakedImage.getPixels().data(), blob.data() + 64);
+  ASSERT_EQ(bakedImage.getRegionCount(), 2u);
+  ASSERT_EQ(bakedImage.getRegion(1).getX(), 4u);
+  ASSERT_EQ(bakedImage.getRegion(1).getHeight(), 2u);
+  ASSERT_THROW(bakedImage.getRegion(2), std::out_of_range);
+}
+
+TEST(BakedImageTest, rejectsTruncatedOrForeignData) {
+  auto blob = bake(8, 4, { { 0, 0, 8, 4 } });
+  ASSERT_THROW(sdl::BakedImage(std::span { blob.data(), blob.size() - 1 }), std::invalid_argument);
+
+  blob[0] = std::byte { 0 };
+  ASSERT_THROW(sdl::BakedImage { blob }, std::invalid_argument);
+}
+
+TEST(BakedImageTest, rejectsRowsShorterThanTheWidth) {
+  auto blob = bake(8, 4, { { 0, 0, 8, 4 } });
+  sdl::BakedImageHeader header;
+  std::memcpy(&header, blob.data(), sizeof(header));
+  header.pitch = 8 * 4 - 1;
+  std::memcpy(blob.data(), &header, sizeof(header));
+  ASSERT_THROW(sdl::BakedImage { blob }, std::invalid_argument);
+}
+
+TEST(BakedImageTest, rejectsRegionsOutsideTheImage) {
+  ASSERT_THROW(sdl::BakedImage { bake(8, 4, { { 0, 0, 8, 4 }, { 4, 0, 5, 2 } }) }, std::invalid_argument);
+  ASSERT_THROW(sdl::BakedImage { bake(8, 4, { { 0, 3, 1, 2 } }) }, std::invalid_argument);
+  // wide enough that x + width wraps around in 32 bits
+  ASSERT_THROW(sdl::BakedImage { bake(8, 4, { { 4, 0, 0xfffffffeu, 1 } }) }, std::invalid_argument);
+  ASSERT_NO_THROW(sdl::BakedImage { bake(8, 4, { { 8, 4, 0, 0 } }) });
+}
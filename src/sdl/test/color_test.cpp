@@ -0,0 +1,33 @@
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <color.h>
+#include <texture.h>
+
+using sdl::Color;
+using sdl::Texture;
+
+TEST(ColorTest, convertsToAndFromPackedPixels) {
+  constexpr Color color { 0x11, 0x22, 0x33, 0x44 };
+  static_assert(color.toPixel(Texture::kARGB8888) == 0x44112233);
+  static_assert(Color::fromPixel(0x44112233, Texture::kARGB8888) == color);
+  // formats with no alpha read back as opaque
+  static_assert(Color::fromPixel(color.toPixel(Texture::kRGB888), Texture::kRGB888) == Color { 0x11, 0x22, 0x33, 0xff });
+  ASSERT_THROW(color.toPixel(Texture::kRGB24), std::invalid_argument);
+}
+
+TEST(ColorTest, bulkConversionMatchesPerColor) {
+  const std::array<Color, 3> colors { Color { 1, 2, 3, 4 }, Color { 0xff, 0x80, 0x00, 0xff }, Color { 0, 0, 0, 0 } };
+  for(const Texture::PixelFormat pixelFormat : { Texture::kARGB8888, Texture::kRGBA8888, Texture::kABGR8888, Texture::kBGRA8888 }) {
+    std::array<uint32_t, 3> pixels {};
+    Color::toPixels(colors, pixels, pixelFormat);
+    for(std::size_t i = 0; i < colors.size(); ++i) ASSERT_EQ(pixels[i], colors[i].toPixel(pixelFormat));
+
+    std::array<Color, 3> readBack {};
+    Color::fromPixels(pixels, readBack, pixelFormat);
+    ASSERT_EQ(readBack, colors);
+  }
+}
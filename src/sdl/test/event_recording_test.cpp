@@ -0,0 +1,88 @@
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <event.h>
+#include <event_recording.h>
+
+using namespace sdl;
+
+namespace {
+
+//! @brief hands out a fixed list of events, then nothing
+class ListEventProducer : public BaseEventProducer {
+  public:
+    virtual std::unique_ptr<BaseEvent> wait() { return poll(); };
+    virtual std::unique_ptr<BaseEvent> poll() {
+      switch(_next++) {
+        case 0: return std::make_unique<MouseMotionEvent>(std::chrono::milliseconds(10), 1, 0, -5, 7, -2, 3, 1);
+        case 1: return std::make_unique<KeyboardEvent>(std::chrono::milliseconds(12), 1, 'a', 4, 1, KeyboardEvent::State::kPressed, true);
+        case 2: return std::make_unique<Event>(std::chrono::duration<uint64_t, std::milli>(13));
+        case 3: return std::make_unique<MouseButtonEvent>(
+          std::chrono::milliseconds(15), 1, 0, 64, 32, MouseButtonEvent::Button::kRight, MouseButtonEvent::State::kReleased, 2
+        );
+        default: return nullptr;
+      }
+    };
+
+  private:
+    int _next { 0 };
+};
+
+}
+
+TEST(EventRecordingTest, replaysRecordedEvents) {
+  ListEventProducer listEventProducer;
+  std::stringstream log;
+  RecordingEventProducer recordingEventProducer { listEventProducer, log };
+  std::vector<std::unique_ptr<BaseEvent>> events(8);
+  ASSERT_EQ(recordingEventProducer.drain(events), 4u);
+  // the plain Event has no record, so is passed on but not written
+  ASSERT_EQ(recordingEventProducer.getRecordedCount(), 3u);
+
+  ReplayEventProducer replayEventProducer { log };
+  ASSERT_EQ(replayEventProducer.size(), 3u);
+
+  const auto motion = replayEventProducer.poll();
+  const auto* mouseMotionEvent = dynamic_cast<const MouseMotionEvent*>(motion.get());
+  ASSERT_NE(mouseMotionEvent, nullptr);
+  ASSERT_EQ(mouseMotionEvent->timestamp.count(), 10u);
+  ASSERT_EQ(mouseMotionEvent->x, -5);
+  ASSERT_EQ(mouseMotionEvent->relativeX, -2);
+  ASSERT_EQ(mouseMotionEvent->buttons, 1u);
+
+  const auto key = replayEventProducer.poll();
+  const auto* keyboardEvent = dynamic_cast<const KeyboardEvent*>(key.get());
+  ASSERT_NE(keyboardEvent, nullptr);
+  ASSERT_EQ(keyboardEvent->keyCode, 'a');
+  ASSERT_TRUE(keyboardEvent->repeat);
+
+  const auto button = replayEventProducer.poll();
+  const auto* mouseButtonEvent = dynamic_cast<const MouseButtonEvent*>(button.get());
+  ASSERT_NE(mouseButtonEvent, nullptr);
+  ASSERT_EQ(mouseButtonEvent->button, MouseButtonEvent::Button::kRight);
+  ASSERT_EQ(mouseButtonEvent->clicks, 2u);
+
+  ASSERT_TRUE(replayEventProducer.isFinished());
+  ASSERT_EQ(replayEventProducer.poll(), nullptr);
+  ASSERT_NE(dynamic_cast<const QuitEvent*>(replayEventProducer.wait().get()), nullptr);
+
+  replayEventProducer.rewind();
+  ASSERT_NE(dynamic_cast<const MouseMotionEvent*>(replayEventProducer.wait().get()), nullptr);
+}
+
+TEST(EventRecordingTest, rejectsBrokenLogs) {
+  ListEventProducer listEventProducer;
+  std::stringstream log;
+  RecordingEventProducer recordingEventProducer { listEventProducer, log };
+  recordingEventProducer.poll();
+
+  std::string bytes = log.str();
+  std::istringstream truncated { bytes.substr(0, bytes.size() - 1) };
+  ASSERT_THROW(ReplayEventProducer { truncated }, std::invalid_argument);
+  std::istringstream garbage { "not a log" };
+  ASSERT_THROW(ReplayEventProducer { garbage }, std::invalid_argument);
+}
@@ -0,0 +1,144 @@
+#include <array>
+#include <cstring>
+#include <memory>
+
+#include <gtest/gtest.h>
+#include <SDL2/SDL.h>
+
+#include <event.h>
+#include <sdl.h>
+#include <user_event.h>
+
+using namespace sdl;
+
+static void pushMotion(int32_t x, int32_t y, int32_t xrel, int32_t yrel) {
+  SDL_Event sdlEvent {};
+  sdlEvent.motion.type = SDL_MOUSEMOTION;
+  sdlEvent.motion.x = x;
+  sdlEvent.motion.y = y;
+  sdlEvent.motion.xrel = xrel;
+  sdlEvent.motion.yrel = yrel;
+  SDL_PushEvent(&sdlEvent);
+}
+
+static void pushButton() {
+  SDL_Event sdlEvent {};
+  sdlEvent.button.type = SDL_MOUSEBUTTONDOWN;
+  sdlEvent.button.button = SDL_BUTTON_LEFT;
+  sdlEvent.button.state = SDL_PRESSED;
+  SDL_PushEvent(&sdlEvent);
+}
+
+TEST(EventProducerTest, coalescesConsecutiveMotion) {
+  SDL sdl;
+  sdl.initSubSystem(SDL::kEvents);
+  SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+  pushMotion(1, 1, 1, 1);
+  pushMotion(3, 2, 2, 1);
+  pushButton();
+  pushMotion(6, 4, 3, 2);
+
+  EventProducer eventProducer { EventProducer::MotionPolicy::kCoalesce };
+  std::array<std::unique_ptr<BaseEvent>, 8> events;
+  ASSERT_EQ(eventProducer.drain(events), 3u);
+
+  const auto* motion = dynamic_cast<const MouseMotionEvent*>(events[0].get());
+  ASSERT_NE(motion, nullptr);
+  ASSERT_EQ(motion->x, 3);
+  ASSERT_EQ(motion->relativeX, 3);
+  ASSERT_EQ(motion->relativeY, 2);
+  ASSERT_NE(dynamic_cast<const MouseButtonEvent*>(events[1].get()), nullptr);
+  ASSERT_NE(dynamic_cast<const MouseMotionEvent*>(events[2].get()), nullptr);
+}
+
+TEST(EventProducerTest, keepsEveryMotionByDefault) {
+  SDL sdl;
+  sdl.initSubSystem(SDL::kEvents);
+  SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+  pushMotion(1, 1, 1, 1);
+  pushMotion(3, 2, 2, 1);
+
+  EventProducer eventProducer;
+  std::array<std::unique_ptr<BaseEvent>, 8> events;
+  ASSERT_EQ(eventProducer.drain(events), 2u);
+}
+
+TEST(EventProducerTest, wrapsUnknownEventsInsteadOfThrowing) {
+  SDL sdl;
+  sdl.initSubSystem(SDL::kEvents);
+  SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+  SDL_Event sdlEvent {};
+  sdlEvent.window.type = SDL_WINDOWEVENT;
+  sdlEvent.window.windowID = 7;
+  SDL_PushEvent(&sdlEvent);
+
+  EventProducer eventProducer;
+  const auto event = eventProducer.wait();
+  const auto* rawEvent = dynamic_cast<const RawEvent*>(event.get());
+  ASSERT_NE(rawEvent, nullptr);
+  ASSERT_EQ(rawEvent->type, SDL_WINDOWEVENT);
+
+  SDL_Event copy;
+  std::memcpy(&copy, rawEvent->data.data(), RawEvent::kSize);
+  ASSERT_EQ(copy.window.windowID, 7u);
+}
+
+class CountEvent : public BaseUserEvent {
+  public:
+    CountEvent(int count) : count { count } {};
+    virtual EventTypeId typeId() const override { return eventTypeId<CountEvent>(); };
+    int count;
+};
+
+TEST(EventProducerTest, returnsPushedUserEvents) {
+  SDL sdl;
+  sdl.initSubSystem(SDL::kEvents);
+  SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+  ASSERT_TRUE(BaseUserEvent::push(std::make_unique<CountEvent>(42)));
+
+  EventProducer eventProducer;
+  const auto event = eventProducer.wait();
+  const auto* countEvent = dynamic_cast<const CountEvent*>(event.get());
+  ASSERT_NE(countEvent, nullptr);
+  ASSERT_EQ(countEvent->count, 42);
+}
+
+struct Tick { uint64_t frame; };
+struct Score { int points; };
+
+TEST(EventProducerTest, givesEachPayloadItsOwnEventType) {
+  SDL sdl;
+  sdl.initSubSystem(SDL::kEvents);
+  SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+  ASSERT_NE(UserEvent<Tick>::sdlEventType(), UserEvent<Score>::sdlEventType());
+  ASSERT_TRUE(BaseUserEvent::push(std::make_unique<UserEvent<Score>>(7)));
+  ASSERT_TRUE(SDL_HasEvent(UserEvent<Score>::sdlEventType()));
+  ASSERT_FALSE(SDL_HasEvent(UserEvent<Tick>::sdlEventType()));
+
+  EventProducer eventProducer;
+  const auto event = eventProducer.wait();
+  ASSERT_EQ(event->typeId(), eventTypeId<UserEvent<Score>>());
+  ASSERT_EQ(static_cast<const UserEvent<Score>&>(*event).payload.points, 7);
+}
+
+TEST(EventProducerTest, freesTheSlotsOfDroppedUserEvents) {
+  SDL sdl;
+  sdl.initSubSystem(SDL::kEvents);
+  SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+  for(std::size_t i = 0; i < BaseUserEvent::kSlotCount; ++i) ASSERT_TRUE(BaseUserEvent::push(std::make_unique<CountEvent>(0)));
+  ASSERT_FALSE(BaseUserEvent::push(std::make_unique<CountEvent>(0)));
+
+  BaseUserEvent::flush();
+  ASSERT_TRUE(BaseUserEvent::push(std::make_unique<CountEvent>(1)));
+  EventProducer eventProducer;
+  const auto event = eventProducer.wait();
+  const auto* countEvent = dynamic_cast<const CountEvent*>(event.get());
+  ASSERT_NE(countEvent, nullptr);
+  ASSERT_EQ(countEvent->count, 1);
+}
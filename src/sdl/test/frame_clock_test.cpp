@@ -0,0 +1,50 @@
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include <frame_clock.h>
+
+using namespace std::chrono_literals;
+using sdl::FrameClock;
+using sdl::FrameStatistics;
+
+TEST(FrameStatisticsTest, reportsPercentilesOfTheWindow) {
+  FrameStatistics statistics;
+  ASSERT_EQ(statistics.getMedian(), 0ns);
+
+  for(int i = 1; i <= 100; ++i) statistics.record(std::chrono::milliseconds(i));
+  ASSERT_EQ(statistics.size(), 100u);
+  ASSERT_EQ(statistics.getPercentile(0.0), 1ms);
+  ASSERT_EQ(statistics.getPercentile(1.0), 100ms);
+  ASSERT_EQ(statistics.getMedian(), 51ms);
+  ASSERT_EQ(statistics.getP99(), 99ms);
+  ASSERT_EQ(statistics.getMean(), 50500us);
+}
+
+TEST(FrameStatisticsTest, forgetsFramesOutsideTheWindow) {
+  FrameStatistics statistics;
+  for(std::size_t i = 0; i < FrameStatistics::kWindowSize; ++i) statistics.record(100ms);
+  for(std::size_t i = 0; i < FrameStatistics::kWindowSize; ++i) statistics.record(1ms);
+
+  ASSERT_EQ(statistics.size(), FrameStatistics::kWindowSize);
+  ASSERT_EQ(statistics.getPercentile(1.0), 1ms);
+}
+
+TEST(FrameClockTest, stepsThroughAGivenFrameTime) {
+  FrameClock frameClock { 10ms, 10ms };
+
+  frameClock.beginFrame(25ms);
+  ASSERT_EQ(frameClock.getFrameTime(), 25ms);
+  ASSERT_EQ(frameClock.getStatistics().size(), 1u);
+  ASSERT_TRUE(frameClock.step());
+  ASSERT_TRUE(frameClock.step());
+  ASSERT_FALSE(frameClock.step());
+  ASSERT_DOUBLE_EQ(frameClock.getInterpolation(), 0.5);
+
+  // the remainder carries over, and a stall only counts up to kMaxFrameTime
+  frameClock.beginFrame(1s);
+  int steps = 0;
+  while(frameClock.step()) ++steps;
+  ASSERT_EQ(steps, 25);
+  ASSERT_EQ(frameClock.getFrameTime(), 1s);
+}
@@ -0,0 +1,20 @@
+#include <gtest/gtest.h>
+
+#include <rectangle.h>
+
+using sdl::Rectangle;
+
+TEST(RectangleTest, intersectsOnlyWhenAreaIsShared) {
+  constexpr Rectangle rectangle { 10, 10, 10, 10 };
+  static_assert(rectangle.intersects({ 15, 15, 10, 10 }));
+  static_assert(rectangle.intersects({ 12, 12, 2, 2 }));
+  static_assert(!rectangle.intersects({ 20, 10, 10, 10 }));
+  static_assert(!rectangle.intersects({ 10, 20, 10, 10 }));
+  ASSERT_FALSE(rectangle.intersects({ 0, 0, 10, 10 }));
+}
+
+TEST(RectangleTest, unionCoversBothRectangles) {
+  constexpr Rectangle united = Rectangle { 10, 20, 5, 5 }.getUnion({ 0, 30, 20, 2 });
+  static_assert(united == Rectangle { 0, 20, 20, 12 });
+  ASSERT_EQ(united.getWidth(), 20u);
+}
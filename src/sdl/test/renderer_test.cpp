@@ -0,0 +1,118 @@
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color.h>
+#include <pixel_kernels.h>
+#include <rectangle.h>
+#include <renderer.h>
+#include <streaming_texture.h>
+#include <surface.h>
+#include <texture.h>
+
+TEST(RendererTest, testSurfaceRendererNeedsNoWindow) {
+  sdl::Surface frame { 8, 8 };
+  sdl::Renderer renderer { frame };
+
+  renderer.setRenderDrawColour({ 0x10, 0x20, 0x30, 0xff });
+  renderer.clear();
+  renderer.setRenderDrawColour({ 0xff, 0x00, 0x00, 0xff });
+  renderer.fillRectangle({ 4, 0, 4, 8 });
+
+  // read into a buffer of our own, as a service reusing it across frames would
+  std::vector<uint32_t> pixels(8 * 8);
+  const vodden::PixelView view { std::as_writable_bytes(std::span { pixels }), 8, 8, 8 * 4 };
+  renderer.readPixels(view, sdl::Texture::kARGB8888);
+
+  ASSERT_EQ(pixels[0], 0xff102030u);
+  ASSERT_EQ(pixels[7], 0xffff0000u);
+  ASSERT_EQ(pixels[8 * 7 + 3], 0xff102030u);
+}
+
+TEST(RendererTest, testReadPixelsRejectsShortViews) {
+  sdl::Surface frame { 8, 8 };
+  sdl::Renderer renderer { frame };
+
+  std::vector<uint32_t> pixels(8 * 8 - 1);
+  const vodden::PixelView shortView { std::as_writable_bytes(std::span { pixels }), 8, 8, 8 * 4 };
+  ASSERT_THROW(renderer.readPixels(shortView, sdl::Texture::kARGB8888), std::invalid_argument);
+  const vodden::PixelView narrowPitch { std::as_writable_bytes(std::span { pixels }), 8, 4, 7 * 4 };
+  ASSERT_THROW(renderer.readPixels(narrowPitch, sdl::Texture::kARGB8888), std::invalid_argument);
+}
+
+TEST(RendererTest, testReadPixelsIntoSurface) {
+  sdl::Surface frame { 4, 4 };
+  sdl::Renderer renderer { frame };
+  renderer.setRenderDrawColour({ 0x00, 0xff, 0x00, 0xff });
+  renderer.clear();
+
+  sdl::Surface readBack { 4, 4 };
+  renderer.readPixels(readBack);
+
+  // both are drawn in the same format, so the read back pixels match the frame's byte for byte
+  const vodden::ConstPixelView drawn = frame.getPixels();
+  const vodden::ConstPixelView read = std::as_const(readBack).getPixels();
+  for(uint32_t y = 0; y < 4; ++y) {
+    for(uint32_t x = 0; x < 4; ++x) ASSERT_EQ(read.row(y)[x], drawn.row(y)[x]);
+  }
+}
+
+TEST(RendererTest, testStreamingTextureRejectsRegionsOutsideIt) {
+  sdl::Surface frame { 8, 8 };
+  sdl::Renderer renderer { frame };
+  sdl::StreamingTexture texture { renderer, 8, 8 };
+
+  ASSERT_THROW(texture.lock({ 4, 4, 8, 2 }), std::invalid_argument);
+  ASSERT_THROW(texture.update(sdl::Surface { 2, 2 }, { 0, 0, 4, 4 }), std::invalid_argument);
+  ASSERT_THROW(texture.update(sdl::Surface { 8, 8 }, { 6, 0, 4, 4 }), std::invalid_argument);
+  texture.update(sdl::Surface { 4, 4 }, { 4, 4, 4, 4 });
+}
+
+TEST(RendererTest, testPresentCallbackNumbersAndTimesFrames) {
+  sdl::Surface frame { 4, 4 };
+  sdl::Renderer renderer { frame };
+
+  std::vector<sdl::Renderer::PresentTiming> timings;
+  renderer.setPresentCallback([&timings](const sdl::Renderer::PresentTiming& timing) { timings.push_back(timing); });
+  for(int i = 0; i < 3; ++i) renderer.present();
+  renderer.setPresentCallback({});
+  renderer.present();
+
+  ASSERT_EQ(timings.size(), 3u);
+  ASSERT_EQ(timings[0].interval.count(), 0);
+  for(uint64_t i = 0; i < timings.size(); ++i) ASSERT_EQ(timings[i].frame, i);
+  for(std::size_t i = 1; i < timings.size(); ++i) {
+    ASSERT_GE(timings[i].presentTime, timings[i - 1].presentTime);
+    ASSERT_EQ(timings[i].interval, timings[i].presentTime - timings[i - 1].presentTime);
+  }
+}
+
+TEST(RendererTest, testMaxFramesInFlightSyncsOnceEveryLimit) {
+  sdl::Surface frame { 4, 4 };
+  sdl::Renderer renderer { frame };
+
+  for(int i = 0; i < 4; ++i) renderer.present();
+  ASSERT_EQ(renderer.getSyncCount(), 0u);
+
+  renderer.setMaxFramesInFlight(3);
+  for(int i = 0; i < 7; ++i) renderer.present();
+  ASSERT_EQ(renderer.getSyncCount(), 2u);
+
+  // changing the limit starts counting again
+  renderer.setMaxFramesInFlight(1);
+  for(int i = 0; i < 2; ++i) renderer.present();
+  ASSERT_EQ(renderer.getSyncCount(), 4u);
+}
+
+TEST(RendererTest, testAdaptiveVSyncFallsBackToOn) {
+  sdl::Surface frame { 4, 4 };
+  sdl::Renderer renderer { frame };
+
+  ASSERT_EQ(renderer.setVSync(sdl::Renderer::kVSyncAdaptive), sdl::Renderer::kVSyncOn);
+  ASSERT_EQ(renderer.getVSync(), sdl::Renderer::kVSyncOn);
+  ASSERT_EQ(renderer.setVSync(sdl::Renderer::kVSyncOff), sdl::Renderer::kVSyncOff);
+}
@@ -4,9 +4,32 @@
 #include <window.h>
 
 TEST(WindowTest, testMoveConstructor) {
+  // so the tests run on machines without a display; SDL_VIDEODRIVER still wins where it is set
+  sdl::SDL::setVideoDriver(sdl::SDL::kDummyVideoDriver);
   sdl::SDL sdl;
-  sdl::Window windowOne { "This is a title", 100, 100, 100, 100, 0 };
+  sdl::Window windowOne { "This is a title", 100, 100, 100, 100, {} };
   sdl::Window windowTwo { std::move(windowOne) };
 
   ASSERT_EQ(windowTwo.getTitle(), "This is a title");
 }
+
+TEST(WindowTest, testMoveAssignment) {
+  sdl::SDL::setVideoDriver(sdl::SDL::kDummyVideoDriver);
+  sdl::SDL sdl;
+  sdl::Window windowOne { "First", 100, 100, 100, 100, {} };
+  sdl::Window windowTwo { "Second", 100, 100, 100, 100, {} };
+  windowTwo = std::move(windowOne);
+
+  // windowOne is left empty, and destroying it must not touch the window windowTwo now owns
+  ASSERT_EQ(windowTwo.getTitle(), "First");
+}
+
+TEST(WindowTest, testIdsAreDistinct) {
+  sdl::SDL::setVideoDriver(sdl::SDL::kDummyVideoDriver);
+  sdl::SDL sdl;
+  sdl::Window windowOne { "First", 100, 100, 100, 100, {} };
+  sdl::Window windowTwo { "Second", 100, 100, 100, 100, {} };
+
+  ASSERT_NE(windowOne.getId(), 0u);
+  ASSERT_NE(windowOne.getId(), windowTwo.getId());
+}
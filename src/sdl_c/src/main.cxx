@@ -3,7 +3,7 @@
 #include <SDL2/SDL.h>
 #include <SDL_image.h>
 
-#include <images.h>
+#include <assets.h>
 
 int main()
 {
@@ -30,7 +30,8 @@ int main()
   }
   SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, SDL_ALPHA_OPAQUE);
   SDL_RenderClear(renderer);
-  auto rwops = SDL_RWFromConstMem(&_binary_tic_tac_toe_png_start, ticTacToeSize());
+  const auto& image = assets::get(assets::Id::kTicTacToePng);
+  auto rwops = SDL_RWFromConstMem(image.start, static_cast<int>(image.size));
   if(rwops == nullptr) {
     std::cout << "Error extracting image from embedded binary: " << SDL_GetError() << std::endl;
     return -1;
@@ -1,11 +1,15 @@
+#include <array>
+#include <chrono>
 #include <exception>
 #include <forward_list>
 #include <functional>
 #include <iostream>
+#include <optional>
 #include <ranges>
 
-#include <images.h>
+#include <assets.h>
 
+#include <baked_image.h>
 #include <color.h>
 #include <event.h>
 #include <rectangle.h>
@@ -16,61 +20,90 @@
 
 #include <button.h>
 #include <event_dispatcher.h>
+#include <scene.h>
 #include <sprite.h>
-#include <sprite_renderer.h>
+#include <startup.h>
 
 using namespace sdl;
 using namespace sdl::tools;
 
+//! @brief the letters on the board, and whose turn it is
+struct Game {
+  Scene& scene;
+  const Sprite& letterO;
+  const Sprite& letterX;
+  // the node showing each cell's letter, if it has one
+  std::array<std::optional<Scene::NodeId>, 9> cells {};
+  bool crossesTurn { false };
+};
+
 static void mouseButtonEventHandler(
-  const SpriteRenderer& spriteRenderer,
-  const Sprite& sprite,
+  Game& game,
+  std::size_t cell,
   const MousePositionEvent& mousePositionEvent ) {
   std::cout << "Got a mouse button event." << std::endl;
-  spriteRenderer.render(sprite, ( mousePositionEvent.x / 128 ) * 128, ( mousePositionEvent.y / 128 ) * 128);
+  // a cell clicked again has its letter replaced rather than another stacked on it
+  if(game.cells[cell]) game.scene.remove(*game.cells[cell]);
+  // only the clicked cell is redrawn
+  const Sprite& letter = game.crossesTurn ? game.letterX : game.letterO;
+  game.cells[cell] = game.scene.add(letter, ( mousePositionEvent.x / 128 ) * 128, ( mousePositionEvent.y / 128 ) * 128);
+  game.crossesTurn = !game.crossesTurn;
+  game.scene.render();
 }
 
 int main()
 {
   try {
+    // asset work runs on the thread pool while the window and renderer are created:
+    // the board is drawn from the baked image, and the letters from the png, decoded meanwhile
+    Startup startup;
+    const auto boardImage = startup.addImage(BakedImage { assets::get(assets::Id::kTicTacToeBaked).getData() });
+    const auto& letterPng = assets::get(assets::Id::kTicTacToePng);
+    const auto letterImage = startup.addImage(letterPng.start, letterPng.size);
+    startup.begin();
+
     SDL sdl;
-    sdl.initSubSystem(SDL::kVideo);
+    startup.time("video", [&sdl]() { sdl.initSubSystem(SDL::kVideo); });
 
-    Window window {
+    Window window = startup.time("window", []() { return Window {
       "SDL2Test",
       100,
       100,
       384,
       384,
-      0
-    };
+      {}
+    }; });
 
-    Renderer renderer { window, -1, { Renderer::kSoftware } };
-    renderer.setRenderDrawColour(NamedColor::kMagenta);
-    SpriteRenderer spriteRenderer( renderer );
+    Renderer renderer = startup.time("renderer", [&window]() { return Renderer::create(window, { { Renderer::kTargetTexture } }); });
+
+    [[maybe_unused]] const auto report = startup.finish(renderer);
+#ifdef VODDEN_PROFILE
+    // reported with the rest of the profiling output, rather than on every run
+    for(const auto& stage : report.stages) {
+      std::cout << stage.name << ": " << std::chrono::duration_cast<std::chrono::microseconds>(stage.duration).count() << "us" << std::endl;
+    }
+#endif
 
-    Texture texture { renderer, &_binary_tic_tac_toe_png_start, ticTacToeSize() };
-    const Sprite board {texture, {0, 0, 384, 384}};
-    const Sprite letterO {texture, {384, 128, 128, 128}};
-    const Sprite letterX {texture, {384, 0, 128, 128}};
+    Texture boardTexture = startup.takeTexture(boardImage);
+    Texture letterTexture = startup.takeTexture(letterImage);
+    const Sprite board {boardTexture, {0, 0, 384, 384}};
+    const Sprite letterO {letterTexture, {384, 128, 128, 128}};
+    const Sprite letterX {letterTexture, {384, 0, 128, 128}};
 
-    renderer.setRenderDrawColour(NamedColor::kWhite);
-    renderer.clear();
-    texture.setTextureBlendMode(Texture::kBlend);
-    
-    spriteRenderer.render(board, 0, 0);
-    renderer.present();
+    Scene scene { renderer, 384, 384, NamedColor::kWhite };
+    scene.add(board, 0, 0);
+    scene.render();
 
     EventProducer eventProducer { }; 
     EventDispatcher eventDispatcher { eventProducer };
     std::vector<std::unique_ptr<Button>> buttons;
     buttons.reserve(9);
-    bool crossesTurn = false;
+    Game game { scene, letterO, letterX };
     for( uint32_t i : std::ranges::iota_view{ 0, 3 } ) {
       for( uint32_t j : std::ranges::iota_view{ 0, 3 } ) {
         auto button = std::make_unique<Button>(eventDispatcher, Rectangle{ j * 128 + 1, i * 128 + 1, 128u, 128u} );
-        button->registerEventHandler([&spriteRenderer, &letterO](const MousePositionEvent& mousePositionEvent){ 
-          mouseButtonEventHandler(spriteRenderer, letterO, mousePositionEvent);
+        button->registerEventHandler([&game, cell = std::size_t { i * 3 + j }](const MousePositionEvent& mousePositionEvent){ 
+          mouseButtonEventHandler(game, cell, mousePositionEvent);
         });
         buttons.emplace_back(std::move(button));
       }
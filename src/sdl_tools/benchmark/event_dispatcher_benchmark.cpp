@@ -0,0 +1,94 @@
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <event.h>
+#include <event_recording.h>
+
+#include <event_dispatcher.h>
+
+using namespace sdl;
+using namespace sdl::tools;
+
+//! produces an endless supply of mouse button events, with no SDL queue involved
+class SyntheticEventProducer : public BaseEventProducer {
+  public:
+    virtual std::unique_ptr<BaseEvent> wait() { return poll(); };
+    virtual std::unique_ptr<BaseEvent> poll() {
+      return std::make_unique<MouseButtonEvent>(
+        std::chrono::milliseconds(0), 1, 0, 64, 64,
+        MouseButtonEvent::Button::kLeft, MouseButtonEvent::State::kPressed, 1
+      );
+    };
+};
+
+class MouseButtonEventCounter : public EventHandler<MouseButtonEvent>, public BaseEventHandler {
+  public:
+    virtual void handle([[maybe_unused]] const MouseButtonEvent& mouseButtonEvent) { ++count; };
+    uint64_t count { 0 };
+};
+
+class QuitEventCounter : public EventHandler<QuitEvent>, public BaseEventHandler {
+  public:
+    virtual void handle([[maybe_unused]] const QuitEvent& quitEvent) { ++count; };
+    uint64_t count { 0 };
+};
+
+//! one runFrame per iteration; half of the handlers cannot handle the events
+static void BM_EventDispatcherRunFrame(benchmark::State& state) {
+  SyntheticEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+
+  std::vector<std::unique_ptr<BaseEventHandler>> eventHandlers;
+  std::vector<EventDispatcher::Registration> registrations;
+  for(int64_t i = 0; i < state.range(0); ++i) {
+    if(i % 2 == 0) eventHandlers.push_back(std::make_unique<MouseButtonEventCounter>());
+    else eventHandlers.push_back(std::make_unique<QuitEventCounter>());
+    registrations.push_back(eventDispatcher.registerEventHandler(*eventHandlers.back()));
+  }
+
+  for([[maybe_unused]] auto _ : state) eventDispatcher.runFrame();
+}
+BENCHMARK(BM_EventDispatcherRunFrame)->RangeMultiplier(4)->Range(1, 1024);
+
+//! a widget coming and going among many live ones: one register, one frame and one unregister per iteration
+static void BM_EventDispatcherHandlerChurn(benchmark::State& state) {
+  SyntheticEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+
+  std::vector<std::unique_ptr<MouseButtonEventCounter>> eventHandlers;
+  std::vector<EventDispatcher::Registration> registrations;
+  for(int64_t i = 0; i < state.range(0); ++i) {
+    eventHandlers.push_back(std::make_unique<MouseButtonEventCounter>());
+    registrations.push_back(eventDispatcher.registerEventHandler(*eventHandlers.back()));
+  }
+
+  MouseButtonEventCounter transient;
+  for([[maybe_unused]] auto _ : state) {
+    auto registration = eventDispatcher.registerEventHandler(transient);
+    eventDispatcher.runFrame();
+  }
+  state.counters["handlers"] = static_cast<double>(eventDispatcher.getHandlerCount());
+}
+BENCHMARK(BM_EventDispatcherHandlerChurn)->RangeMultiplier(8)->Range(8, 512);
+
+//! replays a recorded burst of motion and button events through run(), which the log's end stops
+static void BM_EventDispatcherReplay(benchmark::State& state) {
+  SyntheticEventProducer syntheticEventProducer;
+  std::stringstream log;
+  RecordingEventProducer recordingEventProducer { syntheticEventProducer, log };
+  for(int64_t i = 0; i < state.range(0); ++i) recordingEventProducer.poll();
+  ReplayEventProducer replayEventProducer { log };
+
+  MouseButtonEventCounter mouseButtonEventCounter;
+  for([[maybe_unused]] auto _ : state) {
+    replayEventProducer.rewind();
+    EventDispatcher eventDispatcher { replayEventProducer };
+    const auto registration = eventDispatcher.registerEventHandler(mouseButtonEventCounter);
+    eventDispatcher.run();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EventDispatcherReplay)->RangeMultiplier(8)->Range(64, 32768);
@@ -0,0 +1,32 @@
+#include <chrono>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <color.h>
+#include <renderer.h>
+#include <surface.h>
+
+#include <frame_capture.h>
+
+using namespace sdl;
+using namespace sdl::tools;
+
+//! clears and captures 384x384 frames while a writer takes state.range(0) milliseconds per frame, as an encoder and disk might
+static void BM_FrameCaptureSlowWriter(benchmark::State& state) {
+  Surface frame { 384, 384 };
+  Renderer renderer { frame };
+  const std::chrono::milliseconds writeTime { state.range(0) };
+  FrameCapture frameCapture { renderer, 384, 384, [writeTime](const Surface&, uint64_t) { std::this_thread::sleep_for(writeTime); } };
+
+  for([[maybe_unused]] auto _ : state) {
+    renderer.setRenderDrawColour({ 0x20, 0x40, 0x60, 0xff });
+    renderer.clear();
+    frameCapture.capture();
+    renderer.present();
+  }
+  frameCapture.flush();
+  // the frame time should stay flat as the writer slows, with the difference showing up here
+  state.counters["dropped"] = benchmark::Counter(static_cast<double>(frameCapture.getDroppedCount()), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_FrameCaptureSlowWriter)->Arg(0)->Arg(1)->Arg(16)->Unit(benchmark::kMicrosecond);
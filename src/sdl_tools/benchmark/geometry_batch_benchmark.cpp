@@ -0,0 +1,29 @@
+#include <benchmark/benchmark.h>
+
+#include <color.h>
+#include <renderer.h>
+#include <surface.h>
+
+#include <geometry_batch.h>
+
+using namespace sdl;
+using namespace sdl::tools;
+
+//! draws state.range(0) solid particles per frame as a single geometry batch
+static void BM_GeometryBatchParticles(benchmark::State& state) {
+  Surface frame { 384, 384 };
+  Renderer renderer { frame };
+  GeometryBatch geometryBatch { renderer, static_cast<std::size_t>(state.range(0)) };
+  const Color color { 0xc2, 0x00, 0x78, 0xff };
+
+  const int64_t particleCount = state.range(0);
+  for([[maybe_unused]] auto _ : state) {
+    for(int64_t i = 0; i < particleCount; ++i) {
+      geometryBatch.addQuad(static_cast<float>(i % 380), static_cast<float>((i / 380) % 380), 4.0f, 4.0f, color);
+    }
+    geometryBatch.flush();
+    renderer.present();
+  }
+  state.SetItemsProcessed(state.iterations() * particleCount);
+}
+BENCHMARK(BM_GeometryBatchParticles)->RangeMultiplier(8)->Range(64, 32768)->Unit(benchmark::kMicrosecond);
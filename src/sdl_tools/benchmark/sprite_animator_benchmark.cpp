@@ -0,0 +1,45 @@
+#include <chrono>
+
+#include <benchmark/benchmark.h>
+
+#include <assets.h>
+
+#include <renderer.h>
+#include <surface.h>
+#include <texture.h>
+
+#include <animation_clip.h>
+#include <sprite_animator.h>
+#include <sprite_world.h>
+
+using namespace sdl;
+using namespace sdl::tools;
+
+//! advances state.range(0) animations by one 60Hz frame, each looping over the tic tac toe sheet's cells
+static void BM_SpriteAnimatorAdvance(benchmark::State& state) {
+  Surface frame { 384, 384 };
+  Renderer renderer { frame };
+  const auto& image = assets::get(assets::Id::kTicTacToePng);
+  Texture texture { renderer, image.start, image.size };
+
+  SpriteWorld spriteWorld;
+  const auto textureId = spriteWorld.addTexture(texture);
+  SpriteAnimator animator { spriteWorld };
+  const AnimationClip clip { { 0, 0, 128, 128 }, 4, 8, std::chrono::milliseconds { 50 } };
+  const auto clipId = animator.addClip(clip);
+
+  const int64_t spriteCount = state.range(0);
+  for(int64_t i = 0; i < spriteCount; ++i) {
+    const auto spriteId = spriteWorld.add(textureId, { 0, 0, 128, 128 }, static_cast<float>(i % 384), 0.0f);
+    animator.play(spriteId, clipId);
+    // stagger the animations in groups so frames change on different steps
+    if(i % 64 == 63) animator.advance(std::chrono::milliseconds { 7 });
+  }
+
+  for([[maybe_unused]] auto _ : state) {
+    animator.advance(std::chrono::microseconds { 16667 });
+    benchmark::DoNotOptimize(animator.getFrames().data());
+  }
+  state.SetItemsProcessed(state.iterations() * spriteCount);
+}
+BENCHMARK(BM_SpriteAnimatorAdvance)->RangeMultiplier(8)->Range(64, 32768)->Unit(benchmark::kMicrosecond);
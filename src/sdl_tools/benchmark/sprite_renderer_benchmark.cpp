@@ -0,0 +1,94 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <assets.h>
+
+#include <rectangle.h>
+#include <renderer.h>
+#include <surface.h>
+#include <target_texture.h>
+#include <texture.h>
+
+#include <sprite.h>
+#include <sprite_renderer.h>
+
+using namespace sdl;
+using namespace sdl::tools;
+
+//! draws state.range(0) sprites per frame into a surface with the software renderer
+static void BM_SpriteRendererFrame(benchmark::State& state) {
+  Surface frame { 384, 384 };
+  Renderer renderer { frame };
+  const auto& image = assets::get(assets::Id::kTicTacToePng);
+  Texture texture { renderer, image.start, image.size };
+  SpriteRenderer spriteRenderer { renderer };
+
+  const Sprite letterO { texture, { 384, 128, 128, 128 } };
+  const Sprite letterX { texture, { 384, 0, 128, 128 } };
+
+  const int64_t spriteCount = state.range(0);
+  for([[maybe_unused]] auto _ : state) {
+    for(int64_t i = 0; i < spriteCount; ++i) {
+      const uint32_t x = (i * 128) % 384;
+      const uint32_t y = ((i / 3) * 128) % 384;
+      spriteRenderer.render(i % 2 == 0 ? letterO : letterX, x, y);
+    }
+    spriteRenderer.endFrame();
+  }
+  state.SetItemsProcessed(state.iterations() * spriteCount);
+}
+BENCHMARK(BM_SpriteRendererFrame)->RangeMultiplier(4)->Range(1, 4096)->Unit(benchmark::kMicrosecond);
+
+//! the same static layer of state.range(0) sprites, drawn once into a target texture and copied each frame
+static void BM_CachedLayerFrame(benchmark::State& state) {
+  Surface frame { 384, 384 };
+  Renderer renderer { frame };
+  const auto& image = assets::get(assets::Id::kTicTacToePng);
+  Texture texture { renderer, image.start, image.size };
+  TargetTexture layer { renderer, 384, 384 };
+  SpriteRenderer spriteRenderer { renderer };
+
+  const Sprite letterO { texture, { 384, 128, 128, 128 } };
+  const Sprite letterX { texture, { 384, 0, 128, 128 } };
+
+  const int64_t spriteCount = state.range(0);
+  {
+    const auto targetScope = renderer.setTarget(layer);
+    for(int64_t i = 0; i < spriteCount; ++i) {
+      spriteRenderer.render(i % 2 == 0 ? letterO : letterX, (i * 128) % 384, ((i / 3) * 128) % 384);
+    }
+    spriteRenderer.flush();
+  }
+
+  for([[maybe_unused]] auto _ : state) {
+    renderer.copy(layer);
+    renderer.present();
+  }
+  state.SetItemsProcessed(state.iterations() * spriteCount);
+}
+BENCHMARK(BM_CachedLayerFrame)->RangeMultiplier(4)->Range(1, 4096)->Unit(benchmark::kMicrosecond);
+
+//! state.range(0) sprites over four z layers and two blend modes, queued in an order the sort has to undo
+static void BM_SpriteRendererLayeredFrame(benchmark::State& state) {
+  Surface frame { 384, 384 };
+  Renderer renderer { frame };
+  const auto& image = assets::get(assets::Id::kTicTacToePng);
+  Texture texture { renderer, image.start, image.size };
+  SpriteRenderer spriteRenderer { renderer };
+
+  const Sprite letterO { texture, { 384, 128, 128, 128 } };
+  const Sprite glowX { texture, { 384, 0, 128, 128 }, Texture::kAdd };
+
+  const int64_t spriteCount = state.range(0);
+  for([[maybe_unused]] auto _ : state) {
+    for(int64_t i = 0; i < spriteCount; ++i) {
+      const uint32_t x = (i * 128) % 384;
+      const uint32_t y = ((i / 3) * 128) % 384;
+      spriteRenderer.render(i % 2 == 0 ? letterO : glowX, x, y, static_cast<int16_t>(3 - i % 4));
+    }
+    spriteRenderer.endFrame();
+  }
+  state.SetItemsProcessed(state.iterations() * spriteCount);
+}
+BENCHMARK(BM_SpriteRendererLayeredFrame)->RangeMultiplier(4)->Range(1, 4096)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,46 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <assets.h>
+
+#include <renderer.h>
+#include <surface.h>
+#include <texture.h>
+
+#include <geometry_batch.h>
+#include <sprite_world.h>
+
+using namespace sdl;
+using namespace sdl::tools;
+
+//! moves and draws state.range(0) sprites per frame from a SpriteWorld, panning over a world mostly out of view
+static void BM_SpriteWorldFrame(benchmark::State& state) {
+  Surface frame { 384, 384 };
+  Renderer renderer { frame };
+  const auto& image = assets::get(assets::Id::kTicTacToePng);
+  Texture texture { renderer, image.start, image.size };
+  GeometryBatch geometryBatch { renderer, static_cast<std::size_t>(state.range(0)) };
+
+  SpriteWorld spriteWorld;
+  const auto textureId = spriteWorld.addTexture(texture);
+  const int64_t spriteCount = state.range(0);
+  std::vector<SpriteWorld::SpriteId> spriteIds;
+  for(int64_t i = 0; i < spriteCount; ++i) {
+    const Rectangle source = i % 2 == 0 ? Rectangle { 384, 128, 128, 128 } : Rectangle { 384, 0, 128, 128 };
+    // spread over a 3840 pixel square world, so about 1% is in view at a time
+    const float x = static_cast<float>((i * 64) % 3840);
+    const float y = static_cast<float>(((i * 64) / 3840 * 64) % 3840);
+    spriteIds.push_back(spriteWorld.add(textureId, source, x, y, static_cast<int32_t>(i % 4)));
+  }
+
+  float camera = 0.0f;
+  for([[maybe_unused]] auto _ : state) {
+    spriteWorld.setPosition(spriteIds[0], camera, camera);
+    spriteWorld.render(geometryBatch, { camera, 0.0f, 384.0f, 384.0f });
+    renderer.present();
+    camera = camera < 3456.0f ? camera + 4.0f : 0.0f;
+  }
+  state.SetItemsProcessed(state.iterations() * spriteCount);
+}
+BENCHMARK(BM_SpriteWorldFrame)->RangeMultiplier(8)->Range(64, 32768)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,42 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <assets.h>
+
+#include <rectangle.h>
+#include <renderer.h>
+#include <surface.h>
+#include <texture.h>
+
+#include <tile_map.h>
+
+using namespace sdl;
+using namespace sdl::tools;
+
+//! pans across a 1000x1000 map of 32 pixel tiles, changing state.range(0) tiles per frame
+static void BM_TileMapScroll(benchmark::State& state) {
+  Surface frame { 384, 384 };
+  Renderer renderer { frame };
+  const auto& image = assets::get(assets::Id::kTicTacToePng);
+  Texture texture { renderer, image.start, image.size };
+
+  constexpr uint32_t kSize = 1000;
+  TileMap tileMap { renderer, texture, 32, 32, kSize, kSize };
+  std::vector<TileMap::TileId> tiles(kSize * kSize);
+  for(std::size_t i = 0; i < tiles.size(); ++i) tiles[i] = static_cast<TileMap::TileId>(i % 16);
+  tileMap.setTiles(tiles);
+
+  const int64_t changesPerFrame = state.range(0);
+  uint32_t camera = 0;
+  for([[maybe_unused]] auto _ : state) {
+    for(int64_t i = 0; i < changesPerFrame; ++i) {
+      const auto cell = tileMap.hitTest(camera + static_cast<uint32_t>(i * 37) % 384, static_cast<uint32_t>(i * 53) % 384);
+      if(cell) tileMap.setTile(cell->column, cell->row, static_cast<TileMap::TileId>(i % 16));
+    }
+    tileMap.render({ camera, 0, 384, 384 });
+    renderer.present();
+    camera = (camera + 2) % (kSize * 32 - 384);
+  }
+}
+BENCHMARK(BM_TileMapScroll)->Arg(0)->Arg(1)->Arg(64)->Unit(benchmark::kMicrosecond);
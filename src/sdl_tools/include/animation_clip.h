@@ -0,0 +1,70 @@
+#ifndef __SDL_TOOLS_ANIMATION_CLIP_H__
+#define __SDL_TOOLS_ANIMATION_CLIP_H__
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include "rectangle.h"
+
+namespace sdl::tools {
+
+class AnimationClipImpl;
+
+/**
+ * @brief The frames of one animation on a sprite sheet.
+ *
+ * The clip is stored as frame tables: the frames' source rectangles in one
+ * array and, in another, the time at which each frame ends, measured from
+ * the start of the clip. Finding the frame for a point in time is then a
+ * walk along a short array rather than a sum of durations.
+ */
+class AnimationClip {
+  public:
+    typedef std::chrono::nanoseconds Duration;
+
+    enum class Playback {
+      //! @brief start again from the first frame after the last
+      kLoop,
+      //! @brief stay on the last frame
+      kOnce
+    };
+
+    struct Frame {
+      Rectangle source;
+      Duration duration;
+    };
+
+    //! @brief a clip of the provided frames; throws std::invalid_argument if there are none or a duration is not positive
+    AnimationClip(std::span<const Frame> frames, Playback playback = Playback::kLoop);
+
+    /**
+     * @brief a clip of equally long frames laid out in a grid on the sheet.
+     *
+     * The frames are the size of firstFrame and run left to right from it,
+     * columns to a row, then on to the next row down.
+     */
+    AnimationClip(const Rectangle& firstFrame, uint32_t columns, uint32_t frameCount, Duration frameDuration, Playback playback = Playback::kLoop);
+
+    AnimationClip(AnimationClip&& other);
+    ~AnimationClip();
+
+    AnimationClip& operator=(AnimationClip&& other);
+
+    std::size_t getFrameCount() const;
+    Playback getPlayback() const;
+    //! @brief the length of one pass through every frame
+    Duration getDuration() const;
+
+    std::span<const Rectangle> getSources() const;
+    //! @brief when each frame ends, from the start of the clip; the last is getDuration()
+    std::span<const Duration> getFrameEnds() const;
+
+  private:
+    std::unique_ptr<AnimationClipImpl> _animationClipImpl;
+};
+
+}
+
+#endif
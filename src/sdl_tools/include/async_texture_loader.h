@@ -0,0 +1,58 @@
+#ifndef __SDL_TOOLS_ASYNC_TEXTURE_LOADER_H__
+#define __SDL_TOOLS_ASYNC_TEXTURE_LOADER_H__
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+#include "renderer.h"
+
+#include "texture_handle.h"
+
+namespace sdl::tools {
+
+class AsyncTextureLoaderImpl;
+
+/**
+ * @brief Loads textures without stalling the render thread.
+ *
+ * Images are decoded to surfaces on the shared thread pool and handed back
+ * through a lock-free queue. update(), called once a frame on the render
+ * thread, uploads the decoded surfaces a bounded slice at a time so that a
+ * burst of loads is spread over several frames rather than causing a hitch.
+ */
+class AsyncTextureLoader {
+  public:
+    //! @brief the default number of decoded bytes uploaded per call to update()
+    static constexpr std::size_t kDefaultUploadBudget = 8 * 1024 * 1024;
+
+    AsyncTextureLoader(const Renderer& renderer, std::size_t uploadBudget = kDefaultUploadBudget);
+    AsyncTextureLoader(AsyncTextureLoader&& other);
+    //! @brief waits for outstanding decodes; handles which were never uploaded are marked failed
+    ~AsyncTextureLoader();
+
+    //! @brief start loading a texture from a file on disk
+    TextureHandle load(std::filesystem::path filePath);
+
+    //! @brief start loading a texture from an encoded image in cpu memory, which must outlive the load
+    TextureHandle load(const void* location, std::size_t size);
+
+    /**
+     * @brief upload decoded surfaces, up to the upload budget; render thread only.
+     *
+     * At least one surface is uploaded if any are waiting, however large it is.
+     *
+     * @return the number of handles which became ready or failed.
+     */
+    std::size_t update();
+
+    //! @brief the number of handles which are neither ready nor failed
+    std::size_t getPendingCount() const;
+
+  private:
+    std::unique_ptr<AsyncTextureLoaderImpl> _asyncTextureLoaderImpl;
+};
+
+}
+
+#endif
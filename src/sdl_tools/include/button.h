@@ -1,25 +1,42 @@
 #ifndef __SDL_TOOLS_BUTTON_H__
 #define __SDL_TOOLS_BUTTON_H__
 
+#include <cstddef>
 #include <memory>
 
 #include <event.h>
+#include <inplace_function.h>
 #include <rectangle.h>
 
+#include <button_layer.h>
 #include <event_dispatcher.h>
 
+namespace sdl {
+
+class Window;
+
+}
+
 namespace sdl::tools {
 
 class ButtonImpl;
 
 class Button {
   public:
-    typedef std::function<void(const MousePositionEvent&)> Handler;
+    //! @brief the bytes a handler's captures may take, enough for a few references or pointers
+    static constexpr std::size_t kHandlerCapacity = 32;
+    //! @brief held inside the button, so registering and invoking handlers never allocates
+    typedef vodden::InplaceFunction<void(const MousePositionEvent&), kHandlerCapacity> Handler;
 
     Button(EventDispatcher& eventProcessor, sdl::Rectangle rectangle);
+    //! @brief construct a button which only sees the events of the provided window
+    Button(EventDispatcher& eventProcessor, const sdl::Window& window, sdl::Rectangle rectangle);
+    //! @brief construct a button which is hit-tested through the provided layer, in the layer's window if it has one
+    Button(ButtonLayer& buttonLayer, sdl::Rectangle rectangle);
     Button(Button&& other);
     ~Button();
 
+    //! @brief add a handler, invoked after those registered before it; a handler must not add handlers to its own button
     void registerEventHandler(Handler handler);
 
   private:
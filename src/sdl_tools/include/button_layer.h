@@ -0,0 +1,55 @@
+#ifndef __SDL_TOOLS_BUTTON_LAYER_H__
+#define __SDL_TOOLS_BUTTON_LAYER_H__
+
+#include <memory>
+
+#include <event_dispatcher.h>
+
+namespace sdl {
+
+class Window;
+
+}
+
+namespace sdl::tools {
+
+class Button;
+class ButtonLayerImpl;
+
+/**
+ * @brief A hit-test index for many buttons.
+ *
+ * Buttons constructed against a ButtonLayer are registered in a uniform grid
+ * instead of with the EventDispatcher. The layer registers a single handler
+ * and routes each MouseButtonEvent only to the buttons whose rectangles
+ * overlap the grid cell under the cursor.
+ */
+class ButtonLayer {
+  friend Button;
+  public:
+    /**
+     * @brief Construct a layer which receives its events from the provided dispatcher.
+     *
+     * @param cellSize the width and height of a grid cell, in pixels.
+     */
+    ButtonLayer(EventDispatcher& eventDispatcher, uint32_t cellSize = kDefaultCellSize);
+    //! @brief Construct a layer which only sees the events of the provided window.
+    ButtonLayer(EventDispatcher& eventDispatcher, const sdl::Window& window, uint32_t cellSize = kDefaultCellSize);
+    //! @brief ButtonLayer cannot be moved, the dispatcher holds a reference to it
+    ButtonLayer(ButtonLayer&& other) = delete;
+    //! @brief ButtonLayer cannot be copied
+    ButtonLayer(const ButtonLayer& other) = delete;
+    ~ButtonLayer();
+
+    ButtonLayer& operator=(ButtonLayer&& other) = delete;
+    ButtonLayer& operator=(const ButtonLayer& other) = delete;
+
+    static constexpr uint32_t kDefaultCellSize = 64;
+
+  private:
+    std::unique_ptr<ButtonLayerImpl> _buttonLayerImpl;
+};
+
+}
+
+#endif
@@ -1,7 +1,12 @@
 #ifndef __SDL_TOOLS_EVENT_DISPATCHER_H__
 #define __SDL_TOOLS_EVENT_DISPATCHER_H__
 
+#include <coroutine>
+#include <cstdint>
 #include <memory>
+#include <optional>
+
+#include <handle_table.h>
 
 #include "event.h"
 
@@ -9,14 +14,168 @@ namespace sdl::tools {
 
 class EventDispatcherImpl;
 
+/**
+ * @brief Pulls events from a producer and hands each one to the handlers registered for its type.
+ *
+ * Handlers are kept in a table indexed by EventTypeId, so dispatching an
+ * event only visits the handlers which can handle it.
+ *
+ * A handler is registered with an ExecutionPolicy. Inline handlers are invoked
+ * on the thread which calls run() or runFrame(); pool handlers are invoked on
+ * the library's worker pool. Each pool handler sees its events one at a time,
+ * in the order they were dispatched.
+ *
+ * A handler may be scoped to one window, by its SDL window id. Events from
+ * that window then reach it while events from other windows skip it
+ * altogether; events from no particular window, such as QuitEvent, reach
+ * every handler. Unscoped handlers receive everything.
+ *
+ * Registering returns a Registration, and the handler stays registered until
+ * that is destroyed or reset. Handlers of a type are invoked in the order
+ * they were registered, the unscoped ones before those of the event's
+ * window, and removing one keeps the others in that order.
+ *
+ * A Task may instead co_await next(), which resumes it with the next event
+ * of a type once that event has been dispatched to every handler, and
+ * before the one after it is dispatched.
+ */
 class EventDispatcher {
   public:
-    EventDispatcher(sdl::EventProducer eventProducer);
+    enum class ExecutionPolicy {
+      //! @brief invoke the handler on the dispatching thread
+      kInline,
+      //! @brief invoke the handler on the worker pool, preserving the order of its events
+      kPool
+    };
+
+    /**
+     * @brief keeps a handler registered for as long as it lives
+     *
+     * A handler may be unregistered at any time, including by a handler in
+     * the middle of a dispatch, after which it is not invoked again.
+     * Unregistering a pool handler drops the events queued for it and waits
+     * for any call already running, so a pool handler must not unregister
+     * itself. A Registration must not outlive its dispatcher.
+     */
+    class Registration {
+      friend EventDispatcher;
+      public:
+        Registration() = default;
+        Registration(Registration&& other) noexcept;
+        Registration(const Registration& other) = delete;
+        //! @brief unregisters the handler
+        ~Registration();
+
+        Registration& operator=(Registration&& other) noexcept;
+        Registration& operator=(const Registration& other) = delete;
+
+        //! @brief unregister the handler now
+        void reset();
+        bool isRegistered() const;
+
+      private:
+        Registration(EventDispatcherImpl& eventDispatcherImpl, vodden::HandleTable::Handle handle) :
+          _eventDispatcherImpl { &eventDispatcherImpl }, _handle { handle } {};
+
+        EventDispatcherImpl* _eventDispatcherImpl { nullptr };
+        vodden::HandleTable::Handle _handle {};
+    };
+
+    //! @brief an SDL window id, as Window::getId()
+    typedef uint32_t WindowId;
+    //! @brief SDL never gives a window the id 0, so it stands for every window
+    static constexpr WindowId kAllWindows = 0;
+
+    //! @brief awaits one event of a type, registered as its handler only while a coroutine is suspended on it
+    template <class EventClass>
+    class EventAwaiter : public sdl::EventHandler<EventClass> {
+      public:
+        EventAwaiter(EventDispatcher& eventDispatcher, WindowId windowId) : _eventDispatcher { eventDispatcher }, _windowId { windowId } {};
+        EventAwaiter(const EventAwaiter& other) = delete;
+        ~EventAwaiter() {
+          // destroyed along with a suspended coroutine, after the event arrived but before it was resumed
+          if(_awaiting && _event) _eventDispatcher.cancelResumption(_awaiting);
+        };
+
+        bool await_ready() const noexcept { return false; };
+        void await_suspend(std::coroutine_handle<> awaiting) {
+          _awaiting = awaiting;
+          _registration = _eventDispatcher.registerEventHandler(static_cast<sdl::EventHandler<EventClass>&>(*this), ExecutionPolicy::kInline, _windowId);
+        };
+        EventClass await_resume() {
+          _awaiting = {};
+          return std::move(*_event);
+        };
+
+        void handle(const EventClass& event) override {
+          if(_event) return;
+          _event.emplace(event);
+          _registration.reset();
+          _eventDispatcher.resumeAfterDispatch(_awaiting);
+        };
+
+      private:
+        EventDispatcher& _eventDispatcher;
+        WindowId _windowId;
+        std::coroutine_handle<> _awaiting {};
+        std::optional<EventClass> _event {};
+        Registration _registration {};
+    };
+
+    EventDispatcher(sdl::BaseEventProducer& eventProducer);
+    //! @brief waits for every pool handler to finish with the events it has been given
     ~EventDispatcher();
+
+    //! @brief block, dispatching events as they arrive, until a QuitEvent is handled.
     void run();
-    void registerEventHandler(sdl::BaseEventHandler& baseEventHandler);
+
+    /**
+     * @brief dispatch one batch of pending events without blocking.
+     *
+     * Intended to be called once per iteration of a render loop.
+     *
+     * @return false once a QuitEvent has been handled.
+     */
+    bool runFrame();
+
+    /**
+     * @brief register a handler for every event type it implements an EventHandler for.
+     *
+     * The handler is matched against each event type once, when that type is
+     * first seen, rather than on every event.
+     */
+    [[nodiscard]] Registration registerEventHandler(
+      sdl::BaseEventHandler& baseEventHandler,
+      ExecutionPolicy executionPolicy = ExecutionPolicy::kInline,
+      WindowId windowId = kAllWindows
+    );
+
+    //! @brief register a handler for a single event type.
+    template <class EventClass>
+    [[nodiscard]] Registration registerEventHandler(
+      sdl::EventHandler<EventClass>& eventHandler,
+      ExecutionPolicy executionPolicy = ExecutionPolicy::kInline,
+      WindowId windowId = kAllWindows
+    ) {
+      return registerEventHandler(sdl::eventTypeId<EventClass>(), static_cast<void*>(&eventHandler), executionPolicy, windowId);
+    }
+
+    //! @brief an awaitable which resumes a Task with a copy of the next EventClass, from the window if one is given
+    template <class EventClass>
+    [[nodiscard]] EventAwaiter<EventClass> next(WindowId windowId = kAllWindows) {
+      return { *this, windowId };
+    }
+
+    //! @brief the number of handlers currently registered, including the default QuitEvent handler
+    std::size_t getHandlerCount() const;
 
   private:
+    //! @brief resume a coroutine once the event being dispatched has reached every handler
+    void resumeAfterDispatch(std::coroutine_handle<> awaiting);
+    void cancelResumption(std::coroutine_handle<> awaiting);
+
+    Registration registerEventHandler(sdl::EventTypeId eventTypeId, void* eventHandler, ExecutionPolicy executionPolicy, WindowId windowId);
+
     std::unique_ptr<EventDispatcherImpl> _eventDispatcherImpl;
 };
 
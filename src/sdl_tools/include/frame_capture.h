@@ -0,0 +1,73 @@
+#ifndef __SDL_TOOLS_FRAME_CAPTURE_H__
+#define __SDL_TOOLS_FRAME_CAPTURE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+
+#include "renderer.h"
+#include "surface.h"
+
+namespace sdl::tools {
+
+class FrameCaptureImpl;
+
+/**
+ * @brief Captures rendered frames without stalling the render loop on encoding or disk writes.
+ *
+ * Frames are read back into a ring of surfaces allocated up front, and each
+ * captured surface is handed to the writer on a thread of the capture's own,
+ * which returns it to the ring once written; slow writes so never hold up
+ * the shared thread pool's other users. When every surface is still waiting
+ * on a writer, capture() drops the frame rather than wait, so slow disks
+ * cost frames, not frame time.
+ *
+ * SDL leaves the back buffer undefined once presented, so call capture()
+ * after the frame's last draw and before Renderer::present().
+ */
+class FrameCapture {
+  public:
+    //! @brief writes a captured frame; called on the writer thread, frameNumber counting every capture() call
+    typedef std::function<void(const Surface& frame, uint64_t frameNumber)> Writer;
+
+    static constexpr std::size_t kDefaultSlotCount = 3;
+
+    /**
+     * @brief Capture the top left width by height pixels of renderer's target.
+     *
+     * @param slotCount how many frames may be waiting on the writer before frames are dropped.
+     */
+    FrameCapture(const Renderer& renderer, uint32_t width, uint32_t height, Writer writer, std::size_t slotCount = kDefaultSlotCount);
+    FrameCapture(FrameCapture&& other);
+    //! @brief waits for every captured frame to be written
+    ~FrameCapture();
+
+    //! @brief a writer saving each frame as directory/frame_<frameNumber>.png, numbered to six digits
+    static Writer writePNG(std::filesystem::path directory);
+
+    /**
+     * @brief read back the current frame and queue it for writing; render thread only.
+     *
+     * @return false if the frame was dropped because no surface was free.
+     */
+    bool capture();
+
+    //! @brief block until every captured frame has been written
+    void flush();
+
+    //! @brief the number of frames handed to the writer, including those still being written
+    uint64_t getCapturedCount() const;
+    //! @brief the number of frames dropped because the writer had fallen behind
+    uint64_t getDroppedCount() const;
+    //! @brief the number of frames whose writer threw
+    uint64_t getFailedCount() const;
+
+  private:
+    std::unique_ptr<FrameCaptureImpl> _frameCaptureImpl;
+};
+
+}
+
+#endif
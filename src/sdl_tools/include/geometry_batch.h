@@ -0,0 +1,56 @@
+#ifndef __SDL_TOOLS_GEOMETRY_BATCH_H__
+#define __SDL_TOOLS_GEOMETRY_BATCH_H__
+
+#include <cstddef>
+#include <memory>
+
+#include "color.h"
+#include "rectangle.h"
+#include "renderer.h"
+#include "texture.h"
+
+namespace sdl::tools {
+
+class GeometryBatchImpl;
+
+/**
+ * @brief Accumulates coloured and textured quads and draws them with one call per texture.
+ *
+ * Vertices and indices are collected into buffers which are reserved up
+ * front and reused between flushes, so a steady stream of quads does not
+ * allocate. flush() issues one Renderer::renderGeometry per texture, untextured
+ * quads counting as one more, which makes it suitable for particle effects
+ * with thousands of quads. As with SpriteRenderer, quads are drawn in
+ * submission order only among those sharing a texture.
+ */
+class GeometryBatch {
+  public:
+    static constexpr std::size_t kDefaultQuadCapacity = 4096;
+
+    GeometryBatch(const Renderer& renderer, std::size_t quadCapacity = kDefaultQuadCapacity);
+    GeometryBatch(GeometryBatch&& other);
+    ~GeometryBatch();
+
+    //! @brief queue a solid coloured quad
+    void addQuad(float x, float y, float width, float height, const Color& color);
+    void addQuad(const Rectangle& destination, const Color& color);
+
+    //! @brief queue a region of a texture, tinted by color
+    void addQuad(const Texture& texture, const Rectangle& source, const Rectangle& destination, const Color& color = kNoTint);
+    void addQuad(const Texture& texture, const Rectangle& source, float x, float y, float width, float height, const Color& color = kNoTint);
+
+    //! @brief draw every queued quad and empty the batch
+    void flush();
+
+    //! @brief the number of quads queued since the last flush
+    std::size_t size() const;
+
+    static constexpr Color kNoTint { 255, 255, 255, 255 };
+
+  private:
+    std::unique_ptr<GeometryBatchImpl> _geometryBatchImpl;
+};
+
+}
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef __SDL_TOOLS_HOT_RELOADER_H__
+#define __SDL_TOOLS_HOT_RELOADER_H__
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <span>
+
+#include "renderer.h"
+
+#include "texture_cache.h"
+#include "texture_handle.h"
+
+namespace sdl::tools {
+
+class HotReloaderImpl;
+
+/**
+ * @brief Reloads textures and data files as they change on disk, for iterating on content.
+ *
+ * Watched files are read, and images decoded, on the shared thread pool as
+ * soon as they change. update(), called once a frame on the render thread,
+ * uploads the results and swaps them in behind the existing TextureHandles,
+ * so every Sprite and other holder of a handle draws the new pixels with no
+ * further work. Files which fail to decode, as a half written one may, keep
+ * their old contents until the next change.
+ *
+ * Changes are noticed through inotify on Linux. Elsewhere, if inotify is
+ * unavailable, or if polling is asked for, update() checks each watched
+ * file's modification time once every poll interval instead. Should inotify
+ * drop events, update() checks every file's modification time at once.
+ */
+class HotReloader {
+  public:
+    //! @brief given a data file's new contents; called on the render thread, from update()
+    typedef std::function<void(std::span<const std::byte> contents)> FileCallback;
+
+    enum class ChangeDetection {
+      //! @brief be told of changes by the operating system where it can, and poll otherwise
+      kNotify,
+      //! @brief always poll, as for file systems which don't report changes, such as some network shares
+      kPoll
+    };
+
+    static constexpr std::chrono::milliseconds kDefaultPollInterval { 250 };
+
+    HotReloader(
+      const Renderer& renderer,
+      std::chrono::milliseconds pollInterval = kDefaultPollInterval,
+      ChangeDetection changeDetection = ChangeDetection::kNotify
+    );
+    HotReloader(HotReloader&& other);
+    //! @brief waits for outstanding reloads, which are then discarded
+    ~HotReloader();
+
+    /**
+     * @brief replace textureHandle's texture whenever the image file at filePath changes
+     *
+     * The watch doesn't keep the texture alive. Once every handle to it is
+     * gone, the file's next change drops the watch, and the file with it if
+     * nothing else watches it.
+     */
+    void watch(const std::filesystem::path& filePath, TextureHandle textureHandle);
+    //! @brief call fileCallback with the contents of the file at filePath whenever it changes
+    void watch(const std::filesystem::path& filePath, FileCallback fileCallback);
+    //! @brief load a texture through textureCache, and watch its file
+    TextureHandle load(TextureCache& textureCache, const std::filesystem::path& filePath);
+
+    /**
+     * @brief start reloading changed files and swap in those which have finished; render thread only.
+     *
+     * @return the number of files swapped in.
+     */
+    std::size_t update();
+
+    //! @brief the number of distinct files watched
+    std::size_t getWatchCount() const;
+    //! @brief true if changes are reported by the operating system rather than found by polling
+    bool isNotified() const;
+
+  private:
+    std::unique_ptr<HotReloaderImpl> _hotReloaderImpl;
+};
+
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef __SDL_TOOLS_SCENE_H__
+#define __SDL_TOOLS_SCENE_H__
+
+#include <cstddef>
+#include <memory>
+
+#include "color.h"
+#include "rectangle.h"
+#include "renderer.h"
+
+#include "sprite.h"
+
+namespace sdl::tools {
+
+class SceneImpl;
+
+/**
+ * @brief A retained set of sprites which is only redrawn where it changes.
+ *
+ * The scene keeps its contents in a render target texture. Adding, moving or
+ * removing a sprite marks the area it covers as dirty, and render() redraws
+ * just the dirty areas, with overlapping areas merged, before copying the
+ * target to the screen. A frame where nothing changed costs nothing.
+ *
+ * Sprites are drawn in the order they were added and must outlive the scene,
+ * or their removal from it.
+ */
+class Scene {
+  public:
+    typedef std::size_t NodeId;
+
+    Scene(Renderer& renderer, uint32_t width, uint32_t height, const Color& background);
+    Scene(Scene&& other);
+    ~Scene();
+
+    NodeId add(const Sprite& sprite, uint32_t x, uint32_t y);
+    void move(NodeId nodeId, uint32_t x, uint32_t y);
+    void remove(NodeId nodeId);
+
+    //! @brief force a region to be redrawn, e.g. when a sprite's texture has changed
+    void invalidate(const Rectangle& region);
+
+    /**
+     * @brief redraw the dirty regions then copy the scene to the window and present it.
+     *
+     * @return false, without presenting, if nothing was dirty.
+     */
+    bool render();
+
+  private:
+    std::unique_ptr<SceneImpl> _sceneImpl;
+};
+
+}
+
+#endif
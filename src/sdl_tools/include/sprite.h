@@ -4,18 +4,27 @@
 #include <memory>
 
 #include "sprite_renderer.h"
+#include "texture_handle.h"
 
 #include "texture.h"
 
 namespace sdl::tools{
 
+class Scene;
 class SpriteImpl;
 class SpriteRenderer;
 
 class Sprite {
+  friend Scene;
   friend SpriteRenderer;
   public:
-    Sprite(const Texture& texture, const Rectangle& rectangle);
+    //! @brief draw with whatever blend mode the texture has when the sprite is drawn, as set by Texture::setTextureBlendMode
+    static constexpr Texture::BlendMode kTextureBlendMode = 0xff;
+
+    //! @brief a sprite drawn with blendMode, which is applied per draw rather than shared through the texture
+    Sprite(const Texture& texture, const Rectangle& rectangle, Texture::BlendMode blendMode = kTextureBlendMode);
+    //! @brief a sprite whose texture may still be loading; it is skipped when rendered until the texture is ready
+    Sprite(TextureHandle textureHandle, const Rectangle& rectangle, Texture::BlendMode blendMode = kTextureBlendMode);
     Sprite(Sprite&& other);
 
     ~Sprite();
@@ -0,0 +1,66 @@
+#ifndef __SDL_TOOLS_SPRITE_ANIMATOR_H__
+#define __SDL_TOOLS_SPRITE_ANIMATOR_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include <handle_table.h>
+
+#include "rectangle.h"
+
+#include "animation_clip.h"
+#include "sprite_world.h"
+
+namespace sdl::tools {
+
+class SpriteAnimatorImpl;
+
+/**
+ * @brief Plays animation clips on the sprites of a SpriteWorld.
+ *
+ * Clips are copied into one shared frame table when added, and the state of
+ * every playing animation is kept in packed arrays, so advance walks them
+ * all in a single pass without allocating. A sprite's source rectangle is
+ * only written when its frame changes.
+ */
+class SpriteAnimator {
+  public:
+    typedef vodden::HandleTable::Handle AnimatedSprite;
+    typedef uint32_t ClipId;
+
+    //! @brief animate sprites of world, which must outlive the animator
+    explicit SpriteAnimator(SpriteWorld& world);
+    SpriteAnimator(SpriteAnimator&& other);
+    ~SpriteAnimator();
+
+    ClipId addClip(const AnimationClip& clip);
+
+    //! @brief show the clip's first frame on the sprite and start playing it. Throws std::out_of_range for unknown clips or removed sprites.
+    AnimatedSprite play(SpriteWorld::SpriteId spriteId, ClipId clipId);
+    //! @brief stop animating, leaving the sprite on its current frame
+    void stop(AnimatedSprite animatedSprite);
+    bool contains(AnimatedSprite animatedSprite) const;
+    std::size_t size() const;
+
+    //! @brief whether a clip played once has reached its end; looping clips never finish
+    bool isFinished(AnimatedSprite animatedSprite) const;
+    //! @brief the current frame within the animation's clip
+    std::size_t getFrame(AnimatedSprite animatedSprite) const;
+
+    //! @brief move every animation on by elapsed
+    void advance(AnimationClip::Duration elapsed);
+
+    //! @brief the source rectangles of every frame of every clip
+    std::span<const Rectangle> getFrameSources() const;
+    //! @brief the current frame of each animation, as an index into getFrameSources(); valid until the next play or stop
+    std::span<const uint32_t> getFrames() const;
+
+  private:
+    std::unique_ptr<SpriteAnimatorImpl> _spriteAnimatorImpl;
+};
+
+}
+
+#endif
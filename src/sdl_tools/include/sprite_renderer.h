@@ -1,6 +1,7 @@
 #ifndef __SDL_TOOLS_SPRITE_RENDERER_H__
 #define __SDL_TOOLS_SPRITE_RENDERER_H__
 
+#include <cstdint>
 #include <memory>
 
 #include "renderer.h"
@@ -12,15 +13,34 @@ namespace sdl::tools {
 class Sprite;
 class SpriteRendererImpl;
 
+/**
+ * @brief Draws sprites in frame-scoped batches.
+ *
+ * Calls to render() only queue a draw command. The queue is emitted when
+ * flush() or endFrame() is called, so a frame costs one present regardless
+ * of how many sprites are drawn.
+ *
+ * Each draw is keyed by its z, its sprite's blend mode and its texture, in
+ * that order of significance, and the queue is stably radix sorted on the
+ * key. Layers are drawn in increasing z, and within a layer the draws are
+ * grouped so that each blend mode and texture is switched to once; draws
+ * sharing all three keep the order they were queued in.
+ */
 class SpriteRenderer {
   public:
     SpriteRenderer(const Renderer& renderer);
     SpriteRenderer(SpriteRenderer&& other);
     ~SpriteRenderer();
 
-    //! @brief render the provided sprite at the provided locations
-    void render(const Sprite& sprite, const uint32_t x, const uint32_t y) const;
-  
+    //! @brief queue the provided sprite to be rendered at the provided location, over every sprite of lower z
+    void render(const Sprite& sprite, const uint32_t x, const uint32_t y, const int16_t z = 0);
+
+    //! @brief emit every queued draw to the renderer, in key order, without presenting
+    void flush();
+
+    //! @brief flush the queued draws and present the frame
+    void endFrame();
+
   private:
     std::unique_ptr<SpriteRendererImpl> _spriteRendererImpl;
 };
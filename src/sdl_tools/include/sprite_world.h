@@ -0,0 +1,108 @@
+#ifndef __SDL_TOOLS_SPRITE_WORLD_H__
+#define __SDL_TOOLS_SPRITE_WORLD_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include <handle_table.h>
+
+#include "rectangle.h"
+#include "texture.h"
+
+#include "geometry_batch.h"
+
+namespace sdl::tools {
+
+class SpriteWorldImpl;
+
+/**
+ * @brief Sprite instances stored as parallel arrays for large scenes.
+ *
+ * Each property of every sprite lives in its own packed array, so passes
+ * over the whole world walk memory linearly and a sprite costs no
+ * allocations of its own. Gameplay code keeps a SpriteId, which stays valid
+ * as other sprites come and go; the index it maps to does not, as removing
+ * a sprite moves the last one into its place.
+ *
+ * Positions are in world co-ordinates, and render draws the world as seen
+ * from a camera position.
+ */
+class SpriteWorld {
+  public:
+    typedef vodden::HandleTable::Handle SpriteId;
+    typedef uint32_t TextureId;
+
+    typedef uint8_t SpriteFlag;
+    //! @brief the sprite is kept but not drawn
+    static constexpr SpriteFlag kHidden = 1 << 0;
+
+    //! @brief the area of the world shown, which is drawn at the window's top left
+    struct Camera {
+      float x;
+      float y;
+      float width;
+      float height;
+    };
+
+    SpriteWorld();
+    SpriteWorld(SpriteWorld&& other);
+    ~SpriteWorld();
+
+    //! @brief make a texture available to sprites. It must outlive the world.
+    TextureId addTexture(const Texture& texture);
+    const Texture& getTexture(TextureId textureId) const;
+
+    //! @brief add a sprite drawn at its source rectangle's size
+    SpriteId add(TextureId textureId, const Rectangle& source, float x, float y, int32_t z = 0, SpriteFlag flags = 0);
+    void remove(SpriteId spriteId);
+    bool contains(SpriteId spriteId) const;
+
+    void setPosition(SpriteId spriteId, float x, float y);
+    void setSize(SpriteId spriteId, float width, float height);
+    void setSource(SpriteId spriteId, TextureId textureId, const Rectangle& source);
+    //! @brief change the source rectangle within the sprite's current texture, e.g. to show another animation frame
+    void setSource(SpriteId spriteId, const Rectangle& source);
+    //! @brief sprites are drawn in increasing z, and in no particular order within a z
+    void setZ(SpriteId spriteId, int32_t z);
+    void setFlags(SpriteId spriteId, SpriteFlag flags);
+
+    //! @brief the index of a sprite in the arrays below, until the next remove. Throws std::out_of_range for removed sprites.
+    std::size_t getIndex(SpriteId spriteId) const;
+    std::size_t size() const;
+
+    std::span<const float> getX() const;
+    std::span<const float> getY() const;
+    std::span<const float> getWidth() const;
+    std::span<const float> getHeight() const;
+    std::span<const int32_t> getZ() const;
+    std::span<const TextureId> getTextureIds() const;
+    std::span<const Rectangle> getSources() const;
+    std::span<const SpriteFlag> getFlags() const;
+
+    /**
+     * @brief the indices, in increasing order, of the sprites overlapping the camera.
+     *
+     * The test runs over the position and size arrays several sprites at a
+     * time where the build targets SSE2, AVX2 or NEON. The span is valid until
+     * the next cull or render.
+     */
+    std::span<const uint32_t> cull(const Camera& camera) const;
+
+    /**
+     * @brief draw every sprite overlapping the camera which isn't hidden.
+     *
+     * The batch is flushed after each z layer, so the calls made are one per
+     * texture per layer. Only the visible sprites are ordered by z, and not
+     * at all when every sprite shares a z.
+     */
+    void render(GeometryBatch& geometryBatch, const Camera& camera) const;
+
+  private:
+    std::unique_ptr<SpriteWorldImpl> _spriteWorldImpl;
+};
+
+}
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef __SDL_TOOLS_STARTUP_H__
+#define __SDL_TOOLS_STARTUP_H__
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "baked_image.h"
+#include "renderer.h"
+#include "texture.h"
+
+#include "texture_atlas.h"
+
+namespace sdl::tools {
+
+class StartupImpl;
+
+/**
+ * @brief Overlaps the CPU side of start up with creating the window and renderer.
+ *
+ * Images, atlases and data blobs are queued first. begin() then decodes,
+ * packs and reads them on the shared thread pool while the calling thread
+ * goes on to create the window and renderer, which SDL wants done on the main
+ * thread; wrapping that in time() adds it to the report. finish() waits for
+ * the CPU work and uploads every texture in one batch.
+ *
+ * A Startup usually outlives the window and renderer it overlaps with, so
+ * the results are taken out of it rather than lent, and can then be
+ * destroyed before the renderer is.
+ *
+ * Each stage is reported as the span from its first piece of work starting
+ * to its last finishing, measured from begin(), so stages which overlap are
+ * easy to spot.
+ */
+class Startup {
+  public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::size_t ImageId;
+    typedef std::size_t AtlasId;
+    typedef std::size_t BlobId;
+
+    struct StageTiming {
+      std::string name;
+      //! @brief when the stage's first piece of work started, after begin()
+      Clock::duration start;
+      Clock::duration duration;
+    };
+
+    struct Report {
+      //! @brief in the order each stage first started
+      std::vector<StageTiming> stages;
+      //! @brief from begin() to the end of finish()
+      Clock::duration total;
+    };
+
+    Startup();
+    Startup(const Startup& other) = delete;
+    Startup(Startup&& other) noexcept;
+    //! @brief waits for any work begin() started
+    ~Startup();
+
+    Startup& operator=(const Startup& other) = delete;
+    Startup& operator=(Startup&& other) noexcept;
+
+    //! @brief queue an image file to be decoded and uploaded as its own texture
+    ImageId addImage(std::filesystem::path filePath);
+    //! @brief queue an encoded image in cpu memory, which must outlive finish()
+    ImageId addImage(const void* location, std::size_t size);
+    //! @brief queue a baked image; it needs no decoding, but its upload joins the batch
+    ImageId addImage(const BakedImage& bakedImage);
+
+    //! @brief queue an atlas, to be packed once its images have been decoded
+    AtlasId addAtlas(
+      uint32_t pageWidth = TextureAtlas::kDefaultPageSize,
+      uint32_t pageHeight = TextureAtlas::kDefaultPageSize,
+      uint32_t padding = TextureAtlas::kDefaultPadding
+    );
+    //! @brief queue an image file for the atlas; the id is the image's within that atlas
+    TextureAtlas::ImageId addAtlasImage(AtlasId atlasId, std::filesystem::path filePath);
+    //! @brief queue an encoded image in cpu memory for the atlas; it must outlive finish()
+    TextureAtlas::ImageId addAtlasImage(AtlasId atlasId, const void* location, std::size_t size);
+
+    //! @brief queue a file to be read whole into memory
+    BlobId addBlob(std::filesystem::path filePath);
+
+    //! @brief start the queued CPU work on the shared thread pool; nothing more may be queued afterwards
+    void begin();
+
+    /**
+     * @brief call function on this thread, reporting it as a stage of the given name.
+     *
+     * Meant for the work begin() leaves to the calling thread, such as
+     * creating the window and renderer. Returns whatever function returns.
+     */
+    template<class Function>
+    decltype(auto) time(std::string_view name, Function&& function) {
+      const Clock::time_point start = Clock::now();
+      if constexpr (std::is_void_v<std::invoke_result_t<Function>>) {
+        function();
+        record(name, start, Clock::now());
+      } else {
+        decltype(auto) result = function();
+        record(name, start, Clock::now());
+        return result;
+      }
+    }
+
+    /**
+     * @brief wait for the CPU work, upload every texture and report how long each stage took.
+     *
+     * Calls begin() if it has not been called. Throws the first exception any
+     * piece of work threw, once all of the work has stopped.
+     */
+    Report finish(const Renderer& renderer);
+
+    //! @brief the texture uploaded for an image; once finished, and once per image
+    Texture takeTexture(ImageId imageId);
+    //! @brief an atlas, packed and uploaded; once finished, and once per atlas
+    TextureAtlas takeAtlas(AtlasId atlasId);
+    //! @brief the contents of a blob; once finished, and once per blob
+    std::vector<std::byte> takeBlob(BlobId blobId);
+
+  private:
+    //! @brief widen the named stage to cover start to end, adding it if it is new
+    void record(std::string_view name, Clock::time_point start, Clock::time_point end);
+
+    std::unique_ptr<StartupImpl> _startupImpl;
+};
+
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef __SDL_TOOLS_SURFACE_TILES_H__
+#define __SDL_TOOLS_SURFACE_TILES_H__
+
+#include <cstddef>
+#include <utility>
+
+#include <parallel_tiles.h>
+#include <thread_pool.h>
+
+#include "surface.h"
+
+namespace sdl::tools {
+
+/**
+ * @brief process a surface's pixels in row bands of about tileBytes on the shared worker pool.
+ *
+ * fn is called as fn(vodden::PixelView tile, uint32_t firstRow) for each
+ * band, several at once; see vodden::parallelForTiles. The surface must be
+ * one Surface::getPixels can view.
+ */
+template <class Function>
+void parallelForTiles(Surface& surface, std::size_t tileBytes, Function&& fn) {
+  vodden::parallelForTiles(surface.getPixels(), tileBytes, std::forward<Function>(fn), vodden::ThreadPool::shared());
+}
+
+//! @brief as above, in tiles of vodden::kDefaultTileBytes
+template <class Function>
+void parallelForTiles(Surface& surface, Function&& fn) {
+  parallelForTiles(surface, vodden::kDefaultTileBytes, std::forward<Function>(fn));
+}
+
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef __SDL_TOOLS_TASK_H__
+#define __SDL_TOOLS_TASK_H__
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace sdl::tools {
+
+class TaskScheduler;
+
+/**
+ * @brief A coroutine which a game's flow can be written in, one step after another.
+ *
+ * Any function returning Task may co_await EventDispatcher::next(),
+ * TextureHandles and TaskScheduler::nextFrame(), each of which resumes it on
+ * the thread running the main loop, and may co_await other Tasks. A Task
+ * does nothing until it is given to TaskScheduler::spawn() or awaited, and
+ * destroying it destroys the coroutine wherever it is suspended.
+ *
+ * An exception which escapes a Task is rethrown by whatever awaits it, or
+ * by TaskScheduler::update() if it was spawned.
+ */
+class Task {
+  friend TaskScheduler;
+  public:
+    class promise_type;
+
+    class Awaiter {
+      public:
+        Awaiter(std::coroutine_handle<promise_type> task) : _task { task } {};
+
+        bool await_ready() const noexcept { return !_task || _task.done(); };
+        //! @brief start the awaited task, which resumes the awaiting coroutine when it finishes
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+          _task.promise()._continuation = awaiting;
+          return _task;
+        };
+        void await_resume() const {
+          if(_task && _task.promise()._exception) std::rethrow_exception(_task.promise()._exception);
+        };
+
+      private:
+        std::coroutine_handle<promise_type> _task;
+    };
+
+    class promise_type {
+      friend Task;
+      friend Awaiter;
+      friend TaskScheduler;
+      public:
+        Task get_return_object() { return Task { std::coroutine_handle<promise_type>::from_promise(*this) }; };
+        std::suspend_always initial_suspend() noexcept { return {}; };
+        auto final_suspend() noexcept {
+          // hands straight over to the awaiting coroutine, so that long chains of tasks don't grow the stack
+          struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; };
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> task) noexcept {
+              const std::coroutine_handle<> continuation = task.promise()._continuation;
+              return continuation ? continuation : std::noop_coroutine();
+            };
+            void await_resume() const noexcept {};
+          };
+          return FinalAwaiter {};
+        };
+        void return_void() {};
+        void unhandled_exception() { _exception = std::current_exception(); };
+
+      private:
+        std::coroutine_handle<> _continuation {};
+        std::exception_ptr _exception {};
+    };
+
+    Task(Task&& other) noexcept : _task { std::exchange(other._task, {}) } {};
+    Task(const Task& other) = delete;
+    ~Task() { if(_task) _task.destroy(); };
+
+    Task& operator=(Task&& other) noexcept {
+      if(this == &other) return *this;
+      if(_task) _task.destroy();
+      _task = std::exchange(other._task, {});
+      return *this;
+    };
+    Task& operator=(const Task& other) = delete;
+
+    Awaiter operator co_await() const noexcept { return { _task }; };
+
+    //! @brief true once the coroutine has returned or thrown
+    bool isDone() const { return !_task || _task.done(); };
+
+  private:
+    explicit Task(std::coroutine_handle<promise_type> task) : _task { task } {};
+
+    std::coroutine_handle<promise_type> _task;
+};
+
+}
+
+#endif
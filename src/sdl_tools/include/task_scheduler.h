@@ -0,0 +1,80 @@
+#ifndef __SDL_TOOLS_TASK_SCHEDULER_H__
+#define __SDL_TOOLS_TASK_SCHEDULER_H__
+
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+
+#include "task.h"
+
+namespace sdl::tools {
+
+class TaskSchedulerImpl;
+
+/**
+ * @brief Runs Tasks on the main loop, without threads, resuming them once per frame.
+ *
+ * update() is called once a frame on the render thread. Tasks awaiting
+ * nextFrame() resume there, while those awaiting an event or a texture
+ * resume as soon as the dispatcher or loader has it. So the flow of a game
+ * reads top to bottom:
+ *
+ *   Task playTurns(EventDispatcher& eventDispatcher, TaskScheduler& taskScheduler) {
+ *     bool crossesTurn = false;
+ *     while(true) {
+ *       const auto click = co_await eventDispatcher.next<MouseButtonEvent>();
+ *       place(crossesTurn ? letterX : letterO, click.x, click.y);
+ *       crossesTurn = !crossesTurn;
+ *       co_await taskScheduler.nextFrame();
+ *     }
+ *   }
+ *
+ *   taskScheduler.spawn(playTurns(eventDispatcher, taskScheduler));
+ *
+ * Destroying the scheduler destroys its tasks wherever they are suspended,
+ * so it must be destroyed before the dispatchers they may be waiting on.
+ */
+class TaskScheduler {
+  public:
+    class FrameAwaiter {
+      public:
+        FrameAwaiter(TaskSchedulerImpl& taskSchedulerImpl) : _taskSchedulerImpl { taskSchedulerImpl } {};
+
+        bool await_ready() const noexcept { return false; };
+        void await_suspend(std::coroutine_handle<> awaiting);
+        void await_resume() const noexcept {};
+
+      private:
+        TaskSchedulerImpl& _taskSchedulerImpl;
+    };
+
+    TaskScheduler();
+    TaskScheduler(TaskScheduler&& other);
+    ~TaskScheduler();
+
+    //! @brief run task until it first suspends, then keep it until it finishes
+    void spawn(Task task);
+
+    //! @brief an awaitable which resumes at the next call to update()
+    [[nodiscard]] FrameAwaiter nextFrame();
+
+    /**
+     * @brief resume the tasks awaiting nextFrame() and release finished tasks; render thread only.
+     *
+     * The first exception to have escaped a finished task is rethrown, after
+     * the rest have been resumed.
+     *
+     * @return the number of tasks resumed.
+     */
+    std::size_t update();
+
+    //! @brief the number of spawned tasks which haven't finished, as of the last update()
+    std::size_t getTaskCount() const;
+
+  private:
+    std::unique_ptr<TaskSchedulerImpl> _taskSchedulerImpl;
+};
+
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef __SDL_TOOLS_TEXT_RENDERER_H__
+#define __SDL_TOOLS_TEXT_RENDERER_H__
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include <handle_table.h>
+
+#include "color.h"
+#include "font.h"
+#include "renderer.h"
+#include "texture.h"
+
+#include "geometry_batch.h"
+
+namespace sdl::tools {
+
+class TextRendererImpl;
+
+/**
+ * @brief Draws strings of one font from a cache of rasterized glyphs.
+ *
+ * Each glyph is rasterized the first time a string needs it and packed
+ * into a single atlas texture, and each string is laid out once, as it is
+ * added or changed, into the glyph quads it draws with. Drawing is then
+ * one pass over those quads into a GeometryBatch, which draws every string
+ * with one call as they share the atlas. Glyphs are white, and tinted to
+ * each string's colour by the batch. The layout handles newlines and the
+ * font's kerning, and no further shaping.
+ */
+class TextRenderer {
+  public:
+    typedef vodden::HandleTable::Handle TextId;
+
+    static constexpr uint32_t kDefaultAtlasSize = 1024;
+
+    //! @brief draw with font, which must outlive the renderer
+    TextRenderer(const Renderer& renderer, const Font& font, uint32_t atlasSize = kDefaultAtlasSize);
+    TextRenderer(TextRenderer&& other);
+    ~TextRenderer();
+
+    /**
+     * @brief add UTF-8 text with its top left at x, y.
+     *
+     * When a glyph it needs doesn't fit in what is left of the atlas, the
+     * atlas is emptied and every text laid out again, which drops the glyphs
+     * no text uses any more. Throws std::length_error if the glyphs in use
+     * still don't fit together.
+     */
+    TextId add(std::string_view text, float x, float y, const Color& color = GeometryBatch::kNoTint);
+    void remove(TextId textId);
+    bool contains(TextId textId) const;
+
+    //! @brief replace the text, laying it out again only if it differs; may empty the atlas as add does
+    void setText(TextId textId, std::string_view text);
+    void setPosition(TextId textId, float x, float y);
+    void setColor(TextId textId, const Color& color);
+
+    //! @brief the size of the laid out text
+    float getWidth(TextId textId) const;
+    float getHeight(TextId textId) const;
+
+    //! @brief queue every text's glyphs into geometryBatch, which is left to be flushed
+    void render(GeometryBatch& geometryBatch) const;
+
+    const Texture& getAtlas() const;
+
+  private:
+    std::unique_ptr<TextRendererImpl> _textRendererImpl;
+};
+
+}
+
+#endif
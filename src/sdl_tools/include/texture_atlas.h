@@ -0,0 +1,61 @@
+#ifndef __SDL_TOOLS_TEXTURE_ATLAS_H__
+#define __SDL_TOOLS_TEXTURE_ATLAS_H__
+
+#include <cstddef>
+#include <memory>
+
+#include "renderer.h"
+#include "surface.h"
+
+#include "sprite.h"
+
+namespace sdl::tools {
+
+class TextureAtlasImpl;
+
+/**
+ * @brief Packs many images into a few large textures.
+ *
+ * Images are queued with add() and packed, tallest first, into pages of at
+ * most pageWidth by pageHeight when build() is called. Packing touches only
+ * CPU memory, so it can also be done ahead of time, on any thread, with
+ * pack(), leaving build() just the upload. The sprites handed back
+ * by getSprite() reference sub-rectangles of those pages, so a SpriteRenderer
+ * can draw everything from one page with a single texture bind.
+ */
+class TextureAtlas {
+  public:
+    typedef std::size_t ImageId;
+
+    static constexpr uint32_t kDefaultPageSize = 2048;
+    //! @brief the transparent gap left between packed images, to stop neighbours bleeding when filtered
+    static constexpr uint32_t kDefaultPadding = 1;
+
+    TextureAtlas(uint32_t pageWidth = kDefaultPageSize, uint32_t pageHeight = kDefaultPageSize, uint32_t padding = kDefaultPadding);
+    TextureAtlas(TextureAtlas&& other);
+    ~TextureAtlas();
+
+    //! @brief queue a surface for packing; throws std::invalid_argument if it is larger than a page
+    ImageId add(Surface&& surface);
+    //! @brief queue an encoded image already held in cpu memory, e.g. one embedded by the data target
+    ImageId add(const void* location, std::size_t size);
+
+    //! @brief pack every queued image into page surfaces, without touching the renderer; may only be called once
+    void pack();
+
+    //! @brief pack every queued image, unless pack() already has, and upload the pages; may only be called once
+    void build(const Renderer& renderer);
+
+    //! @brief a sprite covering the provided image; only valid once the atlas is built
+    Sprite getSprite(ImageId imageId) const;
+
+    //! @brief the number of textures the images were packed into
+    std::size_t getPageCount() const;
+
+  private:
+    std::unique_ptr<TextureAtlasImpl> _textureAtlasImpl;
+};
+
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef __SDL_TOOLS_TEXTURE_CACHE_H__
+#define __SDL_TOOLS_TEXTURE_CACHE_H__
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+#include "renderer.h"
+
+#include "texture_handle.h"
+
+namespace sdl::tools {
+
+class TextureCacheImpl;
+
+/**
+ * @brief Loads each texture once and shares it between everything that asks for it.
+ *
+ * Files are keyed by path and in-memory images by a hash of their content,
+ * so loading the same image twice returns a handle to the same texture.
+ *
+ * The cache keeps recently used textures resident after their last outside
+ * handle goes away. Once the estimated footprint of everything resident
+ * passes the budget, the least recently used textures which nothing else
+ * references are released. Textures still in use are never released, so the
+ * budget can be exceeded while they are held.
+ */
+class TextureCache {
+  public:
+    static constexpr std::size_t kDefaultBudget = 256 * 1024 * 1024;
+
+    TextureCache(const Renderer& renderer, std::size_t budget = kDefaultBudget);
+    TextureCache(TextureCache&& other);
+    ~TextureCache();
+
+    //! @brief the texture for a file on disk, loading it if it isn't resident
+    TextureHandle load(const std::filesystem::path& filePath);
+    //! @brief the texture for an encoded image in cpu memory, loading it if identical content isn't resident
+    TextureHandle load(const void* location, std::size_t size);
+
+    //! @brief release unreferenced textures, least recently used first, until the cache is within budget
+    void trim();
+
+    void setBudget(std::size_t budget);
+    std::size_t getBudget() const;
+    //! @brief the estimated video memory used by resident textures, at four bytes a pixel
+    std::size_t getResidentBytes() const;
+    //! @brief the number of resident textures
+    std::size_t size() const;
+
+  private:
+    std::unique_ptr<TextureCacheImpl> _textureCacheImpl;
+};
+
+}
+
+#endif
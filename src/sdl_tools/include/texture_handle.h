@@ -0,0 +1,74 @@
+#ifndef __SDL_TOOLS_TEXTURE_HANDLE_H__
+#define __SDL_TOOLS_TEXTURE_HANDLE_H__
+
+#include <coroutine>
+#include <memory>
+
+#include "texture.h"
+
+namespace sdl::tools {
+
+class TextureHandleImpl;
+class AsyncTextureLoaderImpl;
+class TextureCacheImpl;
+class HotReloader;
+
+/**
+ * @brief A shared reference to a texture which may still be loading.
+ *
+ * Copies of a handle refer to the same texture, which is destroyed along with
+ * the last handle. Until the texture has been uploaded get() returns nullptr,
+ * so a handle can be given to a Sprite straight away and the sprite simply
+ * isn't drawn until its texture arrives. A Task may also co_await a handle,
+ * which resumes it once the texture is ready or has failed.
+ */
+class TextureHandle {
+  friend AsyncTextureLoaderImpl;
+  friend TextureCacheImpl;
+  friend HotReloader;
+  public:
+    enum class Status {
+      kPending,
+      kReady,
+      kFailed
+    };
+
+    //! @brief resumes a coroutine from the loader's update() once the texture is no longer pending
+    class Awaiter {
+      public:
+        Awaiter(std::shared_ptr<TextureHandleImpl> textureHandleImpl) : _textureHandleImpl { std::move(textureHandleImpl) } {};
+        Awaiter(const Awaiter& other) = delete;
+        ~Awaiter();
+
+        bool await_ready() const noexcept;
+        void await_suspend(std::coroutine_handle<> awaiting);
+        //! @brief the handle, now ready or failed
+        TextureHandle await_resume();
+
+      private:
+        std::shared_ptr<TextureHandleImpl> _textureHandleImpl;
+        std::coroutine_handle<> _awaiting {};
+    };
+
+    //! @brief a handle which owns an already uploaded texture
+    TextureHandle(Texture&& texture);
+
+    Status getStatus() const;
+    bool isReady() const { return getStatus() == Status::kReady; };
+
+    //! @brief the texture, or nullptr until it is ready; only use it on the render thread
+    const Texture* get() const;
+
+    Awaiter operator co_await() const { return { _textureHandleImpl }; };
+
+    bool operator==(const TextureHandle& other) const { return _textureHandleImpl == other._textureHandleImpl; };
+
+  private:
+    TextureHandle(std::shared_ptr<TextureHandleImpl> textureHandleImpl) : _textureHandleImpl { std::move(textureHandleImpl) } {};
+
+    std::shared_ptr<TextureHandleImpl> _textureHandleImpl;
+};
+
+}
+
+#endif
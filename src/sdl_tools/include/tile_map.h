@@ -0,0 +1,96 @@
+#ifndef __SDL_TOOLS_TILE_MAP_H__
+#define __SDL_TOOLS_TILE_MAP_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+
+#include "rectangle.h"
+#include "renderer.h"
+#include "texture.h"
+
+namespace sdl::tools {
+
+class TileMapImpl;
+
+/**
+ * @brief A grid of tiles drawn from a tileset, cached in square chunks.
+ *
+ * Tile n of the tileset is the nth tileWidth by tileHeight cell, counting
+ * left to right and then top to bottom. The map is split into chunks of
+ * chunkSize by chunkSize tiles, each of which is drawn once into a render
+ * target texture and then copied to the screen whole. Only chunks overlapping
+ * the view are drawn, and changing a tile only redraws its own chunk.
+ *
+ * At most cachedChunks chunk textures are kept, the least recently drawn
+ * being reused first, so memory stays bounded however large the map; the
+ * cache grows if more chunks than that are in view at once. The renderer
+ * must support render targets and the tileset must outlive the map.
+ *
+ * Some renderers lose the contents of their render targets, reporting
+ * SDL_RENDER_TARGETS_RESET; call invalidate() then, and the chunks are
+ * redrawn as they next come into view.
+ */
+class TileMap {
+  public:
+    typedef uint16_t TileId;
+    //! @brief a cell with nothing in it
+    static constexpr TileId kNoTile = 0xffff;
+
+    static constexpr uint32_t kDefaultChunkSize = 16;
+    static constexpr std::size_t kDefaultCachedChunks = 64;
+
+    struct Cell {
+      uint32_t column;
+      uint32_t row;
+    };
+
+    TileMap(
+      Renderer& renderer,
+      const Texture& tileset,
+      uint32_t tileWidth,
+      uint32_t tileHeight,
+      uint32_t columns,
+      uint32_t rows,
+      uint32_t chunkSize = kDefaultChunkSize,
+      std::size_t cachedChunks = kDefaultCachedChunks
+    );
+    TileMap(TileMap&& other);
+    ~TileMap();
+
+    //! @brief throws std::out_of_range outside the map, and std::invalid_argument for an id past the tileset's last tile
+    void setTile(uint32_t column, uint32_t row, TileId tileId);
+    TileId getTile(uint32_t column, uint32_t row) const;
+    /**
+     * @brief replace every tile, row by row; tiles must hold columns * rows ids.
+     *
+     * Throws std::invalid_argument, leaving the map as it was, if any id is
+     * past the tileset's last tile.
+     */
+    void setTiles(std::span<const TileId> tiles);
+
+    //! @brief redraw every chunk when it is next in view, as after its cached texture has lost its contents
+    void invalidate();
+
+    //! @brief the cell under a point in map pixels, or std::nullopt if it is outside the map
+    std::optional<Cell> hitTest(uint32_t x, uint32_t y) const;
+
+    //! @brief draw the part of the map inside view, which is in map pixels, to the top left of the current target
+    void render(const Rectangle& view);
+
+    uint32_t getColumns() const;
+    uint32_t getRows() const;
+    uint32_t getTileWidth() const;
+    uint32_t getTileHeight() const;
+    //! @brief the number of whole tiles in the tileset, ids 0 to one less than this
+    uint32_t getTileCount() const;
+
+  private:
+    std::unique_ptr<TileMapImpl> _tileMapImpl;
+};
+
+}
+
+#endif
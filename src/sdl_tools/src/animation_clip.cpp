@@ -0,0 +1,70 @@
+#include <stdexcept>
+
+#include "animation_clip_impl.h"
+#include "animation_clip.h"
+
+namespace sdl::tools {
+
+void AnimationClipImpl::addFrame(const Rectangle& source, AnimationClip::Duration duration) {
+  if(duration <= AnimationClip::Duration::zero()) throw std::invalid_argument("AnimationClip: frame durations must be positive.");
+  const AnimationClip::Duration start = _frameEnds.empty() ? AnimationClip::Duration::zero() : _frameEnds.back();
+  _sources.push_back(source);
+  _frameEnds.push_back(start + duration);
+}
+
+AnimationClip::AnimationClip(std::span<const Frame> frames, Playback playback) :
+  _animationClipImpl { std::make_unique<AnimationClipImpl>(playback) } {
+  if(frames.empty()) throw std::invalid_argument("AnimationClip: a clip needs at least one frame.");
+
+  _animationClipImpl->_sources.reserve(frames.size());
+  _animationClipImpl->_frameEnds.reserve(frames.size());
+  for(const Frame& frame : frames) _animationClipImpl->addFrame(frame.source, frame.duration);
+}
+
+AnimationClip::AnimationClip(const Rectangle& firstFrame, uint32_t columns, uint32_t frameCount, Duration frameDuration, Playback playback) :
+  _animationClipImpl { std::make_unique<AnimationClipImpl>(playback) } {
+  if(columns == 0 || frameCount == 0) throw std::invalid_argument("AnimationClip: a clip needs at least one frame.");
+
+  _animationClipImpl->_sources.reserve(frameCount);
+  _animationClipImpl->_frameEnds.reserve(frameCount);
+  for(uint32_t i = 0; i < frameCount; ++i) {
+    const Rectangle source {
+      firstFrame.getX() + (i % columns) * firstFrame.getWidth(),
+      firstFrame.getY() + (i / columns) * firstFrame.getHeight(),
+      firstFrame.getWidth(),
+      firstFrame.getHeight()
+    };
+    _animationClipImpl->addFrame(source, frameDuration);
+  }
+}
+
+AnimationClip::AnimationClip(AnimationClip&& other) : _animationClipImpl { std::move(other._animationClipImpl) } { }
+
+AnimationClip::~AnimationClip() {};
+
+AnimationClip& AnimationClip::operator=(AnimationClip&& other) {
+  _animationClipImpl = std::move(other._animationClipImpl);
+  return *this;
+}
+
+std::size_t AnimationClip::getFrameCount() const {
+  return _animationClipImpl->_sources.size();
+}
+
+AnimationClip::Playback AnimationClip::getPlayback() const {
+  return _animationClipImpl->_playback;
+}
+
+AnimationClip::Duration AnimationClip::getDuration() const {
+  return _animationClipImpl->_frameEnds.back();
+}
+
+std::span<const Rectangle> AnimationClip::getSources() const {
+  return _animationClipImpl->_sources;
+}
+
+std::span<const AnimationClip::Duration> AnimationClip::getFrameEnds() const {
+  return _animationClipImpl->_frameEnds;
+}
+
+}
@@ -0,0 +1,30 @@
+#ifndef __SDL_TOOLS_ANIMATION_CLIP_IMPL_H__
+#define __SDL_TOOLS_ANIMATION_CLIP_IMPL_H__
+
+#include <vector>
+
+#include <memory_tracker.h>
+
+#include "rectangle.h"
+
+#include "animation_clip.h"
+
+namespace sdl::tools {
+
+class AnimationClipImpl : public vodden::memory::Tracked<vodden::memory::Category::kGeometry> {
+  friend AnimationClip;
+  public:
+    AnimationClipImpl(AnimationClip::Playback playback) : _playback { playback } {};
+
+  private:
+    //! @brief append a frame; throws std::invalid_argument if its duration is not positive
+    void addFrame(const Rectangle& source, AnimationClip::Duration duration);
+
+    AnimationClip::Playback _playback;
+    std::vector<Rectangle> _sources;
+    std::vector<AnimationClip::Duration> _frameEnds;
+};
+
+}
+
+#endif
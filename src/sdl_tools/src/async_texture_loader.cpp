@@ -0,0 +1,97 @@
+#include <coroutine>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include <thread_pool.h>
+
+#include "async_texture_loader_impl.h"
+#include "async_texture_loader.h"
+
+namespace sdl::tools {
+
+TextureHandle AsyncTextureLoaderImpl::submit(std::function<Surface()> decode) {
+  auto textureHandleImpl = TextureHandleImpl::create();
+  ++_pendingCount;
+  _decodesInFlight.fetch_add(1, std::memory_order_relaxed);
+
+  vodden::ThreadPool::shared().submit([this, textureHandleImpl, decode = std::move(decode)]() {
+    DecodedSurface decodedSurface { textureHandleImpl, std::nullopt };
+    try {
+      decodedSurface.surface.emplace(decode());
+    } catch(const std::exception&) {
+      // reported to the render thread as a surface-less result
+    }
+    publish(std::move(decodedSurface));
+  });
+
+  return TextureHandle { std::move(textureHandleImpl) };
+}
+
+void AsyncTextureLoaderImpl::publish(DecodedSurface&& decodedSurface) {
+  while(!_decodedSurfaces.push(std::move(decodedSurface))) std::this_thread::yield();
+  _decodesInFlight.fetch_sub(1, std::memory_order_release);
+}
+
+AsyncTextureLoader::AsyncTextureLoader(const Renderer& renderer, std::size_t uploadBudget) :
+  _asyncTextureLoaderImpl { std::make_unique<AsyncTextureLoaderImpl>(renderer, uploadBudget) } { }
+
+AsyncTextureLoader::AsyncTextureLoader(AsyncTextureLoader&& other) : _asyncTextureLoaderImpl { std::move(other._asyncTextureLoaderImpl) } { }
+
+AsyncTextureLoader::~AsyncTextureLoader() {
+  if(!_asyncTextureLoaderImpl) return;
+
+  // keep draining so that workers blocked on a full queue can finish
+  auto& decodedSurfaces = _asyncTextureLoaderImpl->_decodedSurfaces;
+  while(true) {
+    const bool finished = _asyncTextureLoaderImpl->_decodesInFlight.load(std::memory_order_acquire) == 0;
+    while(auto decodedSurface = decodedSurfaces.tryPop()) decodedSurface->textureHandleImpl->setFailed();
+    if(finished) break;
+    std::this_thread::yield();
+  }
+}
+
+TextureHandle AsyncTextureLoader::load(std::filesystem::path filePath) {
+  return _asyncTextureLoaderImpl->submit([filePath = std::move(filePath)]() { return Surface { filePath }; });
+}
+
+TextureHandle AsyncTextureLoader::load(const void* location, std::size_t size) {
+  return _asyncTextureLoaderImpl->submit([location, size]() { return Surface { location, size }; });
+}
+
+std::size_t AsyncTextureLoader::update() {
+  auto& impl = *_asyncTextureLoaderImpl;
+  std::size_t completed = 0;
+  std::size_t uploadedBytes = 0;
+  std::vector<std::coroutine_handle<>> waiters;
+
+  while(completed == 0 || uploadedBytes < impl._uploadBudget) {
+    auto decodedSurface = impl._decodedSurfaces.tryPop();
+    if(!decodedSurface) break;
+
+    auto& textureHandleImpl = *decodedSurface->textureHandleImpl;
+    if(decodedSurface->surface) {
+      const Surface& surface = *decodedSurface->surface;
+      uploadedBytes += std::size_t { surface.getWidth() } * surface.getHeight() * 4;
+      try {
+        textureHandleImpl.setTexture(Texture { impl._renderer, surface });
+      } catch(const std::exception&) {
+        textureHandleImpl.setFailed();
+      }
+    } else {
+      textureHandleImpl.setFailed();
+    }
+    textureHandleImpl.takeWaiters(waiters);
+    --impl._pendingCount;
+    ++completed;
+  }
+  // resumed once the loop is done with the queue, as the coroutines may well load more
+  for(const auto awaiting : waiters) awaiting.resume();
+  return completed;
+}
+
+std::size_t AsyncTextureLoader::getPendingCount() const {
+  return _asyncTextureLoaderImpl->_pendingCount;
+}
+
+}
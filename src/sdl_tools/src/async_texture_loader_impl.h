@@ -0,0 +1,49 @@
+#ifndef __SDL_TOOLS_ASYNC_TEXTURE_LOADER_IMPL_H__
+#define __SDL_TOOLS_ASYNC_TEXTURE_LOADER_IMPL_H__
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include <memory_tracker.h>
+#include <mpsc_queue.h>
+
+#include "renderer.h"
+#include "surface.h"
+
+#include "async_texture_loader.h"
+#include "texture_handle_impl.h"
+
+namespace sdl::tools {
+
+//! @brief the result of a decode, passed from a worker to the render thread
+struct DecodedSurface {
+  std::shared_ptr<TextureHandleImpl> textureHandleImpl;
+  //! @brief empty if the image could not be decoded
+  std::optional<Surface> surface;
+};
+
+class AsyncTextureLoaderImpl : public vodden::memory::Tracked<vodden::memory::Category::kTextures> {
+  friend AsyncTextureLoader;
+  public:
+    AsyncTextureLoaderImpl(const Renderer& renderer, std::size_t uploadBudget) : _renderer { renderer }, _uploadBudget { uploadBudget } {};
+
+  private:
+    static constexpr std::size_t kQueueCapacity = 256;
+
+    //! @brief decode on the shared thread pool and queue the result for upload
+    TextureHandle submit(std::function<Surface()> decode);
+    //! @brief queue a decoded surface, waiting for space if the render thread has fallen behind; worker threads only
+    void publish(DecodedSurface&& decodedSurface);
+
+    const Renderer& _renderer;
+    std::size_t _uploadBudget;
+    std::size_t _pendingCount { 0 };
+    std::atomic<std::size_t> _decodesInFlight { 0 };
+    vodden::MpscQueue<DecodedSurface, kQueueCapacity> _decodedSurfaces;
+};
+
+}
+
+#endif
@@ -1,5 +1,7 @@
-#include <iostream>
 #include <memory>
+#include <utility>
+
+#include <window.h>
 
 #include "button_impl.h"
 #include "button.h"
@@ -8,12 +10,27 @@ namespace sdl::tools {
 
 void ButtonImpl::MouseEventHandler::handle([[maybe_unused]] const sdl::MouseButtonEvent &mouseButtonEvent) {
   if(_rectangle.contains(mouseButtonEvent.x, mouseButtonEvent.y) ) {
-    for(auto& handler : _eventHandlers) handler(mouseButtonEvent);
+    for(const Button::Handler& handler : _eventHandlers) handler(mouseButtonEvent);
   }
 }
 
 Button::Button(EventDispatcher &eventProcessor, sdl::Rectangle rectangle) : _buttonImpl { std::make_unique<ButtonImpl>(eventProcessor, rectangle) } {
-  _buttonImpl->_eventProcessor.registerEventHandler(_buttonImpl->_mouseEventHandler);
+  _buttonImpl->_registration = _buttonImpl->_eventProcessor.registerEventHandler(_buttonImpl->_mouseEventHandler);
+}
+
+Button::Button(EventDispatcher &eventProcessor, const sdl::Window &window, sdl::Rectangle rectangle) :
+  _buttonImpl { std::make_unique<ButtonImpl>(eventProcessor, rectangle) } {
+  _buttonImpl->_registration = _buttonImpl->_eventProcessor.registerEventHandler(
+    _buttonImpl->_mouseEventHandler,
+    EventDispatcher::ExecutionPolicy::kInline,
+    window.getId()
+  );
+}
+
+Button::Button(ButtonLayer &buttonLayer, sdl::Rectangle rectangle) :
+  _buttonImpl { std::make_unique<ButtonImpl>(buttonLayer._buttonLayerImpl->_eventDispatcher, rectangle) } {
+  _buttonImpl->_buttonLayerImpl = buttonLayer._buttonLayerImpl.get();
+  _buttonImpl->_buttonLayerImpl->insert(*_buttonImpl, _buttonImpl->_rectangle);
 }
 
 Button::Button(Button &&other) : _buttonImpl { std::move(other._buttonImpl) } {};
@@ -21,16 +38,7 @@ Button::Button(Button &&other) : _buttonImpl { std::move(other._buttonImpl) } {}
 Button::~Button() {}
 
 void Button::registerEventHandler(Handler handler) {
-  _buttonImpl->_eventHandlers.push_front(handler);
+  _buttonImpl->_eventHandlers.push_back(std::move(handler));
 };
 
-void ButtonImpl::eventHandler([[maybe_unused]] const sdl::MousePositionEvent &mousePositionEvent)
-{
-  if(_rectangle.contains(mousePositionEvent.x, mousePositionEvent.y)) {
-    for(const auto& handler : _eventHandlers) {
-      handler(mousePositionEvent);
-    }
-  };
-}
-
 }
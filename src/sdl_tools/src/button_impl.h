@@ -1,41 +1,52 @@
 #ifndef __SDL_TOOLS_BUTTON_IMPL_H__
 #define __SDL_TOOLS_BUTTON_IMPL_H__
 
-#include <forward_list>
-
 #include <event.h>
+#include <memory_tracker.h>
 #include <rectangle.h>
+#include <small_vector.h>
 
 #include "button.h"
+#include "button_layer_impl.h"
 
 namespace sdl::tools {
 
-class ButtonImpl {
+class ButtonImpl : public vodden::memory::Tracked<vodden::memory::Category::kUI> {
   friend Button;
+  friend ButtonLayerImpl;
   public:
     ButtonImpl(EventDispatcher &eventProcessor, sdl::Rectangle& rectangle) : 
       _rectangle { rectangle },
       _eventProcessor { eventProcessor } { };
+    ~ButtonImpl() {
+      if(_buttonLayerImpl != nullptr) _buttonLayerImpl->erase(*this, _rectangle);
+    }
+
+    //! @brief handlers beyond this many per button move to the heap
+    static constexpr std::size_t kInlineHandlers = 2;
+    typedef vodden::SmallVector<Button::Handler, kInlineHandlers> Handlers;
 
     class MouseEventHandler : public sdl::EventHandler<sdl::MouseButtonEvent>, public sdl::BaseEventHandler {
       public:
         MouseEventHandler(
           Rectangle& rectangle,
-          std::forward_list<Button::Handler>& eventHandlers
+          Handlers& eventHandlers
         ) : _rectangle{ rectangle }, _eventHandlers { eventHandlers } { };
         virtual void handle(const sdl::MouseButtonEvent& mouseEvent);
       private:
         Rectangle& _rectangle;
-        std::forward_list<Button::Handler>& _eventHandlers;
+        Handlers& _eventHandlers;
     };
 
   private:
-    void eventHandler(const sdl::MousePositionEvent &mousePositionEvent);
-
     sdl::Rectangle _rectangle;
     EventDispatcher& _eventProcessor;
-    std::forward_list<Button::Handler> _eventHandlers { };
+    // set when the button is hit-tested by a ButtonLayer instead of the dispatcher
+    ButtonLayerImpl* _buttonLayerImpl { nullptr };
+    Handlers _eventHandlers { };
     MouseEventHandler _mouseEventHandler { _rectangle , _eventHandlers };
+    // declared last, so the handler is unregistered before any of it is destroyed
+    EventDispatcher::Registration _registration {};
 };
 
 }
@@ -0,0 +1,59 @@
+#include <algorithm>
+
+#include <window.h>
+
+#include "button_impl.h"
+#include "button_layer_impl.h"
+#include "button_layer.h"
+
+namespace sdl::tools {
+
+void ButtonLayerImpl::MouseEventHandler::handle(const sdl::MouseButtonEvent &mouseButtonEvent) {
+  if(mouseButtonEvent.x < 0 || mouseButtonEvent.y < 0) return;
+
+  const auto cell = _buttonLayerImpl._cells.find(_buttonLayerImpl.cellKey(
+    static_cast<uint32_t>(mouseButtonEvent.x) / _buttonLayerImpl._cellSize,
+    static_cast<uint32_t>(mouseButtonEvent.y) / _buttonLayerImpl._cellSize
+  ));
+  if(cell == _buttonLayerImpl._cells.end()) return;
+
+  auto& candidates = _buttonLayerImpl._candidates;
+  candidates.assign(cell->second.cbegin(), cell->second.cend());
+  // by index, and re-read each time, as a handler may destroy any of the candidates
+  for(std::size_t index = 0; index < candidates.size(); ++index) {
+    if(ButtonImpl* buttonImpl = candidates[index]) buttonImpl->_mouseEventHandler.handle(mouseButtonEvent);
+  }
+  candidates.clear();
+}
+
+void ButtonLayerImpl::insert(ButtonImpl &buttonImpl, const Rectangle &rectangle) {
+  forEachCell(rectangle, [&buttonImpl](std::vector<ButtonImpl*>& cell) { cell.push_back(&buttonImpl); });
+}
+
+void ButtonLayerImpl::erase(ButtonImpl &buttonImpl, const Rectangle &rectangle) {
+  forEachCell(rectangle, [&buttonImpl](std::vector<ButtonImpl*>& cell) {
+    auto iterator = std::find(cell.begin(), cell.end(), &buttonImpl);
+    if(iterator == cell.end()) return;
+    *iterator = cell.back();
+    cell.pop_back();
+  });
+  std::replace(_candidates.begin(), _candidates.end(), &buttonImpl, static_cast<ButtonImpl*>(nullptr));
+}
+
+ButtonLayer::ButtonLayer(EventDispatcher &eventDispatcher, uint32_t cellSize) :
+  _buttonLayerImpl { std::make_unique<ButtonLayerImpl>(eventDispatcher, cellSize) } {
+  _buttonLayerImpl->_registration = eventDispatcher.registerEventHandler(_buttonLayerImpl->_mouseEventHandler);
+}
+
+ButtonLayer::ButtonLayer(EventDispatcher &eventDispatcher, const sdl::Window &window, uint32_t cellSize) :
+  _buttonLayerImpl { std::make_unique<ButtonLayerImpl>(eventDispatcher, cellSize) } {
+  _buttonLayerImpl->_registration = eventDispatcher.registerEventHandler(
+    _buttonLayerImpl->_mouseEventHandler,
+    EventDispatcher::ExecutionPolicy::kInline,
+    window.getId()
+  );
+}
+
+ButtonLayer::~ButtonLayer() {}
+
+}
@@ -0,0 +1,73 @@
+#ifndef __SDL_TOOLS_BUTTON_LAYER_IMPL_H__
+#define __SDL_TOOLS_BUTTON_LAYER_IMPL_H__
+
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <event.h>
+#include <memory_tracker.h>
+#include <rectangle.h>
+
+#include "button_layer.h"
+
+namespace sdl::tools {
+
+class ButtonImpl;
+
+class ButtonLayerImpl : public vodden::memory::Tracked<vodden::memory::Category::kUI> {
+  friend ButtonLayer;
+  friend Button;
+  public:
+    ButtonLayerImpl(EventDispatcher& eventDispatcher, uint32_t cellSize) :
+      _eventDispatcher { eventDispatcher },
+      _cellSize { cellSize } {
+      if(_cellSize == 0) throw std::invalid_argument("ButtonLayer::ButtonLayer: the cell size must be at least 1.");
+    };
+
+    class MouseEventHandler : public sdl::EventHandler<sdl::MouseButtonEvent>, public sdl::BaseEventHandler {
+      public:
+        MouseEventHandler(ButtonLayerImpl& buttonLayerImpl) : _buttonLayerImpl { buttonLayerImpl } {};
+        virtual void handle(const sdl::MouseButtonEvent& mouseButtonEvent);
+      private:
+        ButtonLayerImpl& _buttonLayerImpl;
+    };
+
+    //! @brief add the button to every cell its rectangle overlaps
+    void insert(ButtonImpl& buttonImpl, const Rectangle& rectangle);
+    //! @brief remove the button from every cell its rectangle overlaps, and from the dispatch under way
+    void erase(ButtonImpl& buttonImpl, const Rectangle& rectangle);
+
+  private:
+    typedef uint64_t CellKey;
+
+    CellKey cellKey(uint32_t column, uint32_t row) const {
+      return (static_cast<CellKey>(column) << 32) | row;
+    }
+
+    template<class Function>
+    void forEachCell(const Rectangle& rectangle, Function function) {
+      uint32_t firstColumn = rectangle.getX() / _cellSize;
+      uint32_t lastColumn = (rectangle.getX() + rectangle.getWidth()) / _cellSize;
+      uint32_t firstRow = rectangle.getY() / _cellSize;
+      uint32_t lastRow = (rectangle.getY() + rectangle.getHeight()) / _cellSize;
+      for(uint32_t column = firstColumn; column <= lastColumn; ++column) {
+        for(uint32_t row = firstRow; row <= lastRow; ++row) {
+          function(_cells[cellKey(column, row)]);
+        }
+      }
+    }
+
+    EventDispatcher& _eventDispatcher;
+    const uint32_t _cellSize;
+    std::unordered_map<CellKey, std::vector<ButtonImpl*>> _cells {};
+    // copy of the hit cell, so a handler may create or destroy buttons safely; erase nulls destroyed ones
+    std::vector<ButtonImpl*> _candidates {};
+    MouseEventHandler _mouseEventHandler { *this };
+    // declared last, so the handler is unregistered before any of it is destroyed
+    EventDispatcher::Registration _registration {};
+};
+
+}
+
+#endif
@@ -1,4 +1,11 @@
+#include <algorithm>
 #include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <profiler.h>
+#include <thread_pool.h>
 
 #include "event_dispatcher_impl.h"
 
@@ -8,10 +15,274 @@ void DefaultQuitEventHandler::handle( [[maybe_unused]] const QuitEvent& quitEven
   _eventDispatcherImpl.quit();
 }
 
-EventDispatcher::EventDispatcher( EventProducer eventProducer ) : 
+EventDispatcherImpl::~EventDispatcherImpl() {
+  std::unique_lock lock { _activeStrandsMutex };
+  _activeStrandsChanged.wait(lock, [this]() { return _activeStrands == 0; });
+}
+
+namespace {
+  //! @brief counts a dispatch as under way, and removes what it unregistered when the last one ends
+  class DispatchScope {
+    public:
+      DispatchScope(std::size_t& dispatchDepth, std::vector<vodden::HandleTable::Handle>& pendingRemovals, EventDispatcherImpl& eventDispatcherImpl) :
+        _dispatchDepth { dispatchDepth }, _pendingRemovals { pendingRemovals }, _eventDispatcherImpl { eventDispatcherImpl } {
+        ++_dispatchDepth;
+      }
+      ~DispatchScope() {
+        if(--_dispatchDepth > 0) return;
+        // unregister sees no dispatch under way now, so removes at once
+        while(!_pendingRemovals.empty()) {
+          const vodden::HandleTable::Handle registration = _pendingRemovals.back();
+          _pendingRemovals.pop_back();
+          _eventDispatcherImpl.unregister(registration);
+        }
+      }
+
+    private:
+      std::size_t& _dispatchDepth;
+      std::vector<vodden::HandleTable::Handle>& _pendingRemovals;
+      EventDispatcherImpl& _eventDispatcherImpl;
+  };
+}
+
+void EventDispatcherImpl::dispatch(std::unique_ptr<BaseEvent> &event) {
+  const BaseEvent& currentEvent = *event;
+  const EventTypeId eventTypeId = currentEvent.typeId();
+  if(eventTypeId >= _eventHandlers.size()) addEventType(eventTypeId);
+  VODDEN_PROFILE_COUNT(kEventsDispatched, 1);
+  // the frame being built is the one this event affects, so its latency runs to that frame's present
+  VODDEN_PROFILE_INPUT(currentEvent.getInputTime());
+
+  const DispatchScope dispatchScope { _dispatchDepth, _pendingRemovals, *this };
+  std::shared_ptr<const BaseEvent> sharedEvent;
+  invokeHandlers(0, currentEvent, event, sharedEvent);
+
+  // an event from no window in particular reaches every window's handlers
+  const EventDispatcher::WindowId windowId = currentEvent.getWindowId();
+  for(std::size_t i = 0; i < _windowHandlers.size(); ++i) {
+    if(windowId == EventDispatcher::kAllWindows || _windowHandlers[i].windowId == windowId) {
+      invokeHandlers(i + 1, currentEvent, event, sharedEvent);
+    }
+  }
+}
+
+void EventDispatcherImpl::invokeHandlers(
+  std::size_t table,
+  const BaseEvent& currentEvent,
+  std::unique_ptr<BaseEvent>& event,
+  std::shared_ptr<const BaseEvent>& sharedEvent
+) {
+  const EventTypeId eventTypeId = currentEvent.typeId();
+  // indexed, and looked up afresh, so that handlers may register further handlers while being invoked
+  for(std::size_t i = 0; i < getHandlers(table, eventTypeId).size(); ++i) {
+    const HandlerEntry handlerEntry = getHandlers(table, eventTypeId)[i];
+    if(handlerEntry.eventHandler == nullptr) continue;
+    if(handlerEntry.strand == nullptr) {
+      VODDEN_PROFILE_ZONE("EventHandler::handle");
+      handlerEntry.invoke(handlerEntry.eventHandler, currentEvent);
+      continue;
+    }
+    if(!sharedEvent) sharedEvent.reset(event.release());
+    enqueue(handlerEntry, sharedEvent);
+  }
+}
+
+std::size_t EventDispatcherImpl::getTable(EventDispatcher::WindowId windowId) {
+  if(windowId == EventDispatcher::kAllWindows) return 0;
+  for(std::size_t i = 0; i < _windowHandlers.size(); ++i) {
+    if(_windowHandlers[i].windowId == windowId) return i + 1;
+  }
+  _windowHandlers.push_back({ windowId, {} });
+  return _windowHandlers.size();
+}
+
+std::vector<HandlerEntry>& EventDispatcherImpl::getHandlers(std::size_t table, EventTypeId eventTypeId) {
+  if(table == 0) return _eventHandlers[eventTypeId];
+  auto& eventHandlers = _windowHandlers[table - 1].eventHandlers;
+  if(eventTypeId >= eventHandlers.size()) eventHandlers.resize(eventTypeId + 1);
+  return eventHandlers[eventTypeId];
+}
+
+void EventDispatcherImpl::addEventType(EventTypeId eventTypeId) {
+  while(_eventHandlers.size() <= eventTypeId) {
+    const EventTypeId newEventTypeId = _eventHandlers.size();
+    _eventHandlers.emplace_back();
+    // bound in the order they were registered, which removals have shuffled out of _registrations
+    std::vector<std::size_t> baseRegistrations;
+    for(std::size_t i = 0; i < _registrations.size(); ++i) {
+      if(_registrations[i].baseEventHandler != nullptr) baseRegistrations.push_back(i);
+    }
+    std::sort(baseRegistrations.begin(), baseRegistrations.end(), [this](std::size_t a, std::size_t b) {
+      return _registrations[a].order < _registrations[b].order;
+    });
+    for(const std::size_t index : baseRegistrations) bindEventHandler(newEventTypeId, _registrationHandles.getHandle(index));
+  }
+}
+
+vodden::HandleTable::Handle EventDispatcherImpl::addRegistration(
+  BaseEventHandler* baseEventHandler,
+  EventDispatcher::ExecutionPolicy executionPolicy,
+  EventDispatcher::WindowId windowId
+) {
+  const vodden::HandleTable::Handle registration = _registrationHandles.insert();
+  _registrations.push_back({ baseEventHandler, createStrand(executionPolicy), getTable(windowId), _registrationCount++, {} });
+  if(baseEventHandler != nullptr) {
+    for(EventTypeId eventTypeId = 0; eventTypeId < _eventHandlers.size(); ++eventTypeId) bindEventHandler(eventTypeId, registration);
+  }
+  return registration;
+}
+
+void EventDispatcherImpl::bindEventHandler(EventTypeId eventTypeId, vodden::HandleTable::Handle registration) {
+  BaseEventHandler& baseEventHandler = *_registrations[*_registrationHandles.find(registration)].baseEventHandler;
+  void* eventHandler = sdl::detail::getEventTypeInfo(eventTypeId).probe(baseEventHandler);
+  if(eventHandler != nullptr) addHandlerEntry(eventTypeId, eventHandler, registration);
+}
+
+void EventDispatcherImpl::addHandlerEntry(EventTypeId eventTypeId, void* eventHandler, vodden::HandleTable::Handle registration) {
+  if(eventTypeId >= _eventHandlers.size()) addEventType(eventTypeId);
+  RegistrationEntry& registrationEntry = _registrations[*_registrationHandles.find(registration)];
+  auto& eventHandlers = getHandlers(registrationEntry.table, eventTypeId);
+  registrationEntry.bindings.push_back({ registrationEntry.table, eventTypeId, eventHandlers.size() });
+  eventHandlers.push_back({ eventHandler, sdl::detail::getEventTypeInfo(eventTypeId).invoke, registrationEntry.strand, registration });
+}
+
+void EventDispatcherImpl::unregister(vodden::HandleTable::Handle registration) {
+  const auto index = _registrationHandles.find(registration);
+  if(!index) return;
+  RegistrationEntry& registrationEntry = _registrations[*index];
+
+  if(_dispatchDepth > 0) {
+    // a dispatch may be walking these very entries, so they are only emptied for now
+    for(const Binding& binding : registrationEntry.bindings) getHandlers(binding.table, binding.eventTypeId)[binding.index].eventHandler = nullptr;
+    registrationEntry.baseEventHandler = nullptr;
+    _pendingRemovals.push_back(registration);
+    // events queued for a pool handler are dropped all the same
+    if(registrationEntry.strand != nullptr) cancelStrand(*registrationEntry.strand);
+    return;
+  }
+  remove(registration);
+}
+
+void EventDispatcherImpl::remove(vodden::HandleTable::Handle registration) {
+  RegistrationEntry& registrationEntry = _registrations[*_registrationHandles.find(registration)];
+  for(const Binding& binding : registrationEntry.bindings) {
+    auto& eventHandlers = getHandlers(binding.table, binding.eventTypeId);
+    eventHandlers.erase(eventHandlers.begin() + binding.index);
+    // the entries after it each move down one, and their registrations have to learn where they now sit
+    for(std::size_t i = binding.index; i < eventHandlers.size(); ++i) {
+      for(Binding& movedBinding : _registrations[*_registrationHandles.find(eventHandlers[i].registration)].bindings) {
+        if(movedBinding.table == binding.table && movedBinding.eventTypeId == binding.eventTypeId) movedBinding.index = i;
+      }
+    }
+  }
+
+  if(registrationEntry.strand != nullptr) {
+    cancelStrand(*registrationEntry.strand);
+    _freeStrands.push_back(registrationEntry.strand);
+  }
+
+  const auto move = _registrationHandles.erase(registration);
+  if(move->index != move->from) _registrations[move->index] = std::move(_registrations[move->from]);
+  _registrations.pop_back();
+}
+
+Strand* EventDispatcherImpl::createStrand(EventDispatcher::ExecutionPolicy executionPolicy) {
+  if(executionPolicy == EventDispatcher::ExecutionPolicy::kInline) return nullptr;
+  if(_freeStrands.empty()) return &_strands.emplace_back();
+  Strand* strand = _freeStrands.back();
+  _freeStrands.pop_back();
+  return strand;
+}
+
+void EventDispatcherImpl::cancelStrand(Strand& strand) {
+  {
+    std::scoped_lock lock { strand.mutex };
+    strand.pending.clear();
+  }
+  // runStrand clears scheduled before it takes this lock to notify, so the wakeup can't be missed
+  std::unique_lock lock { _activeStrandsMutex };
+  _activeStrandsChanged.wait(lock, [&strand]() {
+    std::scoped_lock strandLock { strand.mutex };
+    return !strand.scheduled;
+  });
+}
+
+void EventDispatcherImpl::enqueue(const HandlerEntry &handlerEntry, std::shared_ptr<const BaseEvent> event) {
+  Strand& strand = *handlerEntry.strand;
+  {
+    std::scoped_lock lock { strand.mutex };
+    strand.pending.emplace_back(handlerEntry, std::move(event));
+    if(strand.scheduled) return;
+    strand.scheduled = true;
+  }
+  {
+    std::scoped_lock lock { _activeStrandsMutex };
+    ++_activeStrands;
+  }
+  vodden::ThreadPool::shared().submit([this, &strand]() { runStrand(strand); });
+}
+
+void EventDispatcherImpl::runStrand(Strand &strand) {
+  while(true) {
+    std::pair<HandlerEntry, std::shared_ptr<const BaseEvent>> next;
+    {
+      std::scoped_lock lock { strand.mutex };
+      if(strand.pending.empty()) {
+        strand.scheduled = false;
+        break;
+      }
+      next = std::move(strand.pending.front());
+      strand.pending.pop_front();
+    }
+    VODDEN_PROFILE_ZONE("EventHandler::handle");
+    next.first.invoke(next.first.eventHandler, *next.second);
+  }
+
+  std::scoped_lock lock { _activeStrandsMutex };
+  --_activeStrands;
+  _activeStrandsChanged.notify_all();
+}
+
+void EventDispatcherImpl::resumeAll() {
+  std::swap(_resuming, _resumptions);
+  for(const auto awaiting : _resuming) {
+    // null if the coroutine was destroyed by one resumed before it
+    if(awaiting) awaiting.resume();
+  }
+  _resuming.clear();
+}
+
+EventDispatcher::Registration::Registration(Registration&& other) noexcept :
+  _eventDispatcherImpl { std::exchange(other._eventDispatcherImpl, nullptr) },
+  _handle { other._handle } {}
+
+EventDispatcher::Registration::~Registration() {
+  reset();
+}
+
+EventDispatcher::Registration& EventDispatcher::Registration::operator=(Registration&& other) noexcept {
+  if(this == &other) return *this;
+  reset();
+  _eventDispatcherImpl = std::exchange(other._eventDispatcherImpl, nullptr);
+  _handle = other._handle;
+  return *this;
+}
+
+void EventDispatcher::Registration::reset() {
+  if(_eventDispatcherImpl == nullptr) return;
+  _eventDispatcherImpl->unregister(_handle);
+  _eventDispatcherImpl = nullptr;
+}
+
+bool EventDispatcher::Registration::isRegistered() const {
+  return _eventDispatcherImpl != nullptr;
+}
+
+EventDispatcher::EventDispatcher( BaseEventProducer& eventProducer ) : 
     _eventDispatcherImpl { std::make_unique<EventDispatcherImpl>( eventProducer ) }
 {
-  registerEventHandler( _eventDispatcherImpl->defaultQuitEventHandler );
+  // registered for the dispatcher's whole life, so it needs no Registration
+  _eventDispatcherImpl->addRegistration(&_eventDispatcherImpl->defaultQuitEventHandler, ExecutionPolicy::kInline, kAllWindows);
 }
 
 EventDispatcher::~EventDispatcher() {};
@@ -19,18 +290,58 @@ EventDispatcher::~EventDispatcher() {};
 void EventDispatcher::run() {
   std::unique_ptr<BaseEvent> event;
   while( !_eventDispatcherImpl->quitFlag ) {
-    try {
-      event = _eventDispatcherImpl->_eventProducer.wait();
-      for(const auto& handler : _eventDispatcherImpl->_eventHandlers) {
-        event->handle(handler);
-      }
-    } catch ([[maybe_unused]] sdl::UnknownEventException &_) { } // TODO: unknown events are "fine"
+    event = _eventDispatcherImpl->_eventProducer.wait();
+    _eventDispatcherImpl->dispatch(event);
+    _eventDispatcherImpl->resumeAwaiting();
   }
 }
 
-void EventDispatcher::registerEventHandler(BaseEventHandler& baseEventHandler ) {
-  _eventDispatcherImpl->_eventHandlers.push_front(std::ref(baseEventHandler));
+bool EventDispatcher::runFrame() {
+  // a handler calling runFrame mid-dispatch must not drain over the events of the frame dispatching it
+  std::vector<std::unique_ptr<BaseEvent>> nestedFrameEvents;
+  if(_eventDispatcherImpl->_dispatchDepth > 0) nestedFrameEvents.resize(EventDispatcherImpl::kFrameBatchSize);
+  const std::span<std::unique_ptr<BaseEvent>> frameEvents = nestedFrameEvents.empty()
+    ? std::span<std::unique_ptr<BaseEvent>> { _eventDispatcherImpl->_frameEvents }
+    : std::span<std::unique_ptr<BaseEvent>> { nestedFrameEvents };
+  const std::size_t count = _eventDispatcherImpl->_eventProducer.drain(frameEvents);
+  for(std::size_t i = 0; i < count && !_eventDispatcherImpl->quitFlag; ++i) {
+    _eventDispatcherImpl->dispatch(frameEvents[i]);
+    _eventDispatcherImpl->resumeAwaiting();
+  }
+  for(std::size_t i = 0; i < count; ++i) frameEvents[i].reset();
+  return !_eventDispatcherImpl->quitFlag;
 }
 
+EventDispatcher::Registration EventDispatcher::registerEventHandler(
+  BaseEventHandler& baseEventHandler,
+  ExecutionPolicy executionPolicy,
+  WindowId windowId
+) {
+  return { *_eventDispatcherImpl, _eventDispatcherImpl->addRegistration(&baseEventHandler, executionPolicy, windowId) };
+}
+
+EventDispatcher::Registration EventDispatcher::registerEventHandler(
+  EventTypeId eventTypeId,
+  void* eventHandler,
+  ExecutionPolicy executionPolicy,
+  WindowId windowId
+) {
+  const vodden::HandleTable::Handle registration = _eventDispatcherImpl->addRegistration(nullptr, executionPolicy, windowId);
+  _eventDispatcherImpl->addHandlerEntry(eventTypeId, eventHandler, registration);
+  return { *_eventDispatcherImpl, registration };
+}
+
+void EventDispatcher::resumeAfterDispatch(std::coroutine_handle<> awaiting) {
+  _eventDispatcherImpl->_resumptions.push_back(awaiting);
+}
+
+void EventDispatcher::cancelResumption(std::coroutine_handle<> awaiting) {
+  std::erase(_eventDispatcherImpl->_resumptions, awaiting);
+  std::replace(_eventDispatcherImpl->_resuming.begin(), _eventDispatcherImpl->_resuming.end(), awaiting, std::coroutine_handle<> {});
+}
+
+std::size_t EventDispatcher::getHandlerCount() const {
+  return _eventDispatcherImpl->_registrations.size();
+}
 
 }
@@ -1,8 +1,18 @@
 #ifndef __SDL_TOOLS_EVENT_DISPATCHER_IMPL_H__
 #define __SDL_TOOLS_EVENT_DISPATCHER_IMPL_H__
 
+#include <array>
 #include <atomic>
-#include <forward_list>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <handle_table.h>
+#include <memory_tracker.h>
 
 #include "event_dispatcher.h"
 
@@ -19,14 +29,140 @@ class DefaultQuitEventHandler : public sdl::EventHandler<QuitEvent>, public sdl:
     EventDispatcherImpl& _eventDispatcherImpl;
 };
 
-class EventDispatcherImpl {
+struct Strand;
+
+//! @brief a handler bound to one event type, invoked without any casting on the hot path
+struct HandlerEntry {
+  // nullptr once unregistered during a dispatch, until the dispatch ends and the entry is removed
+  void* eventHandler;
+  sdl::detail::HandlerInvoker invoke;
+  // the queue of a pool handler, or nullptr for an inline handler
+  Strand* strand;
+  vodden::HandleTable::Handle registration;
+};
+
+//! @brief the events waiting for one pool handler, which are run one at a time and in order
+struct Strand {
+  std::mutex mutex {};
+  std::deque<std::pair<HandlerEntry, std::shared_ptr<const sdl::BaseEvent>>> pending {};
+  // true while a pool task is draining this strand
+  bool scheduled { false };
+};
+
+//! @brief the handlers scoped to one window, indexed by the EventTypeId they handle
+struct WindowHandlers {
+  EventDispatcher::WindowId windowId;
+  std::vector<std::vector<HandlerEntry>> eventHandlers;
+};
+
+//! @brief where in the handler tables one of a registration's entries sits
+struct Binding {
+  // 0 for the handlers of every window, otherwise one past the index of its WindowHandlers
+  std::size_t table;
+  sdl::EventTypeId eventTypeId;
+  std::size_t index;
+};
+
+//! @brief one registered handler and every entry it has in the handler tables
+struct RegistrationEntry {
+  // set for a handler registered through its BaseEventHandler, which is matched against each new event type
+  sdl::BaseEventHandler* baseEventHandler;
+  Strand* strand;
+  // as Binding::table
+  std::size_t table;
+  // counts up with each registration, so handlers bound to a new event type keep to the order they were registered in
+  std::size_t order;
+  std::vector<Binding> bindings;
+};
+
+class EventDispatcherImpl : public vodden::memory::Tracked<vodden::memory::Category::kEvents> {
   friend EventDispatcher;
   public:
     EventDispatcherImpl( sdl::BaseEventProducer& eventProducer ) : _eventProducer { eventProducer } {};
+    ~EventDispatcherImpl();
     void quit() { quitFlag = true; };
+
+    //! @brief a new registration, bound to every event type seen so far if it has a BaseEventHandler
+    vodden::HandleTable::Handle addRegistration(
+      sdl::BaseEventHandler* baseEventHandler,
+      EventDispatcher::ExecutionPolicy executionPolicy,
+      EventDispatcher::WindowId windowId
+    );
+    //! @brief add an entry for eventHandler to the event type's handlers
+    void addHandlerEntry(sdl::EventTypeId eventTypeId, void* eventHandler, vodden::HandleTable::Handle registration);
+    //! @brief stop invoking the registration's handler, removing it at once unless a dispatch is under way
+    void unregister(vodden::HandleTable::Handle registration);
+
+    /**
+     * @brief hand the event to every handler registered for its type.
+     *
+     * Ownership is taken from the caller only if a pool handler needs to keep the event alive.
+     */
+    void dispatch(std::unique_ptr<sdl::BaseEvent>& event);
+    //! @brief resume the coroutines whose events have been dispatched
+    void resumeAwaiting() {
+      if(!_resumptions.empty()) resumeAll();
+    };
+
   private:
+    //! @brief grow the table to cover the event type, matching existing handlers against new types
+    void addEventType(sdl::EventTypeId eventTypeId);
+    //! @brief the table for the window's handlers, as Binding::table, adding one if the window has none
+    std::size_t getTable(EventDispatcher::WindowId windowId);
+    //! @brief the event type's handlers in a table, growing a window's table to cover the type
+    std::vector<HandlerEntry>& getHandlers(std::size_t table, sdl::EventTypeId eventTypeId);
+    //! @brief invoke or enqueue, for the event, each of the event type's handlers in a table
+    void invokeHandlers(
+      std::size_t table,
+      const sdl::BaseEvent& currentEvent,
+      std::unique_ptr<sdl::BaseEvent>& event,
+      std::shared_ptr<const sdl::BaseEvent>& sharedEvent
+    );
+    //! @brief add the registration's handler to the event type's handlers if it can handle that type
+    void bindEventHandler(sdl::EventTypeId eventTypeId, vodden::HandleTable::Handle registration);
+    //! @brief erase the registration's entries from the handler tables, keeping the others in order, and the registration itself
+    void remove(vodden::HandleTable::Handle registration);
+    //! @brief a strand for a pool handler, reusing one freed by unregister, or nullptr for an inline one
+    Strand* createStrand(EventDispatcher::ExecutionPolicy executionPolicy);
+    //! @brief drop the strand's queued events and wait until no pool task is running it
+    void cancelStrand(Strand& strand);
+    //! @brief queue the event on the handler's strand, scheduling the strand if it is idle
+    void enqueue(const HandlerEntry& handlerEntry, std::shared_ptr<const sdl::BaseEvent> event);
+    //! @brief run on the pool: invoke the strand's handler for each of its events until none remain
+    void runStrand(Strand& strand);
+    void resumeAll();
+
+    //! @brief the most events runFrame will dispatch in one call
+    static constexpr std::size_t kFrameBatchSize = 256;
+
     sdl::BaseEventProducer& _eventProducer;
-    std::forward_list<std::reference_wrapper<sdl::BaseEventHandler>> _eventHandlers {};
+    // reused by every runFrame outside a dispatch, so a frame's events are drained without allocating a buffer
+    std::array<std::unique_ptr<sdl::BaseEvent>, kFrameBatchSize> _frameEvents {};
+    // the handlers of every window, indexed by the EventTypeId they handle
+    std::vector<std::vector<HandlerEntry>> _eventHandlers {};
+    // few, so found by a linear search; kept once a window's handlers are all gone
+    std::vector<WindowHandlers> _windowHandlers {};
+    vodden::HandleTable _registrationHandles {};
+    // indexed by _registrationHandles, packed as registrations are removed
+    std::vector<RegistrationEntry> _registrations {};
+    // as RegistrationEntry::order, for the next registration
+    std::size_t _registrationCount { 0 };
+    // the dispatches under way, more than one if a handler itself calls runFrame
+    std::size_t _dispatchDepth { 0 };
+    // unregistered while a dispatch was under way, removed once it is over
+    std::vector<vodden::HandleTable::Handle> _pendingRemovals {};
+    // a deque so strands keep their address as more are added
+    std::deque<Strand> _strands {};
+    std::vector<Strand*> _freeStrands {};
+    // strands currently scheduled on the pool, waited for on destruction
+    std::mutex _activeStrandsMutex {};
+    std::condition_variable _activeStrandsChanged {};
+    std::size_t _activeStrands { 0 };
+    // coroutines given an event by the dispatch under way, resumed once it is over
+    std::vector<std::coroutine_handle<>> _resumptions {};
+    // swapped with _resumptions while they are resumed, so coroutines awaiting again wait for the next event
+    std::vector<std::coroutine_handle<>> _resuming {};
+    // set by handlers on any thread, read by the dispatching thread
     std::atomic_bool quitFlag { false };
     DefaultQuitEventHandler defaultQuitEventHandler { *this };
 };
@@ -0,0 +1,82 @@
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+
+#include "frame_capture_impl.h"
+#include "frame_capture.h"
+
+namespace sdl::tools {
+
+FrameCaptureImpl::FrameCaptureImpl(const Renderer& renderer, uint32_t width, uint32_t height, FrameCapture::Writer writer, std::size_t slotCount) :
+  _renderer { renderer }, _writer { std::move(writer) } {
+  if(slotCount == 0) throw std::invalid_argument("FrameCapture::FrameCapture: at least one slot is needed.");
+  if(!_writer) throw std::invalid_argument("FrameCapture::FrameCapture: the writer is empty.");
+  for(std::size_t i = 0; i < slotCount; ++i) _slots.emplace_back(width, height);
+}
+
+void FrameCaptureImpl::write(CaptureSlot& slot, uint64_t frameNumber) {
+  try {
+    _writer(slot.surface, frameNumber);
+  } catch(...) {
+    // a thread pool task must not throw, whatever the writer throws
+    _failedCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  slot.busy.store(false, std::memory_order_release);
+}
+
+FrameCapture::FrameCapture(const Renderer& renderer, uint32_t width, uint32_t height, Writer writer, std::size_t slotCount) :
+  _frameCaptureImpl { std::make_unique<FrameCaptureImpl>(renderer, width, height, std::move(writer), slotCount) } { }
+
+FrameCapture::FrameCapture(FrameCapture&& other) : _frameCaptureImpl { std::move(other._frameCaptureImpl) } { }
+
+FrameCapture::~FrameCapture() {
+  // the writer thread holds a pointer to the impl until its writes are done
+  if(_frameCaptureImpl) flush();
+}
+
+FrameCapture::Writer FrameCapture::writePNG(std::filesystem::path directory) {
+  return [directory = std::move(directory)](const Surface& frame, uint64_t frameNumber) {
+    char fileName[32];
+    std::snprintf(fileName, sizeof(fileName), "frame_%06llu.png", static_cast<unsigned long long>(frameNumber));
+    frame.savePNG(directory / fileName);
+  };
+}
+
+bool FrameCapture::capture() {
+  auto& impl = *_frameCaptureImpl;
+  const uint64_t frameNumber = impl._frameNumber++;
+
+  // writes can finish out of order, so the ring is searched from the oldest slot for a free one
+  std::size_t free = 0;
+  while(free < impl._slots.size() && impl._slots[(impl._nextSlot + free) % impl._slots.size()].busy.load(std::memory_order_acquire)) ++free;
+  if(free == impl._slots.size()) {
+    ++impl._droppedCount;
+    return false;
+  }
+  CaptureSlot& slot = impl._slots[(impl._nextSlot + free) % impl._slots.size()];
+  impl._renderer.readPixels(slot.surface);
+  impl._nextSlot = (impl._nextSlot + free + 1) % impl._slots.size();
+
+  slot.busy.store(true, std::memory_order_relaxed);
+  ++impl._capturedCount;
+  impl._writerPool.submit([&impl, &slot, frameNumber]() { impl.write(slot, frameNumber); });
+  return true;
+}
+
+void FrameCapture::flush() {
+  _frameCaptureImpl->_writerPool.waitIdle();
+}
+
+uint64_t FrameCapture::getCapturedCount() const {
+  return _frameCaptureImpl->_capturedCount;
+}
+
+uint64_t FrameCapture::getDroppedCount() const {
+  return _frameCaptureImpl->_droppedCount;
+}
+
+uint64_t FrameCapture::getFailedCount() const {
+  return _frameCaptureImpl->_failedCount.load(std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,54 @@
+#ifndef __SDL_TOOLS_FRAME_CAPTURE_IMPL_H__
+#define __SDL_TOOLS_FRAME_CAPTURE_IMPL_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+#include <memory_tracker.h>
+#include <thread_pool.h>
+
+#include "renderer.h"
+#include "surface.h"
+
+#include "frame_capture.h"
+
+namespace sdl::tools {
+
+//! @brief one preallocated frame of the ring, owned by a writer while busy
+struct CaptureSlot {
+  CaptureSlot(uint32_t width, uint32_t height) : surface { width, height } {};
+
+  Surface surface;
+  //! @brief set by the render thread when the frame is queued, cleared by the worker once it is written
+  std::atomic<bool> busy { false };
+};
+
+class FrameCaptureImpl : public vodden::memory::Tracked<vodden::memory::Category::kTextures> {
+  friend FrameCapture;
+  public:
+    FrameCaptureImpl(const Renderer& renderer, uint32_t width, uint32_t height, FrameCapture::Writer writer, std::size_t slotCount);
+
+  private:
+    //! @brief write slot's frame and free it; worker threads only
+    void write(CaptureSlot& slot, uint64_t frameNumber);
+
+    const Renderer& _renderer;
+    FrameCapture::Writer _writer;
+    // a deque, as slots hold atomics and can't be moved on growth
+    std::deque<CaptureSlot> _slots;
+    // the slot the next capture goes to, so that slots are reused in the order they were filled
+    std::size_t _nextSlot { 0 };
+    uint64_t _frameNumber { 0 };
+    uint64_t _capturedCount { 0 };
+    uint64_t _droppedCount { 0 };
+    std::atomic<uint64_t> _failedCount { 0 };
+    // a thread of its own, so that slow writes never hold up the shared pool's other users;
+    // last, so that it finishes the writes queued on it before the slots they use are destroyed
+    vodden::ThreadPool _writerPool { 1 };
+};
+
+}
+
+#endif
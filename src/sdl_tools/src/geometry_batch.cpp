@@ -0,0 +1,102 @@
+#include "geometry_batch_impl.h"
+#include "geometry_batch.h"
+
+namespace sdl::tools {
+
+GeometryRun& GeometryBatchImpl::getRun(const Texture* texture) {
+  for(std::size_t i = 0; i < _activeRuns; ++i) {
+    if(_runs[i].texture == texture) return _runs[i];
+  }
+
+  if(_activeRuns == _runs.size()) {
+    _runs.push_back({});
+    _runs.back().vertices.reserve(_quadCapacity * 4);
+    _runs.back().indices.reserve(_quadCapacity * 6);
+  }
+  GeometryRun& run = _runs[_activeRuns++];
+  run.texture = texture;
+  run.inverseWidth = texture != nullptr ? 1.0f / static_cast<float>(texture->getWidth()) : 0.0f;
+  run.inverseHeight = texture != nullptr ? 1.0f / static_cast<float>(texture->getHeight()) : 0.0f;
+  return run;
+}
+
+void GeometryBatchImpl::pushQuad(GeometryRun& run, float x, float y, float width, float height, const Color& color, float u, float v, float uWidth, float vHeight) {
+  const int first = static_cast<int>(run.vertices.size());
+  run.vertices.emplace_back(x, y, color, u, v);
+  run.vertices.emplace_back(x + width, y, color, u + uWidth, v);
+  run.vertices.emplace_back(x + width, y + height, color, u + uWidth, v + vHeight);
+  run.vertices.emplace_back(x, y + height, color, u, v + vHeight);
+
+  const int indices[] = { first, first + 1, first + 2, first, first + 2, first + 3 };
+  run.indices.insert(run.indices.end(), std::begin(indices), std::end(indices));
+  ++_quadCount;
+}
+
+GeometryBatch::GeometryBatch(const Renderer& renderer, std::size_t quadCapacity) :
+  _geometryBatchImpl { std::make_unique<GeometryBatchImpl>(renderer, quadCapacity) } { }
+
+GeometryBatch::GeometryBatch(GeometryBatch&& other) : _geometryBatchImpl { std::move(other._geometryBatchImpl) } { }
+
+GeometryBatch::~GeometryBatch() {};
+
+void GeometryBatch::addQuad(float x, float y, float width, float height, const Color& color) {
+  auto& impl = *_geometryBatchImpl;
+  impl.pushQuad(impl.getRun(nullptr), x, y, width, height, color, 0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void GeometryBatch::addQuad(const Rectangle& destination, const Color& color) {
+  addQuad(
+    static_cast<float>(destination.getX()),
+    static_cast<float>(destination.getY()),
+    static_cast<float>(destination.getWidth()),
+    static_cast<float>(destination.getHeight()),
+    color
+  );
+}
+
+void GeometryBatch::addQuad(const Texture& texture, const Rectangle& source, const Rectangle& destination, const Color& color) {
+  addQuad(
+    texture,
+    source,
+    static_cast<float>(destination.getX()),
+    static_cast<float>(destination.getY()),
+    static_cast<float>(destination.getWidth()),
+    static_cast<float>(destination.getHeight()),
+    color
+  );
+}
+
+void GeometryBatch::addQuad(const Texture& texture, const Rectangle& source, float x, float y, float width, float height, const Color& color) {
+  auto& impl = *_geometryBatchImpl;
+  GeometryRun& run = impl.getRun(&texture);
+  impl.pushQuad(
+    run,
+    x,
+    y,
+    width,
+    height,
+    color,
+    static_cast<float>(source.getX()) * run.inverseWidth,
+    static_cast<float>(source.getY()) * run.inverseHeight,
+    static_cast<float>(source.getWidth()) * run.inverseWidth,
+    static_cast<float>(source.getHeight()) * run.inverseHeight
+  );
+}
+
+void GeometryBatch::flush() {
+  auto& impl = *_geometryBatchImpl;
+  for(std::size_t i = 0; i < impl._activeRuns; ++i) {
+    GeometryRun& run = impl._runs[i];
+    impl._renderer.renderGeometry(run.texture, run.vertices, run.indices);
+    run.vertices.clear();
+    run.indices.clear();
+  }
+  impl._activeRuns = 0;
+  impl._quadCount = 0;
+}
+
+std::size_t GeometryBatch::size() const {
+  return _geometryBatchImpl->_quadCount;
+}
+
+}
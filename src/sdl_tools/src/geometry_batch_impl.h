@@ -0,0 +1,45 @@
+#ifndef __SDL_TOOLS_GEOMETRY_BATCH_IMPL_H__
+#define __SDL_TOOLS_GEOMETRY_BATCH_IMPL_H__
+
+#include <vector>
+
+#include <memory_tracker.h>
+
+#include "renderer.h"
+#include "texture.h"
+#include "vertex.h"
+
+#include "geometry_batch.h"
+
+namespace sdl::tools {
+
+//! @brief the quads queued for one texture, or for none
+struct GeometryRun {
+  const Texture* texture;
+  float inverseWidth;
+  float inverseHeight;
+  std::vector<Vertex, vodden::memory::TrackingAllocator<Vertex, vodden::memory::Category::kGeometry>> vertices;
+  std::vector<int, vodden::memory::TrackingAllocator<int, vodden::memory::Category::kGeometry>> indices;
+};
+
+class GeometryBatchImpl : public vodden::memory::Tracked<vodden::memory::Category::kGeometry> {
+  friend GeometryBatch;
+  public:
+    GeometryBatchImpl(const Renderer& renderer, std::size_t quadCapacity) : _renderer { renderer }, _quadCapacity { quadCapacity } {};
+
+  private:
+    //! @brief the run for texture, reusing the buffers of an emptied run where possible
+    GeometryRun& getRun(const Texture* texture);
+    void pushQuad(GeometryRun& run, float x, float y, float width, float height, const Color& color, float u, float v, float uWidth, float vHeight);
+
+    const Renderer& _renderer;
+    std::size_t _quadCapacity;
+    std::size_t _quadCount { 0 };
+    // runs[0, _activeRuns) hold the current frame's quads; the rest keep their capacity for reuse
+    std::vector<GeometryRun> _runs;
+    std::size_t _activeRuns { 0 };
+};
+
+}
+
+#endif
@@ -0,0 +1,266 @@
+#include <cerrno>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <thread_pool.h>
+
+#include "texture.h"
+
+#include "hot_reloader_impl.h"
+#include "hot_reloader.h"
+
+namespace sdl::tools {
+
+namespace {
+
+std::optional<std::vector<std::byte>> readFile(const std::filesystem::path& filePath) {
+  std::ifstream file { filePath, std::ios::binary };
+  if(!file) return std::nullopt;
+  std::vector<char> contents { std::istreambuf_iterator<char> { file }, std::istreambuf_iterator<char> {} };
+  if(file.bad()) return std::nullopt;
+  const auto bytes = reinterpret_cast<const std::byte*>(contents.data());
+  return std::vector<std::byte> { bytes, bytes + contents.size() };
+}
+
+std::optional<std::filesystem::file_time_type> getLastWriteTime(const std::filesystem::path& filePath) {
+  std::error_code errorCode;
+  const auto lastWriteTime = std::filesystem::last_write_time(filePath, errorCode);
+  if(errorCode) return std::nullopt;
+  return lastWriteTime;
+}
+
+}
+
+HotReloaderImpl::HotReloaderImpl(const Renderer& renderer, std::chrono::milliseconds pollInterval, HotReloader::ChangeDetection changeDetection) :
+  _renderer { renderer }, _pollInterval { pollInterval } {
+#ifdef __linux__
+  if(changeDetection == HotReloader::ChangeDetection::kNotify) _notifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#else
+  static_cast<void>(changeDetection);
+#endif
+}
+
+HotReloaderImpl::~HotReloaderImpl() {
+#ifdef __linux__
+  if(_notifyDescriptor != -1) close(_notifyDescriptor);
+#endif
+}
+
+WatchedFile& HotReloaderImpl::getWatchedFile(const std::filesystem::path& filePath) {
+  const std::string key = getKey(filePath);
+  const auto found = _watchedFiles.find(key);
+  if(found != _watchedFiles.end()) return found->second;
+
+  const std::filesystem::path normalPath { key };
+#ifdef __linux__
+  if(_notifyDescriptor != -1) {
+    // files are watched through their directories, so that editors which save by renaming over them are seen too
+    const std::filesystem::path directory = normalPath.parent_path();
+    const int watchDescriptor = inotify_add_watch(_notifyDescriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if(watchDescriptor == -1) {
+      // polling finds changes to every file, so there is no need for a mixture
+      close(_notifyDescriptor);
+      _notifyDescriptor = -1;
+      _watchedDirectories.clear();
+    } else {
+      _watchedDirectories.emplace(watchDescriptor, directory);
+    }
+  }
+#endif
+
+  WatchedFile& watchedFile = _watchedFiles[key];
+  watchedFile.filePath = normalPath;
+  watchedFile.lastWriteTime = getLastWriteTime(normalPath);
+  return watchedFile;
+}
+
+void HotReloaderImpl::changed(const std::string& key) {
+  const auto found = _watchedFiles.find(key);
+  if(found == _watchedFiles.end()) return;
+
+  WatchedFile& watchedFile = found->second;
+  if(watchedFile.reloading) {
+    watchedFile.changedAgain = true;
+    return;
+  }
+  if(!submit(key, watchedFile)) _watchedFiles.erase(found);
+}
+
+bool HotReloaderImpl::submit(const std::string& key, WatchedFile& watchedFile) {
+  std::erase_if(watchedFile.textureHandles, [](const auto& textureHandle) { return textureHandle.expired(); });
+  const bool decode = !watchedFile.textureHandles.empty();
+  if(!decode && watchedFile.fileCallbacks.empty()) return false;
+
+  watchedFile.reloading = true;
+  watchedFile.changedAgain = false;
+  {
+    std::scoped_lock lock { _mutex };
+    ++_reloadsInFlight;
+  }
+
+  vodden::ThreadPool::shared().submit([this, key, filePath = watchedFile.filePath, decode]() {
+    ReloadedFile reloadedFile { key, readFile(filePath), std::nullopt };
+    if(decode && reloadedFile.contents) {
+      try {
+        reloadedFile.surface.emplace(reloadedFile.contents->data(), reloadedFile.contents->size());
+      } catch(const std::exception&) {
+        // most likely caught mid-write; the textures keep their pixels until the next change
+      }
+    }
+    publish(std::move(reloadedFile));
+  });
+  return true;
+}
+
+void HotReloaderImpl::publish(ReloadedFile&& reloadedFile) {
+  std::unique_lock lock { _mutex };
+  // push leaves the file untouched when the queue is full, so it is simply tried again once update() has made space
+  _reloadsChanged.wait(lock, [this, &reloadedFile]() { return _discarding || _reloadedFiles.push(std::move(reloadedFile)); });
+  // notified with the lock held, as the destructor may destroy this the moment it sees no reloads left
+  if(--_reloadsInFlight == 0) _reloadsChanged.notify_all();
+}
+
+void HotReloaderImpl::findChanges(std::vector<std::string>& keys) {
+#ifdef __linux__
+  if(_notifyDescriptor != -1) {
+    bool overflowed = false;
+    alignas(inotify_event) char buffer[4096];
+    while(true) {
+      const ssize_t length = read(_notifyDescriptor, buffer, sizeof(buffer));
+      if(length <= 0) break;
+      for(ssize_t offset = 0; offset < length;) {
+        const auto event = reinterpret_cast<const inotify_event*>(buffer + offset);
+        offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        if(event->mask & IN_Q_OVERFLOW) overflowed = true;
+        const auto directory = _watchedDirectories.find(event->wd);
+        if(event->len == 0 || directory == _watchedDirectories.end()) continue;
+
+        std::string key = (directory->second / event->name).string();
+        const auto found = _watchedFiles.find(key);
+        if(found == _watchedFiles.end()) continue;
+        // kept up to date, so that a scan after an overflow only finds the changes which weren't reported
+        found->second.lastWriteTime = getLastWriteTime(found->second.filePath);
+        keys.push_back(std::move(key));
+      }
+    }
+    // the kernel dropped events once its queue filled, so any watched file may have changed unreported
+    if(overflowed) scanWriteTimes(keys);
+    return;
+  }
+#endif
+
+  const auto now = std::chrono::steady_clock::now();
+  if(now - _lastPoll < _pollInterval) return;
+  _lastPoll = now;
+  scanWriteTimes(keys);
+}
+
+void HotReloaderImpl::scanWriteTimes(std::vector<std::string>& keys) {
+  for(auto& [key, watchedFile] : _watchedFiles) {
+    const auto lastWriteTime = getLastWriteTime(watchedFile.filePath);
+    // a file which has gone is left alone, as it may be on its way back
+    if(!lastWriteTime || lastWriteTime == watchedFile.lastWriteTime) continue;
+    watchedFile.lastWriteTime = lastWriteTime;
+    keys.push_back(key);
+  }
+}
+
+bool HotReloaderImpl::apply(ReloadedFile& reloadedFile) {
+  const auto found = _watchedFiles.find(reloadedFile.key);
+  if(found == _watchedFiles.end() || !reloadedFile.contents) return false;
+
+  WatchedFile& watchedFile = found->second;
+  bool applied = false;
+  if(reloadedFile.surface) {
+    for(const auto& weakTextureHandle : watchedFile.textureHandles) {
+      const auto textureHandleImpl = weakTextureHandle.lock();
+      if(!textureHandleImpl) continue;
+      try {
+        // replaced in place, so pointers which Sprites hold to the texture stay valid
+        textureHandleImpl->setTexture(Texture { _renderer, *reloadedFile.surface });
+        applied = true;
+      } catch(const std::exception&) {
+        // keep the old texture
+      }
+    }
+  }
+  const std::span<const std::byte> contents { *reloadedFile.contents };
+  for(const auto& fileCallback : watchedFile.fileCallbacks) fileCallback(contents);
+  return applied || !watchedFile.fileCallbacks.empty();
+}
+
+HotReloader::HotReloader(const Renderer& renderer, std::chrono::milliseconds pollInterval, ChangeDetection changeDetection) :
+  _hotReloaderImpl { std::make_unique<HotReloaderImpl>(renderer, pollInterval, changeDetection) } { }
+
+HotReloader::HotReloader(HotReloader&& other) : _hotReloaderImpl { std::move(other._hotReloaderImpl) } { }
+
+HotReloader::~HotReloader() {
+  if(!_hotReloaderImpl) return;
+
+  auto& impl = *_hotReloaderImpl;
+  std::unique_lock lock { impl._mutex };
+  // wakes workers waiting for space in the queue, which then drop their results
+  impl._discarding = true;
+  impl._reloadsChanged.notify_all();
+  impl._reloadsChanged.wait(lock, [&impl]() { return impl._reloadsInFlight == 0; });
+}
+
+void HotReloader::watch(const std::filesystem::path& filePath, TextureHandle textureHandle) {
+  _hotReloaderImpl->getWatchedFile(filePath).textureHandles.push_back(textureHandle._textureHandleImpl);
+}
+
+void HotReloader::watch(const std::filesystem::path& filePath, FileCallback fileCallback) {
+  if(!fileCallback) throw std::invalid_argument("HotReloader::watch: the file callback is empty.");
+  _hotReloaderImpl->getWatchedFile(filePath).fileCallbacks.push_back(std::move(fileCallback));
+}
+
+TextureHandle HotReloader::load(TextureCache& textureCache, const std::filesystem::path& filePath) {
+  TextureHandle textureHandle = textureCache.load(filePath);
+  watch(filePath, textureHandle);
+  return textureHandle;
+}
+
+std::size_t HotReloader::update() {
+  auto& impl = *_hotReloaderImpl;
+
+  std::vector<std::string> keys;
+  impl.findChanges(keys);
+  for(const auto& key : keys) impl.changed(key);
+
+  std::size_t reloaded = 0;
+  bool popped = false;
+  while(auto reloadedFile = impl._reloadedFiles.tryPop()) {
+    popped = true;
+    if(impl.apply(*reloadedFile)) ++reloaded;
+
+    const auto found = impl._watchedFiles.find(reloadedFile->key);
+    if(found == impl._watchedFiles.end()) continue;
+    found->second.reloading = false;
+    if(found->second.changedAgain && !impl.submit(found->first, found->second)) impl._watchedFiles.erase(found);
+  }
+  if(popped) {
+    // for workers waiting on a full queue
+    std::scoped_lock lock { impl._mutex };
+    impl._reloadsChanged.notify_all();
+  }
+  return reloaded;
+}
+
+std::size_t HotReloader::getWatchCount() const {
+  return _hotReloaderImpl->_watchedFiles.size();
+}
+
+bool HotReloader::isNotified() const {
+  return _hotReloaderImpl->_notifyDescriptor != -1;
+}
+
+}
@@ -0,0 +1,103 @@
+#ifndef __SDL_TOOLS_HOT_RELOADER_IMPL_H__
+#define __SDL_TOOLS_HOT_RELOADER_IMPL_H__
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <memory_tracker.h>
+#include <mpsc_queue.h>
+
+#include "renderer.h"
+#include "surface.h"
+
+#include "hot_reloader.h"
+#include "texture_handle_impl.h"
+
+namespace sdl::tools {
+
+//! @brief everything which wants to know when one file changes
+struct WatchedFile {
+  std::filesystem::path filePath;
+  // weak, so that watching a texture doesn't keep it alive
+  std::vector<std::weak_ptr<TextureHandleImpl>> textureHandles;
+  std::vector<HotReloader::FileCallback> fileCallbacks;
+  //! @brief the modification time last seen, when polling
+  std::optional<std::filesystem::file_time_type> lastWriteTime;
+  //! @brief true while a reload is on the thread pool
+  bool reloading { false };
+  //! @brief true if the file changed again while reloading, so it must be reloaded once more
+  bool changedAgain { false };
+};
+
+//! @brief a reloaded file, passed from a worker to the render thread
+struct ReloadedFile {
+  std::string key;
+  //! @brief empty if the file could not be read
+  std::optional<std::vector<std::byte>> contents;
+  //! @brief empty if no texture watches the file, or it could not be decoded
+  std::optional<Surface> surface;
+};
+
+class HotReloaderImpl : public vodden::memory::Tracked<vodden::memory::Category::kTextures> {
+  friend HotReloader;
+  public:
+    HotReloaderImpl(const Renderer& renderer, std::chrono::milliseconds pollInterval, HotReloader::ChangeDetection changeDetection);
+    ~HotReloaderImpl();
+
+  private:
+    static constexpr std::size_t kQueueCapacity = 64;
+
+    //! @brief the watch for filePath, creating it and watching its directory if need be
+    WatchedFile& getWatchedFile(const std::filesystem::path& filePath);
+    //! @brief the file changed; reload it now unless a reload is already under way
+    void changed(const std::string& key);
+    /**
+     * @brief read, and decode if a texture is watching, on the shared thread pool
+     *
+     * @return false, submitting nothing, if nothing watches the file any more.
+     */
+    bool submit(const std::string& key, WatchedFile& watchedFile);
+    //! @brief hand a reloaded file to the render thread, waiting for space if it has fallen behind; worker threads only
+    void publish(ReloadedFile&& reloadedFile);
+    //! @brief append keys of watched files which changed since the last call
+    void findChanges(std::vector<std::string>& keys);
+    //! @brief append keys of watched files whose modification time isn't the one last seen
+    void scanWriteTimes(std::vector<std::string>& keys);
+    //! @brief swap a reloaded file in, returning true if anything took it
+    bool apply(ReloadedFile& reloadedFile);
+
+    //! @brief the key of a path, the same however the path was spelt
+    static std::string getKey(const std::filesystem::path& filePath) {
+      return std::filesystem::absolute(filePath).lexically_normal().string();
+    }
+
+    const Renderer& _renderer;
+    std::chrono::milliseconds _pollInterval;
+    std::chrono::steady_clock::time_point _lastPoll {};
+    std::unordered_map<std::string, WatchedFile> _watchedFiles;
+
+    // -1 when polling
+    int _notifyDescriptor { -1 };
+    // the directory each inotify watch descriptor reports on
+    std::unordered_map<int, std::filesystem::path> _watchedDirectories;
+
+    vodden::MpscQueue<ReloadedFile, kQueueCapacity> _reloadedFiles;
+    std::mutex _mutex;
+    // signalled, with _mutex held, when the queue has space again and when the last reload in flight is done
+    std::condition_variable _reloadsChanged;
+    std::size_t _reloadsInFlight { 0 };
+    // set by the destructor, after which workers drop their results rather than queue them
+    bool _discarding { false };
+};
+
+}
+
+#endif
@@ -0,0 +1,96 @@
+#include <stdexcept>
+
+#include "sprite_impl.h"
+
+#include "scene_impl.h"
+#include "scene.h"
+
+namespace sdl::tools {
+
+void SceneImpl::mergeDirtyRectangles() {
+  auto& rectangles = _dirtyRectangles;
+  for(bool merged = true; merged;) {
+    merged = false;
+    for(std::size_t i = 0; i < rectangles.size(); ++i) {
+      for(std::size_t j = i + 1; j < rectangles.size();) {
+        if(rectangles[i].intersects(rectangles[j])) {
+          rectangles[i] = rectangles[i].getUnion(rectangles[j]);
+          rectangles[j] = rectangles.back();
+          rectangles.pop_back();
+          merged = true;
+        } else {
+          ++j;
+        }
+      }
+    }
+  }
+}
+
+Scene::Scene(Renderer& renderer, uint32_t width, uint32_t height, const Color& background) :
+  _sceneImpl { std::make_unique<SceneImpl>(renderer, width, height, background) } {
+  // the target is copied over whatever is in the window rather than blended with it
+  _sceneImpl->_target.setTextureBlendMode(Texture::kNone);
+  invalidate(_sceneImpl->_bounds);
+}
+
+Scene::Scene(Scene&& other) : _sceneImpl { std::move(other._sceneImpl) } { }
+
+Scene::~Scene() {};
+
+Scene::NodeId Scene::add(const Sprite& sprite, uint32_t x, uint32_t y) {
+  const Rectangle& source = sprite._spriteImpl->_rectangle;
+  const Rectangle bounds { x, y, source.getWidth(), source.getHeight() };
+  _sceneImpl->_nodes.push_back(SceneImpl::Node { &sprite, bounds });
+  invalidate(bounds);
+  return _sceneImpl->_nodes.size() - 1;
+}
+
+void Scene::move(NodeId nodeId, uint32_t x, uint32_t y) {
+  auto& node = _sceneImpl->_nodes.at(nodeId);
+  if(!node) throw std::out_of_range("Scene::move: node has been removed.");
+  invalidate(node->bounds);
+  node->bounds = Rectangle { x, y, node->bounds.getWidth(), node->bounds.getHeight() };
+  invalidate(node->bounds);
+}
+
+void Scene::remove(NodeId nodeId) {
+  auto& node = _sceneImpl->_nodes.at(nodeId);
+  if(!node) return;
+  invalidate(node->bounds);
+  node.reset();
+}
+
+void Scene::invalidate(const Rectangle& region) {
+  if(region.getWidth() == 0 || region.getHeight() == 0) return;
+  _sceneImpl->_dirtyRectangles.push_back(region);
+}
+
+bool Scene::render() {
+  auto& impl = *_sceneImpl;
+  if(impl._dirtyRectangles.empty()) return false;
+  impl.mergeDirtyRectangles();
+
+  Renderer& renderer = impl._renderer;
+  {
+    const auto targetScope = renderer.setTarget(impl._target);
+    renderer.setRenderDrawColour(impl._background);
+    for(const Rectangle& dirty : impl._dirtyRectangles) {
+      renderer.setClipRectangle(dirty);
+      renderer.fillRectangle(dirty);
+      for(const auto& node : impl._nodes) {
+        if(!node || !node->bounds.intersects(dirty)) continue;
+        const Texture* texture = node->sprite->_spriteImpl->getTexture();
+        if(texture == nullptr) continue;
+        renderer.copy(*texture, node->sprite->_spriteImpl->_rectangle, node->bounds, node->sprite->_spriteImpl->getBlendMode(*texture));
+      }
+    }
+    renderer.resetClipRectangle();
+  }
+  impl._dirtyRectangles.clear();
+
+  renderer.copy(impl._target, impl._bounds, impl._bounds);
+  renderer.present();
+  return true;
+}
+
+}
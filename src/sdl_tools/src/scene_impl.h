@@ -0,0 +1,47 @@
+#ifndef __SDL_TOOLS_SCENE_IMPL_H__
+#define __SDL_TOOLS_SCENE_IMPL_H__
+
+#include <optional>
+#include <vector>
+
+#include <memory_tracker.h>
+
+#include "color.h"
+#include "rectangle.h"
+#include "renderer.h"
+#include "target_texture.h"
+
+#include "scene.h"
+
+namespace sdl::tools {
+
+class SceneImpl : public vodden::memory::Tracked<vodden::memory::Category::kGeometry> {
+  friend Scene;
+  public:
+    SceneImpl(Renderer& renderer, uint32_t width, uint32_t height, const Color& background) :
+      _renderer { renderer },
+      _target { renderer, width, height },
+      _bounds { 0, 0, width, height },
+      _background { background } {};
+
+  private:
+    struct Node {
+      const Sprite* sprite;
+      Rectangle bounds;
+    };
+
+    //! @brief merge overlapping dirty rectangles until none overlap
+    void mergeDirtyRectangles();
+
+    Renderer& _renderer;
+    TargetTexture _target;
+    Rectangle _bounds;
+    Color _background;
+    // indexed by NodeId, empty once removed; also the draw order
+    std::vector<std::optional<Node>> _nodes;
+    std::vector<Rectangle> _dirtyRectangles;
+};
+
+}
+
+#endif
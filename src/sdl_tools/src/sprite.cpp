@@ -2,7 +2,11 @@
 
 namespace sdl::tools {
 
-Sprite::Sprite( const Texture& texture, const Rectangle& rectangle ): _spriteImpl { std::make_unique<SpriteImpl>( texture, rectangle ) } { }
+Sprite::Sprite( const Texture& texture, const Rectangle& rectangle, Texture::BlendMode blendMode ):
+  _spriteImpl { std::make_unique<SpriteImpl>( texture, rectangle, blendMode ) } { }
+
+Sprite::Sprite( TextureHandle textureHandle, const Rectangle& rectangle, Texture::BlendMode blendMode ):
+  _spriteImpl { std::make_unique<SpriteImpl>( std::move(textureHandle), rectangle, blendMode ) } { }
 
 Sprite::Sprite( Sprite&& other ): _spriteImpl { std::move( other._spriteImpl ) } { }
 
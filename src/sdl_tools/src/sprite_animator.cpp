@@ -0,0 +1,119 @@
+#include <stdexcept>
+#include <string>
+
+#include "sprite_animator_impl.h"
+#include "sprite_animator.h"
+
+namespace sdl::tools {
+
+std::size_t SpriteAnimatorImpl::indexOf(SpriteAnimator::AnimatedSprite animatedSprite, const char* caller) const {
+  const auto index = _handles.find(animatedSprite);
+  if(!index) throw std::out_of_range(std::string(caller) + ": animation has been stopped.");
+  return *index;
+}
+
+SpriteAnimator::SpriteAnimator(SpriteWorld& world) : _spriteAnimatorImpl { std::make_unique<SpriteAnimatorImpl>(world) } { }
+
+SpriteAnimator::SpriteAnimator(SpriteAnimator&& other) : _spriteAnimatorImpl { std::move(other._spriteAnimatorImpl) } { }
+
+SpriteAnimator::~SpriteAnimator() {};
+
+SpriteAnimator::ClipId SpriteAnimator::addClip(const AnimationClip& clip) {
+  auto& impl = *_spriteAnimatorImpl;
+  const auto sources = clip.getSources();
+  const auto frameEnds = clip.getFrameEnds();
+  impl._clips.push_back({ static_cast<uint32_t>(impl._frameSources.size()), static_cast<uint32_t>(sources.size()), clip.getDuration(), clip.getPlayback() });
+  impl._frameSources.insert(impl._frameSources.end(), sources.begin(), sources.end());
+  impl._frameEnds.insert(impl._frameEnds.end(), frameEnds.begin(), frameEnds.end());
+  return static_cast<ClipId>(impl._clips.size() - 1);
+}
+
+SpriteAnimator::AnimatedSprite SpriteAnimator::play(SpriteWorld::SpriteId spriteId, ClipId clipId) {
+  auto& impl = *_spriteAnimatorImpl;
+  if(clipId >= impl._clips.size()) throw std::out_of_range("SpriteAnimator::play: unknown clip.");
+  if(!impl._world.contains(spriteId)) throw std::out_of_range("SpriteAnimator::play: sprite has been removed.");
+
+  const uint32_t firstFrame = impl._clips[clipId].firstFrame;
+  impl._world.setSource(spriteId, impl._frameSources[firstFrame]);
+
+  const AnimatedSprite animatedSprite = impl._handles.insert();
+  impl._sprites.push_back(spriteId);
+  impl._clipIds.push_back(clipId);
+  impl._elapsed.push_back(AnimationClip::Duration::zero());
+  impl._frames.push_back(firstFrame);
+  return animatedSprite;
+}
+
+void SpriteAnimator::stop(AnimatedSprite animatedSprite) {
+  auto& impl = *_spriteAnimatorImpl;
+  const auto move = impl._handles.erase(animatedSprite);
+  if(!move) return;
+
+  const auto repack = [&move](auto& values) {
+    values[move->index] = values[move->from];
+    values.pop_back();
+  };
+  repack(impl._sprites);
+  repack(impl._clipIds);
+  repack(impl._elapsed);
+  repack(impl._frames);
+}
+
+bool SpriteAnimator::contains(AnimatedSprite animatedSprite) const {
+  return _spriteAnimatorImpl->_handles.contains(animatedSprite);
+}
+
+std::size_t SpriteAnimator::size() const {
+  return _spriteAnimatorImpl->_handles.size();
+}
+
+bool SpriteAnimator::isFinished(AnimatedSprite animatedSprite) const {
+  const auto& impl = *_spriteAnimatorImpl;
+  const std::size_t index = impl.indexOf(animatedSprite, "SpriteAnimator::isFinished");
+  const auto& clip = impl._clips[impl._clipIds[index]];
+  return clip.playback == AnimationClip::Playback::kOnce && impl._elapsed[index] >= clip.duration;
+}
+
+std::size_t SpriteAnimator::getFrame(AnimatedSprite animatedSprite) const {
+  const auto& impl = *_spriteAnimatorImpl;
+  const std::size_t index = impl.indexOf(animatedSprite, "SpriteAnimator::getFrame");
+  return impl._frames[index] - impl._clips[impl._clipIds[index]].firstFrame;
+}
+
+void SpriteAnimator::advance(AnimationClip::Duration elapsed) {
+  auto& impl = *_spriteAnimatorImpl;
+  for(std::size_t i = 0; i < impl._frames.size(); ++i) {
+    const auto& clip = impl._clips[impl._clipIds[i]];
+    const uint32_t lastFrame = clip.firstFrame + clip.frameCount - 1;
+    uint32_t frame = impl._frames[i];
+
+    auto time = impl._elapsed[i] + elapsed;
+    if(time >= clip.duration) {
+      if(clip.playback == AnimationClip::Playback::kLoop) {
+        time %= clip.duration;
+        frame = clip.firstFrame;
+      } else {
+        time = clip.duration;
+        frame = lastFrame;
+      }
+    }
+    impl._elapsed[i] = time;
+
+    // frames are short, and a step rarely passes more than one
+    while(frame < lastFrame && time >= impl._frameEnds[frame]) ++frame;
+
+    if(frame == impl._frames[i]) continue;
+    impl._frames[i] = frame;
+    if(impl._world.contains(impl._sprites[i])) impl._world.setSource(impl._sprites[i], impl._frameSources[frame]);
+  }
+}
+
+std::span<const Rectangle> SpriteAnimator::getFrameSources() const {
+  return _spriteAnimatorImpl->_frameSources;
+}
+
+std::span<const uint32_t> SpriteAnimator::getFrames() const {
+  return _spriteAnimatorImpl->_frames;
+}
+
+}
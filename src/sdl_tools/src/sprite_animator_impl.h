@@ -0,0 +1,51 @@
+#ifndef __SDL_TOOLS_SPRITE_ANIMATOR_IMPL_H__
+#define __SDL_TOOLS_SPRITE_ANIMATOR_IMPL_H__
+
+#include <vector>
+
+#include <handle_table.h>
+#include <memory_tracker.h>
+
+#include "rectangle.h"
+
+#include "animation_clip.h"
+#include "sprite_animator.h"
+#include "sprite_world.h"
+
+namespace sdl::tools {
+
+class SpriteAnimatorImpl : public vodden::memory::Tracked<vodden::memory::Category::kGeometry> {
+  friend SpriteAnimator;
+  public:
+    SpriteAnimatorImpl(SpriteWorld& world) : _world { world } {};
+
+  private:
+    //! @brief a clip's place in the frame table
+    struct Clip {
+      uint32_t firstFrame;
+      uint32_t frameCount;
+      AnimationClip::Duration duration;
+      AnimationClip::Playback playback;
+    };
+
+    //! @brief the index of animatedSprite, throwing std::out_of_range if it has been stopped
+    std::size_t indexOf(SpriteAnimator::AnimatedSprite animatedSprite, const char* caller) const;
+
+    SpriteWorld& _world;
+
+    // every clip's frames, back to back
+    std::vector<Rectangle> _frameSources;
+    std::vector<AnimationClip::Duration> _frameEnds;
+    std::vector<Clip> _clips;
+
+    vodden::HandleTable _handles;
+    // one entry per animation in each, all indexed alike
+    std::vector<SpriteWorld::SpriteId> _sprites;
+    std::vector<SpriteAnimator::ClipId> _clipIds;
+    std::vector<AnimationClip::Duration> _elapsed;
+    std::vector<uint32_t> _frames;
+};
+
+}
+
+#endif
@@ -1,25 +1,46 @@
 #ifndef __SPRITE_SHEET_IMPL_H__
 #define __SPRITE_SHEET_IMPL_H__
 
+#include <optional>
 #include <unordered_map>
 
+#include <memory_tracker.h>
+
 #include "rectangle.h"
 #include "sprite.h"
+#include "texture_handle.h"
 
 namespace sdl::tools {
 
+class Scene;
 class SpriteRenderer;
 
-class SpriteImpl {
+class SpriteImpl : public vodden::memory::Tracked<vodden::memory::Category::kGeometry> {
   friend Sprite;
+  friend Scene;
   friend SpriteRenderer;
   public:
-    SpriteImpl(const Texture& texture, const Rectangle& rectangle ) : _texture { texture }, _rectangle { rectangle } {};
-    SpriteImpl(const SpriteImpl& other) : _texture { other._texture }, _rectangle { other._rectangle } {};
+    SpriteImpl(const Texture& texture, const Rectangle& rectangle, Texture::BlendMode blendMode) :
+      _texture { &texture }, _rectangle { rectangle }, _blendMode { blendMode } {};
+    SpriteImpl(TextureHandle textureHandle, const Rectangle& rectangle, Texture::BlendMode blendMode) :
+      _textureHandle { std::move(textureHandle) }, _rectangle { rectangle }, _blendMode { blendMode } {};
+    SpriteImpl(const SpriteImpl& other) = default;
+
+    //! @brief the texture to draw from, or nullptr if it is still loading
+    const Texture* getTexture() const {
+      return _texture != nullptr ? _texture : _textureHandle->get();
+    }
+
+    //! @brief the blend mode to draw from texture with, the texture's own unless the sprite was given one
+    Texture::BlendMode getBlendMode(const Texture& texture) const {
+      return _blendMode == Sprite::kTextureBlendMode ? texture.getTextureBlendMode() : _blendMode;
+    }
 
   private:
-    const Texture& _texture;
+    const Texture* _texture { nullptr };
+    std::optional<TextureHandle> _textureHandle;
     const Rectangle _rectangle;
+    const Texture::BlendMode _blendMode;
 };
 
 }
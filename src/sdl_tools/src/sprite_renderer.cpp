@@ -1,4 +1,6 @@
-#include <iostream>
+#include <algorithm>
+
+#include <radix_sort.h>
 
 #include "sprite_renderer_impl.h"
 
@@ -8,21 +10,70 @@
 
 namespace sdl::tools {
 
+uint64_t SpriteRendererImpl::makeKey(const Texture* texture, Texture::BlendMode blendMode, int16_t z) {
+  if(texture != _lastTexture) {
+    // ordinals only group draws, so once they run out they can start again from nothing
+    if(_textureOrdinals.size() == (1u << kTextureOrdinalBits)) _textureOrdinals.clear();
+    _lastOrdinal = _textureOrdinals.try_emplace(texture, static_cast<uint32_t>(_textureOrdinals.size())).first->second;
+    _lastTexture = texture;
+  }
+  // biased so that negative z sorts below positive
+  const uint64_t biasedZ = static_cast<uint16_t>(z ^ INT16_MIN);
+  return biasedZ << 32 | static_cast<uint64_t>(blendMode) << kTextureOrdinalBits | _lastOrdinal;
+}
+
 SpriteRenderer::SpriteRenderer(const Renderer& renderer) : _spriteRendererImpl { std::make_unique<SpriteRendererImpl>(renderer) } {}
 SpriteRenderer::SpriteRenderer(SpriteRenderer &&other) : _spriteRendererImpl { std::move(other._spriteRendererImpl ) } {}
 
 SpriteRenderer::~SpriteRenderer() {};
 
-void SpriteRenderer::render(const Sprite &sprite, const uint32_t x, const uint32_t y) const
+void SpriteRenderer::render(const Sprite &sprite, const uint32_t x, const uint32_t y, const int16_t z)
 {
-  std::cout << "I am rendering a sprite at (" << x << ", " << y << ");" << std::endl;
-  const Rectangle destination = {
-      x,
-      y,
-      sprite._spriteImpl->_rectangle.getWidth(),
-      sprite._spriteImpl->_rectangle.getHeight()};
-
-  _spriteRendererImpl->_renderer.copy(sprite._spriteImpl->_texture, sprite._spriteImpl->_rectangle, destination);
-  _spriteRendererImpl->_renderer.present(); // TODO: doing this here is horribly inefficient
+  const Texture* texture = sprite._spriteImpl->getTexture();
+  if(texture == nullptr) return;
+
+  const Rectangle& source = sprite._spriteImpl->_rectangle;
+  const Texture::BlendMode blendMode = sprite._spriteImpl->getBlendMode(*texture);
+  _spriteRendererImpl->_drawCommands.push_back({
+    _spriteRendererImpl->makeKey(texture, blendMode, z),
+    texture,
+    blendMode,
+    source,
+    { x, y, source.getWidth(), source.getHeight() }
+  });
 }
+
+void SpriteRenderer::flush() {
+  auto& drawCommands = _spriteRendererImpl->_drawCommands;
+
+  // stable, so that draws sharing a key keep their submission order
+  vodden::radixSort(drawCommands, _spriteRendererImpl->_sortScratch, [](const DrawCommand& drawCommand) { return drawCommand.key; });
+
+  auto& runArena = _spriteRendererImpl->_runArena;
+  for(auto run = drawCommands.cbegin(); run != drawCommands.cend(); ) {
+    const uint64_t key = run->key;
+    const Texture* texture = run->texture;
+    const Texture::BlendMode blendMode = run->blendMode;
+    // the texture is compared too, as ordinals are handed out again once they run out
+    const auto runEnd = std::find_if(run, drawCommands.cend(), [key, texture](const DrawCommand& drawCommand) {
+      return drawCommand.key != key || drawCommand.texture != texture;
+    });
+    const auto sources = runArena.allocateArray<Rectangle>(static_cast<std::size_t>(runEnd - run));
+    const auto destinations = runArena.allocateArray<Rectangle>(sources.size());
+    for(std::size_t i = 0; run != runEnd; ++run, ++i) {
+      sources[i] = run->source;
+      destinations[i] = run->destination;
+    }
+    _spriteRendererImpl->_renderer.copy(*texture, sources, destinations, blendMode);
+  }
+  drawCommands.clear();
+  // once the arena has held the busiest frame's runs, later frames reuse its block
+  runArena.reset();
+}
+
+void SpriteRenderer::endFrame() {
+  flush();
+  _spriteRendererImpl->_renderer.present();
+}
+
 }
@@ -1,17 +1,57 @@
 #ifndef __SDL_TOOLS_SPRITE_RENDERER_IMPL_H__
 #define __SDL_TOOLS_SPRITE_RENDERER_IMPL_H__
 
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <frame_arena.h>
+#include <memory_tracker.h>
+
+#include "rectangle.h"
+#include "texture.h"
+
 #include "sprite_renderer.h"
 
 namespace sdl::tools {
 
-class SpriteRendererImpl {
+//! @brief a single queued draw, recorded by SpriteRenderer::render
+struct DrawCommand {
+  //! @brief z, blend mode and texture ordinal from the most significant bits down, see SpriteRendererImpl::makeKey
+  uint64_t key;
+  const Texture* texture;
+  Texture::BlendMode blendMode;
+  Rectangle source;
+  Rectangle destination;
+};
+
+class SpriteRendererImpl : public vodden::memory::Tracked<vodden::memory::Category::kGeometry> {
   friend SpriteRenderer;
   public:
-    SpriteRendererImpl(const Renderer& renderer): _renderer { renderer } {};
+    SpriteRendererImpl(const Renderer& renderer): _renderer { renderer } {
+      _drawCommands.reserve(kInitialQueueCapacity);
+      _sortScratch.reserve(kInitialQueueCapacity);
+    };
 
   private:
-    const Renderer& _renderer;  
+    static constexpr std::size_t kInitialQueueCapacity = 1024;
+    static constexpr uint32_t kTextureOrdinalBits = 24;
+
+    //! @brief the sort key of a draw: 16 bits of biased z, then 8 bits of blend mode and 24 of texture ordinal
+    uint64_t makeKey(const Texture* texture, Texture::BlendMode blendMode, int16_t z);
+
+    const Renderer& _renderer;
+    // cleared, not released, after every flush so steady-state frames don't allocate
+    std::vector<DrawCommand> _drawCommands {};
+    std::vector<DrawCommand> _sortScratch {};
+    // the source and destination arrays handing each run of same-texture draws to Renderer::copy, reset every flush
+    vodden::FrameArena _runArena { 2 * kInitialQueueCapacity * sizeof(Rectangle), vodden::memory::Category::kGeometry };
+
+    // a small number for each texture seen, kept across frames so the same textures cost no allocation
+    std::unordered_map<const Texture*, uint32_t> _textureOrdinals {};
+    // the last lookup, as consecutive draws usually share a texture
+    const Texture* _lastTexture { nullptr };
+    uint32_t _lastOrdinal { 0 };
 };
 
 }
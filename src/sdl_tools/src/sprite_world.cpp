@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include <viewport_cull.h>
+
+#include "sprite_world_impl.h"
+#include "sprite_world.h"
+
+namespace sdl::tools {
+
+std::size_t SpriteWorldImpl::indexOf(SpriteWorld::SpriteId spriteId, const char* caller) const {
+  const auto index = _handles.find(spriteId);
+  if(!index) throw std::out_of_range(std::string(caller) + ": sprite has been removed.");
+  return *index;
+}
+
+bool SpriteWorldImpl::isLayered() const {
+  if(_layeredDirty) {
+    const auto [lowest, highest] = std::minmax_element(_z.begin(), _z.end());
+    _layered = lowest != _z.end() && *lowest != *highest;
+    _layeredDirty = false;
+  }
+  return _layered;
+}
+
+SpriteWorld::SpriteWorld() : _spriteWorldImpl { std::make_unique<SpriteWorldImpl>() } { }
+
+SpriteWorld::SpriteWorld(SpriteWorld&& other) : _spriteWorldImpl { std::move(other._spriteWorldImpl) } { }
+
+SpriteWorld::~SpriteWorld() {};
+
+SpriteWorld::TextureId SpriteWorld::addTexture(const Texture& texture) {
+  _spriteWorldImpl->_textures.push_back(&texture);
+  return static_cast<TextureId>(_spriteWorldImpl->_textures.size() - 1);
+}
+
+const Texture& SpriteWorld::getTexture(TextureId textureId) const {
+  return *_spriteWorldImpl->_textures.at(textureId);
+}
+
+SpriteWorld::SpriteId SpriteWorld::add(TextureId textureId, const Rectangle& source, float x, float y, int32_t z, SpriteFlag flags) {
+  auto& impl = *_spriteWorldImpl;
+  if(textureId >= impl._textures.size()) throw std::out_of_range("SpriteWorld::add: unknown texture.");
+
+  const SpriteId spriteId = impl._handles.insert();
+  impl._x.push_back(x);
+  impl._y.push_back(y);
+  impl._width.push_back(static_cast<float>(source.getWidth()));
+  impl._height.push_back(static_cast<float>(source.getHeight()));
+  impl._z.push_back(z);
+  impl._textureIds.push_back(textureId);
+  impl._sources.push_back(source);
+  impl._flags.push_back(flags);
+  impl._layeredDirty = true;
+  return spriteId;
+}
+
+void SpriteWorld::remove(SpriteId spriteId) {
+  auto& impl = *_spriteWorldImpl;
+  const auto move = impl._handles.erase(spriteId);
+  if(!move) return;
+
+  const auto repack = [&move](auto& values) {
+    values[move->index] = values[move->from];
+    values.pop_back();
+  };
+  repack(impl._x);
+  repack(impl._y);
+  repack(impl._width);
+  repack(impl._height);
+  repack(impl._z);
+  repack(impl._textureIds);
+  repack(impl._sources);
+  repack(impl._flags);
+  impl._layeredDirty = true;
+}
+
+bool SpriteWorld::contains(SpriteId spriteId) const {
+  return _spriteWorldImpl->_handles.contains(spriteId);
+}
+
+void SpriteWorld::setPosition(SpriteId spriteId, float x, float y) {
+  auto& impl = *_spriteWorldImpl;
+  const std::size_t index = impl.indexOf(spriteId, "SpriteWorld::setPosition");
+  impl._x[index] = x;
+  impl._y[index] = y;
+}
+
+void SpriteWorld::setSize(SpriteId spriteId, float width, float height) {
+  auto& impl = *_spriteWorldImpl;
+  const std::size_t index = impl.indexOf(spriteId, "SpriteWorld::setSize");
+  impl._width[index] = width;
+  impl._height[index] = height;
+}
+
+void SpriteWorld::setSource(SpriteId spriteId, TextureId textureId, const Rectangle& source) {
+  auto& impl = *_spriteWorldImpl;
+  const std::size_t index = impl.indexOf(spriteId, "SpriteWorld::setSource");
+  if(textureId >= impl._textures.size()) throw std::out_of_range("SpriteWorld::setSource: unknown texture.");
+  impl._textureIds[index] = textureId;
+  impl._sources[index] = source;
+}
+
+void SpriteWorld::setSource(SpriteId spriteId, const Rectangle& source) {
+  auto& impl = *_spriteWorldImpl;
+  impl._sources[impl.indexOf(spriteId, "SpriteWorld::setSource")] = source;
+}
+
+void SpriteWorld::setZ(SpriteId spriteId, int32_t z) {
+  auto& impl = *_spriteWorldImpl;
+  const std::size_t index = impl.indexOf(spriteId, "SpriteWorld::setZ");
+  if(impl._z[index] != z) impl._layeredDirty = true;
+  impl._z[index] = z;
+}
+
+void SpriteWorld::setFlags(SpriteId spriteId, SpriteFlag flags) {
+  auto& impl = *_spriteWorldImpl;
+  impl._flags[impl.indexOf(spriteId, "SpriteWorld::setFlags")] = flags;
+}
+
+std::size_t SpriteWorld::getIndex(SpriteId spriteId) const {
+  return _spriteWorldImpl->indexOf(spriteId, "SpriteWorld::getIndex");
+}
+
+std::size_t SpriteWorld::size() const { return _spriteWorldImpl->_handles.size(); }
+
+std::span<const float> SpriteWorld::getX() const { return _spriteWorldImpl->_x; }
+std::span<const float> SpriteWorld::getY() const { return _spriteWorldImpl->_y; }
+std::span<const float> SpriteWorld::getWidth() const { return _spriteWorldImpl->_width; }
+std::span<const float> SpriteWorld::getHeight() const { return _spriteWorldImpl->_height; }
+std::span<const int32_t> SpriteWorld::getZ() const { return _spriteWorldImpl->_z; }
+std::span<const SpriteWorld::TextureId> SpriteWorld::getTextureIds() const { return _spriteWorldImpl->_textureIds; }
+std::span<const Rectangle> SpriteWorld::getSources() const { return _spriteWorldImpl->_sources; }
+std::span<const SpriteWorld::SpriteFlag> SpriteWorld::getFlags() const { return _spriteWorldImpl->_flags; }
+
+std::span<const uint32_t> SpriteWorld::cull(const Camera& camera) const {
+  const auto& impl = *_spriteWorldImpl;
+  impl._visible.resize(impl._handles.size());
+  const std::size_t count = vodden::cullRectangles(
+    impl._x, impl._y, impl._width, impl._height,
+    { camera.x, camera.y, camera.x + camera.width, camera.y + camera.height },
+    impl._visible
+  );
+  return std::span<const uint32_t>(impl._visible).first(count);
+}
+
+void SpriteWorld::render(GeometryBatch& geometryBatch, const Camera& camera) const {
+  const auto& impl = *_spriteWorldImpl;
+  const auto visible = cull(camera);
+
+  const bool layered = impl.isLayered();
+  if(layered) {
+    std::sort(impl._visible.begin(), impl._visible.begin() + visible.size(), [&impl](uint32_t a, uint32_t b) {
+      if(impl._z[a] != impl._z[b]) return impl._z[a] < impl._z[b];
+      return impl._textureIds[a] < impl._textureIds[b];
+    });
+  }
+
+  for(std::size_t i = 0; i < visible.size(); ++i) {
+    const uint32_t index = visible[i];
+    if(layered && i > 0 && impl._z[index] != impl._z[visible[i - 1]]) geometryBatch.flush();
+    if(impl._flags[index] & kHidden) continue;
+    geometryBatch.addQuad(
+      *impl._textures[impl._textureIds[index]],
+      impl._sources[index],
+      impl._x[index] - camera.x,
+      impl._y[index] - camera.y,
+      impl._width[index],
+      impl._height[index]
+    );
+  }
+  geometryBatch.flush();
+}
+
+}
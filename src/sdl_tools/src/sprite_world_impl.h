@@ -0,0 +1,45 @@
+#ifndef __SDL_TOOLS_SPRITE_WORLD_IMPL_H__
+#define __SDL_TOOLS_SPRITE_WORLD_IMPL_H__
+
+#include <vector>
+
+#include <handle_table.h>
+#include <memory_tracker.h>
+
+#include "rectangle.h"
+#include "texture.h"
+
+#include "sprite_world.h"
+
+namespace sdl::tools {
+
+class SpriteWorldImpl : public vodden::memory::Tracked<vodden::memory::Category::kGeometry> {
+  friend SpriteWorld;
+  private:
+    //! @brief the index of spriteId, throwing std::out_of_range if it has been removed
+    std::size_t indexOf(SpriteWorld::SpriteId spriteId, const char* caller) const;
+    //! @brief whether sprites are spread over more than one z, rechecked after a change to z
+    bool isLayered() const;
+
+    std::vector<const Texture*> _textures;
+
+    vodden::HandleTable _handles;
+    // one entry per sprite in each, all indexed alike
+    std::vector<float> _x;
+    std::vector<float> _y;
+    std::vector<float> _width;
+    std::vector<float> _height;
+    std::vector<int32_t> _z;
+    std::vector<SpriteWorld::TextureId> _textureIds;
+    std::vector<Rectangle> _sources;
+    std::vector<SpriteWorld::SpriteFlag> _flags;
+
+    // the compacted output of the last cull
+    mutable std::vector<uint32_t> _visible;
+    mutable bool _layered { false };
+    mutable bool _layeredDirty { false };
+};
+
+}
+
+#endif
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include <profiler.h>
+#include <thread_pool.h>
+
+#include "startup_impl.h"
+#include "startup.h"
+
+namespace sdl::tools {
+
+static std::vector<std::byte> readFile(const std::filesystem::path& filePath) {
+  std::ifstream file { filePath, std::ios::binary };
+  if(!file) throw std::runtime_error("Startup: could not open " + filePath.string() + ".");
+  std::vector<char> contents { std::istreambuf_iterator<char> { file }, std::istreambuf_iterator<char> {} };
+  if(file.bad()) throw std::runtime_error("Startup: could not read " + filePath.string() + ".");
+
+  std::vector<std::byte> data(contents.size());
+  std::memcpy(data.data(), contents.data(), contents.size());
+  return data;
+}
+
+void StartupImpl::checkQueueing(const char* method) const {
+  if(_begun) throw std::logic_error(std::string { "Startup::" } + method + " called after begin.");
+}
+
+void StartupImpl::checkFinished(const char* method) const {
+  if(!_finished) throw std::logic_error(std::string { "Startup::" } + method + " called before finish.");
+}
+
+void StartupImpl::checkNotTaken(const char* method, bool taken) const {
+  if(taken) throw std::logic_error(std::string { "Startup::" } + method + " called twice for one result.");
+}
+
+void StartupImpl::submit(const char* stage, std::function<void()> task) {
+  {
+    std::scoped_lock lock { _mutex };
+    ++_outstanding;
+  }
+  vodden::ThreadPool::shared().submit([this, stage, task = std::move(task)]() {
+    const auto start = Startup::Clock::now();
+    std::exception_ptr failure;
+    try {
+      task();
+    } catch(...) {
+      failure = std::current_exception();
+    }
+    recordStage(stage, start, Startup::Clock::now());
+
+    std::scoped_lock lock { _mutex };
+    if(failure && !_failure) _failure = failure;
+    if(--_outstanding == 0) _idle.notify_all();
+  });
+}
+
+void StartupImpl::recordStage(std::string_view name, Startup::Clock::time_point start, Startup::Clock::time_point end) {
+  std::scoped_lock lock { _mutex };
+  auto stageIt = std::find_if(_stages.begin(), _stages.end(), [name](const Stage& stage) { return stage.name == name; });
+  if(stageIt == _stages.end()) {
+    _stages.push_back({ std::string { name }, start, end });
+  } else {
+    stageIt->start = std::min(stageIt->start, start);
+    stageIt->end = std::max(stageIt->end, end);
+  }
+}
+
+void StartupImpl::decodeAtlasImage(Atlas& atlas, std::size_t index) {
+  submit("decode", [this, &atlas, index]() {
+    // the last decode to finish packs the atlas, even if this one failed
+    struct PackWhenLast {
+      StartupImpl& startupImpl;
+      Atlas& atlas;
+      ~PackWhenLast() {
+        if(atlas.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) startupImpl.packAtlas(atlas);
+      }
+    } packWhenLast { *this, atlas };
+
+    VODDEN_PROFILE_ZONE("Startup::decode");
+    atlas.surfaces[index].emplace(atlas.decodes[index]());
+  });
+}
+
+void StartupImpl::packAtlas(Atlas& atlas) {
+  submit("pack", [&atlas]() {
+    VODDEN_PROFILE_ZONE("Startup::pack");
+    for(auto& surface : atlas.surfaces) {
+      // a decode failed, which finish() reports
+      if(!surface) return;
+    }
+    for(auto& surface : atlas.surfaces) atlas.atlas.add(std::move(*surface));
+    atlas.surfaces.clear();
+    atlas.atlas.pack();
+  });
+}
+
+void StartupImpl::wait() {
+  std::unique_lock lock { _mutex };
+  _idle.wait(lock, [this]() { return _outstanding == 0; });
+}
+
+Startup::Startup() : _startupImpl { std::make_unique<StartupImpl>() } { }
+
+Startup::Startup(Startup&& other) noexcept = default;
+
+Startup::~Startup() {
+  if(_startupImpl) _startupImpl->wait();
+}
+
+Startup& Startup::operator=(Startup&& other) noexcept {
+  if(_startupImpl) _startupImpl->wait();
+  _startupImpl = std::move(other._startupImpl);
+  return *this;
+}
+
+Startup::ImageId Startup::addImage(std::filesystem::path filePath) {
+  _startupImpl->checkQueueing("addImage");
+  _startupImpl->_images.push_back({ [filePath = std::move(filePath)]() { return Surface { filePath }; }, std::nullopt, std::nullopt });
+  return _startupImpl->_images.size() - 1;
+}
+
+Startup::ImageId Startup::addImage(const void* location, std::size_t size) {
+  _startupImpl->checkQueueing("addImage");
+  _startupImpl->_images.push_back({ [location, size]() { return Surface { location, size }; }, std::nullopt, std::nullopt });
+  return _startupImpl->_images.size() - 1;
+}
+
+Startup::ImageId Startup::addImage(const BakedImage& bakedImage) {
+  _startupImpl->checkQueueing("addImage");
+  _startupImpl->_images.push_back({ {}, bakedImage, std::nullopt });
+  return _startupImpl->_images.size() - 1;
+}
+
+Startup::AtlasId Startup::addAtlas(uint32_t pageWidth, uint32_t pageHeight, uint32_t padding) {
+  _startupImpl->checkQueueing("addAtlas");
+  _startupImpl->_atlases.emplace_back(pageWidth, pageHeight, padding);
+  return _startupImpl->_atlases.size() - 1;
+}
+
+TextureAtlas::ImageId Startup::addAtlasImage(AtlasId atlasId, std::filesystem::path filePath) {
+  _startupImpl->checkQueueing("addAtlasImage");
+  auto& decodes = _startupImpl->_atlases.at(atlasId).decodes;
+  decodes.push_back([filePath = std::move(filePath)]() { return Surface { filePath }; });
+  return decodes.size() - 1;
+}
+
+TextureAtlas::ImageId Startup::addAtlasImage(AtlasId atlasId, const void* location, std::size_t size) {
+  _startupImpl->checkQueueing("addAtlasImage");
+  auto& decodes = _startupImpl->_atlases.at(atlasId).decodes;
+  decodes.push_back([location, size]() { return Surface { location, size }; });
+  return decodes.size() - 1;
+}
+
+Startup::BlobId Startup::addBlob(std::filesystem::path filePath) {
+  _startupImpl->checkQueueing("addBlob");
+  _startupImpl->_blobs.push_back({ std::move(filePath), {} });
+  return _startupImpl->_blobs.size() - 1;
+}
+
+void Startup::begin() {
+  auto& impl = *_startupImpl;
+  impl.checkQueueing("begin");
+  impl._begun = true;
+  impl._begin = Clock::now();
+
+  for(auto& image : impl._images) {
+    if(!image.decode) continue;
+    impl.submit("decode", [&image]() {
+      VODDEN_PROFILE_ZONE("Startup::decode");
+      image.surface.emplace(image.decode());
+    });
+  }
+  for(auto& atlas : impl._atlases) {
+    atlas.surfaces.resize(atlas.decodes.size());
+    atlas.remaining.store(atlas.decodes.size(), std::memory_order_relaxed);
+    if(atlas.decodes.empty()) impl.packAtlas(atlas);
+    for(std::size_t i = 0; i < atlas.decodes.size(); ++i) impl.decodeAtlasImage(atlas, i);
+  }
+  for(auto& blob : impl._blobs) {
+    impl.submit("load", [&blob]() {
+      VODDEN_PROFILE_ZONE("Startup::load");
+      blob.data = readFile(blob.filePath);
+    });
+  }
+}
+
+Startup::Report Startup::finish(const Renderer& renderer) {
+  auto& impl = *_startupImpl;
+  if(impl._finished) throw std::logic_error("Startup::finish called twice.");
+  if(!impl._begun) begin();
+
+  impl.wait();
+  if(impl._failure) std::rethrow_exception(impl._failure);
+
+  {
+    VODDEN_PROFILE_ZONE("Startup::upload");
+    const Clock::time_point start = Clock::now();
+    for(auto& image : impl._images) {
+      if(image.bakedImage) {
+        impl._textures.emplace_back(std::in_place, renderer, *image.bakedImage);
+      } else {
+        impl._textures.emplace_back(std::in_place, renderer, *image.surface);
+        image.surface.reset();
+      }
+    }
+    for(auto& atlas : impl._atlases) atlas.atlas.build(renderer);
+    record("upload", start, Clock::now());
+  }
+  impl._finished = true;
+
+  const Clock::time_point end = Clock::now();
+  Report report { {}, end - impl._begin };
+  std::scoped_lock lock { impl._mutex };
+  std::stable_sort(impl._stages.begin(), impl._stages.end(), [](const StartupImpl::Stage& a, const StartupImpl::Stage& b) {
+    return a.start < b.start;
+  });
+  for(const auto& stage : impl._stages) report.stages.push_back({ stage.name, stage.start - impl._begin, stage.end - stage.start });
+  return report;
+}
+
+Texture Startup::takeTexture(ImageId imageId) {
+  _startupImpl->checkFinished("takeTexture");
+  auto& texture = _startupImpl->_textures.at(imageId);
+  _startupImpl->checkNotTaken("takeTexture", !texture);
+  Texture taken { std::move(*texture) };
+  texture.reset();
+  return taken;
+}
+
+TextureAtlas Startup::takeAtlas(AtlasId atlasId) {
+  _startupImpl->checkFinished("takeAtlas");
+  auto& atlas = _startupImpl->_atlases.at(atlasId);
+  _startupImpl->checkNotTaken("takeAtlas", atlas.taken);
+  atlas.taken = true;
+  return std::move(atlas.atlas);
+}
+
+std::vector<std::byte> Startup::takeBlob(BlobId blobId) {
+  _startupImpl->checkFinished("takeBlob");
+  auto& blob = _startupImpl->_blobs.at(blobId);
+  _startupImpl->checkNotTaken("takeBlob", blob.taken);
+  blob.taken = true;
+  return std::move(blob.data);
+}
+
+void Startup::record(std::string_view name, Clock::time_point start, Clock::time_point end) {
+  _startupImpl->recordStage(name, start, end);
+}
+
+}
@@ -0,0 +1,99 @@
+#ifndef __SDL_TOOLS_STARTUP_IMPL_H__
+#define __SDL_TOOLS_STARTUP_IMPL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <memory_tracker.h>
+
+#include "baked_image.h"
+#include "surface.h"
+#include "texture.h"
+
+#include "startup.h"
+#include "texture_atlas.h"
+
+namespace sdl::tools {
+
+class StartupImpl : public vodden::memory::Tracked<vodden::memory::Category::kOther> {
+  friend Startup;
+  private:
+    struct Image {
+      //! @brief empty for a baked image, which needs no decoding
+      std::function<Surface()> decode;
+      std::optional<BakedImage> bakedImage;
+      //! @brief the decoded pixels, released once they have been uploaded
+      std::optional<Surface> surface;
+    };
+
+    struct Atlas {
+      Atlas(uint32_t pageWidth, uint32_t pageHeight, uint32_t padding) : atlas { pageWidth, pageHeight, padding } {};
+
+      TextureAtlas atlas;
+      std::vector<std::function<Surface()>> decodes;
+      //! @brief decoded out of order, then added to the atlas in order so the image ids hold
+      std::vector<std::optional<Surface>> surfaces;
+      //! @brief decodes still to finish; the last one to finish packs the atlas
+      std::atomic<std::size_t> remaining { 0 };
+      bool taken { false };
+    };
+
+    struct Blob {
+      std::filesystem::path filePath;
+      std::vector<std::byte> data;
+      bool taken { false };
+    };
+
+    struct Stage {
+      std::string name;
+      Startup::Clock::time_point start;
+      Startup::Clock::time_point end;
+    };
+
+    //! @brief throws std::logic_error once begin() has been called
+    void checkQueueing(const char* method) const;
+    //! @brief throws std::logic_error until finish() has returned
+    void checkFinished(const char* method) const;
+    //! @brief throws std::logic_error if the result has already been taken
+    void checkNotTaken(const char* method, bool taken) const;
+
+    //! @brief run task on the shared thread pool as part of the named stage, keeping the first exception it throws
+    void submit(const char* stage, std::function<void()> task);
+    //! @brief widen the named stage to cover start to end, adding it if it is new
+    void recordStage(std::string_view name, Startup::Clock::time_point start, Startup::Clock::time_point end);
+    void decodeAtlasImage(Atlas& atlas, std::size_t index);
+    void packAtlas(Atlas& atlas);
+    //! @brief block until every submitted task has finished
+    void wait();
+
+    std::deque<Image> _images;
+    // deques, as the tasks hold references to their elements
+    std::deque<Atlas> _atlases;
+    std::deque<Blob> _blobs;
+    // emptied as they are taken
+    std::deque<std::optional<Texture>> _textures;
+
+    bool _begun { false };
+    bool _finished { false };
+    Startup::Clock::time_point _begin;
+
+    std::mutex _mutex;
+    std::condition_variable _idle;
+    std::size_t _outstanding { 0 };
+    std::exception_ptr _failure;
+    std::vector<Stage> _stages;
+};
+
+}
+
+#endif
@@ -0,0 +1,58 @@
+#include <exception>
+#include <utility>
+
+#include "task_scheduler_impl.h"
+#include "task_scheduler.h"
+
+namespace sdl::tools {
+
+void TaskScheduler::FrameAwaiter::await_suspend(std::coroutine_handle<> awaiting) {
+  _taskSchedulerImpl.resumeNextFrame(awaiting);
+}
+
+TaskScheduler::TaskScheduler() : _taskSchedulerImpl { std::make_unique<TaskSchedulerImpl>() } { }
+
+TaskScheduler::TaskScheduler(TaskScheduler&& other) : _taskSchedulerImpl { std::move(other._taskSchedulerImpl) } { }
+
+TaskScheduler::~TaskScheduler() {
+  if(!_taskSchedulerImpl) return;
+  // forgotten first, as the handles belong to the tasks about to be destroyed
+  _taskSchedulerImpl->_nextFrame.clear();
+  _taskSchedulerImpl->_tasks.clear();
+}
+
+void TaskScheduler::spawn(Task task) {
+  auto& tasks = _taskSchedulerImpl->_tasks;
+  tasks.push_back(std::move(task));
+  // resumed through a copy of the handle, as the task may spawn others and so move tasks
+  const auto handle = tasks.back()._task;
+  if(handle) handle.resume();
+}
+
+TaskScheduler::FrameAwaiter TaskScheduler::nextFrame() {
+  return { *_taskSchedulerImpl };
+}
+
+std::size_t TaskScheduler::update() {
+  auto& impl = *_taskSchedulerImpl;
+
+  std::swap(impl._resuming, impl._nextFrame);
+  const std::size_t resumed = impl._resuming.size();
+  for(const auto awaiting : impl._resuming) awaiting.resume();
+  impl._resuming.clear();
+
+  std::exception_ptr exception;
+  std::erase_if(impl._tasks, [&exception](const Task& task) {
+    if(!task.isDone()) return false;
+    if(!exception && task._task) exception = task._task.promise()._exception;
+    return true;
+  });
+  if(exception) std::rethrow_exception(exception);
+  return resumed;
+}
+
+std::size_t TaskScheduler::getTaskCount() const {
+  return _taskSchedulerImpl->_tasks.size();
+}
+
+}
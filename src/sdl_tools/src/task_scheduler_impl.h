@@ -0,0 +1,29 @@
+#ifndef __SDL_TOOLS_TASK_SCHEDULER_IMPL_H__
+#define __SDL_TOOLS_TASK_SCHEDULER_IMPL_H__
+
+#include <coroutine>
+#include <vector>
+
+#include <memory_tracker.h>
+
+#include "task.h"
+#include "task_scheduler.h"
+
+namespace sdl::tools {
+
+class TaskSchedulerImpl : public vodden::memory::Tracked<vodden::memory::Category::kOther> {
+  friend TaskScheduler;
+  public:
+    void resumeNextFrame(std::coroutine_handle<> awaiting) { _nextFrame.push_back(awaiting); };
+
+  private:
+    std::vector<Task> _tasks {};
+    // awaiting the next update()
+    std::vector<std::coroutine_handle<>> _nextFrame {};
+    // swapped with _nextFrame by update(), so that tasks which await the next frame again wait for the one after
+    std::vector<std::coroutine_handle<>> _resuming {};
+};
+
+}
+
+#endif
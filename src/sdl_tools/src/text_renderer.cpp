@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <utf8.h>
+
+#include "surface.h"
+
+#include "text_renderer_impl.h"
+#include "text_renderer.h"
+
+namespace sdl::tools {
+
+TextRendererImpl::TextRendererImpl(const Renderer& renderer, const Font& font, uint32_t atlasSize) :
+  _font { font }, _atlas { renderer, atlasSize, atlasSize, Texture::kARGB8888 }, _packer { atlasSize, atlasSize } {
+  clearAtlas();
+  _atlas.setTextureBlendMode(Texture::kBlend);
+}
+
+void TextRendererImpl::clearAtlas() {
+  // a streaming texture starts undefined, and the padding between glyphs must read as transparent
+  const auto lockedPixels = _atlas.lock();
+  std::memset(lockedPixels.pixels.data(), 0, lockedPixels.pixels.size());
+  _atlas.unlock();
+}
+
+std::size_t TextRendererImpl::indexOf(TextRenderer::TextId textId, const char* caller) const {
+  const auto index = _handles.find(textId);
+  if(!index) throw std::out_of_range(std::string(caller) + ": text has been removed.");
+  return *index;
+}
+
+const CachedGlyph* TextRendererImpl::getGlyph(char32_t codePoint) {
+  if(const auto glyph = _glyphs.find(codePoint); glyph != _glyphs.end()) return &glyph->second;
+
+  const int32_t advance = _font.getGlyphMetrics(codePoint).advance;
+  const Surface surface = _font.renderGlyph(codePoint);
+  Rectangle source { 0, 0, 0, 0 };
+  // blank glyphs such as spaces only move the pen
+  if(surface.getWidth() != 0 && surface.getHeight() != 0) {
+    const auto position = _packer.insert(surface.getWidth() + kPadding, surface.getHeight() + kPadding);
+    if(!position) return nullptr;
+    source = Rectangle { position->x, position->y, surface.getWidth(), surface.getHeight() };
+    _atlas.update(surface, source);
+  }
+  return &_glyphs.emplace(codePoint, CachedGlyph { source, advance }).first->second;
+}
+
+void TextRendererImpl::layOut(LaidOutText& laidOutText) {
+  if(tryLayOut(laidOutText)) return;
+
+  // the atlas is full: start it again, and pack only the glyphs still in use
+  _glyphs.clear();
+  _packer = vodden::SkylinePacker { _atlas.getWidth(), _atlas.getHeight() };
+  clearAtlas();
+  bool fits = tryLayOut(laidOutText);
+  for(LaidOutText& text : _texts) {
+    if(&text != &laidOutText) fits = tryLayOut(text) && fits;
+  }
+  if(!fits) throw std::length_error("TextRenderer: the glyph atlas can't hold every glyph in use.");
+}
+
+bool TextRendererImpl::tryLayOut(LaidOutText& laidOutText) {
+  laidOutText.quads.clear();
+  const float lineSkip = static_cast<float>(_font.getLineSkip());
+  float penX = 0.0f;
+  float penY = 0.0f;
+  float width = 0.0f;
+  char32_t previous = 0;
+
+  const std::string_view text = laidOutText.text;
+  for(std::size_t index = 0; index < text.size();) {
+    const char32_t codePoint = vodden::decodeUtf8(text, index);
+    if(codePoint == U'\n') {
+      penX = 0.0f;
+      penY += lineSkip;
+      previous = 0;
+      continue;
+    }
+
+    if(previous != 0) penX += static_cast<float>(_font.getKerning(previous, codePoint));
+    const CachedGlyph* glyph = getGlyph(codePoint);
+    if(!glyph) return false;
+    if(glyph->source.getWidth() != 0) laidOutText.quads.push_back({ glyph->source, penX, penY });
+    penX += static_cast<float>(glyph->advance);
+    width = std::max(width, penX);
+    previous = codePoint;
+  }
+
+  laidOutText.width = width;
+  laidOutText.height = text.empty() ? 0.0f : penY + static_cast<float>(_font.getHeight());
+  return true;
+}
+
+TextRenderer::TextRenderer(const Renderer& renderer, const Font& font, uint32_t atlasSize) :
+  _textRendererImpl { std::make_unique<TextRendererImpl>(renderer, font, atlasSize) } { }
+
+TextRenderer::TextRenderer(TextRenderer&& other) : _textRendererImpl { std::move(other._textRendererImpl) } { }
+
+TextRenderer::~TextRenderer() {};
+
+TextRenderer::TextId TextRenderer::add(std::string_view text, float x, float y, const Color& color) {
+  auto& impl = *_textRendererImpl;
+  LaidOutText laidOutText { std::string { text }, x, y, color, 0.0f, 0.0f, {} };
+  impl.layOut(laidOutText);
+
+  const TextId textId = impl._handles.insert();
+  impl._texts.push_back(std::move(laidOutText));
+  return textId;
+}
+
+void TextRenderer::remove(TextId textId) {
+  auto& impl = *_textRendererImpl;
+  const auto move = impl._handles.erase(textId);
+  if(!move) return;
+  impl._texts[move->index] = std::move(impl._texts[move->from]);
+  impl._texts.pop_back();
+}
+
+bool TextRenderer::contains(TextId textId) const {
+  return _textRendererImpl->_handles.contains(textId);
+}
+
+void TextRenderer::setText(TextId textId, std::string_view text) {
+  auto& impl = *_textRendererImpl;
+  LaidOutText& laidOutText = impl._texts[impl.indexOf(textId, "TextRenderer::setText")];
+  if(laidOutText.text == text) return;
+  laidOutText.text.assign(text);
+  impl.layOut(laidOutText);
+}
+
+void TextRenderer::setPosition(TextId textId, float x, float y) {
+  auto& impl = *_textRendererImpl;
+  LaidOutText& laidOutText = impl._texts[impl.indexOf(textId, "TextRenderer::setPosition")];
+  laidOutText.x = x;
+  laidOutText.y = y;
+}
+
+void TextRenderer::setColor(TextId textId, const Color& color) {
+  auto& impl = *_textRendererImpl;
+  impl._texts[impl.indexOf(textId, "TextRenderer::setColor")].color = color;
+}
+
+float TextRenderer::getWidth(TextId textId) const {
+  const auto& impl = *_textRendererImpl;
+  return impl._texts[impl.indexOf(textId, "TextRenderer::getWidth")].width;
+}
+
+float TextRenderer::getHeight(TextId textId) const {
+  const auto& impl = *_textRendererImpl;
+  return impl._texts[impl.indexOf(textId, "TextRenderer::getHeight")].height;
+}
+
+void TextRenderer::render(GeometryBatch& geometryBatch) const {
+  const auto& impl = *_textRendererImpl;
+  for(const LaidOutText& laidOutText : impl._texts) {
+    for(const GlyphQuad& quad : laidOutText.quads) {
+      geometryBatch.addQuad(
+        impl._atlas, quad.source,
+        laidOutText.x + quad.x, laidOutText.y + quad.y,
+        static_cast<float>(quad.source.getWidth()), static_cast<float>(quad.source.getHeight()),
+        laidOutText.color
+      );
+    }
+  }
+}
+
+const Texture& TextRenderer::getAtlas() const {
+  return _textRendererImpl->_atlas;
+}
+
+}
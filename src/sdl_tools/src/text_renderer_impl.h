@@ -0,0 +1,78 @@
+#ifndef __SDL_TOOLS_TEXT_RENDERER_IMPL_H__
+#define __SDL_TOOLS_TEXT_RENDERER_IMPL_H__
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <handle_table.h>
+#include <memory_tracker.h>
+#include <skyline_packer.h>
+
+#include "color.h"
+#include "font.h"
+#include "rectangle.h"
+#include "renderer.h"
+#include "streaming_texture.h"
+
+#include "text_renderer.h"
+
+namespace sdl::tools {
+
+//! @brief a rasterized glyph's place in the atlas
+struct CachedGlyph {
+  Rectangle source;
+  int32_t advance;
+};
+
+//! @brief one glyph of a laid out text, relative to the text's top left
+struct GlyphQuad {
+  Rectangle source;
+  float x;
+  float y;
+};
+
+//! @brief a string and its layout, which is only redone when the string changes
+struct LaidOutText {
+  std::string text;
+  float x;
+  float y;
+  Color color;
+  float width;
+  float height;
+  std::vector<GlyphQuad> quads;
+};
+
+class TextRendererImpl : public vodden::memory::Tracked<vodden::memory::Category::kUI> {
+  friend TextRenderer;
+  public:
+    TextRendererImpl(const Renderer& renderer, const Font& font, uint32_t atlasSize);
+
+  private:
+    // the transparent gap left between glyphs, to stop neighbours bleeding when filtered
+    static constexpr uint32_t kPadding = 1;
+
+    //! @brief the index of textId, throwing std::out_of_range if it has been removed
+    std::size_t indexOf(TextRenderer::TextId textId, const char* caller) const;
+    //! @brief make every atlas pixel transparent
+    void clearAtlas();
+    //! @brief the cached glyph for codePoint, rasterizing and packing it the first time; nullptr if the atlas is full
+    const CachedGlyph* getGlyph(char32_t codePoint);
+    //! @brief fill laidOutText's quads and size from its text, emptying the atlas and laying every text out again if it fills up
+    void layOut(LaidOutText& laidOutText);
+    //! @brief fill laidOutText's quads and size from its text, or return false if a glyph doesn't fit in the atlas
+    bool tryLayOut(LaidOutText& laidOutText);
+
+    const Font& _font;
+    StreamingTexture _atlas;
+    vodden::SkylinePacker _packer;
+    std::unordered_map<char32_t, CachedGlyph> _glyphs;
+
+    vodden::HandleTable _handles;
+    std::vector<LaidOutText> _texts;
+};
+
+}
+
+#endif
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include <skyline_packer.h>
+
+#include "texture_atlas_impl.h"
+#include "texture_atlas.h"
+
+namespace sdl::tools {
+
+TextureAtlas::TextureAtlas(uint32_t pageWidth, uint32_t pageHeight, uint32_t padding) :
+  _textureAtlasImpl { std::make_unique<TextureAtlasImpl>(pageWidth, pageHeight, padding) } { }
+
+TextureAtlas::TextureAtlas(TextureAtlas&& other) : _textureAtlasImpl { std::move(other._textureAtlasImpl) } { }
+
+TextureAtlas::~TextureAtlas() {};
+
+TextureAtlas::ImageId TextureAtlas::add(Surface&& surface) {
+  if(_textureAtlasImpl->_packed) throw std::logic_error("TextureAtlas::add called after pack.");
+  if(surface.getWidth() > _textureAtlasImpl->_pageWidth || surface.getHeight() > _textureAtlasImpl->_pageHeight)
+    throw std::invalid_argument("Image is larger than an atlas page.");
+
+  _textureAtlasImpl->_images.push_back({ std::move(surface), 0, {} });
+  return _textureAtlasImpl->_images.size() - 1;
+}
+
+TextureAtlas::ImageId TextureAtlas::add(const void* location, std::size_t size) {
+  return add(Surface { location, size });
+}
+
+void TextureAtlas::pack() {
+  if(_textureAtlasImpl->_packed) throw std::logic_error("TextureAtlas::pack called twice.");
+  auto& images = _textureAtlasImpl->_images;
+
+  std::vector<ImageId> order(images.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&images](ImageId a, ImageId b) {
+    return images[a].surface->getHeight() > images[b].surface->getHeight();
+  });
+
+  std::vector<vodden::SkylinePacker> packers;
+  std::vector<std::vector<ImageId>> pageImages;
+  for(ImageId imageId : order) {
+    auto& image = images[imageId];
+    const uint32_t width = image.surface->getWidth(), height = image.surface->getHeight();
+    const uint32_t paddedWidth = std::min(width + _textureAtlasImpl->_padding, _textureAtlasImpl->_pageWidth);
+    const uint32_t paddedHeight = std::min(height + _textureAtlasImpl->_padding, _textureAtlasImpl->_pageHeight);
+
+    std::optional<vodden::SkylinePacker::Position> position;
+    std::size_t page = 0;
+    while(page < packers.size() && !(position = packers[page].insert(paddedWidth, paddedHeight))) ++page;
+    if(!position) {
+      packers.emplace_back(_textureAtlasImpl->_pageWidth, _textureAtlasImpl->_pageHeight);
+      pageImages.emplace_back();
+      position = packers.back().insert(paddedWidth, paddedHeight);
+    }
+
+    image.page = page;
+    image.rectangle = Rectangle { position->x, position->y, width, height };
+    pageImages[page].push_back(imageId);
+  }
+
+  for(std::size_t page = 0; page < packers.size(); ++page) {
+    // pages are trimmed to the height actually used, so a partial final page costs less memory
+    Surface pageSurface { packers[page].getWidth(), packers[page].getUsedHeight() };
+    for(ImageId imageId : pageImages[page]) {
+      auto& image = images[imageId];
+      pageSurface.blit(*image.surface, image.rectangle.getX(), image.rectangle.getY());
+      image.surface.reset();
+    }
+    _textureAtlasImpl->_pageSurfaces.push_back(std::move(pageSurface));
+  }
+  _textureAtlasImpl->_packed = true;
+}
+
+void TextureAtlas::build(const Renderer& renderer) {
+  if(_textureAtlasImpl->_built) throw std::logic_error("TextureAtlas::build called twice.");
+  if(!_textureAtlasImpl->_packed) pack();
+
+  auto& pageSurfaces = _textureAtlasImpl->_pageSurfaces;
+  for(const Surface& pageSurface : pageSurfaces) _textureAtlasImpl->_pages.emplace_back(renderer, pageSurface);
+  pageSurfaces.clear();
+  _textureAtlasImpl->_built = true;
+}
+
+Sprite TextureAtlas::getSprite(ImageId imageId) const {
+  if(!_textureAtlasImpl->_built) throw std::logic_error("TextureAtlas::getSprite called before build.");
+  const auto& image = _textureAtlasImpl->_images.at(imageId);
+  return Sprite { _textureAtlasImpl->_pages[image.page], image.rectangle };
+}
+
+std::size_t TextureAtlas::getPageCount() const {
+  return _textureAtlasImpl->_pages.size();
+}
+
+}
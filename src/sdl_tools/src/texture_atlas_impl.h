@@ -0,0 +1,46 @@
+#ifndef __SDL_TOOLS_TEXTURE_ATLAS_IMPL_H__
+#define __SDL_TOOLS_TEXTURE_ATLAS_IMPL_H__
+
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include <memory_tracker.h>
+
+#include "rectangle.h"
+#include "surface.h"
+#include "texture.h"
+
+#include "texture_atlas.h"
+
+namespace sdl::tools {
+
+class TextureAtlasImpl : public vodden::memory::Tracked<vodden::memory::Category::kTextures> {
+  friend TextureAtlas;
+  public:
+    TextureAtlasImpl(uint32_t pageWidth, uint32_t pageHeight, uint32_t padding) :
+      _pageWidth { pageWidth }, _pageHeight { pageHeight }, _padding { padding } {};
+
+  private:
+    struct Image {
+      //! @brief the source pixels, released once they have been uploaded
+      std::optional<Surface> surface;
+      std::size_t page;
+      Rectangle rectangle;
+    };
+
+    uint32_t _pageWidth;
+    uint32_t _pageHeight;
+    uint32_t _padding;
+    bool _packed { false };
+    bool _built { false };
+    std::vector<Image> _images;
+    // the packed pages, released once they have been uploaded
+    std::vector<Surface> _pageSurfaces;
+    // a deque so the textures the sprites refer to never move
+    std::deque<Texture> _pages;
+};
+
+}
+
+#endif
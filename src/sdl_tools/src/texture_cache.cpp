@@ -0,0 +1,80 @@
+#include <string_view>
+
+#include "texture_cache_impl.h"
+#include "texture_cache.h"
+
+namespace sdl::tools {
+
+TextureHandle TextureCacheImpl::find(std::string key, const std::function<Texture()>& load) {
+  const auto found = _index.find(key);
+  if(found != _index.end()) {
+    _entries.splice(_entries.begin(), _entries, found->second);
+    return found->second->textureHandle;
+  }
+
+  Texture texture = load();
+  const std::size_t bytes = std::size_t { texture.getWidth() } * texture.getHeight() * 4;
+  _entries.push_front({ key, TextureHandle { std::move(texture) }, bytes });
+  _index.emplace(std::move(key), _entries.begin());
+  _residentBytes += bytes;
+
+  // copied before evicting so the new texture counts as referenced
+  TextureHandle textureHandle = _entries.front().textureHandle;
+  evict();
+  return textureHandle;
+}
+
+void TextureCacheImpl::evict() {
+  for(auto entry = _entries.end(); entry != _entries.begin() && _residentBytes > _budget;) {
+    --entry;
+    if(!isUnreferenced(*entry)) continue;
+    _residentBytes -= entry->bytes;
+    _index.erase(entry->key);
+    entry = _entries.erase(entry);
+  }
+}
+
+TextureCache::TextureCache(const Renderer& renderer, std::size_t budget) :
+  _textureCacheImpl { std::make_unique<TextureCacheImpl>(renderer, budget) } { }
+
+TextureCache::TextureCache(TextureCache&& other) : _textureCacheImpl { std::move(other._textureCacheImpl) } { }
+
+TextureCache::~TextureCache() {};
+
+TextureHandle TextureCache::load(const std::filesystem::path& filePath) {
+  auto& renderer = _textureCacheImpl->_renderer;
+  return _textureCacheImpl->find("file:" + filePath.lexically_normal().string(), [&renderer, &filePath]() {
+    return Texture { renderer, filePath };
+  });
+}
+
+TextureHandle TextureCache::load(const void* location, std::size_t size) {
+  const std::size_t hash = std::hash<std::string_view>{}(std::string_view { static_cast<const char*>(location), size });
+  auto& renderer = _textureCacheImpl->_renderer;
+  return _textureCacheImpl->find("memory:" + std::to_string(hash) + ":" + std::to_string(size), [&renderer, location, size]() {
+    return Texture { renderer, location, size };
+  });
+}
+
+void TextureCache::trim() {
+  _textureCacheImpl->evict();
+}
+
+void TextureCache::setBudget(std::size_t budget) {
+  _textureCacheImpl->_budget = budget;
+  trim();
+}
+
+std::size_t TextureCache::getBudget() const {
+  return _textureCacheImpl->_budget;
+}
+
+std::size_t TextureCache::getResidentBytes() const {
+  return _textureCacheImpl->_residentBytes;
+}
+
+std::size_t TextureCache::size() const {
+  return _textureCacheImpl->_entries.size();
+}
+
+}
@@ -0,0 +1,52 @@
+#ifndef __SDL_TOOLS_TEXTURE_CACHE_IMPL_H__
+#define __SDL_TOOLS_TEXTURE_CACHE_IMPL_H__
+
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include <memory_tracker.h>
+
+#include "renderer.h"
+#include "texture.h"
+
+#include "texture_cache.h"
+#include "texture_handle_impl.h"
+
+namespace sdl::tools {
+
+class TextureCacheImpl : public vodden::memory::Tracked<vodden::memory::Category::kTextures> {
+  friend TextureCache;
+  public:
+    TextureCacheImpl(const Renderer& renderer, std::size_t budget) : _renderer { renderer }, _budget { budget } {};
+
+  private:
+    struct Entry {
+      std::string key;
+      TextureHandle textureHandle;
+      std::size_t bytes;
+    };
+    typedef std::list<Entry> Entries;
+
+    //! @brief the resident texture for key, or a freshly loaded one
+    TextureHandle find(std::string key, const std::function<Texture()>& load);
+    //! @brief release unreferenced entries, least recently used first, until within budget
+    void evict();
+
+    //! @brief true if only the cache holds the texture
+    static bool isUnreferenced(const Entry& entry) {
+      return entry.textureHandle._textureHandleImpl.use_count() == 1;
+    }
+
+    const Renderer& _renderer;
+    std::size_t _budget;
+    std::size_t _residentBytes { 0 };
+    // most recently used at the front
+    Entries _entries;
+    std::unordered_map<std::string, Entries::iterator> _index;
+};
+
+}
+
+#endif
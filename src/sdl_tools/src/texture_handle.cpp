@@ -0,0 +1,36 @@
+#include "texture_handle_impl.h"
+#include "texture_handle.h"
+
+namespace sdl::tools {
+
+TextureHandle::Awaiter::~Awaiter() {
+  // destroyed along with a suspended coroutine, which must not then be resumed
+  if(_awaiting) _textureHandleImpl->removeWaiter(_awaiting);
+}
+
+bool TextureHandle::Awaiter::await_ready() const noexcept {
+  return _textureHandleImpl->_status.load(std::memory_order_acquire) != Status::kPending;
+}
+
+void TextureHandle::Awaiter::await_suspend(std::coroutine_handle<> awaiting) {
+  _awaiting = awaiting;
+  _textureHandleImpl->addWaiter(awaiting);
+}
+
+TextureHandle TextureHandle::Awaiter::await_resume() {
+  _awaiting = {};
+  return TextureHandle { _textureHandleImpl };
+}
+
+TextureHandle::TextureHandle(Texture&& texture) : _textureHandleImpl { TextureHandleImpl::create(std::move(texture)) } { }
+
+TextureHandle::Status TextureHandle::getStatus() const {
+  return _textureHandleImpl->_status.load(std::memory_order_acquire);
+}
+
+const Texture* TextureHandle::get() const {
+  if(getStatus() != Status::kReady) return nullptr;
+  return &*_textureHandleImpl->_texture;
+}
+
+}
@@ -0,0 +1,61 @@
+#ifndef __SDL_TOOLS_TEXTURE_HANDLE_IMPL_H__
+#define __SDL_TOOLS_TEXTURE_HANDLE_IMPL_H__
+
+#include <algorithm>
+#include <atomic>
+#include <coroutine>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <memory_tracker.h>
+
+#include "texture.h"
+
+#include "texture_handle.h"
+
+namespace sdl::tools {
+
+class TextureHandleImpl {
+  friend TextureHandle;
+  friend TextureHandle::Awaiter;
+  public:
+    TextureHandleImpl() {};
+    TextureHandleImpl(Texture&& texture) : _texture { std::move(texture) }, _status { TextureHandle::Status::kReady } {};
+
+    //! @brief a shared TextureHandleImpl, counted against kTextures along with its control block, as make_shared would not be
+    template <class... Args>
+    static std::shared_ptr<TextureHandleImpl> create(Args&&... args) {
+      typedef vodden::memory::TrackingAllocator<TextureHandleImpl, vodden::memory::Category::kTextures> Allocator;
+      return std::allocate_shared<TextureHandleImpl>(Allocator {}, std::forward<Args>(args)...);
+    }
+
+    //! @brief publish the uploaded texture; render thread only
+    void setTexture(Texture&& texture) {
+      _texture.emplace(std::move(texture));
+      _status.store(TextureHandle::Status::kReady, std::memory_order_release);
+    }
+
+    void setFailed() {
+      _status.store(TextureHandle::Status::kFailed, std::memory_order_release);
+    }
+
+    //! @brief resume awaiting once the texture is no longer pending; render thread only
+    void addWaiter(std::coroutine_handle<> awaiting) { _waiters.push_back(awaiting); }
+    void removeWaiter(std::coroutine_handle<> awaiting) { std::erase(_waiters, awaiting); }
+    //! @brief move the waiting coroutines to the end of waiters, for the caller to resume
+    void takeWaiters(std::vector<std::coroutine_handle<>>& waiters) {
+      waiters.insert(waiters.end(), _waiters.begin(), _waiters.end());
+      _waiters.clear();
+    }
+
+  private:
+    std::optional<Texture> _texture;
+    std::vector<std::coroutine_handle<>> _waiters;
+    std::atomic<TextureHandle::Status> _status { TextureHandle::Status::kPending };
+};
+
+}
+
+#endif
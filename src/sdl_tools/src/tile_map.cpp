@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "tile_map_impl.h"
+#include "tile_map.h"
+
+namespace sdl::tools {
+
+TileMapImpl::TileMapImpl(
+  Renderer& renderer,
+  const Texture& tileset,
+  uint32_t tileWidth,
+  uint32_t tileHeight,
+  uint32_t columns,
+  uint32_t rows,
+  uint32_t chunkSize,
+  std::size_t cachedChunks
+) :
+  _renderer { renderer },
+  _tileset { tileset },
+  _tileWidth { tileWidth },
+  _tileHeight { tileHeight },
+  _tilesetColumns { tileWidth > 0 ? tileset.getWidth() / tileWidth : 0 },
+  _tileCount { tileHeight > 0 ? _tilesetColumns * (tileset.getHeight() / tileHeight) : 0 },
+  _columns { columns },
+  _rows { rows },
+  _chunkSize { chunkSize },
+  _chunkColumns { chunkSize > 0 ? (columns + chunkSize - 1) / chunkSize : 0 },
+  _chunkRows { chunkSize > 0 ? (rows + chunkSize - 1) / chunkSize : 0 },
+  _cachedChunks { cachedChunks },
+  _tiles(static_cast<std::size_t>(columns) * rows, TileMap::kNoTile),
+  _chunks(static_cast<std::size_t>(_chunkColumns) * _chunkRows),
+  _geometryBatch { renderer, static_cast<std::size_t>(chunkSize) * chunkSize }
+{
+  if(_tileCount == 0) throw std::invalid_argument("TileMap: the tileset is smaller than a tile.");
+  if(chunkSize == 0) throw std::invalid_argument("TileMap: chunkSize must be at least 1.");
+}
+
+std::size_t TileMapImpl::indexOf(uint32_t column, uint32_t row, const char* caller) const {
+  if(column >= _columns || row >= _rows) throw std::out_of_range(std::string(caller) + ": cell is outside the map.");
+  return static_cast<std::size_t>(row) * _columns + column;
+}
+
+void TileMapImpl::checkTile(TileMap::TileId tileId, const char* caller) const {
+  if(tileId != TileMap::kNoTile && tileId >= _tileCount) {
+    throw std::invalid_argument(std::string(caller) + ": tile " + std::to_string(tileId) + " is past the tileset's " + std::to_string(_tileCount) + " tiles.");
+  }
+}
+
+TileMapImpl::Slot& TileMapImpl::acquireSlot(std::size_t chunk) {
+  auto oldest = std::min_element(_slots.begin(), _slots.end(), [](const Slot& a, const Slot& b) {
+    return a.lastUsed < b.lastUsed;
+  });
+  // chunks drawn this frame are still needed, so grow rather than take one of theirs
+  if(_slots.size() < _cachedChunks || oldest == _slots.end() || oldest->lastUsed == _frame) {
+    Slot& slot = _slots.emplace_back(Slot {
+      TargetTexture { _renderer, _chunkSize * _tileWidth, _chunkSize * _tileHeight },
+      chunk,
+      _frame
+    });
+    slot.texture.setTextureBlendMode(Texture::kBlend);
+    _chunks[chunk].slot = static_cast<int32_t>(_slots.size() - 1);
+  } else {
+    _chunks[oldest->chunk].slot = kNoSlot;
+    oldest->chunk = chunk;
+    _chunks[chunk].slot = static_cast<int32_t>(oldest - _slots.begin());
+  }
+  _chunks[chunk].dirty = true;
+  return _slots[_chunks[chunk].slot];
+}
+
+void TileMapImpl::bake(std::size_t chunk, Slot& slot) {
+  const uint32_t firstColumn = static_cast<uint32_t>(chunk % _chunkColumns) * _chunkSize;
+  const uint32_t firstRow = static_cast<uint32_t>(chunk / _chunkColumns) * _chunkSize;
+  const uint32_t lastColumn = std::min(firstColumn + _chunkSize, _columns);
+  const uint32_t lastRow = std::min(firstRow + _chunkSize, _rows);
+
+  const auto targetScope = _renderer.setTarget(slot.texture);
+  _renderer.setRenderDrawColour(kClear);
+  _renderer.clear();
+  for(uint32_t row = firstRow; row < lastRow; ++row) {
+    for(uint32_t column = firstColumn; column < lastColumn; ++column) {
+      const TileMap::TileId tileId = _tiles[static_cast<std::size_t>(row) * _columns + column];
+      if(tileId == TileMap::kNoTile) continue;
+      _geometryBatch.addQuad(
+        _tileset,
+        { (tileId % _tilesetColumns) * _tileWidth, (tileId / _tilesetColumns) * _tileHeight, _tileWidth, _tileHeight },
+        { (column - firstColumn) * _tileWidth, (row - firstRow) * _tileHeight, _tileWidth, _tileHeight }
+      );
+    }
+  }
+  _geometryBatch.flush();
+  _chunks[chunk].dirty = false;
+}
+
+TileMap::TileMap(
+  Renderer& renderer,
+  const Texture& tileset,
+  uint32_t tileWidth,
+  uint32_t tileHeight,
+  uint32_t columns,
+  uint32_t rows,
+  uint32_t chunkSize,
+  std::size_t cachedChunks
+) : _tileMapImpl { std::make_unique<TileMapImpl>(renderer, tileset, tileWidth, tileHeight, columns, rows, chunkSize, cachedChunks) } { }
+
+TileMap::TileMap(TileMap&& other) : _tileMapImpl { std::move(other._tileMapImpl) } { }
+
+TileMap::~TileMap() {};
+
+void TileMap::setTile(uint32_t column, uint32_t row, TileId tileId) {
+  auto& impl = *_tileMapImpl;
+  TileId& tile = impl._tiles[impl.indexOf(column, row, "TileMap::setTile")];
+  impl.checkTile(tileId, "TileMap::setTile");
+  if(tile == tileId) return;
+  tile = tileId;
+  impl._chunks[static_cast<std::size_t>(row / impl._chunkSize) * impl._chunkColumns + column / impl._chunkSize].dirty = true;
+}
+
+TileMap::TileId TileMap::getTile(uint32_t column, uint32_t row) const {
+  const auto& impl = *_tileMapImpl;
+  return impl._tiles[impl.indexOf(column, row, "TileMap::getTile")];
+}
+
+void TileMap::setTiles(std::span<const TileId> tiles) {
+  auto& impl = *_tileMapImpl;
+  if(tiles.size() != impl._tiles.size()) throw std::invalid_argument("TileMap::setTiles: expected one id per cell.");
+  for(const TileId tileId : tiles) impl.checkTile(tileId, "TileMap::setTiles");
+  std::copy(tiles.begin(), tiles.end(), impl._tiles.begin());
+  invalidate();
+}
+
+void TileMap::invalidate() {
+  for(auto& chunk : _tileMapImpl->_chunks) chunk.dirty = true;
+}
+
+std::optional<TileMap::Cell> TileMap::hitTest(uint32_t x, uint32_t y) const {
+  const auto& impl = *_tileMapImpl;
+  const Cell cell { x / impl._tileWidth, y / impl._tileHeight };
+  if(cell.column >= impl._columns || cell.row >= impl._rows) return std::nullopt;
+  return cell;
+}
+
+void TileMap::render(const Rectangle& view) {
+  auto& impl = *_tileMapImpl;
+  ++impl._frame;
+
+  // clip the view to the map, so every chunk below exists
+  const uint32_t right = std::min(view.getX() + view.getWidth(), impl._columns * impl._tileWidth);
+  const uint32_t bottom = std::min(view.getY() + view.getHeight(), impl._rows * impl._tileHeight);
+  if(view.getX() >= right || view.getY() >= bottom) return;
+
+  const uint32_t chunkWidth = impl._chunkSize * impl._tileWidth;
+  const uint32_t chunkHeight = impl._chunkSize * impl._tileHeight;
+  for(uint32_t chunkRow = view.getY() / chunkHeight; chunkRow <= (bottom - 1) / chunkHeight; ++chunkRow) {
+    for(uint32_t chunkColumn = view.getX() / chunkWidth; chunkColumn <= (right - 1) / chunkWidth; ++chunkColumn) {
+      const std::size_t chunk = static_cast<std::size_t>(chunkRow) * impl._chunkColumns + chunkColumn;
+      auto& slot = impl._chunks[chunk].slot == TileMapImpl::kNoSlot
+        ? impl.acquireSlot(chunk)
+        : impl._slots[impl._chunks[chunk].slot];
+      slot.lastUsed = impl._frame;
+      if(impl._chunks[chunk].dirty) impl.bake(chunk, slot);
+
+      // copy only the part of the chunk inside the view
+      const uint32_t chunkX = chunkColumn * chunkWidth;
+      const uint32_t chunkY = chunkRow * chunkHeight;
+      const uint32_t left = std::max(view.getX(), chunkX);
+      const uint32_t top = std::max(view.getY(), chunkY);
+      const uint32_t width = std::min(right, chunkX + chunkWidth) - left;
+      const uint32_t height = std::min(bottom, chunkY + chunkHeight) - top;
+      impl._renderer.copy(
+        slot.texture,
+        { left - chunkX, top - chunkY, width, height },
+        { left - view.getX(), top - view.getY(), width, height }
+      );
+    }
+  }
+}
+
+uint32_t TileMap::getColumns() const { return _tileMapImpl->_columns; }
+uint32_t TileMap::getRows() const { return _tileMapImpl->_rows; }
+uint32_t TileMap::getTileWidth() const { return _tileMapImpl->_tileWidth; }
+uint32_t TileMap::getTileHeight() const { return _tileMapImpl->_tileHeight; }
+uint32_t TileMap::getTileCount() const { return _tileMapImpl->_tileCount; }
+
+}
@@ -0,0 +1,81 @@
+#ifndef __SDL_TOOLS_TILE_MAP_IMPL_H__
+#define __SDL_TOOLS_TILE_MAP_IMPL_H__
+
+#include <deque>
+#include <vector>
+
+#include <memory_tracker.h>
+
+#include "color.h"
+#include "renderer.h"
+#include "target_texture.h"
+#include "texture.h"
+
+#include "geometry_batch.h"
+#include "tile_map.h"
+
+namespace sdl::tools {
+
+class TileMapImpl : public vodden::memory::Tracked<vodden::memory::Category::kGeometry> {
+  friend TileMap;
+  public:
+    TileMapImpl(
+      Renderer& renderer,
+      const Texture& tileset,
+      uint32_t tileWidth,
+      uint32_t tileHeight,
+      uint32_t columns,
+      uint32_t rows,
+      uint32_t chunkSize,
+      std::size_t cachedChunks
+    );
+
+  private:
+    static constexpr int32_t kNoSlot = -1;
+    static constexpr Color kClear { 0, 0, 0, (uint8_t) Alpha::kTransparent };
+
+    struct Chunk {
+      // the cached texture holding this chunk, or kNoSlot
+      int32_t slot { kNoSlot };
+      // true if the tiles have changed since the chunk was last drawn into its texture
+      bool dirty { true };
+    };
+
+    struct Slot {
+      TargetTexture texture;
+      std::size_t chunk;
+      uint64_t lastUsed;
+    };
+
+    std::size_t indexOf(uint32_t column, uint32_t row, const char* caller) const;
+    //! @brief throws std::invalid_argument unless tileId is kNoTile or within the tileset
+    void checkTile(TileMap::TileId tileId, const char* caller) const;
+    //! @brief a texture for chunk, reusing the least recently drawn one if the cache is full
+    Slot& acquireSlot(std::size_t chunk);
+    //! @brief draw chunk's tiles into its texture
+    void bake(std::size_t chunk, Slot& slot);
+
+    Renderer& _renderer;
+    const Texture& _tileset;
+    uint32_t _tileWidth;
+    uint32_t _tileHeight;
+    // the number of tiles in each row of the tileset, and in all
+    uint32_t _tilesetColumns;
+    uint32_t _tileCount;
+    uint32_t _columns;
+    uint32_t _rows;
+    uint32_t _chunkSize;
+    uint32_t _chunkColumns;
+    uint32_t _chunkRows;
+    std::size_t _cachedChunks;
+
+    std::vector<TileMap::TileId> _tiles;
+    std::vector<Chunk> _chunks;
+    std::deque<Slot> _slots;
+    GeometryBatch _geometryBatch;
+    uint64_t _frame { 0 };
+};
+
+}
+
+#endif
@@ -0,0 +1,152 @@
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <renderer.h>
+#include <surface.h>
+
+#include <async_texture_loader.h>
+#include <task.h>
+#include <task_scheduler.h>
+#include <texture_handle.h>
+
+#include "test_bitmap.h"
+
+using namespace sdl;
+using namespace sdl::tools;
+
+namespace {
+
+Task awaitTexture(TextureHandle textureHandle, std::optional<TextureHandle::Status>& status) {
+  const TextureHandle loaded = co_await textureHandle;
+  status = loaded.getStatus();
+}
+
+//! @brief call update until something completes, as the decode runs on the pool
+std::size_t updateUntilCompleted(AsyncTextureLoader& asyncTextureLoader) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds { 10 };
+  std::size_t completed = 0;
+  while((completed = asyncTextureLoader.update()) == 0 && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+  return completed;
+}
+
+}
+
+TEST(AsyncTextureLoaderTest, resumesWaitersFromUpdateOnceTheTextureIsReady) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  AsyncTextureLoader asyncTextureLoader { renderer };
+  TaskScheduler taskScheduler;
+
+  const std::vector<std::byte> image = test::bitmap(1);
+  const TextureHandle textureHandle = asyncTextureLoader.load(image.data(), image.size());
+  std::optional<TextureHandle::Status> first;
+  std::optional<TextureHandle::Status> second;
+  taskScheduler.spawn(awaitTexture(textureHandle, first));
+  taskScheduler.spawn(awaitTexture(textureHandle, second));
+  ASSERT_FALSE(first.has_value());
+
+  ASSERT_EQ(updateUntilCompleted(asyncTextureLoader), 1u);
+  ASSERT_EQ(first, TextureHandle::Status::kReady);
+  ASSERT_EQ(second, TextureHandle::Status::kReady);
+  ASSERT_NE(textureHandle.get(), nullptr);
+  ASSERT_EQ(textureHandle.get()->getWidth(), 1u);
+  ASSERT_EQ(asyncTextureLoader.getPendingCount(), 0u);
+}
+
+TEST(AsyncTextureLoaderTest, resumesWaitersFromUpdateWhenTheDecodeFails) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  AsyncTextureLoader asyncTextureLoader { renderer };
+  TaskScheduler taskScheduler;
+
+  const std::array<std::byte, 4> garbage {};
+  const TextureHandle textureHandle = asyncTextureLoader.load(garbage.data(), garbage.size());
+  std::optional<TextureHandle::Status> status;
+  taskScheduler.spawn(awaitTexture(textureHandle, status));
+
+  ASSERT_EQ(updateUntilCompleted(asyncTextureLoader), 1u);
+  ASSERT_EQ(status, TextureHandle::Status::kFailed);
+  ASSERT_EQ(textureHandle.get(), nullptr);
+}
+
+TEST(AsyncTextureLoaderTest, doesNotSuspendOnAHandleWhichIsAlreadyReady) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  TaskScheduler taskScheduler;
+
+  std::optional<TextureHandle::Status> status;
+  taskScheduler.spawn(awaitTexture(TextureHandle { Texture { renderer, Surface { 1, 1 } } }, status));
+  ASSERT_EQ(status, TextureHandle::Status::kReady);
+}
+
+TEST(AsyncTextureLoaderTest, uploadsAtMostOneSurfaceOverBudgetPerUpdate) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  // smaller than any surface, so every update uploads exactly one
+  AsyncTextureLoader asyncTextureLoader { renderer, 1 };
+  std::vector<std::vector<std::byte>> bitmaps;
+  std::vector<TextureHandle> textureHandles;
+  for(uint32_t width = 1; width <= 3; ++width) bitmaps.push_back(test::bitmap(width));
+  for(const auto& bitmap : bitmaps) textureHandles.push_back(asyncTextureLoader.load(bitmap.data(), bitmap.size()));
+  ASSERT_EQ(asyncTextureLoader.getPendingCount(), 3u);
+
+  std::size_t completed = 0;
+  while(completed < 3) {
+    const std::size_t completedNow = updateUntilCompleted(asyncTextureLoader);
+    ASSERT_EQ(completedNow, 1u);
+    completed += completedNow;
+    ASSERT_EQ(asyncTextureLoader.getPendingCount(), 3 - completed);
+  }
+  for(std::size_t i = 0; i < textureHandles.size(); ++i) {
+    ASSERT_TRUE(textureHandles[i].isReady());
+    ASSERT_EQ(textureHandles[i].get()->getWidth(), i + 1);
+  }
+}
+
+TEST(AsyncTextureLoaderTest, loadsFilesAndFailsMissingOnes) {
+  const auto filePath = std::filesystem::temp_directory_path() / "async_texture_loader_test.bmp";
+  {
+    const auto bitmap = test::bitmap(2);
+    std::ofstream file { filePath, std::ios::binary };
+    file.write(reinterpret_cast<const char*>(bitmap.data()), static_cast<std::streamsize>(bitmap.size()));
+  }
+
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  AsyncTextureLoader asyncTextureLoader { renderer };
+  const TextureHandle loaded = asyncTextureLoader.load(filePath);
+  const TextureHandle missing = asyncTextureLoader.load(filePath.parent_path() / "async_texture_loader_test_missing.bmp");
+  ASSERT_EQ(loaded.getStatus(), TextureHandle::Status::kPending);
+
+  std::size_t completed = 0;
+  while(completed < 2) {
+    const std::size_t completedNow = updateUntilCompleted(asyncTextureLoader);
+    ASSERT_GT(completedNow, 0u);
+    completed += completedNow;
+  }
+  ASSERT_TRUE(loaded.isReady());
+  ASSERT_EQ(loaded.get()->getWidth(), 2u);
+  ASSERT_EQ(missing.getStatus(), TextureHandle::Status::kFailed);
+  ASSERT_EQ(missing.get(), nullptr);
+  std::filesystem::remove(filePath);
+}
+
+TEST(AsyncTextureLoaderTest, failsHandlesStillPendingWhenDestroyed) {
+  const auto bitmap = test::bitmap(1);
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  std::optional<TextureHandle> textureHandle;
+  {
+    AsyncTextureLoader asyncTextureLoader { renderer };
+    textureHandle = asyncTextureLoader.load(bitmap.data(), bitmap.size());
+  }
+  ASSERT_EQ(textureHandle->getStatus(), TextureHandle::Status::kFailed);
+}
@@ -0,0 +1,106 @@
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <button.h>
+#include <button_layer.h>
+#include <event_dispatcher.h>
+
+#include "fake_event_producer.h"
+
+using namespace sdl;
+using namespace sdl::tools;
+
+TEST(ButtonLayerTest, rejectsAZeroCellSize) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  ASSERT_THROW(ButtonLayer(eventDispatcher, 0), std::invalid_argument);
+}
+
+TEST(ButtonLayerTest, routesClicksToTheButtonUnderThem) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  ButtonLayer buttonLayer { eventDispatcher, 16 };
+
+  int near = 0;
+  int far = 0;
+  // spans the cells either side of x = 16, so is indexed in both
+  Button nearButton { buttonLayer, Rectangle { 10, 10, 20, 4 } };
+  Button farButton { buttonLayer, Rectangle { 200, 200, 8, 8 } };
+  nearButton.registerEventHandler([&near](const MousePositionEvent&) { ++near; });
+  farButton.registerEventHandler([&far](const MousePositionEvent&) { ++far; });
+
+  eventProducer.click(12, 12);
+  eventProducer.click(28, 12);
+  eventProducer.click(204, 204);
+  // in the near button's cell, but outside its rectangle
+  eventProducer.click(12, 30);
+  // in no cell at all
+  eventProducer.click(100, 100);
+  eventProducer.click(-1, 12);
+  ASSERT_TRUE(eventDispatcher.runFrame());
+
+  ASSERT_EQ(near, 2);
+  ASSERT_EQ(far, 1);
+}
+
+TEST(ButtonLayerTest, invokesEveryOverlappingButton) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  ButtonLayer buttonLayer { eventDispatcher, 16 };
+
+  int under = 0;
+  int over = 0;
+  Button underButton { buttonLayer, Rectangle { 0, 0, 40, 40 } };
+  Button overButton { buttonLayer, Rectangle { 20, 20, 10, 10 } };
+  underButton.registerEventHandler([&under](const MousePositionEvent&) { ++under; });
+  overButton.registerEventHandler([&over](const MousePositionEvent&) { ++over; });
+
+  eventProducer.click(25, 25);
+  eventProducer.click(5, 5);
+  ASSERT_TRUE(eventDispatcher.runFrame());
+
+  ASSERT_EQ(under, 2);
+  ASSERT_EQ(over, 1);
+}
+
+TEST(ButtonLayerTest, stopsRoutingToADestroyedButton) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  ButtonLayer buttonLayer { eventDispatcher, 16 };
+
+  int clicks = 0;
+  std::optional<Button> button { std::in_place, buttonLayer, Rectangle { 0, 0, 8, 8 } };
+  button->registerEventHandler([&clicks](const MousePositionEvent&) { ++clicks; });
+  eventProducer.click(4, 4);
+  ASSERT_TRUE(eventDispatcher.runFrame());
+
+  button.reset();
+  eventProducer.click(4, 4);
+  ASSERT_TRUE(eventDispatcher.runFrame());
+  ASSERT_EQ(clicks, 1);
+}
+
+TEST(ButtonLayerTest, toleratesAHandlerDestroyingAnotherButton) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  ButtonLayer buttonLayer { eventDispatcher, 16 };
+
+  // both in one cell, so whichever is invoked first destroys the other before its turn
+  std::optional<Button> first { std::in_place, buttonLayer, Rectangle { 0, 0, 8, 8 } };
+  std::optional<Button> second { std::in_place, buttonLayer, Rectangle { 0, 0, 8, 8 } };
+  int clicks = 0;
+  first->registerEventHandler([&clicks, &second](const MousePositionEvent&) { ++clicks; second.reset(); });
+  second->registerEventHandler([&clicks, &first](const MousePositionEvent&) { ++clicks; first.reset(); });
+
+  eventProducer.click(4, 4);
+  ASSERT_TRUE(eventDispatcher.runFrame());
+  ASSERT_EQ(clicks, 1);
+  ASSERT_NE(first.has_value(), second.has_value());
+
+  eventProducer.click(4, 4);
+  ASSERT_TRUE(eventDispatcher.runFrame());
+  ASSERT_EQ(clicks, 2);
+}
@@ -0,0 +1,358 @@
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <event.h>
+#include <event_dispatcher.h>
+
+#include "fake_event_producer.h"
+
+using namespace sdl;
+using namespace sdl::tools;
+
+namespace {
+
+//! @brief records each click and key press it handles as its name and the event's x or key code
+class RecordingHandler : public BaseEventHandler, public EventHandler<MouseButtonEvent>, public EventHandler<KeyboardEvent> {
+  public:
+    RecordingHandler(std::string name, std::vector<std::string>& log) : _name { std::move(name) }, _log { log } {};
+    void handle(const MouseButtonEvent& event) override {
+      _log.push_back(_name + " click " + std::to_string(event.x));
+      if(onHandle) onHandle();
+    };
+    void handle(const KeyboardEvent& event) override {
+      _log.push_back(_name + " key " + std::to_string(event.keyCode));
+      if(onHandle) onHandle();
+    };
+    std::function<void()> onHandle {};
+  private:
+    std::string _name;
+    std::vector<std::string>& _log;
+};
+
+void pressKey(test::FakeEventProducer& eventProducer, KeyboardEvent::KeyCode keyCode, uint32_t windowId = 1) {
+  eventProducer.push(std::make_unique<KeyboardEvent>(
+    std::chrono::milliseconds { 0 }, windowId, keyCode, 0, 0, KeyboardEvent::State::kPressed, false
+  ));
+}
+
+}
+
+TEST(EventDispatcherTest, handsEachEventToTheHandlersOfItsType) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  std::vector<std::string> log;
+  RecordingHandler both { "both", log };
+  RecordingHandler clicks { "clicks", log };
+  const auto bothRegistration = eventDispatcher.registerEventHandler(both);
+  const auto clicksRegistration = eventDispatcher.registerEventHandler(static_cast<EventHandler<MouseButtonEvent>&>(clicks));
+  ASSERT_EQ(eventDispatcher.getHandlerCount(), 3u);
+
+  eventProducer.click(1, 0);
+  pressKey(eventProducer, 2);
+  ASSERT_TRUE(eventDispatcher.runFrame());
+  ASSERT_EQ(log, (std::vector<std::string> { "both click 1", "clicks click 1", "both key 2" }));
+
+  eventProducer.quit();
+  ASSERT_FALSE(eventDispatcher.runFrame());
+}
+
+TEST(EventDispatcherTest, bindsBaseHandlersToEventTypesFirstSeenLater) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  std::vector<std::string> log;
+  RecordingHandler handler { "handler", log };
+  const auto registration = eventDispatcher.registerEventHandler(handler);
+
+  // keyboard events are new to the dispatcher here, so the handler is matched against them now
+  pressKey(eventProducer, 7);
+  eventDispatcher.runFrame();
+  ASSERT_EQ(log, (std::vector<std::string> { "handler key 7" }));
+}
+
+TEST(EventDispatcherTest, stopsInvokingAHandlerOnceItsRegistrationIsGone) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  std::vector<std::string> log;
+  RecordingHandler handler { "handler", log };
+  {
+    auto registration = eventDispatcher.registerEventHandler(handler);
+    ASSERT_TRUE(registration.isRegistered());
+    auto moved = std::move(registration);
+    ASSERT_FALSE(registration.isRegistered());
+    ASSERT_EQ(eventDispatcher.getHandlerCount(), 2u);
+  }
+  ASSERT_EQ(eventDispatcher.getHandlerCount(), 1u);
+
+  auto registration = eventDispatcher.registerEventHandler(handler);
+  registration.reset();
+  registration.reset();
+  ASSERT_FALSE(registration.isRegistered());
+  eventProducer.click(1, 0);
+  eventDispatcher.runFrame();
+  ASSERT_TRUE(log.empty());
+}
+
+TEST(EventDispatcherTest, skipsAHandlerUnregisteredByAnotherDuringDispatch) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  std::vector<std::string> log;
+  RecordingHandler first { "first", log };
+  RecordingHandler second { "second", log };
+  auto firstRegistration = eventDispatcher.registerEventHandler(first);
+  auto secondRegistration = eventDispatcher.registerEventHandler(second);
+
+  std::size_t countDuringDispatch = 0;
+  first.onHandle = [&]() {
+    if(!secondRegistration.isRegistered()) return;
+    secondRegistration.reset();
+    countDuringDispatch = eventDispatcher.getHandlerCount();
+  };
+  eventProducer.click(1, 0);
+  pressKey(eventProducer, 2);
+  eventDispatcher.runFrame();
+
+  ASSERT_EQ(log, (std::vector<std::string> { "first click 1", "first key 2" }));
+  // the entry is only removed once the dispatch is over
+  ASSERT_EQ(countDuringDispatch, 3u);
+  ASSERT_EQ(eventDispatcher.getHandlerCount(), 2u);
+}
+
+TEST(EventDispatcherTest, letsAHandlerUnregisterItselfDuringDispatch) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  std::vector<std::string> log;
+  RecordingHandler once { "once", log };
+  RecordingHandler always { "always", log };
+  auto onceRegistration = eventDispatcher.registerEventHandler(once);
+  const auto alwaysRegistration = eventDispatcher.registerEventHandler(always);
+  once.onHandle = [&]() { onceRegistration.reset(); };
+
+  eventProducer.click(1, 0);
+  eventProducer.click(2, 0);
+  eventDispatcher.runFrame();
+  ASSERT_EQ(log, (std::vector<std::string> { "once click 1", "always click 1", "always click 2" }));
+  ASSERT_EQ(eventDispatcher.getHandlerCount(), 2u);
+}
+
+TEST(EventDispatcherTest, toleratesUnregisteringDuringANestedDispatch) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  std::vector<std::string> log;
+  RecordingHandler outer { "outer", log };
+  RecordingHandler inner { "inner", log };
+  const auto outerRegistration = eventDispatcher.registerEventHandler(static_cast<EventHandler<KeyboardEvent>&>(outer));
+  auto innerRegistration = eventDispatcher.registerEventHandler(static_cast<EventHandler<MouseButtonEvent>&>(inner));
+
+  // the outer handler dispatches a click, whose handler unregisters while the key press is still being dispatched
+  outer.onHandle = [&]() {
+    eventProducer.click(1, 0);
+    eventDispatcher.runFrame();
+    ASSERT_EQ(eventDispatcher.getHandlerCount(), 3u);
+  };
+  inner.onHandle = [&]() { innerRegistration.reset(); };
+  pressKey(eventProducer, 2);
+  eventDispatcher.runFrame();
+
+  ASSERT_EQ(eventDispatcher.getHandlerCount(), 2u);
+  eventProducer.click(3, 0);
+  eventDispatcher.runFrame();
+  ASSERT_EQ(log, (std::vector<std::string> { "outer key 2", "inner click 1" }));
+}
+
+TEST(EventDispatcherTest, keepsTheOtherHandlersBoundWhenOneIsRemoved) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  std::vector<std::string> log;
+  RecordingHandler first { "first", log };
+  RecordingHandler second { "second", log };
+  RecordingHandler third { "third", log };
+  // seen once so that every handler is bound to both types as it registers
+  eventProducer.click(0, 0);
+  pressKey(eventProducer, 0);
+  eventDispatcher.runFrame();
+
+  auto firstRegistration = eventDispatcher.registerEventHandler(first);
+  auto secondRegistration = eventDispatcher.registerEventHandler(second);
+  auto thirdRegistration = eventDispatcher.registerEventHandler(third);
+
+  // each removal moves entries of the others, whose bindings must follow them
+  firstRegistration.reset();
+  eventProducer.click(1, 0);
+  pressKey(eventProducer, 1);
+  eventDispatcher.runFrame();
+  secondRegistration.reset();
+  eventProducer.click(2, 0);
+  pressKey(eventProducer, 2);
+  eventDispatcher.runFrame();
+  thirdRegistration.reset();
+  eventProducer.click(3, 0);
+  eventDispatcher.runFrame();
+
+  ASSERT_EQ(log, (std::vector<std::string> {
+    "second click 1", "third click 1", "second key 1", "third key 1",
+    "third click 2", "third key 2"
+  }));
+  ASSERT_EQ(eventDispatcher.getHandlerCount(), 1u);
+}
+
+TEST(EventDispatcherTest, invokesHandlersInTheOrderTheyWereRegistered) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  std::vector<std::string> log;
+  RecordingHandler first { "first", log };
+  RecordingHandler second { "second", log };
+  RecordingHandler third { "third", log };
+  RecordingHandler fourth { "fourth", log };
+  auto firstRegistration = eventDispatcher.registerEventHandler(first);
+  auto secondRegistration = eventDispatcher.registerEventHandler(second);
+  const auto thirdRegistration = eventDispatcher.registerEventHandler(third);
+  const auto fourthRegistration = eventDispatcher.registerEventHandler(fourth);
+
+  // removing the first reorders the registrations, which keyboard events are bound from when first seen
+  firstRegistration.reset();
+  eventProducer.click(1, 0);
+  pressKey(eventProducer, 1);
+  eventDispatcher.runFrame();
+  secondRegistration.reset();
+  eventProducer.click(2, 0);
+  pressKey(eventProducer, 2);
+  eventDispatcher.runFrame();
+
+  ASSERT_EQ(log, (std::vector<std::string> {
+    "second click 1", "third click 1", "fourth click 1",
+    "second key 1", "third key 1", "fourth key 1",
+    "third click 2", "fourth click 2",
+    "third key 2", "fourth key 2"
+  }));
+}
+
+TEST(EventDispatcherTest, routesWindowEventsOnlyToThatWindowsHandlers) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  std::vector<std::string> log;
+  RecordingHandler first { "first", log };
+  RecordingHandler second { "second", log };
+  RecordingHandler every { "every", log };
+  const auto firstRegistration = eventDispatcher.registerEventHandler(first, EventDispatcher::ExecutionPolicy::kInline, 1);
+  const auto secondRegistration = eventDispatcher.registerEventHandler(second, EventDispatcher::ExecutionPolicy::kInline, 2);
+  const auto everyRegistration = eventDispatcher.registerEventHandler(every);
+
+  eventProducer.click(1, 0, 1);
+  pressKey(eventProducer, 2, 2);
+  eventProducer.click(3, 0, 3);
+  eventDispatcher.runFrame();
+  ASSERT_EQ(log, (std::vector<std::string> {
+    "every click 1", "first click 1",
+    "every key 2", "second key 2",
+    "every click 3"
+  }));
+}
+
+TEST(EventDispatcherTest, handsEventsFromNoWindowToEveryWindowsHandlers) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  std::vector<std::string> log;
+  RecordingHandler first { "first", log };
+  RecordingHandler second { "second", log };
+  const auto firstRegistration = eventDispatcher.registerEventHandler(first, EventDispatcher::ExecutionPolicy::kInline, 1);
+  const auto secondRegistration = eventDispatcher.registerEventHandler(second, EventDispatcher::ExecutionPolicy::kInline, 2);
+
+  eventProducer.click(1, 0, EventDispatcher::kAllWindows);
+  eventDispatcher.runFrame();
+  ASSERT_EQ(log, (std::vector<std::string> { "first click 1", "second click 1" }));
+}
+
+TEST(EventDispatcherTest, keepsRoutingToAWindowAfterItsHandlersComeAndGo) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  std::vector<std::string> log;
+  RecordingHandler first { "first", log };
+  RecordingHandler second { "second", log };
+  RecordingHandler other { "other", log };
+  auto firstRegistration = eventDispatcher.registerEventHandler(first, EventDispatcher::ExecutionPolicy::kInline, 5);
+  const auto otherRegistration = eventDispatcher.registerEventHandler(other, EventDispatcher::ExecutionPolicy::kInline, 6);
+  firstRegistration.reset();
+
+  // the window has no handlers left, and then gains one
+  eventProducer.click(1, 0, 5);
+  eventDispatcher.runFrame();
+  const auto secondRegistration = eventDispatcher.registerEventHandler(second, EventDispatcher::ExecutionPolicy::kInline, 5);
+  eventProducer.click(2, 0, 5);
+  eventProducer.click(3, 0, 6);
+  eventDispatcher.runFrame();
+  ASSERT_EQ(log, (std::vector<std::string> { "second click 2", "other click 3" }));
+}
+
+TEST(EventDispatcherTest, handsAPoolHandlerItsEventsOneAtATimeInOrder) {
+  static constexpr int32_t kClicks = 200;
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  std::vector<std::string> log;
+  RecordingHandler handler { "pool", log };
+  std::atomic_int running { 0 };
+  std::atomic_bool overlapped { false };
+  std::promise<void> handledAll;
+  handler.onHandle = [&]() {
+    if(running.fetch_add(1) != 0) overlapped = true;
+    std::this_thread::yield();
+    running.fetch_sub(1);
+    if(log.size() == kClicks) handledAll.set_value();
+  };
+  const auto registration = eventDispatcher.registerEventHandler(
+    static_cast<EventHandler<MouseButtonEvent>&>(handler), EventDispatcher::ExecutionPolicy::kPool
+  );
+
+  std::vector<std::string> expected;
+  for(int32_t x = 0; x < kClicks; ++x) {
+    eventProducer.click(x, 0);
+    expected.push_back("pool click " + std::to_string(x));
+  }
+  // the frame's events are freed as it ends, so the queued ones must be kept alive for the handler
+  eventDispatcher.runFrame();
+
+  ASSERT_EQ(handledAll.get_future().wait_for(std::chrono::seconds { 10 }), std::future_status::ready);
+  ASSERT_FALSE(overlapped);
+  ASSERT_EQ(log, expected);
+}
+
+TEST(EventDispatcherTest, dropsTheQueuedEventsOfAnUnregisteredPoolHandler) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  std::vector<std::string> log;
+  RecordingHandler handler { "pool", log };
+  std::promise<void> started;
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  handler.onHandle = [&]() {
+    if(log.size() != 1) return;
+    started.set_value();
+    released.wait();
+  };
+  auto registration = eventDispatcher.registerEventHandler(
+    static_cast<EventHandler<MouseButtonEvent>&>(handler), EventDispatcher::ExecutionPolicy::kPool
+  );
+
+  eventProducer.click(1, 0);
+  eventProducer.click(2, 0);
+  eventProducer.click(3, 0);
+  eventDispatcher.runFrame();
+  started.get_future().wait();
+
+  // unregistering waits for the call under way, so something else has to let it finish
+  std::thread releaser { [&release]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds { 20 });
+    release.set_value();
+  } };
+  registration.reset();
+  releaser.join();
+  ASSERT_EQ(log, (std::vector<std::string> { "pool click 1" }));
+  ASSERT_EQ(eventDispatcher.getHandlerCount(), 1u);
+}
@@ -0,0 +1,53 @@
+#ifndef __SDL_TOOLS_FAKE_EVENT_PRODUCER_H__
+#define __SDL_TOOLS_FAKE_EVENT_PRODUCER_H__
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <utility>
+
+#include <event.h>
+
+namespace sdl::tools::test {
+
+//! @brief hands the dispatcher the events queued on it, so it can be driven without SDL's event queue
+class FakeEventProducer : public sdl::BaseEventProducer {
+  public:
+    //! @brief the next queued event, or a QuitEvent once there are none, so run() returns
+    std::unique_ptr<sdl::BaseEvent> wait() override {
+      std::unique_ptr<sdl::BaseEvent> event = poll();
+      if(!event) event = std::make_unique<sdl::QuitEvent>(std::chrono::milliseconds { 0 });
+      return event;
+    };
+
+    std::unique_ptr<sdl::BaseEvent> poll() override {
+      if(_events.empty()) return nullptr;
+      std::unique_ptr<sdl::BaseEvent> event = std::move(_events.front());
+      _events.pop_front();
+      return event;
+    };
+
+    void push(std::unique_ptr<sdl::BaseEvent> event) {
+      _events.push_back(std::move(event));
+    };
+
+    //! @brief queue a left button press at the position, in the window
+    void click(int32_t x, int32_t y, uint32_t windowId = 1) {
+      push(std::make_unique<sdl::MouseButtonEvent>(
+        std::chrono::milliseconds { 0 }, windowId, 0, x, y,
+        sdl::MouseButtonEvent::Button::kLeft, sdl::MouseButtonEvent::State::kPressed, 1
+      ));
+    };
+
+    void quit() {
+      push(std::make_unique<sdl::QuitEvent>(std::chrono::milliseconds { 0 }));
+    };
+
+  private:
+    std::deque<std::unique_ptr<sdl::BaseEvent>> _events {};
+};
+
+}
+
+#endif
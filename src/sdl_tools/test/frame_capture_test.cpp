@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <renderer.h>
+#include <surface.h>
+
+#include <thread_pool.h>
+
+#include <frame_capture.h>
+
+using namespace sdl;
+using namespace sdl::tools;
+
+TEST(FrameCaptureTest, dropsFramesWhileEverySlotIsBeingWritten) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  std::promise<void> release;
+  const std::shared_future<void> released { release.get_future() };
+  std::mutex mutex;
+  std::vector<uint64_t> written;
+  FrameCapture frameCapture { renderer, 4, 4, [&](const Surface&, uint64_t frameNumber) {
+    released.wait();
+    std::scoped_lock lock { mutex };
+    written.push_back(frameNumber);
+  }, 2 };
+
+  ASSERT_TRUE(frameCapture.capture());
+  ASSERT_TRUE(frameCapture.capture());
+  ASSERT_FALSE(frameCapture.capture());
+  ASSERT_FALSE(frameCapture.capture());
+  ASSERT_EQ(frameCapture.getCapturedCount(), 2u);
+  ASSERT_EQ(frameCapture.getDroppedCount(), 2u);
+
+  release.set_value();
+  frameCapture.flush();
+  // numbered by capture() call, dropped ones included
+  ASSERT_TRUE(frameCapture.capture());
+  frameCapture.flush();
+  std::sort(written.begin(), written.end());
+  ASSERT_EQ(written, (std::vector<uint64_t> { 0, 1, 4 }));
+  ASSERT_EQ(frameCapture.getCapturedCount(), 3u);
+  ASSERT_EQ(frameCapture.getDroppedCount(), 2u);
+}
+
+TEST(FrameCaptureTest, countsTheFramesWhoseWriterThrew) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  FrameCapture frameCapture { renderer, 4, 4, [](const Surface&, uint64_t frameNumber) {
+    if(frameNumber % 2 == 0) throw std::runtime_error("disk full");
+  }, 1 };
+
+  for(int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(frameCapture.capture());
+    // the slot of a failed write is free again too
+    frameCapture.flush();
+  }
+  ASSERT_EQ(frameCapture.getCapturedCount(), 3u);
+  ASSERT_EQ(frameCapture.getFailedCount(), 2u);
+  ASSERT_EQ(frameCapture.getDroppedCount(), 0u);
+}
+
+TEST(FrameCaptureTest, flushWaitsForEveryWrite) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  std::atomic<int> written { 0 };
+  FrameCapture frameCapture { renderer, 4, 4, [&written](const Surface&, uint64_t) {
+    std::this_thread::sleep_for(std::chrono::milliseconds { 10 });
+    written.fetch_add(1);
+  } };
+
+  for(int i = 0; i < 3; ++i) ASSERT_TRUE(frameCapture.capture());
+  frameCapture.flush();
+  ASSERT_EQ(written.load(), 3);
+}
+
+TEST(FrameCaptureTest, finishesItsWritesWhenDestroyed) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  std::atomic<int> written { 0 };
+  {
+    FrameCapture frameCapture { renderer, 4, 4, [&written](const Surface&, uint64_t) {
+      std::this_thread::sleep_for(std::chrono::milliseconds { 10 });
+      written.fetch_add(1);
+    } };
+    for(int i = 0; i < 3; ++i) ASSERT_TRUE(frameCapture.capture());
+  }
+  ASSERT_EQ(written.load(), 3);
+}
+
+TEST(FrameCaptureTest, writesOffTheSharedThreadPool) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  std::atomic<bool> onSharedPool { true };
+  std::atomic<bool> onRenderThread { true };
+  const auto renderThread = std::this_thread::get_id();
+  FrameCapture frameCapture { renderer, 4, 4, [&](const Surface&, uint64_t) {
+    onSharedPool = vodden::ThreadPool::shared().isWorkerThread();
+    onRenderThread = std::this_thread::get_id() == renderThread;
+  } };
+
+  ASSERT_TRUE(frameCapture.capture());
+  frameCapture.flush();
+  ASSERT_FALSE(onSharedPool.load());
+  ASSERT_FALSE(onRenderThread.load());
+}
@@ -0,0 +1,75 @@
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color.h>
+#include <rectangle.h>
+#include <renderer.h>
+#include <surface.h>
+#include <texture.h>
+
+#include <geometry_batch.h>
+
+using namespace sdl;
+using namespace sdl::tools;
+
+static uint32_t readPixel(const Renderer& renderer, uint32_t x, uint32_t y) {
+  std::vector<uint32_t> pixels(4 * 4);
+  renderer.readPixels({ std::as_writable_bytes(std::span { pixels }), 4, 4, 4 * 4 }, Texture::kARGB8888);
+  return pixels[y * 4 + x];
+}
+
+TEST(GeometryBatchTest, drawsSolidQuadsOnFlush) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  renderer.setRenderDrawColour({ 0x00, 0x00, 0x00, 0xff });
+  renderer.clear();
+
+  GeometryBatch geometryBatch { renderer };
+  geometryBatch.addQuad(0.0f, 0.0f, 2.0f, 2.0f, { 0xff, 0x00, 0x00, 0xff });
+  geometryBatch.addQuad(Rectangle { 2, 2, 2, 2 }, { 0x00, 0xff, 0x00, 0xff });
+  ASSERT_EQ(geometryBatch.size(), 2u);
+  // nothing is drawn until the flush
+  ASSERT_EQ(readPixel(renderer, 0, 0), 0xff000000u);
+
+  geometryBatch.flush();
+  ASSERT_EQ(geometryBatch.size(), 0u);
+  ASSERT_EQ(readPixel(renderer, 1, 1), 0xffff0000u);
+  ASSERT_EQ(readPixel(renderer, 3, 3), 0xff00ff00u);
+  ASSERT_EQ(readPixel(renderer, 3, 0), 0xff000000u);
+}
+
+TEST(GeometryBatchTest, tintsTexturedQuads) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  renderer.setRenderDrawColour({ 0x00, 0x00, 0x00, 0xff });
+  renderer.clear();
+
+  Surface image { 2, 1 };
+  image.fill({ 0xff, 0xff, 0xff, 0xff });
+  image.fill(Rectangle { 1, 0, 1, 1 }, { 0x00, 0x00, 0xff, 0xff });
+  const Texture texture { renderer, image };
+
+  GeometryBatch geometryBatch { renderer };
+  geometryBatch.addQuad(texture, Rectangle { 0, 0, 1, 1 }, Rectangle { 0, 0, 2, 2 }, { 0xff, 0x00, 0x00, 0xff });
+  geometryBatch.addQuad(texture, Rectangle { 1, 0, 1, 1 }, 2.0f, 2.0f, 2.0f, 2.0f);
+  geometryBatch.flush();
+
+  ASSERT_EQ(readPixel(renderer, 1, 1), 0xffff0000u);
+  ASSERT_EQ(readPixel(renderer, 3, 3), 0xff0000ffu);
+}
+
+TEST(GeometryBatchTest, growsPastItsReservedCapacity) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  renderer.setRenderDrawColour({ 0x00, 0x00, 0x00, 0xff });
+  renderer.clear();
+
+  GeometryBatch geometryBatch { renderer, 1 };
+  for(uint32_t x = 0; x < 4; ++x) geometryBatch.addQuad(Rectangle { x, 0, 1, 4 }, { 0xff, 0xff, 0xff, 0xff });
+  ASSERT_EQ(geometryBatch.size(), 4u);
+  geometryBatch.flush();
+  for(uint32_t x = 0; x < 4; ++x) ASSERT_EQ(readPixel(renderer, x, 2), 0xffffffffu);
+}
@@ -0,0 +1,189 @@
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <renderer.h>
+#include <surface.h>
+#include <texture.h>
+
+#include <hot_reloader.h>
+#include <texture_handle.h>
+
+#include "test_bitmap.h"
+
+using namespace sdl;
+using namespace sdl::tools;
+
+namespace {
+
+//! @brief a directory of its own for a test, removed with everything in it afterwards
+class ScratchDirectory {
+  public:
+    ScratchDirectory() : _path { std::filesystem::temp_directory_path() / ("hot_reloader_test_" + testName()) } {
+      std::filesystem::remove_all(_path);
+      std::filesystem::create_directories(_path);
+    };
+    ~ScratchDirectory() {
+      std::error_code errorCode;
+      std::filesystem::remove_all(_path, errorCode);
+    };
+
+    std::filesystem::path operator/(const std::string& fileName) const { return _path / fileName; };
+
+  private:
+    static std::string testName() {
+      return ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    };
+
+    std::filesystem::path _path;
+};
+
+/**
+ * @brief replace the file's contents, moving its modification time on by a second each time
+ *
+ * Moved explicitly, as a rewrite within the file system's timestamp
+ * granularity would otherwise look unchanged to a poll.
+ */
+void rewrite(const std::filesystem::path& filePath, std::span<const std::byte> contents) {
+  const bool existed = std::filesystem::exists(filePath);
+  const auto lastWriteTime = existed ? std::filesystem::last_write_time(filePath) : std::filesystem::file_time_type {};
+  {
+    std::ofstream file { filePath, std::ios::binary | std::ios::trunc };
+    file.write(reinterpret_cast<const char*>(contents.data()), static_cast<std::streamsize>(contents.size()));
+  }
+  if(existed) std::filesystem::last_write_time(filePath, lastWriteTime + std::chrono::seconds { 1 });
+}
+
+void rewrite(const std::filesystem::path& filePath, const std::string& contents) {
+  rewrite(filePath, std::as_bytes(std::span { contents.data(), contents.size() }));
+}
+
+//! @brief call update until condition holds, as files are read on the pool
+bool updateUntil(HotReloader& hotReloader, const std::function<bool()>& condition) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds { 10 };
+  while(!condition()) {
+    if(std::chrono::steady_clock::now() > deadline) return false;
+    hotReloader.update();
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+std::string toString(std::span<const std::byte> contents) {
+  return { reinterpret_cast<const char*>(contents.data()), contents.size() };
+}
+
+}
+
+TEST(HotReloaderTest, pollingFindsARewrite) {
+  ScratchDirectory directory;
+  const auto filePath = directory / "data.txt";
+  rewrite(filePath, "before");
+
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  HotReloader hotReloader { renderer, std::chrono::milliseconds { 0 }, HotReloader::ChangeDetection::kPoll };
+  ASSERT_FALSE(hotReloader.isNotified());
+  std::vector<std::string> seen;
+  hotReloader.watch(filePath, [&seen](std::span<const std::byte> contents) { seen.push_back(toString(contents)); });
+
+  hotReloader.update();
+  ASSERT_TRUE(seen.empty());
+
+  rewrite(filePath, "after");
+  ASSERT_TRUE(updateUntil(hotReloader, [&seen]() { return !seen.empty(); }));
+  ASSERT_EQ(seen, std::vector<std::string> { "after" });
+}
+
+TEST(HotReloaderTest, keepsTheOldTextureWhenADecodeFails) {
+  ScratchDirectory directory;
+  const auto filePath = directory / "image.bmp";
+  rewrite(filePath, test::bitmap(1));
+
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  HotReloader hotReloader { renderer, std::chrono::milliseconds { 0 }, HotReloader::ChangeDetection::kPoll };
+  const TextureHandle textureHandle { Texture { renderer, Surface { 1, 1 } } };
+  std::size_t reloads = 0;
+  hotReloader.watch(filePath, textureHandle);
+  hotReloader.watch(filePath, [&reloads](std::span<const std::byte>) { ++reloads; });
+
+  rewrite(filePath, test::bitmap(2));
+  ASSERT_TRUE(updateUntil(hotReloader, [&reloads]() { return reloads == 1; }));
+  ASSERT_EQ(textureHandle.get()->getWidth(), 2u);
+
+  // as an editor's half written file might be
+  rewrite(filePath, "not an image");
+  ASSERT_TRUE(updateUntil(hotReloader, [&reloads]() { return reloads == 2; }));
+  ASSERT_TRUE(textureHandle.isReady());
+  ASSERT_EQ(textureHandle.get()->getWidth(), 2u);
+}
+
+TEST(HotReloaderTest, reloadsAgainWhenChangedDuringAReload) {
+  ScratchDirectory directory;
+  const auto filePath = directory / "data.txt";
+  rewrite(filePath, "zero");
+
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  HotReloader hotReloader { renderer, std::chrono::milliseconds { 0 }, HotReloader::ChangeDetection::kPoll };
+  std::vector<std::string> seen;
+  hotReloader.watch(filePath, [&seen](std::span<const std::byte> contents) { seen.push_back(toString(contents)); });
+
+  rewrite(filePath, "one");
+  hotReloader.update();
+  // found before the first reload can have been swapped in, which would otherwise drop it
+  rewrite(filePath, "two");
+  hotReloader.update();
+
+  ASSERT_TRUE(updateUntil(hotReloader, [&seen]() { return seen.size() == 2; }));
+  ASSERT_EQ(seen.back(), "two");
+}
+
+TEST(HotReloaderTest, dropsWatchesWhoseTexturesHaveGone) {
+  ScratchDirectory directory;
+  const auto filePath = directory / "image.bmp";
+  rewrite(filePath, test::bitmap(1));
+
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  HotReloader hotReloader { renderer, std::chrono::milliseconds { 0 }, HotReloader::ChangeDetection::kPoll };
+  {
+    const TextureHandle textureHandle { Texture { renderer, Surface { 1, 1 } } };
+    hotReloader.watch(filePath, textureHandle);
+  }
+  ASSERT_EQ(hotReloader.getWatchCount(), 1u);
+
+  rewrite(filePath, test::bitmap(2));
+  ASSERT_EQ(hotReloader.update(), 0u);
+  ASSERT_EQ(hotReloader.getWatchCount(), 0u);
+}
+
+TEST(HotReloaderTest, discardsReloadsStillInFlightWhenDestroyed) {
+  ScratchDirectory directory;
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  std::size_t reloads = 0;
+  {
+    HotReloader hotReloader { renderer, std::chrono::milliseconds { 0 }, HotReloader::ChangeDetection::kPoll };
+    // more than fit in the queue, so that some workers wait for space in it
+    for(int i = 0; i < 100; ++i) {
+      const auto filePath = directory / (std::to_string(i) + ".txt");
+      rewrite(filePath, "before");
+      hotReloader.watch(filePath, [&reloads](std::span<const std::byte>) { ++reloads; });
+      rewrite(filePath, "after");
+    }
+    // starts all the reloads; the destructor must then neither hang on the workers blocked on the queue nor free it under them
+    hotReloader.update();
+  }
+  ASSERT_LE(reloads, 100u);
+}
@@ -0,0 +1,165 @@
+#include <array>
+#include <chrono>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <rectangle.h>
+#include <renderer.h>
+#include <surface.h>
+#include <texture.h>
+
+#include <animation_clip.h>
+#include <sprite_animator.h>
+#include <sprite_world.h>
+
+using namespace std::chrono_literals;
+using namespace sdl;
+using namespace sdl::tools;
+
+TEST(AnimationClipTest, laysGridFramesOutInRows) {
+  const AnimationClip clip { Rectangle { 4, 8, 2, 3 }, 2, 3, 10ms };
+  ASSERT_EQ(clip.getFrameCount(), 3u);
+  ASSERT_EQ(clip.getSources()[0], (Rectangle { 4, 8, 2, 3 }));
+  ASSERT_EQ(clip.getSources()[1], (Rectangle { 6, 8, 2, 3 }));
+  ASSERT_EQ(clip.getSources()[2], (Rectangle { 4, 11, 2, 3 }));
+  ASSERT_EQ(clip.getFrameEnds()[0], 10ms);
+  ASSERT_EQ(clip.getFrameEnds()[2], 30ms);
+  ASSERT_EQ(clip.getDuration(), 30ms);
+}
+
+TEST(AnimationClipTest, rejectsEmptyClipsAndNonPositiveDurations) {
+  ASSERT_THROW(AnimationClip(std::span<const AnimationClip::Frame> {}), std::invalid_argument);
+  ASSERT_THROW(AnimationClip(Rectangle { 0, 0, 1, 1 }, 0, 1, 10ms), std::invalid_argument);
+  const std::array<AnimationClip::Frame, 2> frames { { { Rectangle { 0, 0, 1, 1 }, 10ms }, { Rectangle { 1, 0, 1, 1 }, 0ms } } };
+  ASSERT_THROW(AnimationClip { frames }, std::invalid_argument);
+}
+
+class SpriteAnimatorTest : public ::testing::Test {
+  protected:
+    Surface _sheet { 4, 1 };
+    Renderer _renderer { _sheet };
+    Texture _texture { _renderer, _sheet };
+    SpriteWorld _world;
+    SpriteWorld::TextureId _textureId { _world.addTexture(_texture) };
+
+    SpriteWorld::SpriteId addSprite() {
+      return _world.add(_textureId, Rectangle { 3, 0, 1, 1 }, 0.0f, 0.0f);
+    }
+
+    Rectangle sourceOf(SpriteWorld::SpriteId spriteId) const {
+      return _world.getSources()[_world.getIndex(spriteId)];
+    }
+};
+
+TEST_F(SpriteAnimatorTest, showsTheFirstFrameOnPlay) {
+  SpriteAnimator animator { _world };
+  const auto clip = animator.addClip({ Rectangle { 0, 0, 1, 1 }, 3, 3, 10ms });
+  const auto sprite = addSprite();
+
+  const auto animated = animator.play(sprite, clip);
+  ASSERT_TRUE(animator.contains(animated));
+  ASSERT_EQ(animator.getFrame(animated), 0u);
+  ASSERT_EQ(sourceOf(sprite), (Rectangle { 0, 0, 1, 1 }));
+}
+
+TEST_F(SpriteAnimatorTest, stepsThroughFramesAndLoops) {
+  SpriteAnimator animator { _world };
+  const std::array<AnimationClip::Frame, 3> frames { {
+    { Rectangle { 0, 0, 1, 1 }, 10ms },
+    { Rectangle { 1, 0, 1, 1 }, 20ms },
+    { Rectangle { 2, 0, 1, 1 }, 10ms }
+  } };
+  const auto clip = animator.addClip(AnimationClip { frames });
+  const auto sprite = addSprite();
+  const auto animated = animator.play(sprite, clip);
+
+  animator.advance(9ms);
+  ASSERT_EQ(animator.getFrame(animated), 0u);
+  animator.advance(1ms);
+  ASSERT_EQ(animator.getFrame(animated), 1u);
+  ASSERT_EQ(sourceOf(sprite), (Rectangle { 1, 0, 1, 1 }));
+  // a single step may pass over several frames
+  animator.advance(25ms);
+  ASSERT_EQ(animator.getFrame(animated), 2u);
+  ASSERT_EQ(sourceOf(sprite), (Rectangle { 2, 0, 1, 1 }));
+  // 35ms + 15ms wraps to 10ms into the clip
+  animator.advance(15ms);
+  ASSERT_EQ(animator.getFrame(animated), 1u);
+  ASSERT_EQ(sourceOf(sprite), (Rectangle { 1, 0, 1, 1 }));
+  ASSERT_FALSE(animator.isFinished(animated));
+}
+
+TEST_F(SpriteAnimatorTest, holdsTheLastFrameOfClipsPlayedOnce) {
+  SpriteAnimator animator { _world };
+  const auto clip = animator.addClip({ Rectangle { 0, 0, 1, 1 }, 3, 3, 10ms, AnimationClip::Playback::kOnce });
+  const auto sprite = addSprite();
+  const auto animated = animator.play(sprite, clip);
+
+  animator.advance(29ms);
+  ASSERT_FALSE(animator.isFinished(animated));
+  animator.advance(100ms);
+  ASSERT_TRUE(animator.isFinished(animated));
+  ASSERT_EQ(animator.getFrame(animated), 2u);
+  ASSERT_EQ(sourceOf(sprite), (Rectangle { 2, 0, 1, 1 }));
+}
+
+TEST_F(SpriteAnimatorTest, keepsClipsApartInTheFrameTable) {
+  SpriteAnimator animator { _world };
+  const auto first = animator.addClip({ Rectangle { 0, 0, 1, 1 }, 4, 2, 10ms });
+  const auto second = animator.addClip({ Rectangle { 2, 0, 1, 1 }, 4, 2, 10ms });
+  ASSERT_EQ(animator.getFrameSources().size(), 4u);
+
+  const auto sprite = addSprite();
+  const auto animated = animator.play(sprite, second);
+  ASSERT_EQ(animator.getFrames()[0], 2u);
+  animator.advance(10ms);
+  ASSERT_EQ(animator.getFrame(animated), 1u);
+  ASSERT_EQ(sourceOf(sprite), (Rectangle { 3, 0, 1, 1 }));
+
+  const auto other = addSprite();
+  animator.play(other, first);
+  ASSERT_EQ(sourceOf(other), (Rectangle { 0, 0, 1, 1 }));
+}
+
+TEST_F(SpriteAnimatorTest, stopLeavesTheSpriteOnItsFrame) {
+  SpriteAnimator animator { _world };
+  const auto clip = animator.addClip({ Rectangle { 0, 0, 1, 1 }, 3, 3, 10ms });
+  const auto sprite = addSprite();
+  const auto stopped = animator.play(sprite, clip);
+  const auto other = addSprite();
+  const auto playing = animator.play(other, clip);
+
+  animator.advance(10ms);
+  animator.stop(stopped);
+  ASSERT_FALSE(animator.contains(stopped));
+  ASSERT_EQ(animator.size(), 1u);
+  ASSERT_THROW(animator.getFrame(stopped), std::out_of_range);
+  animator.stop(stopped);
+
+  animator.advance(10ms);
+  ASSERT_EQ(sourceOf(sprite), (Rectangle { 1, 0, 1, 1 }));
+  ASSERT_EQ(animator.getFrame(playing), 2u);
+  ASSERT_EQ(sourceOf(other), (Rectangle { 2, 0, 1, 1 }));
+}
+
+TEST_F(SpriteAnimatorTest, rejectsUnknownClipsAndRemovedSprites) {
+  SpriteAnimator animator { _world };
+  const auto clip = animator.addClip({ Rectangle { 0, 0, 1, 1 }, 3, 3, 10ms });
+  const auto sprite = addSprite();
+  ASSERT_THROW(animator.play(sprite, clip + 1), std::out_of_range);
+  _world.remove(sprite);
+  ASSERT_THROW(animator.play(sprite, clip), std::out_of_range);
+}
+
+TEST_F(SpriteAnimatorTest, skipsSpritesRemovedWhilePlaying) {
+  SpriteAnimator animator { _world };
+  const auto clip = animator.addClip({ Rectangle { 0, 0, 1, 1 }, 3, 3, 10ms });
+  const auto sprite = addSprite();
+  const auto animated = animator.play(sprite, clip);
+  _world.remove(sprite);
+
+  animator.advance(10ms);
+  ASSERT_EQ(animator.getFrame(animated), 1u);
+  ASSERT_EQ(_world.size(), 0u);
+}
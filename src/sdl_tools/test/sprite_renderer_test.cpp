@@ -0,0 +1,96 @@
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color.h>
+#include <rectangle.h>
+#include <renderer.h>
+#include <surface.h>
+#include <texture.h>
+
+#include <sprite.h>
+#include <sprite_renderer.h>
+
+using namespace sdl;
+using namespace sdl::tools;
+
+static uint32_t readPixel(const Renderer& renderer, uint32_t x, uint32_t y) {
+  std::vector<uint32_t> pixels(4 * 4);
+  renderer.readPixels({ std::as_writable_bytes(std::span { pixels }), 4, 4, 4 * 4 }, Texture::kARGB8888);
+  return pixels[y * 4 + x];
+}
+
+TEST(SpriteRendererTest, drawsAPremultipliedTextureAsPremultiplied) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  renderer.setRenderDrawColour({ 0x00, 0x00, 0xff, 0xff });
+  renderer.clear();
+
+  Surface image { 1, 1 };
+  image.fill({ 0xff, 0x00, 0x00, 0x80 });
+  const Texture texture { renderer, std::move(image), Texture::kPremultiplied };
+  const Sprite sprite { texture, Rectangle { 0, 0, 1, 1 } };
+
+  SpriteRenderer spriteRenderer { renderer };
+  spriteRenderer.render(sprite, 1, 1);
+  spriteRenderer.flush();
+
+  // premultiplied, the red is drawn at the half it was multiplied down to rather than halved again as kBlend would
+  const uint32_t pixel = readPixel(renderer, 1, 1);
+  ASSERT_NEAR(static_cast<int>(pixel >> 16 & 0xff), 0x80, 1);
+  ASSERT_NEAR(static_cast<int>(pixel & 0xff), 0x7f, 1);
+  ASSERT_EQ(readPixel(renderer, 0, 0), 0xff0000ffu);
+}
+
+TEST(SpriteRendererTest, drawsWithTheSpritesBlendModeOverTheTextures) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  renderer.setRenderDrawColour({ 0x00, 0x00, 0xff, 0xff });
+  renderer.clear();
+
+  Surface image { 1, 1 };
+  image.fill({ 0xff, 0x00, 0x00, 0x80 });
+  const Texture texture { renderer, image };
+  const Sprite sprite { texture, Rectangle { 0, 0, 1, 1 }, Texture::kNone };
+
+  SpriteRenderer spriteRenderer { renderer };
+  spriteRenderer.render(sprite, 0, 0);
+  spriteRenderer.flush();
+
+  ASSERT_EQ(readPixel(renderer, 0, 0) & 0x00ffffffu, 0x00ff0000u);
+}
+
+TEST(SpriteRendererTest, drawsRunsOutgrowingTheirScratchSpaceOverSeveralFrames) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+
+  Surface redImage { 1, 1 };
+  redImage.fill({ 0xff, 0x00, 0x00, 0xff });
+  const Texture red { renderer, redImage };
+  Surface greenImage { 1, 1 };
+  greenImage.fill({ 0x00, 0xff, 0x00, 0xff });
+  const Texture green { renderer, greenImage };
+  const Sprite redSprite { red, Rectangle { 0, 0, 1, 1 } };
+  const Sprite greenSprite { green, Rectangle { 0, 0, 1, 1 } };
+
+  SpriteRenderer spriteRenderer { renderer };
+  // far more draws than the renderer reserves for, in two runs, the first frame growing the scratch space and the second reusing it
+  for(int frameNumber = 0; frameNumber < 2; ++frameNumber) {
+    renderer.setRenderDrawColour({ 0x00, 0x00, 0xff, 0xff });
+    renderer.clear();
+    for(uint32_t i = 0; i < 3000; ++i) {
+      spriteRenderer.render(redSprite, i % 4, 0);
+      spriteRenderer.render(greenSprite, i % 4, 1);
+    }
+    spriteRenderer.flush();
+
+    for(uint32_t x = 0; x < 4; ++x) {
+      ASSERT_EQ(readPixel(renderer, x, 0), 0xffff0000u);
+      ASSERT_EQ(readPixel(renderer, x, 1), 0xff00ff00u);
+      ASSERT_EQ(readPixel(renderer, x, 2), 0xff0000ffu);
+    }
+  }
+}
@@ -0,0 +1,156 @@
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <rectangle.h>
+#include <renderer.h>
+#include <surface.h>
+#include <texture.h>
+
+#include <geometry_batch.h>
+#include <sprite_world.h>
+
+using namespace sdl;
+using namespace sdl::tools;
+
+static uint32_t readPixel(const Renderer& renderer, uint32_t x, uint32_t y) {
+  std::vector<uint32_t> pixels(4 * 4);
+  renderer.readPixels({ std::as_writable_bytes(std::span { pixels }), 4, 4, 4 * 4 }, Texture::kARGB8888);
+  return pixels[y * 4 + x];
+}
+
+// a 2x1 texture, red on the left and blue on the right
+static Texture redAndBlue(const Renderer& renderer) {
+  Surface image { 2, 1 };
+  image.fill({ 0xff, 0x00, 0x00, 0xff });
+  image.fill(Rectangle { 1, 0, 1, 1 }, { 0x00, 0x00, 0xff, 0xff });
+  return Texture { renderer, image };
+}
+
+static const Rectangle kRed { 0, 0, 1, 1 };
+static const Rectangle kBlue { 1, 0, 1, 1 };
+
+TEST(SpriteWorldTest, keepsIdsValidAcrossRemoval) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  const Texture texture = redAndBlue(renderer);
+
+  SpriteWorld world;
+  const auto textureId = world.addTexture(texture);
+  const auto first = world.add(textureId, kRed, 1.0f, 2.0f);
+  const auto second = world.add(textureId, kBlue, 3.0f, 4.0f, 7);
+  ASSERT_EQ(world.size(), 2u);
+
+  world.remove(first);
+  ASSERT_FALSE(world.contains(first));
+  ASSERT_TRUE(world.contains(second));
+  ASSERT_EQ(world.size(), 1u);
+  // the last sprite has moved into the removed one's place
+  const std::size_t index = world.getIndex(second);
+  ASSERT_EQ(index, 0u);
+  ASSERT_EQ(world.getX()[index], 3.0f);
+  ASSERT_EQ(world.getY()[index], 4.0f);
+  ASSERT_EQ(world.getZ()[index], 7);
+
+  // a new sprite doesn't revive the stale id
+  const auto third = world.add(textureId, kRed, 0.0f, 0.0f);
+  ASSERT_NE(third, first);
+  ASSERT_FALSE(world.contains(first));
+  ASSERT_THROW(world.setPosition(first, 0.0f, 0.0f), std::out_of_range);
+  ASSERT_THROW(world.getIndex(first), std::out_of_range);
+  world.remove(first);
+  ASSERT_EQ(world.size(), 2u);
+}
+
+TEST(SpriteWorldTest, rejectsUnknownTextures) {
+  SpriteWorld world;
+  ASSERT_THROW(world.add(0, kRed, 0.0f, 0.0f), std::out_of_range);
+}
+
+TEST(SpriteWorldTest, cullsToTheCamera) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  const Texture texture = redAndBlue(renderer);
+
+  SpriteWorld world;
+  const auto textureId = world.addTexture(texture);
+  world.add(textureId, kRed, 0.0f, 0.0f);
+  world.add(textureId, kRed, 100.0f, 100.0f);
+  world.add(textureId, kRed, 3.5f, 3.5f);
+  world.add(textureId, kRed, -10.0f, 0.0f);
+
+  const auto visible = world.cull({ 0.0f, 0.0f, 4.0f, 4.0f });
+  ASSERT_EQ(std::vector<uint32_t>(visible.begin(), visible.end()), (std::vector<uint32_t> { 0, 2 }));
+
+  const auto moved = world.cull({ 99.0f, 99.0f, 4.0f, 4.0f });
+  ASSERT_EQ(std::vector<uint32_t>(moved.begin(), moved.end()), (std::vector<uint32_t> { 1 }));
+}
+
+TEST(SpriteWorldTest, rendersRelativeToTheCamera) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  renderer.setRenderDrawColour({ 0x00, 0x00, 0x00, 0xff });
+  renderer.clear();
+  const Texture texture = redAndBlue(renderer);
+
+  SpriteWorld world;
+  const auto textureId = world.addTexture(texture);
+  const auto sprite = world.add(textureId, kRed, 10.0f, 10.0f);
+  world.setSize(sprite, 2.0f, 2.0f);
+
+  GeometryBatch geometryBatch { renderer };
+  world.render(geometryBatch, { 9.0f, 9.0f, 4.0f, 4.0f });
+  ASSERT_EQ(geometryBatch.size(), 0u);
+  ASSERT_EQ(readPixel(renderer, 1, 1), 0xffff0000u);
+  ASSERT_EQ(readPixel(renderer, 2, 2), 0xffff0000u);
+  ASSERT_EQ(readPixel(renderer, 0, 0), 0xff000000u);
+  ASSERT_EQ(readPixel(renderer, 3, 3), 0xff000000u);
+}
+
+TEST(SpriteWorldTest, drawsHigherZOnTop) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  const Texture texture = redAndBlue(renderer);
+
+  SpriteWorld world;
+  const auto textureId = world.addTexture(texture);
+  // added top first, so drawing in index order would get it wrong
+  const auto top = world.add(textureId, kBlue, 0.0f, 0.0f, 1);
+  const auto bottom = world.add(textureId, kRed, 0.0f, 0.0f, 0);
+  world.setSize(top, 4.0f, 4.0f);
+  world.setSize(bottom, 4.0f, 4.0f);
+
+  GeometryBatch geometryBatch { renderer };
+  world.render(geometryBatch, { 0.0f, 0.0f, 4.0f, 4.0f });
+  ASSERT_EQ(readPixel(renderer, 2, 2), 0xff0000ffu);
+
+  // changing a z re-orders the layers
+  world.setZ(bottom, 2);
+  world.render(geometryBatch, { 0.0f, 0.0f, 4.0f, 4.0f });
+  ASSERT_EQ(readPixel(renderer, 2, 2), 0xffff0000u);
+}
+
+TEST(SpriteWorldTest, skipsHiddenSprites) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  renderer.setRenderDrawColour({ 0x00, 0x00, 0x00, 0xff });
+  renderer.clear();
+  const Texture texture = redAndBlue(renderer);
+
+  SpriteWorld world;
+  const auto textureId = world.addTexture(texture);
+  const auto sprite = world.add(textureId, kRed, 0.0f, 0.0f, 0, SpriteWorld::kHidden);
+  world.setSize(sprite, 4.0f, 4.0f);
+
+  GeometryBatch geometryBatch { renderer };
+  world.render(geometryBatch, { 0.0f, 0.0f, 4.0f, 4.0f });
+  ASSERT_EQ(readPixel(renderer, 2, 2), 0xff000000u);
+
+  world.setFlags(sprite, 0);
+  world.setSource(sprite, kBlue);
+  world.render(geometryBatch, { 0.0f, 0.0f, 4.0f, 4.0f });
+  ASSERT_EQ(readPixel(renderer, 2, 2), 0xff0000ffu);
+}
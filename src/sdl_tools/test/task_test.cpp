@@ -0,0 +1,203 @@
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <event.h>
+#include <event_dispatcher.h>
+#include <task.h>
+#include <task_scheduler.h>
+
+#include "fake_event_producer.h"
+
+using namespace sdl;
+using namespace sdl::tools;
+
+namespace {
+
+Task countDown(int depth, int& finished) {
+  if(depth > 0) co_await countDown(depth - 1, finished);
+  ++finished;
+}
+
+Task step(std::vector<std::string>& steps, TaskScheduler& taskScheduler) {
+  steps.push_back("child started");
+  co_await taskScheduler.nextFrame();
+  steps.push_back("child finished");
+}
+
+Task awaitStep(std::vector<std::string>& steps, TaskScheduler& taskScheduler) {
+  steps.push_back("parent started");
+  co_await step(steps, taskScheduler);
+  steps.push_back("parent resumed");
+}
+
+Task fail() {
+  throw std::runtime_error("failed");
+  co_return;
+}
+
+Task catchFailure(std::string& caught) {
+  try {
+    co_await fail();
+  } catch(const std::runtime_error& exception) {
+    caught = exception.what();
+  }
+}
+
+Task failNextFrame(TaskScheduler& taskScheduler) {
+  co_await taskScheduler.nextFrame();
+  throw std::runtime_error("failed");
+}
+
+Task recordClicks(
+  EventDispatcher& eventDispatcher,
+  std::vector<std::string>& steps,
+  std::size_t clicks,
+  EventDispatcher::WindowId windowId = EventDispatcher::kAllWindows
+) {
+  for(std::size_t i = 0; i < clicks; ++i) {
+    const MouseButtonEvent click = co_await eventDispatcher.next<MouseButtonEvent>(windowId);
+    steps.push_back("task " + std::to_string(click.x));
+  }
+}
+
+class RecordingHandler : public EventHandler<MouseButtonEvent> {
+  public:
+    RecordingHandler(std::vector<std::string>& steps) : _steps { steps } {};
+    void handle(const MouseButtonEvent& event) override {
+      _steps.push_back("handler " + std::to_string(event.x));
+      if(onHandle) onHandle();
+    };
+    std::function<void()> onHandle {};
+  private:
+    std::vector<std::string>& _steps;
+};
+
+}
+
+TEST(TaskTest, finishesAChainOfAwaits) {
+  TaskScheduler taskScheduler;
+  int finished = 0;
+  // each level starts the next and is resumed by it through symmetric transfer
+  taskScheduler.spawn(countDown(1000, finished));
+  ASSERT_EQ(finished, 1001);
+  taskScheduler.update();
+  ASSERT_EQ(taskScheduler.getTaskCount(), 0u);
+}
+
+TEST(TaskTest, resumesTheAwaitingTaskWhenTheAwaitedOneFinishes) {
+  TaskScheduler taskScheduler;
+  std::vector<std::string> steps;
+  taskScheduler.spawn(awaitStep(steps, taskScheduler));
+  ASSERT_EQ(steps, (std::vector<std::string> { "parent started", "child started" }));
+  ASSERT_EQ(taskScheduler.getTaskCount(), 1u);
+
+  ASSERT_EQ(taskScheduler.update(), 1u);
+  ASSERT_EQ(steps, (std::vector<std::string> { "parent started", "child started", "child finished", "parent resumed" }));
+  ASSERT_EQ(taskScheduler.getTaskCount(), 0u);
+}
+
+TEST(TaskTest, rethrowsToTheAwaitingTask) {
+  TaskScheduler taskScheduler;
+  std::string caught;
+  taskScheduler.spawn(catchFailure(caught));
+  ASSERT_EQ(caught, "failed");
+  ASSERT_NO_THROW(taskScheduler.update());
+}
+
+TEST(TaskSchedulerTest, rethrowsFromUpdate) {
+  TaskScheduler taskScheduler;
+  taskScheduler.spawn(fail());
+  ASSERT_THROW(taskScheduler.update(), std::runtime_error);
+  ASSERT_EQ(taskScheduler.getTaskCount(), 0u);
+
+  std::vector<std::string> steps;
+  taskScheduler.spawn(failNextFrame(taskScheduler));
+  taskScheduler.spawn(awaitStep(steps, taskScheduler));
+  ASSERT_EQ(taskScheduler.getTaskCount(), 2u);
+  // thrown once the other task has been resumed too
+  ASSERT_THROW(taskScheduler.update(), std::runtime_error);
+  ASSERT_EQ(steps.back(), "parent resumed");
+  ASSERT_EQ(taskScheduler.getTaskCount(), 0u);
+}
+
+TEST(EventAwaiterTest, resumesOnceTheEventHasReachedEveryHandler) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  TaskScheduler taskScheduler;
+  std::vector<std::string> steps;
+
+  // the task registers for the event first, so is handed it before the handler
+  taskScheduler.spawn(recordClicks(eventDispatcher, steps, 1));
+  RecordingHandler handler { steps };
+  const auto registration = eventDispatcher.registerEventHandler(handler);
+
+  eventProducer.click(1, 0);
+  ASSERT_TRUE(eventDispatcher.runFrame());
+  ASSERT_EQ(steps, (std::vector<std::string> { "handler 1", "task 1" }));
+  taskScheduler.update();
+  ASSERT_EQ(taskScheduler.getTaskCount(), 0u);
+}
+
+TEST(EventAwaiterTest, awaitsTheFollowingEventWhenAwaitedAgainFromItsResumption) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  TaskScheduler taskScheduler;
+  std::vector<std::string> steps;
+  taskScheduler.spawn(recordClicks(eventDispatcher, steps, 3));
+  const std::size_t handlerCount = eventDispatcher.getHandlerCount();
+
+  eventProducer.click(1, 0);
+  eventProducer.click(2, 0);
+  ASSERT_TRUE(eventDispatcher.runFrame());
+  // each click once, the second not being handed to the resumption the first caused
+  ASSERT_EQ(steps, (std::vector<std::string> { "task 1", "task 2" }));
+  ASSERT_EQ(eventDispatcher.getHandlerCount(), handlerCount);
+
+  eventProducer.click(3, 0);
+  ASSERT_TRUE(eventDispatcher.runFrame());
+  ASSERT_EQ(steps, (std::vector<std::string> { "task 1", "task 2", "task 3" }));
+  // the awaiter unregisters itself once it has its event
+  ASSERT_EQ(eventDispatcher.getHandlerCount(), handlerCount - 1);
+}
+
+TEST(EventAwaiterTest, cancelsTheResumptionOfATaskDestroyedAfterItsEventArrived) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  std::optional<TaskScheduler> doomedScheduler { std::in_place };
+  TaskScheduler taskScheduler;
+  std::vector<std::string> steps;
+
+  doomedScheduler->spawn(recordClicks(eventDispatcher, steps, 1));
+  taskScheduler.spawn(recordClicks(eventDispatcher, steps, 1));
+  // handed the event after both tasks, and destroys the first before it is resumed
+  RecordingHandler handler { steps };
+  handler.onHandle = [&doomedScheduler]() { doomedScheduler.reset(); };
+  const auto registration = eventDispatcher.registerEventHandler(handler);
+
+  eventProducer.click(1, 0);
+  ASSERT_TRUE(eventDispatcher.runFrame());
+  ASSERT_EQ(steps, (std::vector<std::string> { "handler 1", "task 1" }));
+  taskScheduler.update();
+  ASSERT_EQ(taskScheduler.getTaskCount(), 0u);
+}
+
+TEST(EventAwaiterTest, resumesOnlyWithEventsFromItsWindow) {
+  test::FakeEventProducer eventProducer;
+  EventDispatcher eventDispatcher { eventProducer };
+  TaskScheduler taskScheduler;
+  std::vector<std::string> steps;
+  taskScheduler.spawn(recordClicks(eventDispatcher, steps, 1, 2));
+
+  eventProducer.click(1, 0, 1);
+  eventProducer.click(2, 0, 2);
+  eventProducer.click(3, 0, 2);
+  ASSERT_TRUE(eventDispatcher.runFrame());
+  ASSERT_EQ(steps, (std::vector<std::string> { "task 2" }));
+  taskScheduler.update();
+  ASSERT_EQ(taskScheduler.getTaskCount(), 0u);
+}
@@ -0,0 +1,31 @@
+#ifndef __SDL_TOOLS_TEST_BITMAP_H__
+#define __SDL_TOOLS_TEST_BITMAP_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sdl::tools::test {
+
+//! @brief an encoded, width by 1, 24 bit BMP, which SDL decodes without any image library
+inline std::vector<std::byte> bitmap(uint32_t width) {
+  const uint32_t rowSize = (width * 3 + 3) / 4 * 4;
+  const uint32_t pixelOffset = 14 + 40;
+  const uint32_t fileSize = pixelOffset + rowSize;
+
+  std::vector<std::byte> data;
+  const auto put = [&data](uint32_t value, std::size_t size) {
+    for(std::size_t i = 0; i < size; ++i) data.push_back(std::byte { static_cast<uint8_t>(value >> (8 * i)) });
+  };
+  // the file header, then a BITMAPINFOHEADER for an uncompressed, bottom up image
+  put('B', 1); put('M', 1); put(fileSize, 4); put(0, 4); put(pixelOffset, 4);
+  put(40, 4); put(width, 4); put(1, 4); put(1, 2); put(24, 2); put(0, 4); put(rowSize, 4);
+  put(2835, 4); put(2835, 4); put(0, 4); put(0, 4);
+  for(uint32_t x = 0; x < width; ++x) put(0x102030, 3);
+  data.resize(fileSize);
+  return data;
+}
+
+}
+
+#endif
@@ -0,0 +1,88 @@
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <color.h>
+#include <renderer.h>
+#include <surface.h>
+#include <texture.h>
+
+#include <sprite_renderer.h>
+#include <texture_atlas.h>
+
+using namespace sdl;
+using namespace sdl::tools;
+
+static uint32_t readPixel(const Renderer& renderer, uint32_t x, uint32_t y) {
+  std::vector<uint32_t> pixels(4 * 4);
+  renderer.readPixels({ std::as_writable_bytes(std::span { pixels }), 4, 4, 4 * 4 }, Texture::kARGB8888);
+  return pixels[y * 4 + x];
+}
+
+static Surface filled(uint32_t width, uint32_t height, const Color& color) {
+  Surface surface { width, height };
+  surface.fill(color);
+  return surface;
+}
+
+TEST(TextureAtlasTest, drawsEachImageFromItsPackedSprite) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  renderer.setRenderDrawColour({ 0x00, 0x00, 0x00, 0xff });
+  renderer.clear();
+
+  TextureAtlas atlas { 8, 8 };
+  const auto red = atlas.add(filled(2, 1, { 0xff, 0x00, 0x00, 0xff }));
+  const auto green = atlas.add(filled(1, 2, { 0x00, 0xff, 0x00, 0xff }));
+  const auto blue = atlas.add(filled(1, 1, { 0x00, 0x00, 0xff, 0xff }));
+  atlas.build(renderer);
+  ASSERT_EQ(atlas.getPageCount(), 1u);
+
+  SpriteRenderer spriteRenderer { renderer };
+  spriteRenderer.render(atlas.getSprite(red), 0, 0);
+  spriteRenderer.render(atlas.getSprite(green), 3, 0);
+  spriteRenderer.render(atlas.getSprite(blue), 0, 3);
+  spriteRenderer.flush();
+
+  ASSERT_EQ(readPixel(renderer, 0, 0), 0xffff0000u);
+  ASSERT_EQ(readPixel(renderer, 1, 0), 0xffff0000u);
+  // each sprite covers its own image and nothing of its neighbours
+  ASSERT_EQ(readPixel(renderer, 2, 0), 0xff000000u);
+  ASSERT_EQ(readPixel(renderer, 3, 0), 0xff00ff00u);
+  ASSERT_EQ(readPixel(renderer, 3, 1), 0xff00ff00u);
+  ASSERT_EQ(readPixel(renderer, 0, 3), 0xff0000ffu);
+  ASSERT_EQ(readPixel(renderer, 1, 3), 0xff000000u);
+}
+
+TEST(TextureAtlasTest, startsAnotherPageOnceAPageIsFull) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  TextureAtlas atlas { 4, 4, 0 };
+  for(int i = 0; i < 5; ++i) atlas.add(filled(2, 2, { 0xff, 0xff, 0xff, 0xff }));
+  atlas.pack();
+  atlas.build(renderer);
+  ASSERT_EQ(atlas.getPageCount(), 2u);
+}
+
+TEST(TextureAtlasTest, rejectsImagesLargerThanAPage) {
+  TextureAtlas atlas { 4, 4 };
+  ASSERT_THROW(atlas.add(Surface { 5, 1 }), std::invalid_argument);
+  ASSERT_THROW(atlas.add(Surface { 1, 5 }), std::invalid_argument);
+}
+
+TEST(TextureAtlasTest, enforcesAddPackBuildOrder) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  TextureAtlas atlas { 4, 4 };
+  const auto imageId = atlas.add(Surface { 1, 1 });
+  atlas.pack();
+  ASSERT_THROW(atlas.getSprite(imageId), std::logic_error);
+  ASSERT_THROW(atlas.add(Surface { 1, 1 }), std::logic_error);
+  ASSERT_THROW(atlas.pack(), std::logic_error);
+  atlas.build(renderer);
+  ASSERT_THROW(atlas.build(renderer), std::logic_error);
+  ASSERT_THROW(atlas.getSprite(imageId + 1), std::out_of_range);
+}
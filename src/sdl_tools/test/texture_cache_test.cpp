@@ -0,0 +1,96 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <renderer.h>
+#include <surface.h>
+
+#include <texture_cache.h>
+#include <texture_handle.h>
+
+#include "test_bitmap.h"
+
+using namespace sdl;
+using namespace sdl::tools;
+
+TEST(TextureCacheTest, sharesTheTextureOfIdenticalContent) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  TextureCache textureCache { renderer };
+  // separate copies, so only their content is the same
+  const auto first = test::bitmap(1);
+  const auto second = test::bitmap(1);
+  const auto other = test::bitmap(2);
+
+  const TextureHandle textureHandle = textureCache.load(first.data(), first.size());
+  ASSERT_TRUE(textureHandle.isReady());
+  ASSERT_TRUE(textureCache.load(second.data(), second.size()) == textureHandle);
+  ASSERT_FALSE(textureCache.load(other.data(), other.size()) == textureHandle);
+  ASSERT_EQ(textureCache.size(), 2u);
+  ASSERT_EQ(textureCache.getResidentBytes(), 4u + 8u);
+}
+
+TEST(TextureCacheTest, sharesTheTextureOfAFileHoweverItsPathIsSpelt) {
+  const auto directory = std::filesystem::temp_directory_path();
+  const auto filePath = directory / "texture_cache_test.bmp";
+  {
+    const auto bitmap = test::bitmap(1);
+    std::ofstream file { filePath, std::ios::binary };
+    file.write(reinterpret_cast<const char*>(bitmap.data()), static_cast<std::streamsize>(bitmap.size()));
+  }
+
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  TextureCache textureCache { renderer };
+  const TextureHandle textureHandle = textureCache.load(filePath);
+  ASSERT_TRUE(textureCache.load(directory / "." / "texture_cache_test.bmp") == textureHandle);
+  ASSERT_EQ(textureCache.size(), 1u);
+  std::filesystem::remove(filePath);
+}
+
+TEST(TextureCacheTest, releasesTheLeastRecentlyUsedUnreferencedTexturesOverBudget) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  const auto small = test::bitmap(1);
+  const auto medium = test::bitmap(2);
+  const auto large = test::bitmap(3);
+  // enough for small, medium and large apart from one of small or medium
+  TextureCache textureCache { renderer, 20 };
+
+  textureCache.load(small.data(), small.size());
+  textureCache.load(medium.data(), medium.size());
+  // so that medium is now the least recently used of the two
+  textureCache.load(small.data(), small.size());
+  ASSERT_EQ(textureCache.getResidentBytes(), 12u);
+
+  textureCache.load(large.data(), large.size());
+  ASSERT_EQ(textureCache.size(), 2u);
+  ASSERT_EQ(textureCache.getResidentBytes(), 4u + 12u);
+}
+
+TEST(TextureCacheTest, neverReleasesTexturesStillInUse) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  const auto first = test::bitmap(1);
+  const auto second = test::bitmap(2);
+  TextureCache textureCache { renderer, 0 };
+
+  std::vector<TextureHandle> held;
+  held.push_back(textureCache.load(first.data(), first.size()));
+  held.push_back(textureCache.load(second.data(), second.size()));
+  ASSERT_EQ(textureCache.size(), 2u);
+  ASSERT_GT(textureCache.getResidentBytes(), textureCache.getBudget());
+
+  held.pop_back();
+  textureCache.trim();
+  ASSERT_EQ(textureCache.size(), 1u);
+  ASSERT_TRUE(held.front().isReady());
+
+  held.clear();
+  textureCache.setBudget(0);
+  ASSERT_EQ(textureCache.size(), 0u);
+  ASSERT_EQ(textureCache.getResidentBytes(), 0u);
+}
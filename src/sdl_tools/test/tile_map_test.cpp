@@ -0,0 +1,74 @@
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <rectangle.h>
+#include <renderer.h>
+#include <streaming_texture.h>
+#include <surface.h>
+#include <texture.h>
+
+#include <tile_map.h>
+
+using namespace sdl;
+using namespace sdl::tools;
+
+static uint32_t readPixel(const Renderer& renderer, uint32_t x, uint32_t y) {
+  std::vector<uint32_t> pixels(4 * 4);
+  renderer.readPixels({ std::as_writable_bytes(std::span { pixels }), 4, 4, 4 * 4 }, Texture::kARGB8888);
+  return pixels[y * 4 + x];
+}
+
+TEST(TileMapTest, rejectsTileIdsPastTheTileset) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  // two tiles across and three down
+  const Texture tileset { renderer, Surface { 4, 3 } };
+  TileMap tileMap { renderer, tileset, 2, 1, 4, 4, 2 };
+  ASSERT_EQ(tileMap.getTileCount(), 6u);
+
+  tileMap.setTile(0, 0, 5);
+  ASSERT_THROW(tileMap.setTile(0, 0, 6), std::invalid_argument);
+  ASSERT_EQ(tileMap.getTile(0, 0), 5u);
+  tileMap.setTile(0, 0, TileMap::kNoTile);
+
+  std::vector<TileMap::TileId> tiles(16, 1);
+  tiles[7] = 6;
+  ASSERT_THROW(tileMap.setTiles(tiles), std::invalid_argument);
+  // left as it was, not partly replaced
+  ASSERT_EQ(tileMap.getTile(0, 0), TileMap::kNoTile);
+
+  ASSERT_THROW((TileMap { renderer, tileset, 8, 1, 4, 4 }), std::invalid_argument);
+  ASSERT_THROW((TileMap { renderer, tileset, 2, 4, 4, 4 }), std::invalid_argument);
+}
+
+TEST(TileMapTest, redrawsCachedChunksOnceInvalidated) {
+  Surface frame { 4, 4 };
+  Renderer renderer { frame };
+  StreamingTexture tileset { renderer, 1, 1, Texture::kARGB8888 };
+  Surface tile { 1, 1 };
+  tile.fill({ 0xff, 0x00, 0x00, 0xff });
+  tileset.update(tile, { 0, 0, 1, 1 });
+
+  TileMap tileMap { renderer, tileset, 1, 1, 4, 4, 2 };
+  tileMap.setTiles(std::vector<TileMap::TileId>(16, 0));
+  tileMap.render({ 0, 0, 4, 4 });
+  ASSERT_EQ(readPixel(renderer, 3, 3), 0xffff0000u);
+
+  // the chunks are drawn from their cached textures, which still hold the old tile
+  tile.fill({ 0x00, 0xff, 0x00, 0xff });
+  tileset.update(tile, { 0, 0, 1, 1 });
+  renderer.clear();
+  tileMap.render({ 0, 0, 4, 4 });
+  ASSERT_EQ(readPixel(renderer, 3, 3), 0xffff0000u);
+
+  // as after SDL_RENDER_TARGETS_RESET
+  tileMap.invalidate();
+  renderer.clear();
+  tileMap.render({ 0, 0, 4, 4 });
+  ASSERT_EQ(readPixel(renderer, 0, 0), 0xff00ff00u);
+  ASSERT_EQ(readPixel(renderer, 3, 3), 0xff00ff00u);
+}
@@ -0,0 +1,39 @@
+#include <array>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <constexpr_map.h>
+
+// mirrors sdlSubSystemMap: small, dense integral keys
+static constexpr vodden::Map<uint8_t, uint32_t, 9> denseMap {{
+  { 0, 0x0001 }, { 1, 0x0010 }, { 2, 0x0020 }, { 3, 0x0200 }, { 4, 0x1000 },
+  { 5, 0x2000 }, { 6, 0x4000 }, { 7, 0xF231 }, { 8, 0x100000 }
+}};
+
+// sparse keys which cannot be indexed directly
+static constexpr vodden::Map<uint32_t, uint32_t, 8> sparseMap {{
+  { 0x100, 1 }, { 0x200, 2 }, { 0x300, 3 }, { 0x400, 4 },
+  { 0x401, 5 }, { 0x402, 6 }, { 0x8000, 7 }, { 0xFFFF, 8 }
+}};
+
+static void BM_MapDenseLookup(benchmark::State& state) {
+  uint8_t key = 0;
+  for([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(denseMap[key]);
+    key = (key + 1) % 9;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MapDenseLookup);
+
+static void BM_MapSparseLookup(benchmark::State& state) {
+  static constexpr std::array<uint32_t, 8> keys { 0x100, 0x200, 0x300, 0x400, 0x401, 0x402, 0x8000, 0xFFFF };
+  std::size_t index = 0;
+  for([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(sparseMap[keys[index]]);
+    index = (index + 1) % keys.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MapSparseLookup);
@@ -0,0 +1,64 @@
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <parallel_tiles.h>
+#include <pixel_kernels.h>
+
+using namespace vodden;
+
+namespace {
+
+// a 4k frame
+constexpr uint32_t kWidth = 3840;
+constexpr uint32_t kHeight = 2160;
+
+std::vector<std::byte> makeImage() {
+  std::vector<std::byte> bytes(static_cast<std::size_t>(kWidth) * kHeight * 4);
+  for(std::size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<std::byte>(i * 7);
+  return bytes;
+}
+
+}
+
+//! premultiplies a 4k image on the calling thread alone, as the baseline for the parallel runs
+static void BM_PremultiplySerial(benchmark::State& state) {
+  auto bytes = makeImage();
+  const PixelView pixels { bytes, kWidth, kHeight, kWidth * 4 };
+  for([[maybe_unused]] auto _ : state) {
+    premultiplyAlpha(pixels);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes.size()));
+}
+BENCHMARK(BM_PremultiplySerial)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//! premultiplies a 4k image in tiles over state.range(0) workers plus the calling thread
+static void BM_PremultiplyTiles(benchmark::State& state) {
+  auto bytes = makeImage();
+  const PixelView pixels { bytes, kWidth, kHeight, kWidth * 4 };
+  ThreadPool threadPool { static_cast<std::size_t>(state.range(0)) };
+  for([[maybe_unused]] auto _ : state) {
+    parallelForTiles(pixels, kDefaultTileBytes, [](PixelView tile, uint32_t) { premultiplyAlpha(tile); }, threadPool);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes.size()));
+}
+BENCHMARK(BM_PremultiplyTiles)
+  ->RangeMultiplier(2)->Range(1, std::max<int64_t>(std::thread::hardware_concurrency(), 2))
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//! swizzles a 4k image in tiles of state.range(0) bytes over the default worker count, to show the effect of tile size
+static void BM_SwizzleTileSize(benchmark::State& state) {
+  auto bytes = makeImage();
+  const PixelView pixels { bytes, kWidth, kHeight, kWidth * 4 };
+  ThreadPool threadPool;
+  for([[maybe_unused]] auto _ : state) {
+    parallelForTiles(pixels, static_cast<std::size_t>(state.range(0)), [](PixelView tile, uint32_t) { swapRedBlue(tile, tile); }, threadPool);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes.size()));
+}
+BENCHMARK(BM_SwizzleTileSize)->RangeMultiplier(4)->Range(16 * 1024, 4 * 1024 * 1024)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <poly_vector.h>
+
+namespace {
+
+class Handler {
+  public:
+    virtual ~Handler() {};
+    virtual void handle(uint64_t& total) const = 0;
+};
+
+class Adder : public Handler {
+  public:
+    Adder(uint64_t amount) : amount { amount } {};
+    virtual void handle(uint64_t& total) const override { total += amount; };
+    uint64_t amount;
+};
+
+class Multiplier : public Handler {
+  public:
+    Multiplier(uint64_t factor) : factor { factor } {};
+    virtual void handle(uint64_t& total) const override { total *= factor; };
+    uint64_t factor;
+};
+
+}
+
+//! one virtual call per handler, each handler in its own heap allocation as the dispatcher's callers hold them
+static void BM_HandlersOnTheHeap(benchmark::State& state) {
+  std::vector<std::unique_ptr<Handler>> handlers;
+  for(int64_t i = 0; i < state.range(0); ++i) {
+    if(i % 2 == 0) handlers.push_back(std::make_unique<Adder>(i));
+    else handlers.push_back(std::make_unique<Multiplier>(1));
+  }
+  // handlers registered over a program's life don't sit in the heap in the order they are walked
+  std::shuffle(handlers.begin(), handlers.end(), std::mt19937 { 1 });
+
+  for([[maybe_unused]] auto _ : state) {
+    uint64_t total = 0;
+    for(const auto& handler : handlers) handler->handle(total);
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HandlersOnTheHeap)->RangeMultiplier(8)->Range(8, 1 << 15);
+
+//! the same handlers, stored one after another in a PolyVector
+static void BM_HandlersInPolyVector(benchmark::State& state) {
+  vodden::PolyVector<Handler> handlers;
+  for(int64_t i = 0; i < state.range(0); ++i) {
+    if(i % 2 == 0) handlers.emplaceBack<Adder>(i);
+    else handlers.emplaceBack<Multiplier>(1);
+  }
+
+  for([[maybe_unused]] auto _ : state) {
+    uint64_t total = 0;
+    for(const Handler& handler : handlers) handler.handle(total);
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HandlersInPolyVector)->RangeMultiplier(8)->Range(8, 1 << 15);
@@ -0,0 +1,352 @@
+#ifndef __ASSET_PACK_H__
+#define __ASSET_PACK_H__
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+// files are mapped where POSIX mmap is available, and read into memory elsewhere
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#define VODDEN_ASSET_PACK_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace vodden {
+
+//! @brief the 64 bit FNV-1a hash of an asset's name, by which packs look assets up
+constexpr uint64_t hashAssetName(std::string_view name) noexcept {
+  uint64_t hash = 0xcbf29ce484222325;
+  for(const char character : name) {
+    hash ^= static_cast<uint8_t>(character);
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+/**
+ * @brief The fixed-size header at the front of an asset pack.
+ *
+ * A pack is this header, then entryCount AssetPackEntry records sorted by
+ * name hash, then the names, then each asset's bytes starting on a
+ * kBlobAlignment boundary. The fields are stored little endian and with no
+ * padding, in the order declared, whatever the host; these structs hold
+ * them once decoded.
+ */
+struct AssetPackHeader {
+  static constexpr std::size_t kSize = 16;
+
+  uint32_t magic;
+  uint32_t version;
+  uint32_t entryCount;
+  uint32_t namesOffset;
+};
+
+struct AssetPackEntry {
+  static constexpr std::size_t kSize = 32;
+
+  uint64_t nameHash;
+  uint64_t offset;
+  uint64_t size;
+  //! @brief where the name lies within the names, which follow the entries
+  uint32_t nameOffset;
+  uint32_t nameLength;
+};
+
+namespace detail {
+
+  template <class Integer>
+  Integer loadLittleEndian(const std::byte* bytes) noexcept {
+    Integer value = 0;
+    for(std::size_t i = 0; i < sizeof(Integer); ++i) value |= static_cast<Integer>(static_cast<uint8_t>(bytes[i])) << (8 * i);
+    return value;
+  }
+
+  template <class Integer>
+  void appendLittleEndian(std::string& bytes, Integer value) {
+    for(std::size_t i = 0; i < sizeof(Integer); ++i) bytes.push_back(static_cast<char>(static_cast<uint8_t>(value >> (8 * i))));
+  }
+
+}
+
+/**
+ * @brief A read-only asset pack, either mapped from a file or already in memory.
+ *
+ * Assets are returned as views straight into the pack, with nothing copied,
+ * so they stay valid for as long as the pack does. A pack linked into the
+ * executable, as the data target does, is viewed in place with the span
+ * constructor; a pack on disk is mapped with the path constructor, so only
+ * the pages actually read become resident. Where mmap is unavailable the
+ * path constructor reads the whole file instead.
+ *
+ * Assets are only kBlobAlignment aligned if the pack is, so a pack which
+ * isn't is rejected; the data target aligns the pack it links in.
+ */
+class AssetPack {
+  public:
+    static constexpr uint32_t kMagic = 0x314B5056; // "VPK1"
+    static constexpr uint32_t kVersion = 1;
+    //! @brief the alignment of each asset within the pack
+    static constexpr uint64_t kBlobAlignment = 64;
+
+    //! @brief view a pack held in memory, which must outlive this; throws std::invalid_argument if it is malformed or misaligned
+    explicit AssetPack(std::span<const std::byte> data) { open(data); }
+
+    //! @brief map a pack file; throws std::system_error if it cannot be mapped, std::invalid_argument if it is malformed
+    explicit AssetPack(const std::filesystem::path& filePath) {
+#if defined(VODDEN_ASSET_PACK_MMAP)
+      const int file = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+      if(file < 0) throw std::system_error(errno, std::generic_category(), "AssetPack: could not open " + filePath.string());
+
+      struct stat status;
+      if(::fstat(file, &status) < 0) {
+        const int error = errno;
+        ::close(file);
+        throw std::system_error(error, std::generic_category(), "AssetPack: could not stat " + filePath.string());
+      }
+      _mappedSize = static_cast<std::size_t>(status.st_size);
+      // a zero length mapping fails, and an empty file is rejected as truncated below anyway
+      if(_mappedSize > 0) {
+        _mapping = ::mmap(nullptr, _mappedSize, PROT_READ, MAP_PRIVATE, file, 0);
+        const int error = errno;
+        ::close(file);
+        if(_mapping == MAP_FAILED) {
+          _mapping = nullptr;
+          throw std::system_error(error, std::generic_category(), "AssetPack: could not map " + filePath.string());
+        }
+      } else {
+        ::close(file);
+      }
+
+      try {
+        open({ static_cast<const std::byte*>(_mapping), _mappedSize });
+      } catch(...) {
+        unmap();
+        throw;
+      }
+#else
+      std::ifstream file { filePath, std::ios::binary | std::ios::ate };
+      if(!file) throw std::system_error(errno, std::generic_category(), "AssetPack: could not open " + filePath.string());
+      const auto size = static_cast<std::size_t>(file.tellg());
+      _buffer.resize((size + kBlobAlignment - 1) / kBlobAlignment);
+      file.seekg(0);
+      if(!file.read(reinterpret_cast<char*>(_buffer.data()), static_cast<std::streamsize>(size))) {
+        throw std::system_error(errno, std::generic_category(), "AssetPack: could not read " + filePath.string());
+      }
+      open({ reinterpret_cast<const std::byte*>(_buffer.data()), size });
+#endif
+    }
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack(AssetPack&& other) noexcept :
+      _data { other._data }, _header { other._header }, _mapping { other._mapping }, _mappedSize { other._mappedSize },
+      _buffer { std::move(other._buffer) } {
+      other._mapping = nullptr;
+      other._data = {};
+      other._header.entryCount = 0;
+    }
+
+    ~AssetPack() { unmap(); }
+
+    AssetPack& operator=(const AssetPack&) = delete;
+    AssetPack& operator=(AssetPack&& other) noexcept {
+      if(this == &other) return *this;
+      unmap();
+      _data = other._data;
+      _header = other._header;
+      _mapping = other._mapping;
+      _mappedSize = other._mappedSize;
+      _buffer = std::move(other._buffer);
+      other._mapping = nullptr;
+      other._data = {};
+      other._header.entryCount = 0;
+      return *this;
+    }
+
+    std::size_t size() const noexcept { return _header.entryCount; }
+
+    //! @brief the asset with the provided name, or std::nullopt if the pack has none
+    std::optional<std::span<const std::byte>> find(std::string_view name) const {
+      const uint64_t nameHash = hashAssetName(name);
+      // the entries are sorted by hash, so names which collide sit together
+      std::size_t low = 0, high = _header.entryCount;
+      while(low < high) {
+        const std::size_t middle = low + (high - low) / 2;
+        if(getEntry(middle).nameHash < nameHash) low = middle + 1; else high = middle;
+      }
+      for(; low < _header.entryCount; ++low) {
+        const AssetPackEntry entry = getEntry(low);
+        if(entry.nameHash != nameHash) break;
+        if(getName(entry) == name) return getData(entry);
+      }
+      return std::nullopt;
+    }
+
+    //! @brief the asset with the provided name; throws std::out_of_range if the pack has none
+    std::span<const std::byte> at(std::string_view name) const {
+      const auto data = find(name);
+      if(!data) throw std::out_of_range("AssetPack::at: no asset named " + std::string { name } + ".");
+      return *data;
+    }
+
+    //! @brief the name of the index-th asset, in hash order
+    std::string_view getName(std::size_t index) const {
+      if(index >= _header.entryCount) throw std::out_of_range("AssetPack::getName: index out of range.");
+      return getName(getEntry(index));
+    }
+
+    //! @brief the bytes of the index-th asset, in hash order
+    std::span<const std::byte> getData(std::size_t index) const {
+      if(index >= _header.entryCount) throw std::out_of_range("AssetPack::getData: index out of range.");
+      return getData(getEntry(index));
+    }
+
+  private:
+    void open(std::span<const std::byte> data) {
+      if(data.size() < AssetPackHeader::kSize) throw std::invalid_argument("Asset pack is truncated.");
+      if(reinterpret_cast<uintptr_t>(data.data()) % kBlobAlignment != 0) throw std::invalid_argument("Asset pack is not aligned to kBlobAlignment.");
+      _header = {
+        detail::loadLittleEndian<uint32_t>(data.data()),
+        detail::loadLittleEndian<uint32_t>(data.data() + 4),
+        detail::loadLittleEndian<uint32_t>(data.data() + 8),
+        detail::loadLittleEndian<uint32_t>(data.data() + 12)
+      };
+      if(_header.magic != kMagic || _header.version != kVersion) throw std::invalid_argument("Not an asset pack.");
+
+      const uint64_t entriesEnd = AssetPackHeader::kSize + uint64_t { _header.entryCount } * AssetPackEntry::kSize;
+      if(entriesEnd > _header.namesOffset || _header.namesOffset > data.size()) throw std::invalid_argument("Asset pack is truncated.");
+      _data = data;
+      for(std::size_t i = 0; i < _header.entryCount; ++i) {
+        const AssetPackEntry entry = getEntry(i);
+        const uint64_t nameEnd = uint64_t { _header.namesOffset } + entry.nameOffset + entry.nameLength;
+        if(nameEnd > data.size() || entry.offset > data.size() || entry.size > data.size() - entry.offset) {
+          _data = {};
+          throw std::invalid_argument("Asset pack is truncated.");
+        }
+      }
+    }
+
+    AssetPackEntry getEntry(std::size_t index) const {
+      const std::byte* record = _data.data() + AssetPackHeader::kSize + index * AssetPackEntry::kSize;
+      return {
+        detail::loadLittleEndian<uint64_t>(record),
+        detail::loadLittleEndian<uint64_t>(record + 8),
+        detail::loadLittleEndian<uint64_t>(record + 16),
+        detail::loadLittleEndian<uint32_t>(record + 24),
+        detail::loadLittleEndian<uint32_t>(record + 28)
+      };
+    }
+
+    std::string_view getName(const AssetPackEntry& entry) const {
+      return { reinterpret_cast<const char*>(_data.data()) + _header.namesOffset + entry.nameOffset, entry.nameLength };
+    }
+
+    std::span<const std::byte> getData(const AssetPackEntry& entry) const {
+      return _data.subspan(entry.offset, entry.size);
+    }
+
+    void unmap() noexcept {
+#if defined(VODDEN_ASSET_PACK_MMAP)
+      if(_mapping != nullptr) ::munmap(_mapping, _mappedSize);
+#endif
+      _mapping = nullptr;
+    }
+
+    //! @brief storage for a pack read from a file, kBlobAlignment aligned like a mapping
+    struct alignas(kBlobAlignment) Block {
+      std::byte bytes[kBlobAlignment];
+    };
+
+    std::span<const std::byte> _data;
+    AssetPackHeader _header {};
+    // set only when the pack was mapped from a file
+    void* _mapping { nullptr };
+    std::size_t _mappedSize { 0 };
+    // filled only when the pack was read from a file, for want of mmap
+    std::vector<Block> _buffer;
+};
+
+//! @brief Collects named assets and writes them out as an asset pack.
+class AssetPackWriter {
+  public:
+    //! @brief queue an asset; data must outlive write(). Throws std::invalid_argument if the name is already used.
+    void add(std::string name, std::span<const std::byte> data) {
+      const bool used = std::any_of(_assets.cbegin(), _assets.cend(), [&name](const Asset& asset) { return asset.name == name; });
+      if(used) throw std::invalid_argument("AssetPackWriter::add: " + name + " is already in the pack.");
+      _assets.push_back({ std::move(name), data });
+    }
+
+    void write(std::ostream& output) const {
+      std::vector<const Asset*> order;
+      for(const auto& asset : _assets) order.push_back(&asset);
+      std::stable_sort(order.begin(), order.end(), [](const Asset* a, const Asset* b) {
+        return hashAssetName(a->name) < hashAssetName(b->name);
+      });
+
+      const uint64_t namesOffset = AssetPackHeader::kSize + order.size() * AssetPackEntry::kSize;
+      std::vector<AssetPackEntry> entries;
+      uint32_t nameOffset = 0;
+      for(const Asset* asset : order) {
+        entries.push_back({ hashAssetName(asset->name), 0, asset->data.size(), nameOffset, static_cast<uint32_t>(asset->name.size()) });
+        nameOffset += static_cast<uint32_t>(asset->name.size());
+      }
+      uint64_t offset = namesOffset + nameOffset;
+      for(auto& entry : entries) {
+        offset = align(offset);
+        entry.offset = offset;
+        offset += entry.size;
+      }
+
+      std::string records;
+      detail::appendLittleEndian(records, AssetPack::kMagic);
+      detail::appendLittleEndian(records, AssetPack::kVersion);
+      detail::appendLittleEndian(records, static_cast<uint32_t>(entries.size()));
+      detail::appendLittleEndian(records, static_cast<uint32_t>(namesOffset));
+      for(const auto& entry : entries) {
+        detail::appendLittleEndian(records, entry.nameHash);
+        detail::appendLittleEndian(records, entry.offset);
+        detail::appendLittleEndian(records, entry.size);
+        detail::appendLittleEndian(records, entry.nameOffset);
+        detail::appendLittleEndian(records, entry.nameLength);
+      }
+      output.write(records.data(), static_cast<std::streamsize>(records.size()));
+      for(const Asset* asset : order) output.write(asset->name.data(), static_cast<std::streamsize>(asset->name.size()));
+
+      uint64_t written = namesOffset + nameOffset;
+      for(std::size_t i = 0; i < order.size(); ++i) {
+        for(; written < entries[i].offset; ++written) output.put(0);
+        output.write(reinterpret_cast<const char*>(order[i]->data.data()), static_cast<std::streamsize>(entries[i].size));
+        written += entries[i].size;
+      }
+    }
+
+  private:
+    struct Asset {
+      std::string name;
+      std::span<const std::byte> data;
+    };
+
+    static constexpr uint64_t align(uint64_t offset) {
+      return (offset + AssetPack::kBlobAlignment - 1) / AssetPack::kBlobAlignment * AssetPack::kBlobAlignment;
+    }
+
+    std::vector<Asset> _assets;
+};
+
+}
+
+#endif
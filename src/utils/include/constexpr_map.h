@@ -3,34 +3,122 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
 #include <stdexcept>
 #include <tuple>
+#include <type_traits>
 
 namespace vodden {
 
-//! @brief A simple map class capable of being used as a constexpr
+/**
+ * @brief A simple map class capable of being used as a constexpr
+ *
+ * When the keys are integral (or enumerations) the map builds, at compile
+ * time, a collision free hash table over its keys so that lookups are a
+ * multiply, a shift and a single comparison. If no perfect hash can be
+ * found, or the keys are of any other type, lookups fall back to a linear
+ * search.
+ */
 template <class Key, class Value, std::size_t Size>
 struct Map {
     constexpr Map(std::initializer_list<std::pair<Key, Value>> _initList) {
       std::copy_n(std::begin(_initList), Size, _data.begin());
+      buildIndex();
     };
-    constexpr Map(const std::array<std::pair<Key, Value>, Size>& data) : _data { data } {};
-    constexpr Map(std::array<std::pair<Key, Value>, Size>&& data) : _data(std::move(data)) {};
+    constexpr Map(const std::array<std::pair<Key, Value>, Size>& data) : _data { data } { buildIndex(); };
+    constexpr Map(std::array<std::pair<Key, Value>, Size>&& data) : _data(std::move(data)) { buildIndex(); };
 
+    //! @brief the value for key; throws std::range_error if the key is not present
     constexpr Value operator[](const Key &key) const;
 
+    //! @brief the value for key, or std::nullopt if the key is not present
+    constexpr std::optional<Value> find(const Key &key) const noexcept;
+
+    //! @brief true if lookups go through the perfect hash rather than a linear search
+    constexpr bool isHashed() const noexcept { return _multiplier != 0; };
+
     private:
+      static constexpr bool kHashable = std::is_integral_v<Key> || std::is_enum_v<Key>;
+      static constexpr std::size_t kTableSize = std::bit_ceil(std::max<std::size_t>(Size * 2, 2));
+      static constexpr int kTableBits = std::countr_zero(kTableSize);
+      static constexpr std::size_t kMaxSeedAttempts = 512;
+      // the table stores the index of the entry plus one, so zero marks an empty slot
+      typedef std::conditional_t<(Size < 255), uint8_t, std::size_t> Slot;
+
+      static constexpr uint64_t toInteger(const Key& key) {
+        if constexpr (std::is_enum_v<Key>) {
+          return static_cast<uint64_t>(static_cast<std::underlying_type_t<Key>>(key));
+        } else {
+          return static_cast<uint64_t>(key);
+        }
+      }
+
+      constexpr std::size_t hash(uint64_t key) const {
+        return static_cast<std::size_t>(((key * _multiplier) >> _shift) & (kTableSize - 1));
+      }
+
+      //! @brief try to place every key in its own slot with the current multiplier and shift
+      constexpr bool tryBuildTable() {
+        _slots = {};
+        for(std::size_t i = 0; i < Size; ++i) {
+          Slot& slot = _slots[hash(toInteger(_data[i].first))];
+          if(slot != 0) return false;
+          slot = static_cast<Slot>(i + 1);
+        }
+        return true;
+      }
+
+      constexpr void buildIndex() {
+        if constexpr (kHashable) {
+          // dense keys usually index the table directly
+          _multiplier = 1;
+          _shift = 0;
+          if(tryBuildTable()) return;
+
+          // otherwise search for a multiplicative hash which is perfect for these keys
+          uint64_t seed = 0x9E3779B97F4A7C15ull;
+          _shift = 64 - kTableBits;
+          for(std::size_t attempt = 0; attempt < kMaxSeedAttempts; ++attempt) {
+            _multiplier = seed | 1;
+            if(tryBuildTable()) return;
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+          }
+        }
+        _multiplier = 0;
+      }
+
       std::array<std::pair<Key, Value>, Size> _data;
+      std::array<Slot, kTableSize> _slots {};
+      uint64_t _multiplier { 0 };
+      int _shift { 0 };
 };
 
 template <class Key, class Value, std::size_t Size>
-inline constexpr Value Map<Key, Value, Size>::operator[](const Key &key) const
+inline constexpr std::optional<Value> Map<Key, Value, Size>::find(const Key &key) const noexcept
 {
+  if constexpr (kHashable) {
+    if(isHashed()) {
+      const Slot slot = _slots[hash(toInteger(key))];
+      if(slot == 0 || !(_data[slot - 1].first == key)) return std::nullopt;
+      return _data[slot - 1].second;
+    }
+  }
+
   const auto& iterator = std::find_if(_data.cbegin(), _data.cend(), [&key](const auto& value){ return key == value.first; });
-  if (iterator == _data.cend()) throw std::range_error("Not Found.");
+  if (iterator == _data.cend()) return std::nullopt;
   return iterator->second;
 }
 
+template <class Key, class Value, std::size_t Size>
+inline constexpr Value Map<Key, Value, Size>::operator[](const Key &key) const
+{
+  const auto value = find(key);
+  if (!value) throw std::range_error("Not Found.");
+  return *value;
+}
+
 }
 
 #endif
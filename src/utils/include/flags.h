@@ -0,0 +1,154 @@
+#ifndef __FLAGS_H__
+#define __FLAGS_H__
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace vodden {
+
+/**
+ * @brief A constexpr set of small integral or enumeration values, held as one bitmask.
+ *
+ * Flag constants such as sdl::Renderer::RendererFlag are numbered from zero,
+ * so a set of them is a single word: building, testing and combining sets
+ * never allocates, and iterating visits the set values in ascending order.
+ * Values must be below kCapacity.
+ */
+template<class Bit>
+class Flags {
+  static_assert(std::is_integral_v<Bit> || std::is_enum_v<Bit>, "Flags holds integral or enumeration values");
+
+  public:
+    typedef uint64_t Mask;
+
+    static constexpr std::size_t kCapacity = 64;
+
+    //! @brief visits the set values in ascending order
+    class Iterator {
+      public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Bit value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Bit* pointer;
+        typedef Bit reference;
+
+        constexpr Iterator() noexcept = default;
+        constexpr explicit Iterator(Mask remaining) noexcept : _remaining { remaining } {}
+
+        constexpr Bit operator*() const noexcept { return fromIndex(std::countr_zero(_remaining)); }
+        constexpr Iterator& operator++() noexcept {
+          _remaining &= _remaining - 1;
+          return *this;
+        }
+        constexpr Iterator operator++(int) noexcept {
+          Iterator previous = *this;
+          ++*this;
+          return previous;
+        }
+        constexpr bool operator==(const Iterator& other) const noexcept = default;
+
+      private:
+        Mask _remaining { 0 };
+    };
+
+    constexpr Flags() noexcept = default;
+    constexpr Flags(std::initializer_list<Bit> bits) {
+      for(const Bit bit : bits) insert(bit);
+    }
+
+    //! @brief the set whose members are the bits of mask
+    static constexpr Flags fromMask(Mask mask) noexcept {
+      Flags flags;
+      flags._mask = mask;
+      return flags;
+    }
+
+    constexpr Mask getMask() const noexcept { return _mask; }
+
+    constexpr bool contains(Bit bit) const noexcept {
+      const std::size_t index = toIndex(bit);
+      return index < kCapacity && (_mask & (Mask { 1 } << index)) != 0;
+    }
+
+    //! @brief true if every member of other is also a member of this set
+    constexpr bool containsAll(Flags other) const noexcept { return (_mask & other._mask) == other._mask; }
+
+    constexpr bool empty() const noexcept { return _mask == 0; }
+    constexpr std::size_t size() const noexcept { return static_cast<std::size_t>(std::popcount(_mask)); }
+
+    //! @brief add bit; throws std::out_of_range if it is not below kCapacity
+    constexpr Flags& insert(Bit bit) {
+      _mask |= toMask(bit);
+      return *this;
+    }
+
+    constexpr Flags& erase(Bit bit) noexcept {
+      const std::size_t index = toIndex(bit);
+      if(index < kCapacity) _mask &= ~(Mask { 1 } << index);
+      return *this;
+    }
+
+    /**
+     * @brief OR together map's value for each member.
+     *
+     * This turns a set of library flags into the flag word the wrapped API
+     * takes, with map being the same vodden::Map a single flag goes through.
+     */
+    template<class FlagMap>
+    constexpr auto translate(const FlagMap& map) const {
+      std::remove_cvref_t<decltype(map[std::declval<Bit>()])> value {};
+      for(const Bit bit : *this) value |= map[bit];
+      return value;
+    }
+
+    constexpr Iterator begin() const noexcept { return Iterator { _mask }; }
+    constexpr Iterator end() const noexcept { return Iterator {}; }
+
+    constexpr Flags& operator|=(Flags other) noexcept {
+      _mask |= other._mask;
+      return *this;
+    }
+    constexpr Flags& operator&=(Flags other) noexcept {
+      _mask &= other._mask;
+      return *this;
+    }
+    constexpr Flags operator|(Flags other) const noexcept { return fromMask(_mask | other._mask); }
+    constexpr Flags operator&(Flags other) const noexcept { return fromMask(_mask & other._mask); }
+
+    constexpr bool operator==(const Flags& other) const noexcept = default;
+
+  private:
+    static constexpr std::size_t toIndex(Bit bit) noexcept {
+      if constexpr (std::is_enum_v<Bit>) {
+        return static_cast<std::size_t>(static_cast<std::underlying_type_t<Bit>>(bit));
+      } else {
+        return static_cast<std::size_t>(bit);
+      }
+    }
+
+    static constexpr Bit fromIndex(int index) noexcept {
+      if constexpr (std::is_enum_v<Bit>) {
+        return static_cast<Bit>(static_cast<std::underlying_type_t<Bit>>(index));
+      } else {
+        return static_cast<Bit>(index);
+      }
+    }
+
+    static constexpr Mask toMask(Bit bit) {
+      const std::size_t index = toIndex(bit);
+      if(index >= kCapacity) throw std::out_of_range("Flags::insert: value is beyond the capacity.");
+      return Mask { 1 } << index;
+    }
+
+    Mask _mask { 0 };
+};
+
+}
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef __FRAME_ARENA_H__
+#define __FRAME_ARENA_H__
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "memory_tracker.h"
+
+namespace vodden {
+
+/**
+ * @brief A bump allocator for data which lives for one frame, released all at once by reset().
+ *
+ * Allocating is an alignment and an add within the current block. A frame
+ * which outgrows the block chains more, and reset() then replaces them with
+ * one block large enough for the whole frame, so once the arena has seen its
+ * busiest frame every later one is served without touching the heap.
+ *
+ * Destructors are never run, so only trivially destructible objects may be
+ * created in it, and it is not thread safe: one thread allocates, and reset()
+ * must wait until nothing reads the frame's data any more, which is what
+ * DoubleBufferedFrameArena arranges for workers.
+ */
+class FrameArena {
+  public:
+    static constexpr std::size_t kDefaultBlockSize = 64 * 1024;
+
+    explicit FrameArena(std::size_t blockSize = kDefaultBlockSize, memory::Category category = memory::Category::kOther) :
+      _blockSize { std::max<std::size_t>(blockSize, 1) }, _category { category } {};
+    FrameArena(const FrameArena& other) = delete;
+    FrameArena(FrameArena&& other) noexcept :
+      _blockSize { other._blockSize },
+      _category { other._category },
+      _blocks { std::move(other._blocks) },
+      _current { std::exchange(other._current, 0) },
+      _offset { std::exchange(other._offset, 0) },
+      _usedBytes { std::exchange(other._usedBytes, 0) } {
+      other._blocks.clear();
+    };
+    ~FrameArena() { release(); };
+
+    FrameArena& operator=(const FrameArena& other) = delete;
+    FrameArena& operator=(FrameArena&& other) noexcept {
+      if(this == &other) return *this;
+      release();
+      _blockSize = other._blockSize;
+      _category = other._category;
+      _blocks = std::move(other._blocks);
+      other._blocks.clear();
+      _current = std::exchange(other._current, 0);
+      _offset = std::exchange(other._offset, 0);
+      _usedBytes = std::exchange(other._usedBytes, 0);
+      return *this;
+    };
+
+    //! @brief size bytes aligned to alignment, a power of two, valid until the next reset()
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+      if(!std::has_single_bit(alignment)) throw std::invalid_argument("FrameArena::allocate: the alignment must be a power of two.");
+
+      if(!_blocks.empty()) {
+        if(void* pointer = bump(_blocks[_current], size, alignment)) return pointer;
+      }
+      // large enough however the new block happens to be aligned
+      const std::size_t needed = size + (alignment > kBlockAlignment ? alignment : 0);
+      const std::size_t grown = _blocks.empty() ? _blockSize : _blocks.back().size * 2;
+      addBlock(std::max(needed, grown));
+      return bump(_blocks[_current], size, alignment);
+    };
+
+    //! @brief count value-initialised Ts, valid until the next reset()
+    template <class T>
+    std::span<T> allocateArray(std::size_t count) {
+      static_assert(std::is_trivially_destructible_v<T>, "FrameArena: destructors are never run, so T must be trivially destructible.");
+      if(count > SIZE_MAX / sizeof(T)) throw std::bad_array_new_length();
+      T* values = static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+      std::uninitialized_value_construct_n(values, count);
+      return { values, count };
+    };
+
+    //! @brief a T constructed from args, valid until the next reset()
+    template <class T, class... Args>
+    T& create(Args&&... args) {
+      static_assert(std::is_trivially_destructible_v<T>, "FrameArena: destructors are never run, so T must be trivially destructible.");
+      return *::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    };
+
+    //! @brief release everything allocated since the last reset, merging the blocks if the frame needed more than one
+    void reset() {
+      if(_blocks.size() > 1) {
+        std::size_t capacity = 0;
+        for(const Block& block : _blocks) capacity += block.size;
+        release();
+        addBlock(capacity);
+      }
+      _current = 0;
+      _offset = 0;
+      _usedBytes = 0;
+    };
+
+    //! @brief the bytes allocated since the last reset, including alignment padding
+    std::size_t getUsedBytes() const { return _usedBytes; };
+    std::size_t getCapacity() const {
+      std::size_t capacity = 0;
+      for(const Block& block : _blocks) capacity += block.size;
+      return capacity;
+    };
+    std::size_t getBlockCount() const { return _blocks.size(); };
+
+  private:
+    static constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+
+    struct Block {
+      std::byte* data;
+      std::size_t size;
+    };
+
+    //! @brief the allocation from the current block, or nullptr if it doesn't fit
+    void* bump(const Block& block, std::size_t size, std::size_t alignment) {
+      const auto address = reinterpret_cast<std::uintptr_t>(block.data + _offset);
+      const std::size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+      if(padding + size > block.size - _offset) return nullptr;
+      _offset += padding + size;
+      _usedBytes += padding + size;
+      return block.data + _offset - size;
+    };
+
+    void addBlock(std::size_t size) {
+      _blocks.reserve(_blocks.size() + 1);
+      auto data = static_cast<std::byte*>(memory::MemoryTracker::instance().allocate(size, kBlockAlignment, _category));
+      _blocks.push_back({ data, size });
+      _current = _blocks.size() - 1;
+      _offset = 0;
+    };
+
+    void release() noexcept {
+      for(const Block& block : _blocks) memory::MemoryTracker::instance().deallocate(block.data, block.size, kBlockAlignment, _category);
+      _blocks.clear();
+    };
+
+    std::size_t _blockSize;
+    memory::Category _category;
+    std::vector<Block> _blocks {};
+    std::size_t _current { 0 };
+    std::size_t _offset { 0 };
+    std::size_t _usedBytes { 0 };
+};
+
+//! @brief lets std::pmr containers allocate from a FrameArena; deallocating does nothing until the arena is reset
+class FrameArenaResource : public std::pmr::memory_resource {
+  public:
+    explicit FrameArenaResource(FrameArena& frameArena) : _frameArena { frameArena } {};
+
+  private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override { return _frameArena.allocate(bytes, alignment); };
+    void do_deallocate(void*, std::size_t, std::size_t) override {};
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; };
+
+    FrameArena& _frameArena;
+};
+
+/**
+ * @brief Two FrameArenas used alternately, for frame data which worker threads read.
+ *
+ * The render thread fills current() during frame N while workers may still
+ * be reading what it wrote during frame N - 1. swap() starts frame N + 1 in
+ * the arena frame N - 1 used, so data handed to workers stays valid until
+ * the frame after next begins; a worker must be finished with it by then.
+ */
+class DoubleBufferedFrameArena {
+  public:
+    explicit DoubleBufferedFrameArena(std::size_t blockSize = FrameArena::kDefaultBlockSize, memory::Category category = memory::Category::kOther) :
+      _frameArenas { FrameArena { blockSize, category }, FrameArena { blockSize, category } } {};
+
+    //! @brief the arena for the frame being built
+    FrameArena& current() { return _frameArenas[_current]; };
+    //! @brief the arena the previous frame was built in, which workers may still be reading
+    const FrameArena& previous() const { return _frameArenas[1 - _current]; };
+
+    //! @brief begin a new frame, resetting the arena of the frame before the previous one
+    void swap() {
+      _current = 1 - _current;
+      _frameArenas[_current].reset();
+    };
+
+  private:
+    std::array<FrameArena, 2> _frameArenas;
+    std::size_t _current { 0 };
+};
+
+}
+
+#endif
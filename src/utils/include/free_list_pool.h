@@ -0,0 +1,113 @@
+#ifndef __FREE_LIST_POOL_H__
+#define __FREE_LIST_POOL_H__
+
+#include <array>
+#include <cstddef>
+#include <new>
+
+#include "profiler.h"
+
+namespace vodden {
+
+/**
+ * @brief A size-classed free list which recycles small allocations.
+ *
+ * Blocks are rounded up to a power of two between kMinBlockSize and
+ * kMaxBlockSize and, when released, are kept on a free list belonging to the
+ * releasing thread rather than being returned to the heap. Once a program has
+ * reached its high-water mark, allocating and releasing objects of a given
+ * size class costs a pointer swap. Larger requests go straight to the heap.
+ *
+ * Blocks may be released on a different thread to the one which allocated them.
+ */
+class FreeListPool {
+  public:
+    static constexpr std::size_t kMinBlockSize = 32;
+    static constexpr std::size_t kSizeClasses = 5;
+    static constexpr std::size_t kMaxBlockSize = kMinBlockSize << (kSizeClasses - 1);
+    //! @brief the maximum number of blocks kept on each of a thread's free lists
+    static constexpr std::size_t kMaxFreeBlocks = 1024;
+
+    static void* allocate(std::size_t size) {
+      if(size > kMaxBlockSize) {
+        VODDEN_PROFILE_COUNT(kAllocations, 1);
+        return ::operator new(size);
+      }
+
+      const std::size_t sizeClass = getSizeClass(size);
+      auto& freeLists = getFreeLists();
+      FreeBlock* block = freeLists.heads[sizeClass];
+      if(block == nullptr) {
+        VODDEN_PROFILE_COUNT(kAllocations, 1);
+        return ::operator new(kMinBlockSize << sizeClass);
+      }
+
+      freeLists.heads[sizeClass] = block->next;
+      --freeLists.counts[sizeClass];
+      return block;
+    }
+
+    static void deallocate(void* pointer, std::size_t size) noexcept {
+      if(pointer == nullptr) return;
+      // during thread shutdown the free lists may already have been torn down
+      if(size > kMaxBlockSize || _freeListsState == FreeListsState::kDestroyed) return ::operator delete(pointer);
+
+      const std::size_t sizeClass = getSizeClass(size);
+      auto& freeLists = getFreeLists();
+      if(freeLists.counts[sizeClass] >= kMaxFreeBlocks) return ::operator delete(pointer);
+
+      freeLists.heads[sizeClass] = new (pointer) FreeBlock { freeLists.heads[sizeClass] };
+      ++freeLists.counts[sizeClass];
+    }
+
+    //! @brief the number of blocks currently held on the calling thread's free list for the given size
+    static std::size_t freeBlockCount(std::size_t size) {
+      if(size > kMaxBlockSize) return 0;
+      return getFreeLists().counts[getSizeClass(size)];
+    }
+
+  private:
+    struct FreeBlock {
+      FreeBlock* next;
+    };
+
+    enum class FreeListsState {
+      kUnconstructed,
+      kAlive,
+      kDestroyed
+    };
+
+    struct FreeLists {
+      FreeLists() { _freeListsState = FreeListsState::kAlive; };
+      ~FreeLists() {
+        _freeListsState = FreeListsState::kDestroyed;
+        for(FreeBlock* head : heads) {
+          while(head != nullptr) {
+            FreeBlock* next = head->next;
+            ::operator delete(head);
+            head = next;
+          }
+        }
+      };
+
+      std::array<FreeBlock*, kSizeClasses> heads {};
+      std::array<std::size_t, kSizeClasses> counts {};
+    };
+
+    static constexpr std::size_t getSizeClass(std::size_t size) {
+      std::size_t sizeClass = 0;
+      while((kMinBlockSize << sizeClass) < size) ++sizeClass;
+      return sizeClass;
+    }
+
+    static FreeLists& getFreeLists() {
+      thread_local FreeLists freeLists;
+      return freeLists;
+    }
+
+    inline static thread_local FreeListsState _freeListsState { FreeListsState::kUnconstructed };
+};
+
+}
+
+#endif
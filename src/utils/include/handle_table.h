@@ -0,0 +1,110 @@
+#ifndef __HANDLE_TABLE_H__
+#define __HANDLE_TABLE_H__
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace vodden {
+
+/**
+ * @brief Maps stable, generation checked handles onto a dense range of indices.
+ *
+ * Containers which keep their elements in packed, structure-of-arrays form
+ * use this to hand out handles that survive other elements being removed.
+ * Elements live at indices [0, size()); removing one moves the last element
+ * into its place, so the arrays stay packed and can be walked linearly.
+ *
+ * Each slot's generation is odd while the slot is in use and even while it
+ * is free, and it advances on every erase. A handle to a removed element
+ * therefore never matches again, even once its slot has been reused.
+ */
+class HandleTable {
+  public:
+    struct Handle {
+      uint32_t slot { 0 };
+      uint32_t generation { 0 };
+
+      constexpr bool operator==(const Handle& other) const = default;
+    };
+
+    //! @brief the result of an erase: the caller moves element from into index, then drops its last element
+    struct Move {
+      std::size_t index;
+      std::size_t from;
+    };
+
+    //! @brief a handle for a new element at index size() - 1
+    Handle insert() {
+      uint32_t slot = _freeSlot;
+      if(slot == kNoSlot) {
+        slot = static_cast<uint32_t>(_slots.size());
+        _slots.push_back({});
+      } else {
+        _freeSlot = _slots[slot].index;
+      }
+      _slots[slot].index = static_cast<uint32_t>(_dense.size());
+      ++_slots[slot].generation;
+      _dense.push_back(slot);
+      return { slot, _slots[slot].generation };
+    }
+
+    //! @brief the index of handle's element, or std::nullopt if it has been erased
+    std::optional<std::size_t> find(Handle handle) const {
+      if(!contains(handle)) return std::nullopt;
+      return _slots[handle.slot].index;
+    }
+
+    bool contains(Handle handle) const {
+      return handle.slot < _slots.size() && (handle.generation & 1) != 0 && _slots[handle.slot].generation == handle.generation;
+    }
+
+    //! @brief forget handle, returning how the caller should repack its arrays, or std::nullopt if it was already erased
+    std::optional<Move> erase(Handle handle) {
+      if(!contains(handle)) return std::nullopt;
+      Slot& erased = _slots[handle.slot];
+      const Move move { erased.index, _dense.size() - 1 };
+
+      const uint32_t movedSlot = _dense.back();
+      _dense[move.index] = movedSlot;
+      _slots[movedSlot].index = static_cast<uint32_t>(move.index);
+      _dense.pop_back();
+
+      ++erased.generation;
+      erased.index = _freeSlot;
+      _freeSlot = handle.slot;
+      return move;
+    }
+
+    //! @brief the handle of the element at index
+    Handle getHandle(std::size_t index) const {
+      const uint32_t slot = _dense[index];
+      return { slot, _slots[slot].generation };
+    }
+
+    std::size_t size() const { return _dense.size(); }
+
+    void reserve(std::size_t capacity) {
+      _slots.reserve(capacity);
+      _dense.reserve(capacity);
+    }
+
+  private:
+    static constexpr uint32_t kNoSlot = std::numeric_limits<uint32_t>::max();
+
+    struct Slot {
+      // the element's index while in use, the next free slot while free
+      uint32_t index { kNoSlot };
+      uint32_t generation { 0 };
+    };
+
+    std::vector<Slot> _slots;
+    // the slot of the element at each index
+    std::vector<uint32_t> _dense;
+    uint32_t _freeSlot { kNoSlot };
+};
+
+}
+
+#endif
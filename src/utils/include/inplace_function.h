@@ -0,0 +1,116 @@
+#ifndef __INPLACE_FUNCTION_H__
+#define __INPLACE_FUNCTION_H__
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace vodden {
+
+template <class Signature, std::size_t Capacity = 32>
+class InplaceFunction;
+
+/**
+ * @brief A std::function which keeps its callable inside itself and never allocates.
+ *
+ * The callable must fit in Capacity bytes, be no more aligned than
+ * std::max_align_t and be copyable and nothrow movable, all of which is
+ * checked when it is assigned, so a lambda capturing a few references or
+ * pointers fits the default. Calling an empty InplaceFunction throws
+ * std::bad_function_call, as std::function does.
+ */
+template <class Result, class... Args, std::size_t Capacity>
+class InplaceFunction<Result(Args...), Capacity> {
+  public:
+    InplaceFunction() = default;
+    InplaceFunction(std::nullptr_t) {};
+
+    template <class Function>
+      requires (!std::is_same_v<std::decay_t<Function>, InplaceFunction>) && std::is_invocable_r_v<Result, std::decay_t<Function>&, Args...>
+    InplaceFunction(Function&& function) {
+      typedef std::decay_t<Function> Callable;
+      static_assert(sizeof(Callable) <= Capacity, "InplaceFunction: the callable is larger than the capacity.");
+      static_assert(alignof(Callable) <= alignof(std::max_align_t), "InplaceFunction: the callable is over-aligned.");
+      static_assert(std::is_nothrow_move_constructible_v<Callable>, "InplaceFunction: the callable must be nothrow movable.");
+      static_assert(std::is_copy_constructible_v<Callable>, "InplaceFunction: the callable must be copyable.");
+
+      ::new (static_cast<void*>(_storage)) Callable(std::forward<Function>(function));
+      _invoke = [](void* callable, Args&&... args) -> Result {
+        return std::invoke(*std::launder(static_cast<Callable*>(callable)), std::forward<Args>(args)...);
+      };
+      _manage = [](Operation operation, void* destination, void* source) {
+        Callable* callable = std::launder(static_cast<Callable*>(source));
+        switch(operation) {
+          case Operation::kCopy: ::new (destination) Callable(*callable); break;
+          case Operation::kMove: ::new (destination) Callable(std::move(*callable)); callable->~Callable(); break;
+          case Operation::kDestroy: callable->~Callable(); break;
+        }
+      };
+    };
+
+    InplaceFunction(const InplaceFunction& other) : _invoke { other._invoke }, _manage { other._manage } {
+      if(_manage != nullptr) _manage(Operation::kCopy, _storage, const_cast<std::byte*>(other._storage));
+    };
+
+    InplaceFunction(InplaceFunction&& other) noexcept : _invoke { other._invoke }, _manage { other._manage } {
+      if(_manage != nullptr) _manage(Operation::kMove, _storage, other._storage);
+      other._invoke = nullptr;
+      other._manage = nullptr;
+    };
+
+    ~InplaceFunction() { reset(); };
+
+    InplaceFunction& operator=(const InplaceFunction& other) {
+      if(this != &other) {
+        // copied first, so a throwing copy leaves this as it was
+        InplaceFunction copy { other };
+        *this = std::move(copy);
+      }
+      return *this;
+    };
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+      if(this != &other) {
+        reset();
+        _invoke = std::exchange(other._invoke, nullptr);
+        _manage = std::exchange(other._manage, nullptr);
+        if(_manage != nullptr) _manage(Operation::kMove, _storage, other._storage);
+      }
+      return *this;
+    };
+
+    InplaceFunction& operator=(std::nullptr_t) {
+      reset();
+      return *this;
+    };
+
+    Result operator()(Args... args) const {
+      if(_invoke == nullptr) throw std::bad_function_call();
+      return _invoke(const_cast<std::byte*>(_storage), std::forward<Args>(args)...);
+    };
+
+    explicit operator bool() const { return _invoke != nullptr; };
+
+  private:
+    enum class Operation {
+      kCopy,
+      kMove,
+      kDestroy
+    };
+
+    void reset() {
+      if(_manage != nullptr) _manage(Operation::kDestroy, nullptr, _storage);
+      _invoke = nullptr;
+      _manage = nullptr;
+    };
+
+    alignas(std::max_align_t) std::byte _storage[Capacity];
+    Result (*_invoke)(void* callable, Args&&... args) { nullptr };
+    void (*_manage)(Operation operation, void* destination, void* source) { nullptr };
+};
+
+}
+
+#endif
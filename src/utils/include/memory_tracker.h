@@ -0,0 +1,246 @@
+#ifndef __MEMORY_TRACKER_H__
+#define __MEMORY_TRACKER_H__
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <ostream>
+
+#include "profiler.h"
+
+namespace vodden::memory {
+
+//! @brief what memory is for, each with its own counters and budget
+enum class Category : uint8_t {
+  kEvents,
+  kGeometry,
+  //! @brief pixels and texture bookkeeping held in cpu memory
+  kTextures,
+  //! @brief estimated from each texture's format and size, as the driver's real figure can't be had
+  kVideoMemory,
+  kUI,
+  kOther,
+  kCount
+};
+
+static constexpr std::size_t kCategoryCount = static_cast<std::size_t>(Category::kCount);
+
+//! @brief a category's memory, as of the moment it was read
+struct Usage {
+  uint64_t bytes;
+  //! @brief the most bytes ever in use at once, since the last resetPeaks
+  uint64_t peakBytes;
+  //! @brief the number of live allocations
+  uint64_t allocations;
+  //! @brief zero for no budget
+  uint64_t budget;
+
+  bool isOverBudget() const { return budget != 0 && bytes > budget; };
+};
+
+//! @brief where tracked allocations come from, e.g. a fixed arena per category on a console
+struct Allocator {
+  //! @brief size bytes aligned to alignment, or nullptr if there's no memory
+  void* (*allocate)(std::size_t size, std::size_t alignment, Category category);
+  void (*deallocate)(void* pointer, std::size_t size, std::size_t alignment, Category category) noexcept;
+};
+
+/**
+ * @brief Process-wide byte counts, high-water marks and budgets, per Category.
+ *
+ * The library's internal objects are allocated through allocate() by
+ * deriving from Tracked, and containers through TrackingAllocator, so the
+ * counts cover them without a global operator new. Memory which SDL
+ * allocates, surface pixels and video memory, is counted through record()
+ * and release() from its size instead.
+ *
+ * A category may be given a budget. The budget callback is called, on the
+ * allocating thread, each time its usage rises past the budget; nothing is
+ * refused, so the callback decides what to do, such as shrinking a
+ * TextureCache or logging.
+ */
+class MemoryTracker {
+  public:
+    typedef std::function<void(Category category, const Usage& usage)> BudgetCallback;
+
+    static MemoryTracker& instance() {
+      static MemoryTracker memoryTracker;
+      return memoryTracker;
+    }
+
+    //! @brief allocate through the current Allocator and count it; throws std::bad_alloc if it fails
+    void* allocate(std::size_t size, std::size_t alignment, Category category) {
+      void* pointer = _allocate.load(std::memory_order_relaxed)(size, alignment, category);
+      if(pointer == nullptr) throw std::bad_alloc();
+      VODDEN_PROFILE_COUNT(kAllocations, 1);
+      record(category, size);
+      return pointer;
+    }
+
+    //! @brief free memory from allocate(), passing the same size, alignment and category
+    void deallocate(void* pointer, std::size_t size, std::size_t alignment, Category category) noexcept {
+      if(pointer == nullptr) return;
+      _deallocate.load(std::memory_order_relaxed)(pointer, size, alignment, category);
+      release(category, size);
+    }
+
+    //! @brief count bytes allocated by something else, such as SDL
+    void record(Category category, uint64_t bytes) {
+      Counters& counters = _counters[static_cast<std::size_t>(category)];
+      counters.allocations.fetch_add(1, std::memory_order_relaxed);
+      const uint64_t total = counters.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+      uint64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+      while(total > peak && !counters.peakBytes.compare_exchange_weak(peak, total, std::memory_order_relaxed)) {}
+
+      const uint64_t budget = counters.budget.load(std::memory_order_relaxed);
+      if(budget != 0 && total > budget && total - bytes <= budget) exceeded(category);
+    }
+
+    //! @brief uncount bytes given to record()
+    void release(Category category, uint64_t bytes) noexcept {
+      Counters& counters = _counters[static_cast<std::size_t>(category)];
+      counters.allocations.fetch_sub(1, std::memory_order_relaxed);
+      counters.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    Usage getUsage(Category category) const {
+      const Counters& counters = _counters[static_cast<std::size_t>(category)];
+      return {
+        counters.bytes.load(std::memory_order_relaxed),
+        counters.peakBytes.load(std::memory_order_relaxed),
+        counters.allocations.load(std::memory_order_relaxed),
+        counters.budget.load(std::memory_order_relaxed)
+      };
+    }
+
+    //! @brief start every high-water mark again from the current usage
+    void resetPeaks() {
+      for(Counters& counters : _counters) counters.peakBytes.store(counters.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    //! @brief the bytes a category should stay within, or zero for no budget
+    void setBudget(Category category, uint64_t budget) {
+      _counters[static_cast<std::size_t>(category)].budget.store(budget, std::memory_order_relaxed);
+    }
+
+    void setBudgetCallback(BudgetCallback budgetCallback) {
+      std::scoped_lock lock { _mutex };
+      _budgetCallback = std::move(budgetCallback);
+    }
+
+    /**
+     * @brief route tracked allocations through allocator.
+     *
+     * Memory must go back to the allocator it came from, so this is only
+     * safe at startup, before any library object exists.
+     */
+    void setAllocator(const Allocator& allocator) {
+      _allocate.store(allocator.allocate, std::memory_order_relaxed);
+      _deallocate.store(allocator.deallocate, std::memory_order_relaxed);
+    }
+
+    //! @brief write each category's usage as a table, one category per line
+    void writeReport(std::ostream& output) const {
+      static constexpr const char* kCategoryNames[kCategoryCount] = { "events", "geometry", "textures", "video memory", "ui", "other" };
+
+      output << "category bytes peak allocations budget\n";
+      for(std::size_t i = 0; i < kCategoryCount; ++i) {
+        const Usage usage = getUsage(static_cast<Category>(i));
+        output << kCategoryNames[i] << " " << usage.bytes << " " << usage.peakBytes << " " << usage.allocations << " ";
+        if(usage.budget == 0) output << "-"; else output << usage.budget;
+        output << (usage.isOverBudget() ? " over budget\n" : "\n");
+      }
+    }
+
+  private:
+    struct Counters {
+      std::atomic<uint64_t> bytes { 0 };
+      std::atomic<uint64_t> peakBytes { 0 };
+      std::atomic<uint64_t> allocations { 0 };
+      std::atomic<uint64_t> budget { 0 };
+    };
+
+    MemoryTracker() = default;
+
+    static void* defaultAllocate(std::size_t size, std::size_t alignment, Category) {
+      return ::operator new(size, std::align_val_t { alignment }, std::nothrow);
+    }
+
+    static void defaultDeallocate(void* pointer, std::size_t, std::size_t alignment, Category) noexcept {
+      ::operator delete(pointer, std::align_val_t { alignment });
+    }
+
+    void exceeded(Category category) {
+      std::scoped_lock lock { _mutex };
+      if(_budgetCallback) _budgetCallback(category, getUsage(category));
+    }
+
+    std::array<Counters, kCategoryCount> _counters {};
+    std::atomic<decltype(Allocator::allocate)> _allocate { &defaultAllocate };
+    std::atomic<decltype(Allocator::deallocate)> _deallocate { &defaultDeallocate };
+    std::mutex _mutex;
+    BudgetCallback _budgetCallback;
+};
+
+/**
+ * @brief Derive from Tracked to have every new of the class counted against kCategory.
+ *
+ * As the sized operator delete is used, a class which is deleted through a
+ * base pointer must have a virtual destructor, which is needed anyway.
+ */
+template <Category kCategory>
+class Tracked {
+  public:
+    static void* operator new(std::size_t size) {
+      return MemoryTracker::instance().allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, kCategory);
+    }
+
+    static void* operator new(std::size_t size, std::align_val_t alignment) {
+      return MemoryTracker::instance().allocate(size, static_cast<std::size_t>(alignment), kCategory);
+    }
+
+    static void operator delete(void* pointer, std::size_t size) noexcept {
+      MemoryTracker::instance().deallocate(pointer, size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, kCategory);
+    }
+
+    static void operator delete(void* pointer, std::size_t size, std::align_val_t alignment) noexcept {
+      MemoryTracker::instance().deallocate(pointer, size, static_cast<std::size_t>(alignment), kCategory);
+    }
+};
+
+//! @brief a standard allocator counting against kCategory, for containers and std::allocate_shared
+template <class T, Category kCategory>
+class TrackingAllocator {
+  public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind {
+      typedef TrackingAllocator<U, kCategory> other;
+    };
+
+    TrackingAllocator() = default;
+    template <class U>
+    TrackingAllocator(const TrackingAllocator<U, kCategory>&) noexcept {};
+
+    T* allocate(std::size_t count) {
+      if(count > SIZE_MAX / sizeof(T)) throw std::bad_array_new_length();
+      return static_cast<T*>(MemoryTracker::instance().allocate(count * sizeof(T), alignof(T), kCategory));
+    }
+
+    void deallocate(T* pointer, std::size_t count) noexcept {
+      MemoryTracker::instance().deallocate(pointer, count * sizeof(T), alignof(T), kCategory);
+    }
+
+    template <class U>
+    bool operator==(const TrackingAllocator<U, kCategory>&) const noexcept { return true; };
+};
+
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef __MPSC_QUEUE_H__
+#define __MPSC_QUEUE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+namespace vodden {
+
+/**
+ * @brief A bounded, lock-free, multiple producer single consumer queue.
+ *
+ * Any number of threads may push concurrently; exactly one thread may pop.
+ * Each slot of the ring buffer carries a sequence number which tells
+ * producers whether it is free and the consumer whether it has been
+ * published, so neither side ever takes a lock. Producers only contend with
+ * each other on a single compare-and-swap.
+ *
+ * @tparam Capacity the number of slots, which must be a power of two.
+ */
+template <class ContainedType, std::size_t Capacity = 1024>
+class MpscQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+  public:
+    MpscQueue() : _cells { std::make_unique<Cell[]>(Capacity) } {
+      for(std::size_t i = 0; i < Capacity; ++i) _cells[i].sequence.store(i, std::memory_order_relaxed);
+    };
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue(MpscQueue&&) = delete;
+    ~MpscQueue() {
+      while(tryPop()) {};
+    }
+
+    MpscQueue& operator=(const MpscQueue&) = delete;
+    MpscQueue& operator=(MpscQueue&&) = delete;
+
+    /**
+     * @brief add an item to the back of the queue; safe to call from any thread.
+     *
+     * @return false, leaving item untouched, if the queue is full.
+     */
+    bool push(ContainedType&& item) {
+      std::size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+      Cell* cell;
+      while(true) {
+        cell = &_cells[position & kMask];
+        const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if(difference == 0) {
+          if(_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        } else if(difference < 0) {
+          return false;
+        } else {
+          position = _enqueuePosition.load(std::memory_order_relaxed);
+        }
+      }
+
+      new (cell->storage) ContainedType(std::move(item));
+      cell->sequence.store(position + 1, std::memory_order_release);
+      return true;
+    }
+
+    bool push(const ContainedType& item) {
+      ContainedType copy { item };
+      return push(std::move(copy));
+    }
+
+    /**
+     * @brief remove the item at the front of the queue; must only be called from the consumer thread.
+     *
+     * @return the item, or std::nullopt if the queue is empty.
+     */
+    std::optional<ContainedType> tryPop() {
+      Cell& cell = _cells[_dequeuePosition & kMask];
+      const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      if(sequence != _dequeuePosition + 1) return std::nullopt;
+
+      ContainedType* item = std::launder(reinterpret_cast<ContainedType*>(cell.storage));
+      std::optional<ContainedType> popped { std::move(*item) };
+      item->~ContainedType();
+
+      cell.sequence.store(_dequeuePosition + Capacity, std::memory_order_release);
+      ++_dequeuePosition;
+      return popped;
+    }
+
+    //! @brief true if there was nothing to pop at the time of the call; consumer thread only.
+    bool empty() const {
+      return _cells[_dequeuePosition & kMask].sequence.load(std::memory_order_acquire) != _dequeuePosition + 1;
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+  private:
+    static constexpr std::size_t kMask = Capacity - 1;
+    static constexpr std::size_t kCacheLineSize = 64;
+
+    struct Cell {
+      std::atomic<std::size_t> sequence;
+      alignas(ContainedType) std::byte storage[sizeof(ContainedType)];
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+    // kept on separate cache lines so producers and the consumer don't false-share
+    alignas(kCacheLineSize) std::atomic<std::size_t> _enqueuePosition { 0 };
+    alignas(kCacheLineSize) std::size_t _dequeuePosition { 0 };
+};
+
+}
+
+#endif
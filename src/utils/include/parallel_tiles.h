@@ -0,0 +1,84 @@
+#ifndef __PARALLEL_TILES_H__
+#define __PARALLEL_TILES_H__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+#include "pixel_kernels.h"
+#include "thread_pool.h"
+
+namespace vodden {
+
+//! @brief a tile size which keeps each tile within a typical core's L2 cache
+static constexpr std::size_t kDefaultTileBytes = 256 * 1024;
+
+/**
+ * @brief run fn over pixels in tiles of whole rows, in parallel on pool.
+ *
+ * Each tile is a band of as many rows as fit in tileBytes, and at least
+ * one. fn is called as fn(tile, firstRow) with tile the view of those rows,
+ * from several threads at once, so it must only touch its own tile.
+ *
+ * The calling thread works through tiles alongside the pool, which makes
+ * this safe to call from one of pool's own workers, and returns once every
+ * tile is done. If fn throws, the tiles not yet started are skipped and the
+ * first exception is rethrown here.
+ */
+template <class Byte, class Function>
+void parallelForTiles(BasicPixelView<Byte> pixels, std::size_t tileBytes, Function&& fn, ThreadPool& pool = ThreadPool::shared()) {
+  detail::checkView(pixels, "parallelForTiles: rows overrun the view's bytes.");
+  if(pixels.width == 0 || pixels.height == 0) return;
+
+  const uint32_t rowsPerTile = static_cast<uint32_t>(std::clamp<std::size_t>(tileBytes / pixels.pitch, 1, pixels.height));
+  const uint32_t tileCount = (pixels.height + rowsPerTile - 1) / rowsPerTile;
+
+  // shared, as helpers the pool starts late may still look for a tile after this returns
+  struct State {
+    std::atomic<uint32_t> next { 0 };
+    std::atomic<uint32_t> unfinished { 0 };
+    std::atomic<bool> failed { false };
+    std::mutex mutex {};
+    std::condition_variable finished {};
+    std::exception_ptr error {};
+  };
+  const auto state = std::make_shared<State>();
+  state->unfinished = tileCount;
+
+  // fn and pixels are only used while a tile is claimed, and every claimed tile finishes before this returns
+  const auto runTiles = [state, pixels, rowsPerTile, tileCount, &fn]() {
+    for(uint32_t tile; (tile = state->next.fetch_add(1, std::memory_order_relaxed)) < tileCount;) {
+      if(!state->failed.load(std::memory_order_relaxed)) {
+        const uint32_t firstRow = tile * rowsPerTile;
+        try {
+          fn(pixels.region(0, firstRow, pixels.width, std::min(rowsPerTile, pixels.height - firstRow)), firstRow);
+        } catch(...) {
+          std::scoped_lock lock { state->mutex };
+          if(!state->error) state->error = std::current_exception();
+          state->failed = true;
+        }
+      }
+      if(state->unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::scoped_lock lock { state->mutex };
+        state->finished.notify_all();
+      }
+    }
+  };
+
+  const std::size_t helperCount = std::min<std::size_t>(pool.size(), tileCount - 1);
+  for(std::size_t i = 0; i < helperCount; ++i) pool.submit(runTiles);
+  runTiles();
+
+  std::unique_lock lock { state->mutex };
+  state->finished.wait(lock, [&state]() { return state->unfinished.load(std::memory_order_acquire) == 0; });
+  if(state->error) std::rethrow_exception(state->error);
+}
+
+}
+
+#endif
@@ -0,0 +1,281 @@
+#ifndef __PIXEL_KERNELS_H__
+#define __PIXEL_KERNELS_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace vodden {
+
+/**
+ * @brief A rectangle of 32 bit pixels within rows of pitch bytes.
+ *
+ * Rows may be longer than width pixels, as they are when the view is a
+ * region of a larger image or a surface pads its rows, so every row is
+ * found from the pitch rather than by packing.
+ */
+template <class Byte>
+struct BasicPixelView {
+  typedef std::conditional_t<std::is_const_v<Byte>, const uint32_t, uint32_t> Pixel;
+
+  std::span<Byte> bytes;
+  uint32_t width { 0 };
+  uint32_t height { 0 };
+  uint32_t pitch { 0 };
+
+  std::span<Pixel> row(uint32_t y) const {
+    return { reinterpret_cast<Pixel*>(bytes.data() + static_cast<std::size_t>(y) * pitch), width };
+  }
+
+  //! @brief the width by height pixels from x, y; throws std::out_of_range if they aren't all in the view
+  BasicPixelView region(uint32_t x, uint32_t y, uint32_t regionWidth, uint32_t regionHeight) const {
+    if(x > width || regionWidth > width - x || y > height || regionHeight > height - y) throw std::out_of_range("BasicPixelView::region: region is outside the view.");
+    if(regionWidth == 0 || regionHeight == 0) return { {}, regionWidth, regionHeight, pitch };
+    const std::size_t offset = static_cast<std::size_t>(y) * pitch + static_cast<std::size_t>(x) * 4;
+    return { bytes.subspan(offset, static_cast<std::size_t>(regionHeight - 1) * pitch + static_cast<std::size_t>(regionWidth) * 4), regionWidth, regionHeight, pitch };
+  }
+
+  operator BasicPixelView<const Byte>() const requires (!std::is_const_v<Byte>) {
+    return { bytes, width, height, pitch };
+  }
+};
+
+typedef BasicPixelView<std::byte> PixelView;
+typedef BasicPixelView<const std::byte> ConstPixelView;
+
+namespace detail {
+  //! @brief throws std::invalid_argument unless every row of view lies within its bytes
+  template <class Byte>
+  inline void checkView(const BasicPixelView<Byte>& view, const char* message) {
+    if(view.width == 0 || view.height == 0) return;
+    const std::size_t rowBytes = static_cast<std::size_t>(view.width) * 4;
+    if(view.pitch < rowBytes || view.bytes.size() < static_cast<std::size_t>(view.height - 1) * view.pitch + rowBytes) throw std::invalid_argument(message);
+  }
+
+  inline void checkViews(const ConstPixelView& source, const PixelView& destination, const char* message) {
+    if(source.width != destination.width || source.height != destination.height) throw std::invalid_argument(message);
+    checkView(source, message);
+    checkView(destination, message);
+  }
+
+  //! @brief x / 255, rounded to nearest, for x up to 255 * 255
+  constexpr uint32_t divide255(uint32_t x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+  }
+
+  //! @brief blends [begin, end) of source over destination one pixel at a time
+  inline void blendRowScalar(const uint32_t* source, uint32_t* destination, std::size_t begin, std::size_t end) {
+    for(std::size_t i = begin; i < end; ++i) {
+      const uint32_t inverseAlpha = 255 - (source[i] >> 24);
+      uint32_t result = 0;
+      for(uint32_t shift = 0; shift < 32; shift += 8) {
+        const uint32_t channel = ((source[i] >> shift) & 0xff) + divide255(((destination[i] >> shift) & 0xff) * inverseAlpha);
+        result |= std::min<uint32_t>(channel, 255) << shift;
+      }
+      destination[i] = result;
+    }
+  }
+
+  //! @brief copies [begin, end) of source to destination one pixel at a time, skipping pixels matching key
+  inline void colorKeyRowScalar(const uint32_t* source, uint32_t* destination, std::size_t begin, std::size_t end, uint32_t key) {
+    for(std::size_t i = begin; i < end; ++i) {
+      // written unconditionally, so there is no branch to mispredict
+      destination[i] = (source[i] & 0x00ffffff) == key ? destination[i] : source[i];
+    }
+  }
+
+  //! @brief swaps bits 0-7 and 16-23 of [begin, end) one pixel at a time
+  inline void swapRedBlueRowScalar(const uint32_t* source, uint32_t* destination, std::size_t begin, std::size_t end) {
+    for(std::size_t i = begin; i < end; ++i) {
+      const uint32_t pixel = source[i];
+      destination[i] = (pixel & 0xff00ff00) | ((pixel >> 16) & 0xff) | ((pixel & 0xff) << 16);
+    }
+  }
+
+#if defined(__AVX2__)
+  inline __m256i divide255(__m256i x) {
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+  }
+#elif defined(__SSE4_1__)
+  inline __m128i divide255(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  inline uint8x8_t divide255(uint16x8_t x) {
+    return vraddhn_u16(x, vrshrq_n_u16(x, 8));
+  }
+#endif
+
+  inline void blendRow(const uint32_t* source, uint32_t* destination, std::size_t size) {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    // the shuffles and unpacks work within each 128 bit lane, so the mask repeats per lane
+    const __m256i alphaShuffle = _mm256_setr_epi8(
+      3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15,
+      3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15
+    );
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi8(-1);
+    for(; i + 8 <= size; i += 8) {
+      const __m256i source8 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+      const __m256i destination8 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i));
+      const __m256i inverseAlpha = _mm256_xor_si256(_mm256_shuffle_epi8(source8, alphaShuffle), ones);
+      const __m256i low = divide255(_mm256_mullo_epi16(_mm256_unpacklo_epi8(destination8, zero), _mm256_unpacklo_epi8(inverseAlpha, zero)));
+      const __m256i high = divide255(_mm256_mullo_epi16(_mm256_unpackhi_epi8(destination8, zero), _mm256_unpackhi_epi8(inverseAlpha, zero)));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_adds_epu8(source8, _mm256_packus_epi16(low, high)));
+    }
+#elif defined(__SSE4_1__)
+    const __m128i alphaShuffle = _mm_setr_epi8(3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi8(-1);
+    for(; i + 4 <= size; i += 4) {
+      const __m128i source4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+      const __m128i destination4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i));
+      const __m128i inverseAlpha = _mm_xor_si128(_mm_shuffle_epi8(source4, alphaShuffle), ones);
+      const __m128i low = divide255(_mm_mullo_epi16(_mm_cvtepu8_epi16(destination4), _mm_cvtepu8_epi16(inverseAlpha)));
+      const __m128i high = divide255(_mm_mullo_epi16(_mm_unpackhi_epi8(destination4, zero), _mm_unpackhi_epi8(inverseAlpha, zero)));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_adds_epu8(source4, _mm_packus_epi16(low, high)));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint8x16_t alphaShuffle = { 3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15 };
+    for(; i + 4 <= size; i += 4) {
+      const uint8x16_t source4 = vreinterpretq_u8_u32(vld1q_u32(source + i));
+      const uint8x16_t destination4 = vreinterpretq_u8_u32(vld1q_u32(destination + i));
+      const uint8x16_t inverseAlpha = vmvnq_u8(vqtbl1q_u8(source4, alphaShuffle));
+      const uint8x16_t scaled = vcombine_u8(
+        divide255(vmull_u8(vget_low_u8(destination4), vget_low_u8(inverseAlpha))),
+        divide255(vmull_high_u8(destination4, inverseAlpha))
+      );
+      vst1q_u32(destination + i, vreinterpretq_u32_u8(vqaddq_u8(source4, scaled)));
+    }
+#endif
+    blendRowScalar(source, destination, i, size);
+  }
+
+  inline void colorKeyRow(const uint32_t* source, uint32_t* destination, std::size_t size, uint32_t key) {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i key8 = _mm256_set1_epi32(static_cast<int>(key));
+    const __m256i colorMask = _mm256_set1_epi32(0x00ffffff);
+    for(; i + 8 <= size; i += 8) {
+      const __m256i source8 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+      const __m256i destination8 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i));
+      const __m256i keyed = _mm256_cmpeq_epi32(_mm256_and_si256(source8, colorMask), key8);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_blendv_epi8(source8, destination8, keyed));
+    }
+#elif defined(__SSE4_1__)
+    const __m128i key4 = _mm_set1_epi32(static_cast<int>(key));
+    const __m128i colorMask = _mm_set1_epi32(0x00ffffff);
+    for(; i + 4 <= size; i += 4) {
+      const __m128i source4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+      const __m128i destination4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i));
+      const __m128i keyed = _mm_cmpeq_epi32(_mm_and_si128(source4, colorMask), key4);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_blendv_epi8(source4, destination4, keyed));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint32x4_t key4 = vdupq_n_u32(key);
+    const uint32x4_t colorMask = vdupq_n_u32(0x00ffffff);
+    for(; i + 4 <= size; i += 4) {
+      const uint32x4_t source4 = vld1q_u32(source + i);
+      const uint32x4_t keyed = vceqq_u32(vandq_u32(source4, colorMask), key4);
+      vst1q_u32(destination + i, vbslq_u32(keyed, vld1q_u32(destination + i), source4));
+    }
+#endif
+    colorKeyRowScalar(source, destination, i, size, key);
+  }
+
+  inline void swapRedBlueRow(const uint32_t* source, uint32_t* destination, std::size_t size) {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i swap = _mm256_setr_epi8(
+      2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+      2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15
+    );
+    for(; i + 8 <= size; i += 8) {
+      const __m256i source8 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_shuffle_epi8(source8, swap));
+    }
+#elif defined(__SSE4_1__)
+    const __m128i swap = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    for(; i + 4 <= size; i += 4) {
+      const __m128i source4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_shuffle_epi8(source4, swap));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint8x16_t swap = { 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15 };
+    for(; i + 4 <= size; i += 4) {
+      const uint8x16_t source4 = vreinterpretq_u8_u32(vld1q_u32(source + i));
+      vst1q_u32(destination + i, vreinterpretq_u32_u8(vqtbl1q_u8(source4, swap)));
+    }
+#endif
+    swapRedBlueRowScalar(source, destination, i, size);
+  }
+}
+
+/*
+ * The kernels below work on 32 bit pixels with any alpha in bits 24-31, as
+ * in ARGB8888 and ABGR8888, and run several pixels at a time with AVX2,
+ * SSE4.1 or AArch64 NEON, whichever the build targets (see VODDEN_SIMD in
+ * cmake/standard_build.cmake), or one at a time otherwise. The byte shuffles assume a little endian target. Views passed
+ * together must be the same size and each row must lie within its bytes, or
+ * std::invalid_argument is thrown.
+ */
+
+//! @brief draw premultiplied source over destination: each channel becomes source + destination * (255 - source alpha) / 255
+inline void blendPremultiplied(ConstPixelView source, PixelView destination) {
+  detail::checkViews(source, destination, "blendPremultiplied: views differ in size or overrun their bytes.");
+  for(uint32_t y = 0; y < source.height; ++y) detail::blendRow(source.row(y).data(), destination.row(y).data(), source.width);
+}
+
+//! @brief copy source to destination, except for pixels whose colour, ignoring alpha, is key
+inline void copyColorKeyed(ConstPixelView source, PixelView destination, uint32_t key) {
+  detail::checkViews(source, destination, "copyColorKeyed: views differ in size or overrun their bytes.");
+  for(uint32_t y = 0; y < source.height; ++y) detail::colorKeyRow(source.row(y).data(), destination.row(y).data(), source.width, key & 0x00ffffff);
+}
+
+/**
+ * @brief copy source to destination with bits 0-7 and 16-23 of each pixel swapped.
+ *
+ * This converts between ARGB8888 and ABGR8888, which in memory are BGRA and
+ * RGBA. source and destination may be the same pixels.
+ */
+inline void swapRedBlue(ConstPixelView source, PixelView destination) {
+  detail::checkViews(source, destination, "swapRedBlue: views differ in size or overrun their bytes.");
+  for(uint32_t y = 0; y < source.height; ++y) detail::swapRedBlueRow(source.row(y).data(), destination.row(y).data(), source.width);
+}
+
+inline void fillPixels(PixelView destination, uint32_t pixel) {
+  detail::checkView(destination, "fillPixels: rows overrun the view's bytes.");
+  for(uint32_t y = 0; y < destination.height; ++y) std::ranges::fill(destination.row(y), pixel);
+}
+
+//! @brief scale each pixel's colour by its alpha, ready for blendPremultiplied
+inline void premultiplyAlpha(PixelView pixels) {
+  detail::checkView(pixels, "premultiplyAlpha: rows overrun the view's bytes.");
+  for(uint32_t y = 0; y < pixels.height; ++y) {
+    for(uint32_t& pixel : pixels.row(y)) {
+      const uint32_t alpha = pixel >> 24;
+      uint32_t result = alpha << 24;
+      for(uint32_t shift = 0; shift < 24; shift += 8) result |= detail::divide255(((pixel >> shift) & 0xff) * alpha) << shift;
+      pixel = result;
+    }
+  }
+}
+
+}
+
+#endif
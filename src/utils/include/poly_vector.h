@@ -0,0 +1,226 @@
+#ifndef __POLY_VECTOR_H__
+#define __POLY_VECTOR_H__
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vodden {
+
+/**
+ * @brief A sequence of objects of any classes derived from Base, stored inline.
+ *
+ * The objects sit one after another, each suitably aligned, in a single
+ * buffer rather than in a heap allocation each, so walking the sequence
+ * reads memory in order instead of chasing a pointer per element. Each
+ * element carries a table of type-erased operations for its own class, which
+ * is how the buffer moves and destroys objects it only knows as Base.
+ *
+ * Growing the buffer moves every object, so references to elements are
+ * invalidated by emplaceBack the way they are by std::vector::push_back.
+ * As there, elements which may throw on a move are copied instead, so a
+ * throw leaves the sequence as it was. Element classes may be no more
+ * aligned than std::max_align_t.
+ */
+template <class Base>
+class PolyVector {
+  private:
+    struct Operations {
+      //! @brief construct a copy of the object at source at destination, moving it if that can't throw
+      void (*transfer)(std::byte* destination, std::byte* source);
+      void (*destroy)(std::byte* object) noexcept;
+      //! @brief true if transfer moves, which is then also how a failed reserveBytes puts the object back
+      bool moves;
+    };
+
+    struct Entry {
+      std::size_t offset;
+      //! @brief where the Base subobject lies, which differs from offset under multiple inheritance
+      std::size_t baseOffset;
+      const Operations* operations;
+    };
+
+    template <class Derived>
+    static constexpr Operations kOperations {
+      [](std::byte* destination, std::byte* source) {
+        ::new (static_cast<void*>(destination)) Derived(std::move_if_noexcept(*std::launder(reinterpret_cast<Derived*>(source))));
+      },
+      [](std::byte* object) noexcept {
+        std::launder(reinterpret_cast<Derived*>(object))->~Derived();
+      },
+      std::is_nothrow_move_constructible_v<Derived>
+    };
+
+  public:
+    static constexpr std::size_t kAlignment = alignof(std::max_align_t);
+
+    template <class Value, class Byte>
+    class Iterator {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<Value>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        Iterator() = default;
+        Iterator(const Entry* entry, Byte* buffer) : _entry { entry }, _buffer { buffer } {};
+
+        reference operator*() const { return *operator->(); };
+        pointer operator->() const { return std::launder(reinterpret_cast<pointer>(_buffer + _entry->baseOffset)); };
+        reference operator[](difference_type n) const { return *(*this + n); };
+
+        Iterator& operator++() { ++_entry; return *this; };
+        Iterator operator++(int) { Iterator previous = *this; ++_entry; return previous; };
+        Iterator& operator--() { --_entry; return *this; };
+        Iterator operator--(int) { Iterator previous = *this; --_entry; return previous; };
+        Iterator& operator+=(difference_type n) { _entry += n; return *this; };
+        Iterator& operator-=(difference_type n) { _entry -= n; return *this; };
+        friend Iterator operator+(Iterator iterator, difference_type n) { return iterator += n; };
+        friend Iterator operator+(difference_type n, Iterator iterator) { return iterator += n; };
+        friend Iterator operator-(Iterator iterator, difference_type n) { return iterator -= n; };
+        friend difference_type operator-(const Iterator& a, const Iterator& b) { return a._entry - b._entry; };
+
+        bool operator==(const Iterator& other) const { return _entry == other._entry; };
+        auto operator<=>(const Iterator& other) const { return _entry <=> other._entry; };
+
+      private:
+        const Entry* _entry { nullptr };
+        Byte* _buffer { nullptr };
+    };
+
+    typedef Iterator<Base, std::byte> iterator;
+    typedef Iterator<const Base, const std::byte> const_iterator;
+
+    PolyVector() = default;
+    PolyVector(const PolyVector&) = delete;
+    PolyVector& operator=(const PolyVector&) = delete;
+
+    PolyVector(PolyVector&& other) noexcept :
+      _entries { std::move(other._entries) },
+      _buffer { std::exchange(other._buffer, nullptr) },
+      _capacity { std::exchange(other._capacity, 0) },
+      _used { std::exchange(other._used, 0) } {
+      other._entries.clear();
+    };
+
+    PolyVector& operator=(PolyVector&& other) noexcept {
+      if(this == &other) return *this;
+      clear();
+      release();
+      _entries = std::move(other._entries);
+      other._entries.clear();
+      _buffer = std::exchange(other._buffer, nullptr);
+      _capacity = std::exchange(other._capacity, 0);
+      _used = std::exchange(other._used, 0);
+      return *this;
+    };
+
+    ~PolyVector() {
+      clear();
+      release();
+    };
+
+    //! @brief construct a Derived from args at the end of the sequence
+    template <class Derived, class... Args>
+      requires std::derived_from<Derived, Base> && std::constructible_from<Derived, Args...>
+    Derived& emplaceBack(Args&&... args) {
+      static_assert(alignof(Derived) <= kAlignment, "PolyVector: elements may be no more aligned than std::max_align_t.");
+
+      const std::size_t offset = alignUp(_used, alignof(Derived));
+      if(offset + sizeof(Derived) > _capacity) reserveBytes(std::max(2 * _capacity, offset + sizeof(Derived)));
+      _entries.reserve(_entries.size() + 1);
+
+      Derived* object = ::new (static_cast<void*>(_buffer + offset)) Derived(std::forward<Args>(args)...);
+      const std::size_t baseOffset = offset + static_cast<std::size_t>(
+        reinterpret_cast<std::byte*>(static_cast<Base*>(object)) - reinterpret_cast<std::byte*>(object)
+      );
+      _entries.push_back({ offset, baseOffset, &kOperations<Derived> });
+      _used = offset + sizeof(Derived);
+      return *object;
+    };
+
+    //! @brief destroy the last element; its bytes are reused by the next emplaceBack
+    void popBack() {
+      if(_entries.empty()) throw std::out_of_range("PolyVector::popBack: the sequence is empty.");
+      const Entry& entry = _entries.back();
+      entry.operations->destroy(_buffer + entry.offset);
+      _used = entry.offset;
+      _entries.pop_back();
+    };
+
+    //! @brief destroy every element, keeping the buffer for reuse
+    void clear() noexcept {
+      for(auto entry = _entries.rbegin(); entry != _entries.rend(); ++entry) entry->operations->destroy(_buffer + entry->offset);
+      _entries.clear();
+      _used = 0;
+    };
+
+    //! @brief make room for at least bytes of elements, moving any there are now
+    void reserveBytes(std::size_t bytes) {
+      if(bytes <= _capacity) return;
+      std::byte* buffer = static_cast<std::byte*>(::operator new(bytes, std::align_val_t { kAlignment }));
+      std::size_t transferred = 0;
+      try {
+        for(; transferred < _entries.size(); ++transferred) {
+          const Entry& entry = _entries[transferred];
+          entry.operations->transfer(buffer + entry.offset, _buffer + entry.offset);
+        }
+      } catch(...) {
+        while(transferred > 0) {
+          const Entry& entry = _entries[--transferred];
+          if(entry.operations->moves) {
+            entry.operations->destroy(_buffer + entry.offset);
+            entry.operations->transfer(_buffer + entry.offset, buffer + entry.offset);
+          }
+          entry.operations->destroy(buffer + entry.offset);
+        }
+        ::operator delete(buffer, std::align_val_t { kAlignment });
+        throw;
+      }
+      for(auto entry = _entries.rbegin(); entry != _entries.rend(); ++entry) entry->operations->destroy(_buffer + entry->offset);
+      release();
+      _buffer = buffer;
+      _capacity = bytes;
+    };
+
+    std::size_t size() const { return _entries.size(); };
+    bool empty() const { return _entries.empty(); };
+    //! @brief the bytes of buffer taken by elements and their alignment padding
+    std::size_t usedBytes() const { return _used; };
+    std::size_t capacityBytes() const { return _capacity; };
+
+    Base& operator[](std::size_t index) { return begin()[static_cast<std::ptrdiff_t>(index)]; };
+    const Base& operator[](std::size_t index) const { return begin()[static_cast<std::ptrdiff_t>(index)]; };
+
+    iterator begin() { return { _entries.data(), _buffer }; };
+    iterator end() { return { _entries.data() + _entries.size(), _buffer }; };
+    const_iterator begin() const { return { _entries.data(), _buffer }; };
+    const_iterator end() const { return { _entries.data() + _entries.size(), _buffer }; };
+
+  private:
+    static constexpr std::size_t alignUp(std::size_t offset, std::size_t alignment) {
+      return (offset + alignment - 1) & ~(alignment - 1);
+    };
+
+    void release() noexcept {
+      if(_buffer != nullptr) ::operator delete(_buffer, std::align_val_t { kAlignment });
+      _buffer = nullptr;
+      _capacity = 0;
+    };
+
+    std::vector<Entry> _entries {};
+    std::byte* _buffer { nullptr };
+    std::size_t _capacity { 0 };
+    std::size_t _used { 0 };
+};
+
+}
+
+#endif
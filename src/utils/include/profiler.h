@@ -0,0 +1,282 @@
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace vodden::profiler {
+
+enum class Counter : uint8_t {
+  kDrawCalls,
+  kTextureBinds,
+  kEventsDispatched,
+  kAllocations,
+  //! @brief render state changes skipped because the state was already set
+  kRedundantStateCalls,
+  kCount
+};
+
+static constexpr std::size_t kCounterCount = static_cast<std::size_t>(Counter::kCount);
+
+//! @brief the counters accumulated over one frame
+struct FrameSummary {
+  uint64_t frame;
+  std::chrono::nanoseconds duration;
+  std::array<uint64_t, kCounterCount> counters;
+
+  uint64_t operator[](Counter counter) const { return counters[static_cast<std::size_t>(counter)]; };
+};
+
+/**
+ * @brief how long inputs took to reach the screen, in one millisecond buckets.
+ *
+ * Bucket i counts latencies of at least i and under i + 1 milliseconds; the
+ * last bucket also counts everything longer.
+ */
+struct LatencyHistogram {
+  static constexpr std::size_t kBucketCount = 100;
+
+  std::array<uint64_t, kBucketCount> buckets {};
+  uint64_t count { 0 };
+
+  void record(std::chrono::nanoseconds latency) {
+    const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(latency).count();
+    ++buckets[static_cast<std::size_t>(std::clamp<int64_t>(milliseconds, 0, static_cast<int64_t>(kBucketCount) - 1))];
+    ++count;
+  }
+
+  //! @brief the upper edge of the bucket holding the latency which fraction of inputs took no longer than
+  std::chrono::milliseconds getPercentile(double fraction) const {
+    if(count == 0) return std::chrono::milliseconds { 0 };
+    const auto rank = static_cast<uint64_t>(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(count - 1)) + 1;
+    uint64_t seen = 0;
+    std::size_t bucket = 0;
+    while((seen += buckets[bucket]) < rank) ++bucket;
+    return std::chrono::milliseconds { static_cast<int64_t>(bucket) + 1 };
+  }
+};
+
+/**
+ * @brief Process-wide counters, frame summaries and an optional zone trace.
+ *
+ * Normally used through the VODDEN_PROFILE_* macros below, which compile to
+ * nothing unless VODDEN_PROFILE is defined (the VODDEN_PROFILE CMake option).
+ *
+ * Counters are relaxed atomics, so counting from any thread is cheap. Zones
+ * are only recorded while a trace is running, and can then be written out in
+ * the Chrome trace event format, which chrome://tracing and Perfetto load.
+ *
+ * Inputs marked with recordInput belong to the frame being built, and the
+ * next recordPresent adds each one's input to present latency to the input
+ * latency histogram. Both take times on whatever single timeline the caller
+ * keeps, such as sdl::getPerformanceTime(). Inputs still waiting when a
+ * frame ends without a present are dropped, and past kMaxPendingInputs in a
+ * frame the rest are ignored, so dispatching with nothing presented, as a
+ * headless tool does, can't grow them without bound.
+ */
+class Profiler {
+  public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::function<void(const FrameSummary&)> FrameCallback;
+
+    static constexpr std::size_t kHistorySize = 120;
+    //! @brief the most inputs waiting for a present at once
+    static constexpr std::size_t kMaxPendingInputs = 1024;
+
+    static Profiler& instance() {
+      static Profiler profiler;
+      return profiler;
+    }
+
+    void increment(Counter counter, uint64_t amount = 1) {
+      _counters[static_cast<std::size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    //! @brief close the current frame, summarising and resetting the counters
+    void endFrame() {
+      const auto now = Clock::now();
+      std::scoped_lock lock { _mutex };
+
+      FrameSummary summary { _frame++, now - _frameStart, {} };
+      for(std::size_t i = 0; i < kCounterCount; ++i) summary.counters[i] = _counters[i].exchange(0, std::memory_order_relaxed);
+      _frameStart = now;
+      // a present comes before the frame's end, so any input still waiting was never presented
+      _pendingInputs.clear();
+
+      if(_history.size() == kHistorySize) _history.pop_front();
+      _history.push_back(summary);
+      if(_tracing.load(std::memory_order_relaxed)) _traceFrames.push_back({ toMicroseconds(now), summary });
+      if(_frameCallback) _frameCallback(summary);
+    }
+
+    //! @brief tag an input, which happened at inputTime, as affecting the current frame; zero means unknown and is ignored
+    void recordInput(std::chrono::nanoseconds inputTime) {
+      if(inputTime == std::chrono::nanoseconds::zero()) return;
+      std::scoped_lock lock { _mutex };
+      if(_pendingInputs.size() < kMaxPendingInputs) _pendingInputs.push_back(inputTime);
+    }
+
+    //! @brief the current frame reached the screen at presentTime, on the timeline of recordInput
+    void recordPresent(std::chrono::nanoseconds presentTime) {
+      std::scoped_lock lock { _mutex };
+      for(const auto inputTime : _pendingInputs) _inputLatency.record(presentTime - inputTime);
+      _pendingInputs.clear();
+    }
+
+    //! @brief the latency of every input presented since the last resetInputLatency
+    LatencyHistogram getInputLatency() const {
+      std::scoped_lock lock { _mutex };
+      return _inputLatency;
+    }
+
+    void resetInputLatency() {
+      std::scoped_lock lock { _mutex };
+      _inputLatency = {};
+    }
+
+    //! @brief the most recent frame summaries, oldest first
+    std::vector<FrameSummary> getHistory() const {
+      std::scoped_lock lock { _mutex };
+      return { _history.cbegin(), _history.cend() };
+    }
+
+    //! @brief called with each frame's summary as it closes, on the thread closing it
+    void setFrameCallback(FrameCallback frameCallback) {
+      std::scoped_lock lock { _mutex };
+      _frameCallback = std::move(frameCallback);
+    }
+
+    //! @brief discard any previous trace and start recording zones
+    void startTrace() {
+      std::scoped_lock lock { _mutex };
+      _traceZones.clear();
+      _traceFrames.clear();
+      _tracing.store(true, std::memory_order_relaxed);
+    }
+
+    void stopTrace() {
+      _tracing.store(false, std::memory_order_relaxed);
+    }
+
+    bool isTracing() const { return _tracing.load(std::memory_order_relaxed); };
+
+    void recordZone(const char* name, Clock::time_point start, Clock::time_point end) {
+      std::scoped_lock lock { _mutex };
+      _traceZones.push_back({ name, getThreadIndex(), toMicroseconds(start), toMicroseconds(end) - toMicroseconds(start) });
+    }
+
+    //! @brief write the recorded zones, and the counters of each traced frame, as a Chrome trace
+    void writeChromeTrace(std::ostream& output) const {
+      static constexpr const char* kCounterNames[kCounterCount] = { "draw calls", "texture binds", "events dispatched", "allocations", "redundant state calls" };
+
+      std::scoped_lock lock { _mutex };
+      output << "{\"traceEvents\":[";
+      const char* separator = "";
+      for(const auto& zone : _traceZones) {
+        output << separator << "{\"name\":\"" << zone.name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << zone.thread
+          << ",\"ts\":" << zone.start << ",\"dur\":" << zone.duration << "}";
+        separator = ",";
+      }
+      for(const auto& frame : _traceFrames) {
+        output << separator << "{\"name\":\"frame\",\"ph\":\"C\",\"pid\":0,\"ts\":" << frame.timestamp << ",\"args\":{";
+        for(std::size_t i = 0; i < kCounterCount; ++i) {
+          output << (i == 0 ? "" : ",") << "\"" << kCounterNames[i] << "\":" << frame.summary.counters[i];
+        }
+        output << "}}";
+        separator = ",";
+      }
+      output << "]}";
+    }
+
+  private:
+    struct TraceZone {
+      const char* name;
+      std::size_t thread;
+      int64_t start;
+      int64_t duration;
+    };
+
+    struct TraceFrame {
+      int64_t timestamp;
+      FrameSummary summary;
+    };
+
+    Profiler() = default;
+
+    int64_t toMicroseconds(Clock::time_point timePoint) const {
+      return std::chrono::duration_cast<std::chrono::microseconds>(timePoint - _epoch).count();
+    }
+
+    //! @brief a small, stable number for the calling thread, for the trace's thread lanes
+    static std::size_t getThreadIndex() {
+      static std::atomic<std::size_t> nextThreadIndex { 0 };
+      thread_local const std::size_t threadIndex = nextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+      return threadIndex;
+    }
+
+    std::array<std::atomic<uint64_t>, kCounterCount> _counters {};
+    std::atomic<bool> _tracing { false };
+
+    mutable std::mutex _mutex;
+    const Clock::time_point _epoch { Clock::now() };
+    Clock::time_point _frameStart { _epoch };
+    uint64_t _frame { 0 };
+    std::deque<FrameSummary> _history;
+    FrameCallback _frameCallback;
+    std::vector<TraceZone> _traceZones;
+    std::vector<TraceFrame> _traceFrames;
+    // the input times of the frame being built, cleared, keeping their capacity, at each present and frame end
+    std::vector<std::chrono::nanoseconds> _pendingInputs;
+    LatencyHistogram _inputLatency;
+};
+
+//! @brief records the time between its construction and destruction as a trace zone
+class ScopedZone {
+  public:
+    explicit ScopedZone(const char* name) : _name { name } {
+      if(Profiler::instance().isTracing()) _start = Profiler::Clock::now();
+    }
+    ScopedZone(const ScopedZone&) = delete;
+    ~ScopedZone() {
+      if(_start != Profiler::Clock::time_point {}) Profiler::instance().recordZone(_name, _start, Profiler::Clock::now());
+    }
+
+    ScopedZone& operator=(const ScopedZone&) = delete;
+
+  private:
+    const char* _name;
+    Profiler::Clock::time_point _start {};
+};
+
+}
+
+#define VODDEN_PROFILE_CONCATENATE_(a, b) a##b
+#define VODDEN_PROFILE_CONCATENATE(a, b) VODDEN_PROFILE_CONCATENATE_(a, b)
+
+#ifdef VODDEN_PROFILE
+  //! @brief time the rest of the enclosing scope; name must be a string literal
+  #define VODDEN_PROFILE_ZONE(name) const ::vodden::profiler::ScopedZone VODDEN_PROFILE_CONCATENATE(_profileZone, __LINE__) { name }
+  //! @brief add amount to one of the vodden::profiler::Counter values, e.g. VODDEN_PROFILE_COUNT(kDrawCalls, 1)
+  #define VODDEN_PROFILE_COUNT(counter, amount) ::vodden::profiler::Profiler::instance().increment(::vodden::profiler::Counter::counter, amount)
+  #define VODDEN_PROFILE_END_FRAME() ::vodden::profiler::Profiler::instance().endFrame()
+  //! @brief tag an input as affecting the current frame, see Profiler::recordInput
+  #define VODDEN_PROFILE_INPUT(inputTime) ::vodden::profiler::Profiler::instance().recordInput(inputTime)
+  #define VODDEN_PROFILE_PRESENT(presentTime) ::vodden::profiler::Profiler::instance().recordPresent(presentTime)
+#else
+  #define VODDEN_PROFILE_ZONE(name) ((void)0)
+  #define VODDEN_PROFILE_COUNT(counter, amount) ((void)0)
+  #define VODDEN_PROFILE_END_FRAME() ((void)0)
+  #define VODDEN_PROFILE_INPUT(inputTime) ((void)0)
+  #define VODDEN_PROFILE_PRESENT(presentTime) ((void)0)
+#endif
+
+#endif
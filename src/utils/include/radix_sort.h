@@ -0,0 +1,49 @@
+#ifndef __RADIX_SORT_H__
+#define __RADIX_SORT_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace vodden {
+
+/**
+ * @brief stably sort values by key(value), a uint64_t, with a least significant digit radix sort.
+ *
+ * One counting pass builds the histograms for all eight bytes of the key,
+ * then each byte in which the keys differ costs one scatter into scratch;
+ * bytes every key shares are skipped, so keys which only use their low bits
+ * sort in as few passes as they need. Values with equal keys keep their
+ * order. scratch is resized to match and swapped with values, so passing
+ * the same vectors every time reuses their storage.
+ */
+template <class T, class KeyFunction>
+void radixSort(std::vector<T>& values, std::vector<T>& scratch, KeyFunction key) {
+  if(values.size() < 2) return;
+
+  constexpr std::size_t kPasses = sizeof(uint64_t);
+  std::array<std::array<std::size_t, 256>, kPasses> counts {};
+  for(const T& value : values) {
+    const uint64_t valueKey = key(value);
+    for(std::size_t pass = 0; pass < kPasses; ++pass) ++counts[pass][(valueKey >> (pass * 8)) & 0xff];
+  }
+
+  scratch.resize(values.size());
+  const uint64_t firstKey = key(values.front());
+  for(std::size_t pass = 0; pass < kPasses; ++pass) {
+    const std::size_t shift = pass * 8;
+    auto& offsets = counts[pass];
+    if(offsets[(firstKey >> shift) & 0xff] == values.size()) continue;
+
+    std::size_t offset = 0;
+    for(std::size_t& count : offsets) offset += std::exchange(count, offset);
+    for(T& value : values) scratch[offsets[(key(value) >> shift) & 0xff]++] = std::move(value);
+    values.swap(scratch);
+  }
+}
+
+}
+
+#endif
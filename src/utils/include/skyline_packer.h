@@ -0,0 +1,117 @@
+#ifndef __SKYLINE_PACKER_H__
+#define __SKYLINE_PACKER_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace vodden {
+
+/**
+ * @brief Packs rectangles into a fixed size bin using the skyline bottom-left heuristic.
+ *
+ * The packer tracks the upper edge of everything placed so far as a list of
+ * horizontal segments. Each rectangle goes wherever its top edge ends up
+ * lowest, so feeding rectangles tallest first gives a tight packing.
+ */
+class SkylinePacker {
+  public:
+    struct Position {
+      uint32_t x;
+      uint32_t y;
+    };
+
+    SkylinePacker(uint32_t width, uint32_t height) : _width { width }, _height { height }, _skyline { { 0, 0, width } } {};
+
+    //! @brief reserve a width by height region, or std::nullopt if it no longer fits
+    std::optional<Position> insert(uint32_t width, uint32_t height) {
+      std::size_t bestIndex = _skyline.size();
+      uint32_t bestTop = std::numeric_limits<uint32_t>::max();
+      uint32_t bestSegmentWidth = std::numeric_limits<uint32_t>::max();
+      uint32_t bestY = 0;
+
+      for(std::size_t i = 0; i < _skyline.size(); ++i) {
+        const auto y = fit(i, width, height);
+        if(!y) continue;
+        const uint32_t top = *y + height;
+        if(top < bestTop || (top == bestTop && _skyline[i].width < bestSegmentWidth)) {
+          bestIndex = i;
+          bestTop = top;
+          bestSegmentWidth = _skyline[i].width;
+          bestY = *y;
+        }
+      }
+      if(bestIndex == _skyline.size()) return std::nullopt;
+
+      const Position position { _skyline[bestIndex].x, bestY };
+      place(bestIndex, position, width, height);
+      return position;
+    }
+
+    //! @brief the lowest height which contains every rectangle placed so far
+    uint32_t getUsedHeight() const { return _usedHeight; };
+
+    uint32_t getWidth() const { return _width; };
+    uint32_t getHeight() const { return _height; };
+
+  private:
+    struct Segment {
+      uint32_t x;
+      uint32_t y;
+      uint32_t width;
+    };
+
+    //! @brief the y at which a rectangle starting at segment index would rest, if it fits
+    std::optional<uint32_t> fit(std::size_t index, uint32_t width, uint32_t height) const {
+      if(_skyline[index].x + width > _width) return std::nullopt;
+
+      uint32_t y = 0;
+      uint32_t remaining = width;
+      for(std::size_t i = index; remaining > 0; ++i) {
+        y = std::max(y, _skyline[i].y);
+        if(y + height > _height) return std::nullopt;
+        remaining -= std::min(remaining, _skyline[i].width);
+      }
+      return y;
+    }
+
+    void place(std::size_t index, Position position, uint32_t width, uint32_t height) {
+      _skyline.insert(_skyline.begin() + index, Segment { position.x, position.y + height, width });
+
+      // trim or remove the segments now hidden beneath the new one
+      const uint32_t right = position.x + width;
+      for(std::size_t i = index + 1; i < _skyline.size();) {
+        Segment& segment = _skyline[i];
+        if(segment.x >= right) break;
+        const uint32_t overlap = right - segment.x;
+        if(overlap < segment.width) {
+          segment.x += overlap;
+          segment.width -= overlap;
+          break;
+        }
+        _skyline.erase(_skyline.begin() + i);
+      }
+
+      for(std::size_t i = 0; i + 1 < _skyline.size();) {
+        if(_skyline[i].y == _skyline[i + 1].y) {
+          _skyline[i].width += _skyline[i + 1].width;
+          _skyline.erase(_skyline.begin() + i + 1);
+        } else {
+          ++i;
+        }
+      }
+
+      _usedHeight = std::max(_usedHeight, position.y + height);
+    }
+
+    uint32_t _width;
+    uint32_t _height;
+    uint32_t _usedHeight { 0 };
+    std::vector<Segment> _skyline;
+};
+
+}
+
+#endif
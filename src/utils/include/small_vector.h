@@ -0,0 +1,175 @@
+#ifndef __SMALL_VECTOR_H__
+#define __SMALL_VECTOR_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace vodden {
+
+/**
+ * @brief A vector which keeps its first N elements inside itself.
+ *
+ * Up to N elements cost no allocation at all; past that the elements move
+ * to the heap and grow as std::vector's do. Elements are contiguous either
+ * way, and references to them are invalidated by growth and by moving the
+ * SmallVector, since inline elements move with it.
+ */
+template <class T, std::size_t N>
+class SmallVector {
+  static_assert(N > 0, "SmallVector: N must be at least 1.");
+
+  public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    SmallVector() = default;
+
+    SmallVector(std::initializer_list<T> values) {
+      reserve(values.size());
+      for(const T& value : values) push_back(value);
+    };
+
+    SmallVector(const SmallVector& other) {
+      reserve(other._size);
+      for(const T& value : other) push_back(value);
+    };
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+      takeFrom(other);
+    };
+
+    ~SmallVector() {
+      clear();
+      release();
+    };
+
+    SmallVector& operator=(const SmallVector& other) {
+      if(this != &other) {
+        SmallVector copy { other };
+        *this = std::move(copy);
+      }
+      return *this;
+    };
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+      if(this != &other) {
+        clear();
+        release();
+        takeFrom(other);
+      }
+      return *this;
+    };
+
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
+      if(_size == _capacity) {
+        // constructed before the move, as args may refer to an element
+        T value(std::forward<Args>(args)...);
+        grow(_capacity * 2);
+        return *::new (static_cast<void*>(_data + _size++)) T(std::move(value));
+      }
+      return *::new (static_cast<void*>(_data + _size++)) T(std::forward<Args>(args)...);
+    };
+
+    void push_back(const T& value) { emplace_back(value); };
+    void push_back(T&& value) { emplace_back(std::move(value)); };
+
+    void pop_back() {
+      if(_size == 0) throw std::out_of_range("SmallVector::pop_back: the vector is empty.");
+      std::destroy_at(_data + --_size);
+    };
+
+    //! @brief remove the element at index by moving the last element into its place
+    void swapAndPop(std::size_t index) {
+      if(index >= _size) throw std::out_of_range("SmallVector::swapAndPop: index out of range.");
+      if(index != _size - 1) _data[index] = std::move(_data[_size - 1]);
+      std::destroy_at(_data + --_size);
+    };
+
+    void clear() noexcept {
+      std::destroy(_data, _data + _size);
+      _size = 0;
+    };
+
+    void reserve(std::size_t capacity) {
+      if(capacity > _capacity) grow(capacity);
+    };
+
+    std::size_t size() const { return _size; };
+    std::size_t capacity() const { return _capacity; };
+    bool empty() const { return _size == 0; };
+    //! @brief true while the elements are stored inside the SmallVector
+    bool isInline() const { return _data == inlineData(); };
+
+    T& operator[](std::size_t index) { return _data[index]; };
+    const T& operator[](std::size_t index) const { return _data[index]; };
+    T& back() { return _data[_size - 1]; };
+    const T& back() const { return _data[_size - 1]; };
+    T* data() { return _data; };
+    const T* data() const { return _data; };
+
+    iterator begin() { return _data; };
+    iterator end() { return _data + _size; };
+    const_iterator begin() const { return _data; };
+    const_iterator end() const { return _data + _size; };
+
+  private:
+    T* inlineData() { return std::launder(reinterpret_cast<T*>(_storage)); };
+    const T* inlineData() const { return std::launder(reinterpret_cast<const T*>(_storage)); };
+
+    void grow(std::size_t capacity) {
+      capacity = std::max<std::size_t>(capacity, 1);
+      T* data = static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t { alignof(T) }));
+      try {
+        // copied, as std::vector does, if a throwing move could leave elements half moved
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+          std::uninitialized_move_n(_data, _size, data);
+        } else {
+          std::uninitialized_copy_n(_data, _size, data);
+        }
+      } catch(...) {
+        ::operator delete(data, std::align_val_t { alignof(T) });
+        throw;
+      }
+      std::destroy(_data, _data + _size);
+      release();
+      _data = data;
+      _capacity = capacity;
+    };
+
+    //! @brief free the heap buffer, if there is one, leaving the inline storage in use
+    void release() noexcept {
+      if(!isInline()) ::operator delete(_data, std::align_val_t { alignof(T) });
+      _data = inlineData();
+      _capacity = N;
+    };
+
+    //! @brief take other's elements, leaving it empty; this must be empty and inline
+    void takeFrom(SmallVector& other) {
+      if(other.isInline()) {
+        std::uninitialized_move_n(other._data, other._size, _data);
+        _size = other._size;
+        other.clear();
+      } else {
+        _data = std::exchange(other._data, other.inlineData());
+        _size = std::exchange(other._size, 0);
+        _capacity = std::exchange(other._capacity, N);
+      }
+    };
+
+    alignas(T) std::byte _storage[N * sizeof(T)];
+    T* _data { inlineData() };
+    std::size_t _size { 0 };
+    std::size_t _capacity { N };
+};
+
+}
+
+#endif
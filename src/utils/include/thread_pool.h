@@ -0,0 +1,166 @@
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace vodden {
+
+/**
+ * @brief A fixed size, work-stealing pool of worker threads.
+ *
+ * Each worker owns a deque of tasks. Tasks submitted from a worker go to the
+ * back of its own deque and are run last-in first-out, which keeps related
+ * work hot in that worker's cache; tasks submitted from any other thread are
+ * spread round-robin. An idle worker steals from the front of the other
+ * workers' deques before going to sleep.
+ *
+ * Tasks must not throw. The destructor runs every task already submitted
+ * before joining the workers.
+ */
+class ThreadPool {
+  public:
+    typedef std::function<void()> Task;
+
+    explicit ThreadPool(std::size_t threadCount = defaultThreadCount()) {
+      threadCount = std::max<std::size_t>(threadCount, 1);
+      for(std::size_t i = 0; i < threadCount; ++i) _workers.push_back(std::make_unique<Worker>());
+      for(std::size_t i = 0; i < threadCount; ++i) _threads.emplace_back([this, i]() { workerLoop(i); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+
+    ~ThreadPool() {
+      {
+        std::scoped_lock lock { _sleepMutex };
+        _stopping = true;
+      }
+      _wake.notify_all();
+      for(auto& thread : _threads) thread.join();
+    }
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    //! @brief queue a task to be run on one of the workers.
+    void submit(Task task) {
+      const std::size_t workerIndex = (_currentPool == this)
+        ? _currentWorkerIndex
+        : _nextWorker.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+      {
+        std::scoped_lock lock { _workers[workerIndex]->mutex };
+        _workers[workerIndex]->tasks.push_back(std::move(task));
+      }
+      {
+        std::scoped_lock lock { _sleepMutex };
+        ++_pending;
+        ++_unfinished;
+      }
+      _wake.notify_one();
+    }
+
+    //! @brief block until every submitted task, including those submitted by tasks, has finished.
+    void waitIdle() {
+      std::unique_lock lock { _sleepMutex };
+      _idle.wait(lock, [this]() { return _unfinished == 0; });
+    }
+
+    std::size_t size() const { return _workers.size(); }
+
+    //! @brief true when called from one of this pool's workers.
+    bool isWorkerThread() const { return _currentPool == this; }
+
+    static std::size_t defaultThreadCount() {
+      const std::size_t hardwareThreads = std::thread::hardware_concurrency();
+      return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    //! @brief the pool shared by the library's asynchronous facilities.
+    static ThreadPool& shared() {
+      static ThreadPool threadPool;
+      return threadPool;
+    }
+
+  private:
+    struct Worker {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+    };
+
+    std::optional<Task> takeTask(std::size_t workerIndex) {
+      {
+        Worker& own = *_workers[workerIndex];
+        std::scoped_lock lock { own.mutex };
+        if(!own.tasks.empty()) {
+          Task task = std::move(own.tasks.back());
+          own.tasks.pop_back();
+          return task;
+        }
+      }
+      for(std::size_t offset = 1; offset < _workers.size(); ++offset) {
+        Worker& victim = *_workers[(workerIndex + offset) % _workers.size()];
+        std::scoped_lock lock { victim.mutex };
+        if(!victim.tasks.empty()) {
+          Task task = std::move(victim.tasks.front());
+          victim.tasks.pop_front();
+          return task;
+        }
+      }
+      return std::nullopt;
+    }
+
+    void workerLoop(std::size_t workerIndex) {
+      _currentPool = this;
+      _currentWorkerIndex = workerIndex;
+      while(true) {
+        {
+          std::unique_lock lock { _sleepMutex };
+          _wake.wait(lock, [this]() { return _pending > 0 || _stopping; });
+          if(_pending == 0) return; // stopping, and nothing left to run
+          --_pending; // claim one of the queued tasks
+        }
+
+        // a claimed task is always queued somewhere, but may move between deques while we look
+        std::optional<Task> task;
+        while(!(task = takeTask(workerIndex))) std::this_thread::yield();
+        (*task)();
+
+        bool idle;
+        {
+          std::scoped_lock lock { _sleepMutex };
+          idle = (--_unfinished == 0);
+        }
+        if(idle) _idle.notify_all();
+      }
+    }
+
+    std::vector<std::unique_ptr<Worker>> _workers {};
+    std::vector<std::thread> _threads {};
+    std::atomic<std::size_t> _nextWorker { 0 };
+
+    std::mutex _sleepMutex {};
+    std::condition_variable _wake {};
+    std::condition_variable _idle {};
+    // tasks queued but not yet claimed by a worker
+    std::size_t _pending { 0 };
+    // tasks queued or running
+    std::size_t _unfinished { 0 };
+    bool _stopping { false };
+
+    inline static thread_local ThreadPool* _currentPool { nullptr };
+    inline static thread_local std::size_t _currentWorkerIndex { 0 };
+};
+
+}
+
+#endif
@@ -1,53 +1,106 @@
+#ifndef __THREAD_SAFE_QUEUE_H__
+#define __THREAD_SAFE_QUEUE_H__
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <utility>
+
+namespace vodden {
+
+/**
+ * @brief An unbounded multiple producer multiple consumer queue guarded by a mutex.
+ *
+ * The blocking counterpart to MpscQueue: use it where a consumer should sleep
+ * until work arrives, or where the number of items cannot be bounded.
+ */
 template <class ContainedType>
-class ThreadSafeQueue{
+class ThreadSafeQueue {
   public:
     ThreadSafeQueue() = default;
-    ThreadSafeQueue(const ThreadSafeQueue<T>&) = delete;
-    ThreadSafeQueue(ThreadSafeQueue<T> &&other) {
-      std::scoped_lock(_mutex);
-      std::scoped_lock(other.mutex_);
+    ThreadSafeQueue(const ThreadSafeQueue&) = delete;
+    ThreadSafeQueue(ThreadSafeQueue&& other) {
+      std::scoped_lock lock { other._mutex };
       _queue = std::move(other._queue);
+      _closed = other._closed;
     }
-    
+
     virtual ~ThreadSafeQueue() { };
 
-    ThreadSafeQueue &operator=(ThreadSafeQueue<T> &other) = delete;
-    ThreadSafeQueue &operator=(ThreadSafeQueue<T> &&other) {
-      std::scoped_lock(mutex_);
-      std::scoped_lock(other.mutex_);
+    ThreadSafeQueue& operator=(const ThreadSafeQueue&) = delete;
+    ThreadSafeQueue& operator=(ThreadSafeQueue&& other) {
+      if(this == &other) return *this;
+      std::scoped_lock lock { _mutex, other._mutex };
       _queue = std::move(other._queue);
+      _closed = other._closed;
+      return *this;
     }
 
     std::size_t size() const {
-      std::scoped_lock(_mutex);
-      return queue_.size();
+      std::scoped_lock lock { _mutex };
+      return _queue.size();
     }
 
-    void push(const ContainedType &&item) {
+    bool empty() const {
+      std::scoped_lock lock { _mutex };
+      return _queue.empty();
+    }
+
+    void push(ContainedType&& item) {
       {
-        std::scoped_lock(_mutex);
+        std::scoped_lock lock { _mutex };
         _queue.push(std::move(item));
       }
-      _conditionalVariable.notify_one();
+      _conditionVariable.notify_one();
+    }
+
+    void push(const ContainedType& item) {
+      ContainedType copy { item };
+      push(std::move(copy));
     }
 
-    ContainedType &&pop() {
-      ContainedType poppedThing;
+    /**
+     * @brief block until an item is available and remove it.
+     *
+     * @return the item, or std::nullopt once the queue has been closed and emptied.
+     */
+    std::optional<ContainedType> pop() {
+      std::unique_lock lock { _mutex };
+      _conditionVariable.wait(lock, [this]() { return !_queue.empty() || _closed; });
+      return popLocked();
+    }
+
+    //! @brief remove the item at the front of the queue, if there is one, without blocking.
+    std::optional<ContainedType> tryPop() {
+      std::scoped_lock lock { _mutex };
+      return popLocked();
+    }
+
+    //! @brief wake every blocked consumer; pop returns std::nullopt once the queue is empty.
+    void close() {
       {
-        std::scoped_lock(_mutex);
-        _conditionVariable.wait(lock, [this]() { return not this._queue.empty() });
-        poppedThing = std::move(_queue.front);
-        _queue.pop();
+        std::scoped_lock lock { _mutex };
+        _closed = true;
       }
-      return std::move(poppedThing);
+      _conditionVariable.notify_all();
     }
 
   private:
-    std::queue<ContainedType> _queue;
-    std::mutex _mutex;
-    std::conditionalVariable conditionalVariable
-
-    bool empty() const {
-        return _queue.empty();
+    std::optional<ContainedType> popLocked() {
+      if(_queue.empty()) return std::nullopt;
+      std::optional<ContainedType> popped { std::move(_queue.front()) };
+      _queue.pop();
+      return popped;
     }
+
+    std::queue<ContainedType> _queue {};
+    mutable std::mutex _mutex {};
+    std::condition_variable _conditionVariable {};
+    bool _closed { false };
 };
+
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef __UTF8_H__
+#define __UTF8_H__
+
+#include <cstddef>
+#include <string_view>
+
+namespace vodden {
+
+constexpr char32_t kReplacementCharacter = 0xfffd;
+
+/**
+ * @brief the code point starting at text[index], moving index past it.
+ *
+ * Malformed input decodes as U+FFFD: stray continuation bytes, truncated
+ * sequences, overlong encodings, UTF-16 surrogates and values past
+ * U+10FFFF. A sequence cut short by a byte which can't continue it stops
+ * before that byte, so it starts the next code point.
+ */
+constexpr char32_t decodeUtf8(std::string_view text, std::size_t& index) {
+  const auto lead = static_cast<unsigned char>(text[index++]);
+  if(lead < 0x80) return lead;
+
+  std::size_t length;
+  char32_t codePoint;
+  // the smallest code point each length may encode; anything below is overlong
+  char32_t smallest;
+  if((lead & 0xe0) == 0xc0) { length = 1; codePoint = lead & 0x1f; smallest = 0x80; }
+  else if((lead & 0xf0) == 0xe0) { length = 2; codePoint = lead & 0x0f; smallest = 0x800; }
+  else if((lead & 0xf8) == 0xf0) { length = 3; codePoint = lead & 0x07; smallest = 0x10000; }
+  else return kReplacementCharacter;
+
+  for(std::size_t i = 0; i < length; ++i) {
+    if(index == text.size() || (static_cast<unsigned char>(text[index]) & 0xc0) != 0x80) return kReplacementCharacter;
+    codePoint = codePoint << 6 | (static_cast<unsigned char>(text[index++]) & 0x3f);
+  }
+  if(codePoint < smallest || codePoint > 0x10ffff || (codePoint >= 0xd800 && codePoint <= 0xdfff)) return kReplacementCharacter;
+  return codePoint;
+}
+
+}
+
+#endif
@@ -1,6 +1,10 @@
 #ifndef VALUABLE_VALUE_PTR_HPP
 #define VALUABLE_VALUE_PTR_HPP
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 #ifdef _MSC_VER
 #define VALUABLE_DECLSPEC_EMPTY_BASES __declspec(empty_bases)
@@ -128,6 +132,155 @@ public:
   operator bool() const noexcept { return !!ptr(); }
   ~value_ptr() = default;
 };
+// A cloner which creates and destroys values through an allocator, for small_value_ptr
+template <typename T, class Allocator = std::allocator<T> >
+struct allocator_clone {
+  using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+  allocator_clone() = default;
+  allocator_clone(const Allocator &a) : allocator(a) {}
+
+  template <typename... Args>
+  T *create(Args &&...args) {
+    using traits = std::allocator_traits<allocator_type>;
+    T *p = traits::allocate(allocator, 1);
+    try {
+      traits::construct(allocator, p, std::forward<Args>(args)...);
+    } catch (...) {
+      traits::deallocate(allocator, p, 1);
+      throw;
+    }
+    return p;
+  }
+
+  void destroy(T *p) {
+    using traits = std::allocator_traits<allocator_type>;
+    traits::destroy(allocator, p);
+    traits::deallocate(allocator, p, 1);
+  }
+
+  allocator_type allocator;
+};
+
+// A value_ptr which keeps values of up to N bytes inline, so that copying one
+// is a copy of the value rather than an allocation. Larger values, and those
+// which could throw on a move, go through the cloner's create and destroy.
+//
+// Whether T is stored inline is only worked out where T is used, so this can
+// hold a pimpl's incomplete impl as long as the owner's special members are
+// defined where the impl is complete. Moving from one leaves it empty.
+template <class T, std::size_t N = 4 * sizeof(void *), class Cloner = allocator_clone<T> >
+class small_value_ptr {
+  static_assert(N >= sizeof(void *), "small_value_ptr: N must at least fit a pointer.");
+
+  T *ptr_ = nullptr;
+  alignas(std::max_align_t) std::byte storage_[N];
+  [[no_unique_address]] Cloner cloner_;
+
+  template <typename... Args>
+  void construct(Args &&...args) {
+    if constexpr (stores_inline()) {
+      ptr_ = ::new (static_cast<void *>(storage_)) T(std::forward<Args>(args)...);
+    } else {
+      ptr_ = cloner_.create(std::forward<Args>(args)...);
+    }
+  }
+
+public:
+  using pointer = T*;
+  using element_type = T;
+  using cloner_type = Cloner;
+
+  // true when values live in the pointer itself rather than on the heap
+  static constexpr bool stores_inline() {
+    return sizeof(T) <= N && alignof(T) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<T>;
+  }
+
+  small_value_ptr() = default;
+  explicit small_value_ptr(const Cloner &cloner) : cloner_(cloner) {}
+
+  small_value_ptr(const T &value) { construct(value); }
+  small_value_ptr(T &&value) { construct(std::move(value)); }
+
+  template <typename... Args>
+  explicit small_value_ptr(std::in_place_t, Args &&...args) { construct(std::forward<Args>(args)...); }
+
+  small_value_ptr(small_value_ptr const &v) : cloner_(v.cloner_) {
+    if (v) construct(*v);
+  }
+
+  small_value_ptr(small_value_ptr &&v) noexcept : cloner_(std::move(v.cloner_)) {
+    if constexpr (stores_inline()) {
+      if (v) {
+        construct(std::move(*v));
+        v.reset();
+      }
+    } else {
+      ptr_ = std::exchange(v.ptr_, nullptr);
+    }
+  }
+
+  small_value_ptr &operator=(small_value_ptr const &v) {
+    if (this == &v) return *this;
+    if (ptr_ && v) {
+      *ptr_ = *v;
+    } else {
+      reset();
+      cloner_ = v.cloner_;
+      if (v) construct(*v);
+    }
+    return *this;
+  }
+
+  small_value_ptr &operator=(small_value_ptr &&v) noexcept {
+    if (this == &v) return *this;
+    reset();
+    cloner_ = std::move(v.cloner_);
+    if constexpr (stores_inline()) {
+      if (v) {
+        construct(std::move(*v));
+        v.reset();
+      }
+    } else {
+      ptr_ = std::exchange(v.ptr_, nullptr);
+    }
+    return *this;
+  }
+
+  ~small_value_ptr() { reset(); }
+
+  // replace the value with one constructed from args
+  template <typename... Args>
+  T &emplace(Args &&...args) {
+    reset();
+    construct(std::forward<Args>(args)...);
+    return *ptr_;
+  }
+
+  void reset() noexcept {
+    if (!ptr_) return;
+    if constexpr (stores_inline()) {
+      ptr_->~T();
+    } else {
+      cloner_.destroy(ptr_);
+    }
+    ptr_ = nullptr;
+  }
+
+  T *get() noexcept { return ptr_; }
+  T const *get() const noexcept { return ptr_; }
+
+  Cloner &get_cloner() noexcept { return cloner_; }
+  Cloner const &get_cloner() const noexcept { return cloner_; }
+
+  T &operator*() { return *ptr_; }
+  T const &operator*() const { return *ptr_; }
+
+  T const *operator->() const noexcept { return ptr_; }
+  T *operator->() noexcept { return ptr_; }
+
+  operator bool() const noexcept { return ptr_ != nullptr; }
+};
 }
 
 #undef VALUABLE_DECLSPEC_EMPTY_BASES
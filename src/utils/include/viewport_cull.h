@@ -0,0 +1,121 @@
+#ifndef __VIEWPORT_CULL_H__
+#define __VIEWPORT_CULL_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace vodden {
+
+//! @brief an axis aligned region, with right and bottom exclusive
+struct CullBounds {
+  float left;
+  float top;
+  float right;
+  float bottom;
+};
+
+namespace detail {
+  //! @brief culls [begin, end) one rectangle at a time, appending to visible from count
+  inline std::size_t cullRectanglesScalar(
+    const float* x, const float* y, const float* width, const float* height,
+    std::size_t begin, std::size_t end, const CullBounds& bounds, uint32_t* visible, std::size_t count
+  ) {
+    for(std::size_t i = begin; i < end; ++i) {
+      // written unconditionally and kept only if inside, so there is no branch to mispredict
+      visible[count] = static_cast<uint32_t>(i);
+      count += (x[i] < bounds.right) & (x[i] + width[i] > bounds.left) & (y[i] < bounds.bottom) & (y[i] + height[i] > bounds.top);
+    }
+    return count;
+  }
+
+  //! @brief append the lanes of base set in mask, lowest first
+  inline std::size_t compact(uint32_t mask, std::size_t lanes, std::size_t base, uint32_t* visible, std::size_t count) {
+    for(std::size_t lane = 0; lane < lanes; ++lane) {
+      visible[count] = static_cast<uint32_t>(base + lane);
+      count += (mask >> lane) & 1u;
+    }
+    return count;
+  }
+}
+
+/**
+ * @brief write the index of every rectangle overlapping bounds to the front of visible.
+ *
+ * The rectangles are given as parallel arrays, which are tested several at a
+ * time with AVX2, SSE2 or AArch64 NEON, whichever the build targets, or one at a time
+ * otherwise. Indices are written in increasing order. visible must have room
+ * for every rectangle, as each index is written before it is known to be kept.
+ *
+ * @return the number of indices written.
+ */
+inline std::size_t cullRectangles(
+  std::span<const float> x, std::span<const float> y, std::span<const float> width, std::span<const float> height,
+  const CullBounds& bounds, std::span<uint32_t> visible
+) {
+  const std::size_t size = x.size();
+  if(y.size() != size || width.size() != size || height.size() != size) throw std::invalid_argument("cullRectangles: arrays differ in size.");
+  if(visible.size() < size) throw std::invalid_argument("cullRectangles: visible is smaller than the arrays.");
+
+  std::size_t i = 0;
+  std::size_t count = 0;
+#if defined(__AVX2__)
+  const __m256 left = _mm256_set1_ps(bounds.left);
+  const __m256 top = _mm256_set1_ps(bounds.top);
+  const __m256 right = _mm256_set1_ps(bounds.right);
+  const __m256 bottom = _mm256_set1_ps(bounds.bottom);
+  for(; i + 8 <= size; i += 8) {
+    const __m256 x8 = _mm256_loadu_ps(x.data() + i);
+    const __m256 y8 = _mm256_loadu_ps(y.data() + i);
+    const __m256 inside = _mm256_and_ps(
+      _mm256_and_ps(_mm256_cmp_ps(x8, right, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_add_ps(x8, _mm256_loadu_ps(width.data() + i)), left, _CMP_GT_OQ)),
+      _mm256_and_ps(_mm256_cmp_ps(y8, bottom, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_add_ps(y8, _mm256_loadu_ps(height.data() + i)), top, _CMP_GT_OQ))
+    );
+    count = detail::compact(static_cast<uint32_t>(_mm256_movemask_ps(inside)), 8, i, visible.data(), count);
+  }
+#elif defined(__SSE2__) || defined(_M_X64)
+  const __m128 left = _mm_set1_ps(bounds.left);
+  const __m128 top = _mm_set1_ps(bounds.top);
+  const __m128 right = _mm_set1_ps(bounds.right);
+  const __m128 bottom = _mm_set1_ps(bounds.bottom);
+  for(; i + 4 <= size; i += 4) {
+    const __m128 x4 = _mm_loadu_ps(x.data() + i);
+    const __m128 y4 = _mm_loadu_ps(y.data() + i);
+    const __m128 inside = _mm_and_ps(
+      _mm_and_ps(_mm_cmplt_ps(x4, right), _mm_cmpgt_ps(_mm_add_ps(x4, _mm_loadu_ps(width.data() + i)), left)),
+      _mm_and_ps(_mm_cmplt_ps(y4, bottom), _mm_cmpgt_ps(_mm_add_ps(y4, _mm_loadu_ps(height.data() + i)), top))
+    );
+    count = detail::compact(static_cast<uint32_t>(_mm_movemask_ps(inside)), 4, i, visible.data(), count);
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const float32x4_t left = vdupq_n_f32(bounds.left);
+  const float32x4_t top = vdupq_n_f32(bounds.top);
+  const float32x4_t right = vdupq_n_f32(bounds.right);
+  const float32x4_t bottom = vdupq_n_f32(bounds.bottom);
+  // NEON has no movemask, so each lane contributes its own bit
+  const uint32x4_t laneBits = { 1u, 2u, 4u, 8u };
+  for(; i + 4 <= size; i += 4) {
+    const float32x4_t x4 = vld1q_f32(x.data() + i);
+    const float32x4_t y4 = vld1q_f32(y.data() + i);
+    const uint32x4_t inside = vandq_u32(
+      vandq_u32(vcltq_f32(x4, right), vcgtq_f32(vaddq_f32(x4, vld1q_f32(width.data() + i)), left)),
+      vandq_u32(vcltq_f32(y4, bottom), vcgtq_f32(vaddq_f32(y4, vld1q_f32(height.data() + i)), top))
+    );
+    count = detail::compact(vaddvq_u32(vandq_u32(inside, laneBits)), 4, i, visible.data(), count);
+  }
+#endif
+  return detail::cullRectanglesScalar(x.data(), y.data(), width.data(), height.data(), i, size, bounds, visible.data(), count);
+}
+
+}
+
+#endif
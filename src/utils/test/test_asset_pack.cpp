@@ -0,0 +1,105 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <asset_pack.h>
+#include <gtest/gtest.h>
+
+using namespace vodden;
+
+namespace {
+
+std::vector<std::byte> toBytes(const std::string& text) {
+  std::vector<std::byte> bytes;
+  for(const char character : text) bytes.push_back(static_cast<std::byte>(character));
+  return bytes;
+}
+
+std::string writePack(const std::vector<std::pair<std::string, std::vector<std::byte>>>& assets) {
+  AssetPackWriter writer;
+  for(const auto& [name, data] : assets) writer.add(name, data);
+  std::ostringstream output;
+  writer.write(output);
+  return output.str();
+}
+
+//! @brief a copy of a pack starting offset bytes past a kBlobAlignment boundary, as a mapping or the data target's would with none
+class AlignedCopy {
+  public:
+    explicit AlignedCopy(const std::string& packed, std::size_t offset = 0) :
+      _blocks((offset + packed.size()) / AssetPack::kBlobAlignment + 1), _offset { offset }, _size { packed.size() } {
+      std::memcpy(bytes().data(), packed.data(), packed.size());
+    }
+
+    std::span<std::byte> bytes() { return { reinterpret_cast<std::byte*>(_blocks.data()) + _offset, _size }; }
+
+  private:
+    struct alignas(AssetPack::kBlobAlignment) Block {
+      std::byte bytes[AssetPack::kBlobAlignment];
+    };
+
+    std::vector<Block> _blocks;
+    std::size_t _offset;
+    std::size_t _size;
+};
+
+}
+
+TEST(AssetPack, findsAlignedAssetsByName) {
+  AlignedCopy packed { writePack({ { "first.png", toBytes("one") }, { "second.dat", toBytes("second") }, { "empty", {} } }) };
+  const AssetPack pack { packed.bytes() };
+
+  ASSERT_EQ(pack.size(), 3u);
+  const auto second = pack.find("second.dat");
+  ASSERT_TRUE(second.has_value());
+  ASSERT_EQ(std::string(reinterpret_cast<const char*>(second->data()), second->size()), "second");
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(second->data()) % AssetPack::kBlobAlignment, 0u);
+  ASSERT_EQ(pack.at("empty").size(), 0u);
+  ASSERT_FALSE(pack.find("missing").has_value());
+  ASSERT_THROW(pack.at("missing"), std::out_of_range);
+}
+
+TEST(AssetPack, rejectsMalformedPacks) {
+  AlignedCopy packed { writePack({ { "asset", toBytes("data") } }) };
+  ASSERT_THROW(AssetPack { packed.bytes().first(8) }, std::invalid_argument);
+  packed.bytes()[0] = std::byte { 'X' };
+  ASSERT_THROW(AssetPack { packed.bytes() }, std::invalid_argument);
+}
+
+TEST(AssetPack, rejectsMisalignedPacks) {
+  const std::string packed = writePack({ { "asset", toBytes("data") } });
+  AlignedCopy aligned { packed };
+  AlignedCopy misaligned { packed, 1 };
+  ASSERT_NO_THROW(AssetPack { aligned.bytes() });
+  ASSERT_THROW(AssetPack { misaligned.bytes() }, std::invalid_argument);
+}
+
+TEST(AssetPack, writesLittleEndianWhateverTheHost) {
+  const std::string packed = writePack({ { "asset", toBytes("data") } });
+  // the magic, then an entry count of one
+  ASSERT_EQ(packed.substr(0, 4), "VPK1");
+  ASSERT_EQ(packed.substr(8, 4), std::string("\x01\x00\x00\x00", 4));
+  // the entry's size, after its hash and offset
+  ASSERT_EQ(packed.substr(AssetPackHeader::kSize + 16, 8), std::string("\x04\0\0\0\0\0\0\0", 8));
+}
+
+TEST(AssetPack, mapsPackFiles) {
+  const auto filePath = std::filesystem::temp_directory_path() / "vodden_test.pack";
+  {
+    std::ofstream file { filePath, std::ios::binary };
+    file << writePack({ { "asset", toBytes("mapped") } });
+  }
+
+  AssetPack mapped { filePath };
+  AssetPack pack { std::move(mapped) };
+  const auto asset = pack.at("asset");
+  ASSERT_EQ(std::string(reinterpret_cast<const char*>(asset.data()), asset.size()), "mapped");
+  ASSERT_EQ(mapped.size(), 0u);
+  std::filesystem::remove(filePath);
+}
@@ -0,0 +1,53 @@
+#include <stdexcept>
+#include <string_view>
+
+#include <gtest/gtest.h>
+#include <constexpr_map.h>
+
+using namespace vodden;
+
+TEST(Map, looksUpDenseKeysDirectly) {
+  static constexpr Map<uint8_t, int, 4> map {{ { 0, 10 }, { 1, 11 }, { 2, 12 }, { 3, 13 } }};
+  static_assert(map.isHashed());
+  static_assert(map[2] == 12);
+  for(uint8_t key = 0; key < 4; ++key) ASSERT_EQ(map[key], 10 + key);
+}
+
+TEST(Map, findsAPerfectHashForSparseKeys) {
+  static constexpr Map<uint32_t, int, 8> map {{
+    { 0x100, 1 }, { 0x200, 2 }, { 0x300, 3 }, { 0x400, 4 },
+    { 0x401, 5 }, { 0x402, 6 }, { 0x8000, 7 }, { 0xFFFF, 8 }
+  }};
+  static_assert(map.isHashed());
+  ASSERT_EQ(map[0x100], 1);
+  ASSERT_EQ(map[0x402], 6);
+  ASSERT_EQ(map[0xFFFF], 8);
+}
+
+TEST(Map, findReturnsNulloptForMissingKeys) {
+  static constexpr Map<uint32_t, int, 2> map {{ { 5, 50 }, { 9, 90 } }};
+  static_assert(noexcept(map.find(7)));
+  ASSERT_EQ(map.find(9), 90);
+  ASSERT_FALSE(map.find(7).has_value());
+  ASSERT_FALSE(map.find(0xFFFFFFFF).has_value());
+}
+
+TEST(Map, subscriptThrowsForMissingKeys) {
+  static constexpr Map<uint32_t, int, 2> map {{ { 5, 50 }, { 9, 90 } }};
+  ASSERT_THROW(map[6], std::range_error);
+}
+
+TEST(Map, supportsEnumerationKeys) {
+  enum class Colour { kRed = 3, kGreen = 70, kBlue = -4 };
+  static constexpr Map<Colour, char, 3> map {{ { Colour::kRed, 'r' }, { Colour::kGreen, 'g' }, { Colour::kBlue, 'b' } }};
+  static_assert(map.isHashed());
+  ASSERT_EQ(map[Colour::kBlue], 'b');
+  ASSERT_EQ(map[Colour::kGreen], 'g');
+}
+
+TEST(Map, fallsBackToALinearSearchForOtherKeys) {
+  static constexpr Map<std::string_view, int, 2> map {{ { "one", 1 }, { "two", 2 } }};
+  static_assert(!map.isHashed());
+  ASSERT_EQ(map["two"], 2);
+  ASSERT_FALSE(map.find("three").has_value());
+}
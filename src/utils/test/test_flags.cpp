@@ -0,0 +1,44 @@
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <constexpr_map.h>
+#include <flags.h>
+#include <gtest/gtest.h>
+
+using namespace vodden;
+
+namespace {
+
+enum class Colour : uint8_t { kRed, kGreen, kBlue };
+
+static constexpr Flags<Colour> kWarm { Colour::kRed };
+static_assert(kWarm.contains(Colour::kRed) && !kWarm.contains(Colour::kBlue));
+static_assert((kWarm | Flags<Colour> { Colour::kBlue }).getMask() == 0b101);
+
+}
+
+TEST(Flags, insertsErasesAndIteratesInOrder) {
+  Flags<uint8_t> flags { 5, 1, 3 };
+  flags.insert(1).erase(3);
+
+  ASSERT_EQ(flags.size(), 2u);
+  ASSERT_TRUE(flags.contains(1));
+  ASSERT_FALSE(flags.contains(3));
+  ASSERT_FALSE(flags.contains(200));
+  ASSERT_EQ(std::vector<uint8_t>(flags.begin(), flags.end()), (std::vector<uint8_t> { 1, 5 }));
+  ASSERT_TRUE(flags.containsAll({ 5 }));
+  ASSERT_FALSE(flags.containsAll({ 5, 6 }));
+  ASSERT_THROW(flags.insert(64), std::out_of_range);
+}
+
+TEST(Flags, translatesThroughAMap) {
+  static constexpr Map<Colour, uint32_t, 3> colourMap {{
+    { Colour::kRed, 0x100 },
+    { Colour::kGreen, 0x010 },
+    { Colour::kBlue, 0x001 }
+  }};
+
+  ASSERT_EQ((Flags<Colour> { Colour::kRed, Colour::kBlue }).translate(colourMap), 0x101u);
+  ASSERT_EQ(Flags<Colour> {}.translate(colourMap), 0u);
+}
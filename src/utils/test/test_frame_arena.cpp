@@ -0,0 +1,60 @@
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <frame_arena.h>
+
+using namespace vodden;
+
+TEST(FrameArena, alignsAndBumpsWithinABlock) {
+  FrameArena frameArena { 1024 };
+  auto* byte = static_cast<std::byte*>(frameArena.allocate(1, 1));
+  auto* aligned = frameArena.allocate(8, 64);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 64, 0u);
+  ASSERT_GT(static_cast<std::byte*>(aligned), byte);
+
+  const auto values = frameArena.allocateArray<uint32_t>(16);
+  ASSERT_EQ(values.size(), 16u);
+  for(const uint32_t value : values) ASSERT_EQ(value, 0u);
+  ASSERT_EQ(frameArena.getBlockCount(), 1u);
+  ASSERT_THROW(frameArena.allocate(8, 3), std::invalid_argument);
+}
+
+TEST(FrameArena, mergesOverflowBlocksOnReset) {
+  FrameArena frameArena { 256 };
+  for(int i = 0; i < 20; ++i) frameArena.create<std::array<std::byte, 100>>();
+  ASSERT_GT(frameArena.getBlockCount(), 1u);
+  const std::size_t capacity = frameArena.getCapacity();
+
+  frameArena.reset();
+  ASSERT_EQ(frameArena.getBlockCount(), 1u);
+  ASSERT_EQ(frameArena.getCapacity(), capacity);
+  ASSERT_EQ(frameArena.getUsedBytes(), 0u);
+
+  // the same frame again now fits without another block
+  for(int i = 0; i < 20; ++i) frameArena.create<std::array<std::byte, 100>>();
+  ASSERT_EQ(frameArena.getBlockCount(), 1u);
+}
+
+TEST(FrameArena, backsPmrContainers) {
+  FrameArena frameArena { 4096 };
+  FrameArenaResource frameArenaResource { frameArena };
+  std::pmr::vector<int> values { &frameArenaResource };
+  for(int i = 0; i < 100; ++i) values.push_back(i);
+  ASSERT_EQ(values[99], 99);
+  ASSERT_GE(frameArena.getUsedBytes(), 100 * sizeof(int));
+}
+
+TEST(DoubleBufferedFrameArena, keepsThePreviousFrameUntilTheNextSwap) {
+  DoubleBufferedFrameArena frameArenas { 1024 };
+  int& first = frameArenas.current().create<int>(1);
+  frameArenas.swap();
+  int& second = frameArenas.current().create<int>(2);
+  ASSERT_EQ(first, 1);
+  ASSERT_EQ(frameArenas.previous().getUsedBytes(), sizeof(int));
+  frameArenas.swap();
+  // the arena first lived in has been reset for this frame
+  ASSERT_EQ(frameArenas.current().getUsedBytes(), 0u);
+  ASSERT_EQ(second, 2);
+}
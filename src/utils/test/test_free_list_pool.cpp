@@ -0,0 +1,44 @@
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <free_list_pool.h>
+
+using namespace vodden;
+
+TEST(FreeListPool, recyclesReleasedBlocks) {
+  void* first = FreeListPool::allocate(48);
+  FreeListPool::deallocate(first, 48);
+  ASSERT_EQ(FreeListPool::freeBlockCount(48), 1);
+
+  void* second = FreeListPool::allocate(40);
+  ASSERT_EQ(first, second); // 40 and 48 share a size class
+  ASSERT_EQ(FreeListPool::freeBlockCount(48), 0);
+  FreeListPool::deallocate(second, 40);
+}
+
+TEST(FreeListPool, keepsSizeClassesApart) {
+  void* small = FreeListPool::allocate(16);
+  FreeListPool::deallocate(small, 16);
+
+  void* large = FreeListPool::allocate(200);
+  ASSERT_NE(small, large);
+  FreeListPool::deallocate(large, 200);
+}
+
+TEST(FreeListPool, oversizedRequestsBypassThePool) {
+  constexpr std::size_t size = FreeListPool::kMaxBlockSize + 1;
+  void* block = FreeListPool::allocate(size);
+  FreeListPool::deallocate(block, size);
+  ASSERT_EQ(FreeListPool::freeBlockCount(size), 0);
+}
+
+TEST(FreeListPool, blocksMayBeReleasedOnAnotherThread) {
+  void* block = FreeListPool::allocate(64);
+  std::size_t countOnOtherThread = 0;
+  std::thread other { [&]() {
+    FreeListPool::deallocate(block, 64);
+    countOnOtherThread = FreeListPool::freeBlockCount(64);
+  }};
+  other.join();
+  ASSERT_EQ(countOnOtherThread, 1);
+}
@@ -0,0 +1,52 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <handle_table.h>
+
+using namespace vodden;
+
+TEST(HandleTable, packsIndicesInInsertionOrder) {
+  HandleTable table;
+  const auto first = table.insert();
+  const auto second = table.insert();
+
+  ASSERT_EQ(table.size(), 2u);
+  ASSERT_EQ(table.find(first), 0u);
+  ASSERT_EQ(table.find(second), 1u);
+  ASSERT_EQ(table.getHandle(1), second);
+  ASSERT_FALSE(table.contains(HandleTable::Handle {}));
+}
+
+TEST(HandleTable, eraseMovesTheLastElementIntoTheGap) {
+  HandleTable table;
+  std::vector<int> values;
+  std::vector<HandleTable::Handle> handles;
+  for(int i = 0; i < 4; ++i) {
+    handles.push_back(table.insert());
+    values.push_back(i);
+  }
+
+  const auto move = table.erase(handles[1]);
+  ASSERT_TRUE(move.has_value());
+  ASSERT_EQ(move->index, 1u);
+  ASSERT_EQ(move->from, 3u);
+  values[move->index] = values[move->from];
+  values.pop_back();
+
+  ASSERT_EQ(table.size(), 3u);
+  ASSERT_EQ(values[*table.find(handles[3])], 3);
+  ASSERT_EQ(values[*table.find(handles[2])], 2);
+  ASSERT_FALSE(table.find(handles[1]).has_value());
+}
+
+TEST(HandleTable, staleHandlesStayInvalidAfterTheirSlotIsReused) {
+  HandleTable table;
+  const auto stale = table.insert();
+  ASSERT_TRUE(table.erase(stale).has_value());
+  ASSERT_FALSE(table.erase(stale).has_value());
+
+  const auto reused = table.insert();
+  ASSERT_EQ(reused.slot, stale.slot);
+  ASSERT_FALSE(table.contains(stale));
+  ASSERT_TRUE(table.contains(reused));
+}
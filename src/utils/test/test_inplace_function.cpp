@@ -0,0 +1,41 @@
+#include <functional>
+#include <memory>
+
+#include <gtest/gtest.h>
+#include <inplace_function.h>
+
+using namespace vodden;
+
+TEST(InplaceFunction, callsWhatItHolds) {
+  int total = 0;
+  InplaceFunction<void(int)> add = [&total](int amount) { total += amount; };
+  add(2);
+  add(3);
+  ASSERT_EQ(total, 5);
+
+  InplaceFunction<int(int, int)> multiply = std::multiplies<int> {};
+  ASSERT_EQ(multiply(6, 7), 42);
+
+  InplaceFunction<void()> empty;
+  ASSERT_FALSE(empty);
+  ASSERT_THROW(empty(), std::bad_function_call);
+}
+
+TEST(InplaceFunction, copiesAndMovesItsCallable) {
+  const auto shared = std::make_shared<int>(1);
+  InplaceFunction<int()> original = [shared]() { return ++*shared; };
+  ASSERT_EQ(shared.use_count(), 2);
+
+  InplaceFunction<int()> copy { original };
+  ASSERT_EQ(shared.use_count(), 3);
+  InplaceFunction<int()> moved { std::move(original) };
+  ASSERT_FALSE(original);
+  ASSERT_EQ(shared.use_count(), 3);
+  ASSERT_EQ(moved(), 2);
+  ASSERT_EQ(copy(), 3);
+
+  copy = nullptr;
+  moved = copy;
+  ASSERT_FALSE(moved);
+  ASSERT_EQ(shared.use_count(), 1);
+}
@@ -0,0 +1,68 @@
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <memory_tracker.h>
+
+using namespace vodden::memory;
+
+namespace {
+
+struct TrackedObject : Tracked<Category::kUI> {
+  std::byte payload[40];
+};
+
+}
+
+TEST(MemoryTracker, countsTrackedObjectsAndContainers) {
+  auto& memoryTracker = MemoryTracker::instance();
+  const Usage before = memoryTracker.getUsage(Category::kUI);
+
+  auto object = std::make_unique<TrackedObject>();
+  ASSERT_EQ(memoryTracker.getUsage(Category::kUI).bytes, before.bytes + sizeof(TrackedObject));
+  ASSERT_EQ(memoryTracker.getUsage(Category::kUI).allocations, before.allocations + 1);
+
+  {
+    std::vector<uint32_t, TrackingAllocator<uint32_t, Category::kUI>> values (100);
+    ASSERT_EQ(memoryTracker.getUsage(Category::kUI).bytes, before.bytes + sizeof(TrackedObject) + 400);
+  }
+  object.reset();
+  const Usage after = memoryTracker.getUsage(Category::kUI);
+  ASSERT_EQ(after.bytes, before.bytes);
+  ASSERT_EQ(after.allocations, before.allocations);
+  ASSERT_GE(after.peakBytes, before.bytes + sizeof(TrackedObject) + 400);
+}
+
+TEST(MemoryTracker, reportsEachTimeUsageCrossesTheBudget) {
+  auto& memoryTracker = MemoryTracker::instance();
+  memoryTracker.resetPeaks();
+  const uint64_t base = memoryTracker.getUsage(Category::kVideoMemory).bytes;
+  int exceeded = 0;
+  memoryTracker.setBudgetCallback([&exceeded](Category category, const Usage& usage) {
+    ASSERT_EQ(category, Category::kVideoMemory);
+    ASSERT_TRUE(usage.isOverBudget());
+    ++exceeded;
+  });
+  memoryTracker.setBudget(Category::kVideoMemory, base + 1000);
+
+  memoryTracker.record(Category::kVideoMemory, 800);
+  memoryTracker.record(Category::kVideoMemory, 800);
+  // already over, so not reported again
+  memoryTracker.record(Category::kVideoMemory, 800);
+  ASSERT_EQ(exceeded, 1);
+  memoryTracker.release(Category::kVideoMemory, 800);
+  memoryTracker.release(Category::kVideoMemory, 800);
+  memoryTracker.record(Category::kVideoMemory, 800);
+  ASSERT_EQ(exceeded, 2);
+
+  std::ostringstream report;
+  memoryTracker.writeReport(report);
+  ASSERT_NE(report.str().find("video memory " + std::to_string(base + 1600) + " " + std::to_string(base + 2400)), std::string::npos);
+  ASSERT_NE(report.str().find("over budget"), std::string::npos);
+
+  memoryTracker.release(Category::kVideoMemory, 800);
+  memoryTracker.release(Category::kVideoMemory, 800);
+  memoryTracker.setBudget(Category::kVideoMemory, 0);
+  memoryTracker.setBudgetCallback(nullptr);
+}
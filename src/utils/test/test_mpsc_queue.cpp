@@ -0,0 +1,72 @@
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <mpsc_queue.h>
+
+using namespace vodden;
+
+TEST(MpscQueue, popsInPushOrder) {
+  MpscQueue<int, 8> queue;
+  ASSERT_TRUE(queue.empty());
+  for(int i = 0; i < 5; ++i) ASSERT_TRUE(queue.push(i));
+  for(int i = 0; i < 5; ++i) ASSERT_EQ(queue.tryPop(), i);
+  ASSERT_FALSE(queue.tryPop().has_value());
+}
+
+TEST(MpscQueue, refusesPushesWhenFull) {
+  MpscQueue<int, 4> queue;
+  for(int i = 0; i < 4; ++i) ASSERT_TRUE(queue.push(i));
+  ASSERT_FALSE(queue.push(4));
+  ASSERT_EQ(queue.tryPop(), 0);
+  ASSERT_TRUE(queue.push(4));
+}
+
+TEST(MpscQueue, holdsMoveOnlyTypes) {
+  MpscQueue<std::unique_ptr<int>, 4> queue;
+  queue.push(std::make_unique<int>(17));
+  auto popped = queue.tryPop();
+  ASSERT_TRUE(popped.has_value());
+  ASSERT_EQ(**popped, 17);
+}
+
+TEST(MpscQueue, destroysItemsLeftInTheQueue) {
+  auto item = std::make_shared<int>(3);
+  {
+    MpscQueue<std::shared_ptr<int>, 4> queue;
+    queue.push(item);
+    queue.push(item);
+    ASSERT_EQ(item.use_count(), 3);
+  }
+  ASSERT_EQ(item.use_count(), 1);
+}
+
+TEST(MpscQueue, deliversEveryItemFromManyProducers) {
+  constexpr int kProducers = 4;
+  constexpr int kItemsPerProducer = 10000;
+  MpscQueue<int, 256> queue;
+
+  std::vector<std::thread> producers;
+  for(int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&queue, p]() {
+      for(int i = 0; i < kItemsPerProducer; ++i) {
+        while(!queue.push(p * kItemsPerProducer + i)) std::this_thread::yield();
+      }
+    });
+  }
+
+  std::vector<int> lastSeen(kProducers, -1);
+  int received = 0;
+  while(received < kProducers * kItemsPerProducer) {
+    auto item = queue.tryPop();
+    if(!item) { std::this_thread::yield(); continue; }
+    const int producer = *item / kItemsPerProducer;
+    const int sequence = *item % kItemsPerProducer;
+    ASSERT_GT(sequence, lastSeen[producer]); // each producer's items arrive in order
+    lastSeen[producer] = sequence;
+    ++received;
+  }
+  for(auto& producer : producers) producer.join();
+  ASSERT_TRUE(queue.empty());
+}
@@ -0,0 +1,47 @@
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <parallel_tiles.h>
+
+using namespace vodden;
+
+TEST(ParallelTiles, coversEveryRowOnce) {
+  ThreadPool threadPool { 3 };
+  // rows padded to 40 bytes, in tiles of two rows with one left over
+  std::vector<std::byte> bytes(40 * 9);
+  const PixelView pixels { bytes, 8, 9, 40 };
+  std::atomic_int tiles { 0 };
+
+  parallelForTiles(pixels, 80, [&tiles](PixelView tile, uint32_t firstRow) {
+    ++tiles;
+    for(uint32_t y = 0; y < tile.height; ++y) {
+      for(uint32_t& pixel : tile.row(y)) pixel += firstRow + y + 1;
+    }
+  }, threadPool);
+
+  ASSERT_EQ(tiles, 5);
+  for(uint32_t y = 0; y < 9; ++y) {
+    for(const uint32_t pixel : pixels.row(y)) ASSERT_EQ(pixel, y + 1);
+  }
+}
+
+TEST(ParallelTiles, rethrowsAndRunsFromWorkers) {
+  ThreadPool threadPool { 1 };
+  std::vector<std::byte> bytes(4 * 64);
+  const PixelView pixels { bytes, 1, 64, 4 };
+
+  ASSERT_THROW(parallelForTiles(pixels, 4, [](PixelView, uint32_t firstRow) {
+    if(firstRow == 10) throw std::runtime_error("tile failed");
+  }, threadPool), std::runtime_error);
+
+  // the only worker waits on tiles it can run itself
+  std::atomic_int rows { 0 };
+  threadPool.submit([&]() {
+    parallelForTiles(pixels, 16, [&rows](PixelView tile, uint32_t) { rows += tile.height; }, threadPool);
+  });
+  threadPool.waitIdle();
+  ASSERT_EQ(rows, 64);
+}
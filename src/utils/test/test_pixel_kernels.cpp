@@ -0,0 +1,80 @@
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <pixel_kernels.h>
+
+using namespace vodden;
+
+namespace {
+
+//! @brief random premultiplied pixels in rows padded by a few bytes, as surfaces may pad them
+struct Image {
+  static constexpr uint32_t kPadding = 12;
+
+  Image(uint32_t width, uint32_t height, uint32_t seed) : width { width }, height { height }, bytes((width * 4 + kPadding) * height) {
+    std::mt19937 random { seed };
+    for(uint32_t y = 0; y < height; ++y) {
+      for(uint32_t& pixel : view().row(y)) {
+        const uint32_t alpha = random() & 0xff;
+        pixel = alpha << 24;
+        for(uint32_t shift = 0; shift < 24; shift += 8) pixel |= (random() % (alpha + 1)) << shift;
+      }
+    }
+  }
+
+  PixelView view() { return { bytes, width, height, width * 4 + kPadding }; }
+
+  uint32_t width;
+  uint32_t height;
+  std::vector<std::byte> bytes;
+};
+
+}
+
+TEST(PixelKernels, blendsPremultipliedPixels) {
+  std::vector<std::byte> source(4), destination(4);
+  PixelView sourceView { source, 1, 1, 4 };
+  PixelView destinationView { destination, 1, 1, 4 };
+  sourceView.row(0)[0] = 0x80400000;
+  destinationView.row(0)[0] = 0xff0000ff;
+
+  blendPremultiplied(sourceView, destinationView);
+  ASSERT_EQ(destinationView.row(0)[0], 0xff40007f);
+}
+
+TEST(PixelKernels, matchTheScalarKernels) {
+  // 37 pixels wide leaves a tail after every vector width
+  Image source { 37, 5, 1 };
+  Image destination { 37, 5, 2 };
+  Image expected { 37, 5, 2 };
+
+  blendPremultiplied(source.view(), destination.view());
+  for(uint32_t y = 0; y < 5; ++y) detail::blendRowScalar(source.view().row(y).data(), expected.view().row(y).data(), 0, 37);
+  ASSERT_EQ(destination.bytes, expected.bytes);
+
+  const uint32_t key = source.view().row(2)[3] & 0x00ffffff;
+  copyColorKeyed(source.view(), destination.view(), key);
+  for(uint32_t y = 0; y < 5; ++y) detail::colorKeyRowScalar(source.view().row(y).data(), expected.view().row(y).data(), 0, 37, key);
+  ASSERT_EQ(destination.bytes, expected.bytes);
+
+  swapRedBlue(source.view(), destination.view());
+  for(uint32_t y = 0; y < 5; ++y) detail::swapRedBlueRowScalar(source.view().row(y).data(), expected.view().row(y).data(), 0, 37);
+  ASSERT_EQ(destination.bytes, expected.bytes);
+}
+
+TEST(PixelKernels, workOnRegionsAndRejectMismatchedViews) {
+  Image image { 8, 8, 3 };
+  const uint32_t outside = image.view().row(0)[0];
+
+  fillPixels(image.view().region(2, 2, 4, 4), 0x11223344);
+  ASSERT_EQ(image.view().row(2)[2], 0x11223344u);
+  ASSERT_EQ(image.view().row(5)[5], 0x11223344u);
+  ASSERT_EQ(image.view().row(0)[0], outside);
+
+  ASSERT_THROW(image.view().region(6, 0, 4, 1), std::out_of_range);
+  ASSERT_THROW(blendPremultiplied(image.view().region(0, 0, 2, 2), image.view().region(0, 0, 3, 2)), std::invalid_argument);
+  ASSERT_THROW(fillPixels({ image.bytes, 8, 8, 16 }, 0), std::invalid_argument);
+}
@@ -0,0 +1,106 @@
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <poly_vector.h>
+
+using namespace vodden;
+
+namespace {
+
+static int destructions;
+
+class Shape {
+  public:
+    virtual ~Shape() { ++destructions; };
+    virtual int area() const = 0;
+};
+
+class Square : public Shape {
+  public:
+    Square(int side) : side { side } {};
+    virtual int area() const override { return side * side; };
+    int side;
+};
+
+//! @brief larger, more aligned and with Shape as its second base, so the Shape isn't at the object's start
+class Named {
+  public:
+    virtual ~Named() {};
+    std::string name { "a rectangle whose name outgrows the small string buffer" };
+};
+
+class NamedRectangle : public Named, public Shape {
+  public:
+    NamedRectangle(int width, double height) : width { width }, height { height } {};
+    virtual int area() const override { return width * static_cast<int>(height); };
+    int width;
+    double height;
+};
+
+//! @brief has no nothrow move, so is copied when the buffer grows, and the copy can be made to throw
+class Fragile : public Shape {
+  public:
+    Fragile() = default;
+    Fragile(const Fragile& other) : Shape(other) { if(failCopies) throw std::runtime_error("copy failed"); };
+    virtual int area() const override { return 1; };
+    static inline bool failCopies { false };
+};
+
+}
+
+TEST(PolyVector, storesMixedClassesInOrder) {
+  PolyVector<Shape> shapes;
+  shapes.emplaceBack<Square>(2);
+  NamedRectangle& rectangle = shapes.emplaceBack<NamedRectangle>(3, 5.0);
+  ASSERT_EQ(&shapes[1], static_cast<Shape*>(&rectangle));
+  shapes.emplaceBack<Square>(4);
+
+  ASSERT_EQ(shapes.size(), 3u);
+  ASSERT_EQ(shapes[0].area(), 4);
+  ASSERT_EQ(shapes[1].area(), 15);
+  ASSERT_EQ(std::accumulate(shapes.begin(), shapes.end(), 0, [](int sum, const Shape& shape) { return sum + shape.area(); }), 35);
+  ASSERT_LE(shapes.usedBytes(), shapes.capacityBytes());
+}
+
+TEST(PolyVector, movesElementsWhenItGrows) {
+  destructions = 0;
+  {
+    PolyVector<Shape> shapes;
+    for(int i = 0; i < 100; ++i) {
+      if(i % 3 == 0) shapes.emplaceBack<NamedRectangle>(i, 1.0);
+      else shapes.emplaceBack<Square>(i);
+    }
+    const int moves = destructions;
+
+    for(int i = 0; i < 100; ++i) ASSERT_EQ(shapes[i].area(), i % 3 == 0 ? i : i * i);
+    ASSERT_EQ(dynamic_cast<const NamedRectangle&>(shapes[99]).name.size(), Named {}.name.size());
+
+    PolyVector<Shape> moved { std::move(shapes) };
+    ASSERT_TRUE(shapes.empty());
+    moved.popBack();
+    ASSERT_EQ(moved.size(), 99u);
+    ASSERT_EQ(destructions, moves + 1);
+  }
+  // every element which was constructed, or moved into, has been destroyed
+  ASSERT_GT(destructions, 100);
+}
+
+TEST(PolyVector, isUnchangedWhenGrowingThrows) {
+  PolyVector<Shape> shapes;
+  shapes.emplaceBack<Square>(3);
+  shapes.emplaceBack<Fragile>();
+  while(shapes.usedBytes() + sizeof(Square) <= shapes.capacityBytes()) shapes.emplaceBack<Square>(3);
+
+  const std::size_t size = shapes.size();
+  Fragile::failCopies = true;
+  ASSERT_THROW(shapes.emplaceBack<Square>(3), std::runtime_error);
+  Fragile::failCopies = false;
+
+  ASSERT_EQ(shapes.size(), size);
+  ASSERT_EQ(shapes[0].area(), 9);
+  ASSERT_EQ(shapes[1].area(), 1);
+}
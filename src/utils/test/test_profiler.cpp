@@ -0,0 +1,82 @@
+#include <sstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <profiler.h>
+
+using namespace vodden::profiler;
+
+TEST(Profiler, summarisesAndResetsCountersEachFrame) {
+  auto& profiler = Profiler::instance();
+  profiler.endFrame();
+
+  profiler.increment(Counter::kDrawCalls, 3);
+  std::thread { [&profiler]() { profiler.increment(Counter::kDrawCalls); } }.join();
+  profiler.increment(Counter::kEventsDispatched);
+  profiler.endFrame();
+  profiler.endFrame();
+
+  const auto history = profiler.getHistory();
+  ASSERT_GE(history.size(), 2u);
+  const FrameSummary& counted = history[history.size() - 2];
+  ASSERT_EQ(counted[Counter::kDrawCalls], 4u);
+  ASSERT_EQ(counted[Counter::kEventsDispatched], 1u);
+  ASSERT_EQ(history.back()[Counter::kDrawCalls], 0u);
+  ASSERT_EQ(history.back().frame, counted.frame + 1);
+}
+
+TEST(Profiler, recordsZonesOnlyWhileTracing) {
+  auto& profiler = Profiler::instance();
+  { ScopedZone zone { "untraced" }; }
+
+  profiler.startTrace();
+  { ScopedZone zone { "traced" }; }
+  profiler.increment(Counter::kTextureBinds, 2);
+  profiler.endFrame();
+  profiler.stopTrace();
+
+  std::ostringstream trace;
+  profiler.writeChromeTrace(trace);
+  ASSERT_NE(trace.str().find("\"name\":\"traced\",\"ph\":\"X\""), std::string::npos);
+  ASSERT_EQ(trace.str().find("untraced"), std::string::npos);
+  ASSERT_NE(trace.str().find("\"texture binds\":2"), std::string::npos);
+}
+
+TEST(Profiler, measuresEachInputToTheNextPresent) {
+  using std::chrono::milliseconds;
+  auto& profiler = Profiler::instance();
+  profiler.recordPresent(milliseconds { 0 });
+  profiler.resetInputLatency();
+
+  profiler.recordInput(milliseconds { 1000 });
+  profiler.recordInput(milliseconds { 1010 });
+  // zero is an unknown input time, and is not counted
+  profiler.recordInput(milliseconds { 0 });
+  profiler.recordPresent(milliseconds { 1020 });
+  // inputs are only counted against the first present after them
+  profiler.recordPresent(milliseconds { 1040 });
+
+  const LatencyHistogram latency = profiler.getInputLatency();
+  ASSERT_EQ(latency.count, 2u);
+  ASSERT_EQ(latency.buckets[10], 1u);
+  ASSERT_EQ(latency.buckets[20], 1u);
+  ASSERT_EQ(latency.getPercentile(0.0), milliseconds { 11 });
+  ASSERT_EQ(latency.getPercentile(1.0), milliseconds { 21 });
+}
+
+TEST(Profiler, boundsInputsWaitingForAPresent) {
+  using std::chrono::milliseconds;
+  auto& profiler = Profiler::instance();
+  profiler.recordPresent(milliseconds { 0 });
+  profiler.resetInputLatency();
+
+  for(std::size_t i = 0; i < Profiler::kMaxPendingInputs + 10; ++i) profiler.recordInput(milliseconds { 1000 });
+  profiler.recordPresent(milliseconds { 1001 });
+  ASSERT_EQ(profiler.getInputLatency().count, Profiler::kMaxPendingInputs);
+
+  // a frame which ends unpresented drops its inputs
+  profiler.recordInput(milliseconds { 1002 });
+  profiler.endFrame();
+  profiler.recordPresent(milliseconds { 1003 });
+  ASSERT_EQ(profiler.getInputLatency().count, Profiler::kMaxPendingInputs);
+}
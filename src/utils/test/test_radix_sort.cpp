@@ -0,0 +1,43 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <radix_sort.h>
+
+using namespace vodden;
+
+namespace {
+
+struct Keyed {
+  uint64_t key;
+  std::size_t order;
+
+  bool operator==(const Keyed& other) const = default;
+};
+
+}
+
+TEST(RadixSort, matchesAStableSort) {
+  std::mt19937_64 random { 11 };
+  std::vector<Keyed> values;
+  for(std::size_t i = 0; i < 5000; ++i) {
+    // few distinct keys spread over the low and high bytes, so there are many ties
+    const uint64_t key = (random() % 7) << 56 | (random() % 5) << 8 | (random() % 3);
+    values.push_back({ key, i });
+  }
+  std::vector<Keyed> expected = values;
+  std::stable_sort(expected.begin(), expected.end(), [](const Keyed& lhs, const Keyed& rhs) { return lhs.key < rhs.key; });
+
+  std::vector<Keyed> scratch;
+  radixSort(values, scratch, [](const Keyed& value) { return value.key; });
+  ASSERT_EQ(values, expected);
+}
+
+TEST(RadixSort, leavesSharedKeysInOrder) {
+  std::vector<Keyed> values { { 3, 0 }, { 3, 1 }, { 3, 2 } };
+  std::vector<Keyed> scratch;
+  radixSort(values, scratch, [](const Keyed& value) { return value.key; });
+  ASSERT_EQ(values, (std::vector<Keyed> { { 3, 0 }, { 3, 1 }, { 3, 2 } }));
+}
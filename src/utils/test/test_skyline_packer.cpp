@@ -0,0 +1,54 @@
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <skyline_packer.h>
+
+using namespace vodden;
+
+TEST(SkylinePacker, placesTheFirstRectangleInTheCorner) {
+  SkylinePacker packer { 64, 64 };
+  const auto position = packer.insert(16, 8);
+  ASSERT_TRUE(position.has_value());
+  ASSERT_EQ(position->x, 0u);
+  ASSERT_EQ(position->y, 0u);
+  ASSERT_EQ(packer.getUsedHeight(), 8u);
+}
+
+TEST(SkylinePacker, fillsRowsBeforeStackingUpwards) {
+  SkylinePacker packer { 32, 32 };
+  for(uint32_t i = 0; i < 4; ++i) ASSERT_EQ(packer.insert(8, 8)->x, i * 8);
+  const auto position = packer.insert(8, 8);
+  ASSERT_EQ(position->x, 0u);
+  ASSERT_EQ(position->y, 8u);
+}
+
+TEST(SkylinePacker, rejectsRectanglesWhichDoNotFit) {
+  SkylinePacker packer { 16, 16 };
+  ASSERT_FALSE(packer.insert(17, 1).has_value());
+  ASSERT_FALSE(packer.insert(1, 17).has_value());
+  ASSERT_TRUE(packer.insert(16, 16).has_value());
+  ASSERT_FALSE(packer.insert(1, 1).has_value());
+}
+
+TEST(SkylinePacker, neverOverlapsRectangles) {
+  constexpr uint32_t kSize = 256;
+  SkylinePacker packer { kSize, kSize };
+  std::vector<std::vector<bool>> used(kSize, std::vector<bool>(kSize, false));
+  std::mt19937 random { 7 };
+  std::uniform_int_distribution<uint32_t> side { 1, 40 };
+
+  for(int i = 0; i < 500; ++i) {
+    const uint32_t width = side(random), height = side(random);
+    const auto position = packer.insert(width, height);
+    if(!position) continue;
+    ASSERT_LE(position->x + width, kSize);
+    ASSERT_LE(position->y + height, kSize);
+    for(uint32_t y = position->y; y < position->y + height; ++y) {
+      for(uint32_t x = position->x; x < position->x + width; ++x) {
+        ASSERT_FALSE(used[y][x]);
+        used[y][x] = true;
+      }
+    }
+  }
+}
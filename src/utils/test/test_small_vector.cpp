@@ -0,0 +1,58 @@
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <small_vector.h>
+
+using namespace vodden;
+
+TEST(SmallVector, staysInlineUpToItsCapacity) {
+  SmallVector<int, 4> values { 1, 2, 3 };
+  values.push_back(4);
+  ASSERT_TRUE(values.isInline());
+  ASSERT_EQ(values.capacity(), 4u);
+
+  values.push_back(5);
+  ASSERT_FALSE(values.isInline());
+  ASSERT_EQ(values.size(), 5u);
+  for(int i = 0; i < 5; ++i) ASSERT_EQ(values[i], i + 1);
+
+  values.swapAndPop(0);
+  ASSERT_EQ(values[0], 5);
+  ASSERT_EQ(values.size(), 4u);
+}
+
+TEST(SmallVector, copiesAndMovesEitherWay) {
+  SmallVector<std::string, 2> inlineStrings { "a string long enough to live on the heap", "b" };
+  SmallVector<std::string, 2> heapStrings { "c", "d", "e" };
+
+  SmallVector<std::string, 2> copy { inlineStrings };
+  ASSERT_EQ(copy[0], inlineStrings[0]);
+
+  SmallVector<std::string, 2> moved { std::move(inlineStrings) };
+  ASSERT_TRUE(inlineStrings.empty());
+  ASSERT_EQ(moved[1], "b");
+
+  const std::string* heapData = heapStrings.data();
+  moved = std::move(heapStrings);
+  ASSERT_EQ(moved.data(), heapData);
+  ASSERT_EQ(moved[2], "e");
+  ASSERT_TRUE(heapStrings.empty());
+  ASSERT_TRUE(heapStrings.isInline());
+
+  // an argument referring to an element survives the growth it causes
+  SmallVector<std::string, 1> grown { "x" };
+  grown.push_back(grown[0]);
+  ASSERT_EQ(grown[1], "x");
+}
+
+TEST(SmallVector, holdsMoveOnlyTypes) {
+  SmallVector<std::unique_ptr<int>, 1> pointers;
+  pointers.push_back(std::make_unique<int>(1));
+  pointers.emplace_back(std::make_unique<int>(2));
+  ASSERT_EQ(*pointers[1], 2);
+  pointers.pop_back();
+  ASSERT_EQ(pointers.size(), 1u);
+  SmallVector<int, 1> empty;
+  ASSERT_THROW(empty.pop_back(), std::out_of_range);
+}
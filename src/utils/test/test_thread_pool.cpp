@@ -0,0 +1,36 @@
+#include <atomic>
+
+#include <gtest/gtest.h>
+#include <thread_pool.h>
+
+using namespace vodden;
+
+TEST(ThreadPool, runsEverySubmittedTask) {
+  ThreadPool threadPool { 3 };
+  std::atomic_int count { 0 };
+  for(int i = 0; i < 1000; ++i) threadPool.submit([&count]() { ++count; });
+  threadPool.waitIdle();
+  ASSERT_EQ(count, 1000);
+}
+
+TEST(ThreadPool, runsTasksSubmittedFromWorkers) {
+  ThreadPool threadPool { 2 };
+  std::atomic_int count { 0 };
+  for(int i = 0; i < 10; ++i) {
+    threadPool.submit([&threadPool, &count]() {
+      ASSERT_TRUE(threadPool.isWorkerThread());
+      for(int j = 0; j < 10; ++j) threadPool.submit([&count]() { ++count; });
+    });
+  }
+  threadPool.waitIdle();
+  ASSERT_EQ(count, 100);
+}
+
+TEST(ThreadPool, destructorFinishesQueuedTasks) {
+  std::atomic_int count { 0 };
+  {
+    ThreadPool threadPool { 1 };
+    for(int i = 0; i < 100; ++i) threadPool.submit([&count]() { ++count; });
+  }
+  ASSERT_EQ(count, 100);
+}
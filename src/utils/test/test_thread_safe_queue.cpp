@@ -0,0 +1,31 @@
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <thread_safe_queue.h>
+
+using namespace vodden;
+
+TEST(ThreadSafeQueue, popsInPushOrder) {
+  ThreadSafeQueue<int> queue;
+  queue.push(1);
+  queue.push(2);
+  ASSERT_EQ(queue.size(), 2);
+  ASSERT_EQ(queue.pop(), 1);
+  ASSERT_EQ(queue.tryPop(), 2);
+  ASSERT_FALSE(queue.tryPop().has_value());
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(ThreadSafeQueue, popBlocksUntilAnItemArrives) {
+  ThreadSafeQueue<int> queue;
+  std::thread producer { [&queue]() { queue.push(42); } };
+  ASSERT_EQ(queue.pop(), 42);
+  producer.join();
+}
+
+TEST(ThreadSafeQueue, closeReleasesBlockedConsumers) {
+  ThreadSafeQueue<int> queue;
+  std::thread consumer { [&queue]() { ASSERT_FALSE(queue.pop().has_value()); } };
+  queue.close();
+  consumer.join();
+}
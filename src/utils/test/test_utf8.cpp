@@ -0,0 +1,52 @@
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+#include <utf8.h>
+
+using namespace vodden;
+
+namespace {
+
+std::u32string decodeAll(std::string_view text) {
+  std::u32string codePoints;
+  for(std::size_t index = 0; index < text.size();) codePoints.push_back(decodeUtf8(text, index));
+  return codePoints;
+}
+
+static_assert([] {
+  std::size_t index = 0;
+  return decodeUtf8("\xe2\x82\xac", index) == U'€' && index == 3;
+}());
+
+}
+
+TEST(Utf8, decodesEachLength) {
+  ASSERT_EQ(decodeAll("a\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80"), U"aé€\U0001f600");
+  ASSERT_EQ(decodeAll("\xf4\x8f\xbf\xbf"), U"\U0010ffff");
+  ASSERT_EQ(decodeAll("\xed\x9f\xbf\xee\x80\x80"), U"\ud7ff\ue000");
+}
+
+TEST(Utf8, replacesOverlongEncodings) {
+  // '/' as two, three and four bytes, and U+20AC as four
+  ASSERT_EQ(decodeAll("\xc0\xaf"), U"\ufffd");
+  ASSERT_EQ(decodeAll("\xe0\x80\xaf"), U"\ufffd");
+  ASSERT_EQ(decodeAll("\xf0\x80\x80\xaf"), U"\ufffd");
+  ASSERT_EQ(decodeAll("\xf0\x82\x82\xac"), U"\ufffd");
+  ASSERT_EQ(decodeAll("\xc1\xbf"), U"\ufffd");
+}
+
+TEST(Utf8, replacesSurrogatesAndValuesPastTheLast) {
+  ASSERT_EQ(decodeAll("\xed\xa0\x80"), U"\ufffd");
+  ASSERT_EQ(decodeAll("\xed\xbf\xbf"), U"\ufffd");
+  ASSERT_EQ(decodeAll("\xf4\x90\x80\x80"), U"\ufffd");
+}
+
+TEST(Utf8, replacesStrayAndTruncatedBytes) {
+  ASSERT_EQ(decodeAll("\x80z"), U"\ufffdz");
+  ASSERT_EQ(decodeAll("\xf8z"), U"\ufffdz");
+  ASSERT_EQ(decodeAll("\xe2\x82"), U"\ufffd");
+  // the byte which cuts a sequence short is decoded in its own right
+  ASSERT_EQ(decodeAll("\xe2z"), U"\ufffdz");
+  ASSERT_EQ(decodeAll("\xe2\xc3\xa9"), U"\ufffdé");
+}
@@ -1,5 +1,5 @@
 #include <gtest/gtest.h>
-#include <value_ptr.hpp>
+#include <value_ptr.h>
 
 using namespace valuable;
 
@@ -160,3 +160,70 @@ TEST(value_ptr, C_full_api) {
 
   ASSERT_EQ(destructions, 2); // b, c
 }
+
+namespace {
+
+static int allocations;
+
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+  CountingAllocator() = default;
+  template <typename U> CountingAllocator(const CountingAllocator<U> &) {}
+  T *allocate(std::size_t n) { ++allocations; return std::allocator<T>().allocate(n); }
+  void deallocate(T *p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+  bool operator==(const CountingAllocator &) const { return true; }
+};
+
+struct Large {
+  int values[64];
+};
+
+}
+
+TEST(small_value_ptr, stores_small_values_inline) {
+  allocations = 0;
+  using Pointer = small_value_ptr<int, sizeof(void *), allocator_clone<int, CountingAllocator<int>>>;
+  static_assert(Pointer::stores_inline());
+
+  Pointer x = 7;
+  Pointer y = x;
+  *y = 8;
+  ASSERT_EQ(*x, 7);
+  ASSERT_EQ(*y, 8);
+  // the value lives within the pointer
+  const auto offset = reinterpret_cast<const std::byte *>(x.get()) - reinterpret_cast<const std::byte *>(&x);
+  ASSERT_TRUE(offset > 0 && offset < static_cast<std::ptrdiff_t>(sizeof(x)));
+
+  Pointer z = std::move(y);
+  ASSERT_FALSE((bool)y);
+  ASSERT_EQ(*z, 8);
+  x = z;
+  ASSERT_EQ(*x, 8);
+  ASSERT_EQ(allocations, 0);
+}
+
+TEST(small_value_ptr, falls_back_to_the_allocator_for_large_values) {
+  allocations = 0;
+  using Pointer = small_value_ptr<Large, 16, allocator_clone<Large, CountingAllocator<Large>>>;
+  static_assert(!Pointer::stores_inline());
+
+  Pointer x { std::in_place };
+  x->values[0] = 3;
+  Pointer y = x;
+  y->values[0] = 4;
+  ASSERT_EQ(x->values[0], 3);
+  ASSERT_EQ(allocations, 2);
+
+  const Large *moved = y.get();
+  Pointer z = std::move(y);
+  ASSERT_EQ(z.get(), moved);
+  ASSERT_FALSE((bool)y);
+  ASSERT_EQ(allocations, 2);
+
+  z.reset();
+  ASSERT_FALSE((bool)z);
+  z.emplace().values[0] = 5;
+  ASSERT_EQ(z->values[0], 5);
+  ASSERT_EQ(allocations, 3);
+}
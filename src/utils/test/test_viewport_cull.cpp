@@ -0,0 +1,49 @@
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <viewport_cull.h>
+
+using namespace vodden;
+
+TEST(ViewportCull, keepsOnlyOverlappingRectanglesInOrder) {
+  const std::vector<float> x { -20.0f, -5.0f, 10.0f, 100.0f, 50.0f };
+  const std::vector<float> y { 0.0f, 0.0f, 90.0f, 0.0f, -10.0f };
+  const std::vector<float> width { 10.0f, 10.0f, 10.0f, 10.0f, 10.0f };
+  const std::vector<float> height { 10.0f, 10.0f, 10.0f, 10.0f, 10.0f };
+  std::vector<uint32_t> visible(x.size());
+
+  const auto count = cullRectangles(x, y, width, height, { 0.0f, 0.0f, 100.0f, 100.0f }, visible);
+  ASSERT_EQ(count, 2u);
+  ASSERT_EQ(visible[0], 1u);
+  ASSERT_EQ(visible[1], 2u);
+}
+
+TEST(ViewportCull, matchesTheScalarKernel) {
+  std::mt19937 random { 7 };
+  std::uniform_real_distribution<float> position { -500.0f, 1500.0f };
+  std::uniform_real_distribution<float> size { 1.0f, 64.0f };
+  std::vector<float> x, y, width, height;
+  for(int i = 0; i < 1003; ++i) {
+    x.push_back(position(random));
+    y.push_back(position(random));
+    width.push_back(size(random));
+    height.push_back(size(random));
+  }
+  const CullBounds bounds { 0.0f, 0.0f, 800.0f, 600.0f };
+
+  std::vector<uint32_t> visible(x.size());
+  std::vector<uint32_t> expected(x.size());
+  const auto count = cullRectangles(x, y, width, height, bounds, visible);
+  const auto expectedCount = detail::cullRectanglesScalar(x.data(), y.data(), width.data(), height.data(), 0, x.size(), bounds, expected.data(), 0);
+
+  ASSERT_GT(expectedCount, 0u);
+  ASSERT_EQ(count, expectedCount);
+  for(std::size_t i = 0; i < count; ++i) ASSERT_EQ(visible[i], expected[i]);
+}
+
+TEST(ViewportCull, rejectsAnUndersizedOutput) {
+  const std::vector<float> values(5, 0.0f);
+  std::vector<uint32_t> visible(4);
+  ASSERT_THROW(cullRectangles(values, values, values, values, { 0.0f, 0.0f, 1.0f, 1.0f }, visible), std::invalid_argument);
+}
@@ -1,9 +1,12 @@
 #ifndef __VISITOR_PATTERN_LEGACY_SDK_H__
 #define __VISITOR_PATTERN_LEGACY_SDK_H__
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
+#include <span>
 #include <typeinfo>
+#include <variant>
 
 class NoEventsException: public std::runtime_error {
   using std::runtime_error::runtime_error;
@@ -51,6 +54,8 @@ void pushEvent(const BaseEvent& event);
 class UserEvent : public BaseEvent {
   public:
     UserEvent();
+    //! @brief an event for the batch API, which never converts through an impl and so has none
+    explicit UserEvent(uint16_t userNumber);
     uint16_t userNumber;
     virtual void operator()(const BaseEventHandler& abstractHandler) const {
       castHandler(*this, abstractHandler);
@@ -60,6 +65,8 @@ class UserEvent : public BaseEvent {
 class SystemEvent : public BaseEvent {
   public:
     SystemEvent();
+    //! @brief an event for the batch API, which never converts through an impl and so has none
+    explicit SystemEvent(uint16_t systemNumber);
     uint16_t systemNumber;
     virtual void operator()(const BaseEventHandler& abstractHandler) const {
       castHandler(*this, abstractHandler);
@@ -72,17 +79,34 @@ class CustomEvent : public BaseEvent {
   public:
     CustomEvent();
     CustomEvent(CustomEventImpl* impl);
+    //! @brief an event for the batch API, which never converts through an impl and so has none
+    CustomEvent(uint16_t customEventNumber, void* payload);
+    //! @brief an event for the batch API standing in for one pushEvent queued, taking ownership of it
+    explicit CustomEvent(std::unique_ptr<CustomEvent> queuedEvent);
     virtual ~CustomEvent() {};
     
-    uint16_t customEventNumber;
-    void* payload;
+    uint16_t customEventNumber { 0 };
+    //! @brief the caller's data, which is carried as it is on either path and never owned
+    void* payload { nullptr };
     virtual void operator()(const BaseEventHandler& abstractHandler) const {
       castHandler(*this, abstractHandler);
     };
 
+    //! @brief a heap copy of the event, of its own class, which is how pushEvent queues it
     virtual CustomEvent& clone() const;
     virtual CustomEventImpl* cloneImpl() const;
 
+    /**
+     * @brief on the batch path, the event pushEvent queued this one for, or nullptr
+     *
+     * The variant holds a CustomEvent by value, so the clone pushEvent queued
+     * is kept here, of its own class, rather than sliced. pushEvents queues
+     * a clone of it again, so it survives a round trip through the batch API.
+     */
+    const CustomEvent* getQueuedEvent() const { return _queuedEvent.get(); };
+
+  private:
+    std::unique_ptr<CustomEvent> _queuedEvent {};
 };
 
 template<class EventClass>
@@ -90,4 +114,44 @@ class EventHandler: public BaseEventHandler, public InternalEventHandler<EventCl
 
 BaseEvent& getEvent();
 
+/**
+ * @brief an event by value, for converting to and from the legacy SDK in batches
+ *
+ * The events in a variant are built without impls, so converting them
+ * allocates nothing; they can only be pushed back through pushEvents, not
+ * pushEvent. A CustomEvent pushed by pushEvent is drained with the clone it
+ * was queued as, see CustomEvent::getQueuedEvent, and one pushed by
+ * pushEvents is handed to getEvent as a plain CustomEvent, so the two paths
+ * can be mixed on the same queue without leaking or slicing an event.
+ */
+typedef std::variant<UserEvent, SystemEvent, CustomEvent> EventVariant;
+
+/**
+ * @brief take up to events.size() pending legacy events, in the order getEvent would
+ *
+ * Reuse the buffer between calls: once each slot holds an event from a
+ * previous drain, draining does no heap allocation at all.
+ *
+ * @return the number of events written to the front of the buffer.
+ */
+std::size_t drainEvents(std::span<EventVariant> events);
+
+//! @brief hand events back to the legacy SDK, without allocating any OLD_Event
+void pushEvents(std::span<const EventVariant> events);
+
+/**
+ * @brief call handle on every handler which takes the event's type
+ *
+ * This resolves the handlers at compile time, so unlike operator() there is
+ * no dynamic_cast per handler and event.
+ */
+template <class... Handlers>
+void dispatchEvent(const EventVariant& event, const Handlers&... handlers) {
+  std::visit([&handlers...](const auto& concreteEvent) {
+    ([&concreteEvent](const auto& handler) {
+      if constexpr (requires { handler.handle(concreteEvent); }) handler.handle(concreteEvent);
+    }(handlers), ...);
+  }, event);
+}
+
 #endif
@@ -1,4 +1,7 @@
+#include <array>
 #include <functional>
+#include <string>
+#include <variant>
 #include <vector>
 
 #include "legacy_sdk.h"
@@ -96,4 +99,33 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) {
     delete &newEvent;
   }
 
+
+  // the batch API round trips events by value, choosing handlers at compile time
+  std::array<EventVariant, 4> batch {};
+  batch[0].emplace<UserEvent>(5);
+  batch[1].emplace<SystemEvent>(6);
+  pushEvents({ batch.data(), 2 });
+  // the paths mix on one queue: this drains as a CustomEvent holding the ConcreteCustomEvent clone
+  pushEvent(ConcreteCustomEvent { 18, "your dad!" });
+
+  const std::size_t count = drainEvents(batch);
+  for(std::size_t i = 0; i < count; ++i) {
+    dispatchEvent(batch[i], userEventHandler, systemEventHandler, customEventHandler);
+    // handlers of a derived custom event are reached through the event it was queued as
+    const auto* customEvent = std::get_if<CustomEvent>(&batch[i]);
+    if(customEvent != nullptr && customEvent->getQueuedEvent() != nullptr) (*customEvent->getQueuedEvent())(customEventHandler);
+  }
+
+  // and back: pushEvents queues a fresh clone, which getEvent hands over of its own class
+  pushEvents({ batch.data(), count });
+  try {
+    while(true) {
+      BaseEvent& newEvent = getEvent();
+      for(const BaseEventHandler& handler : eventHandlers) {
+        newEvent(handler);
+      }
+      delete &newEvent;
+    }
+  } catch (NoEventsException& _) {};
+
 }
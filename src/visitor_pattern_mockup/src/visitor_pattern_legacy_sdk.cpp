@@ -1,7 +1,11 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -11,7 +15,38 @@ BaseEvent::BaseEvent(BaseEventImpl* impl): _impl { impl,  [](BaseEventImpl* i )
 UserEvent::UserEvent(): BaseEvent(new UserEventImpl(this))  {};
 SystemEvent::SystemEvent(): BaseEvent(new SystemEventImpl(this)) {};
 CustomEvent::CustomEvent(): BaseEvent(new CustomEventImpl(this)) {};
-CustomEvent::CustomEvent(CustomEventImpl* impl): BaseEvent ( static_cast<BaseEventImpl*>(impl) ) {};
+CustomEvent::CustomEvent(CustomEventImpl* impl): BaseEvent ( static_cast<BaseEventImpl*>(impl) ) {
+  // a cloned impl still points at the event it was cloned from
+  if(impl != nullptr) impl->_baseEvent = this;
+};
+UserEvent::UserEvent(uint16_t userNumber): BaseEvent(nullptr), userNumber { userNumber } {};
+SystemEvent::SystemEvent(uint16_t systemNumber): BaseEvent(nullptr), systemNumber { systemNumber } {};
+CustomEvent::CustomEvent(uint16_t customEventNumber, void* payload):
+  BaseEvent(nullptr), customEventNumber { customEventNumber }, payload { payload } {};
+CustomEvent::CustomEvent(std::unique_ptr<CustomEvent> queuedEvent):
+  BaseEvent(nullptr),
+  customEventNumber { queuedEvent->customEventNumber },
+  payload { queuedEvent->payload },
+  _queuedEvent { std::move(queuedEvent) } {};
+
+namespace {
+
+// the payloads of queued OLD_CustomEvents which are clones made by pushEvent, owned by the queue
+std::unordered_set<const void*> queuedClones {};
+
+void* queueClone(const CustomEvent& customEvent) {
+  CustomEvent* clone = &customEvent.clone();
+  queuedClones.insert(clone);
+  return clone;
+}
+
+//! @brief the clone queued as the event's payload, now owned by the caller, or nullptr if the payload is the caller's data
+CustomEvent* takeClone(const OLD_CustomEvent& oldCustomEvent) {
+  if(queuedClones.erase(oldCustomEvent.payload) == 0) return nullptr;
+  return static_cast<CustomEvent*>(oldCustomEvent.payload);
+}
+
+}
 
 CustomEvent& CustomEvent::clone() const {
   auto customEventImpl = static_cast<CustomEventImpl*>(this->_impl.get())->clone();
@@ -19,6 +54,7 @@ CustomEvent& CustomEvent::clone() const {
     customEventImpl
   );
   newCustomEvent->customEventNumber = customEventNumber;
+  newCustomEvent->payload = payload;
   return *newCustomEvent;
 }
 
@@ -43,7 +79,11 @@ SystemEvent& createSystemEvent(OLD_Event* event) {
 }
 
 CustomEvent& createCustomEvent(OLD_Event* event) {
-  auto* customEvent = static_cast<CustomEvent*>(event->custom.payload);
+  if(CustomEvent* clone = takeClone(event->custom)) return *clone;
+  // pushed by pushEvents, so the payload is the caller's own
+  auto* customEvent = new CustomEvent();
+  customEvent->customEventNumber = event->custom.customEventNumber;
+  customEvent->payload = event->custom.payload;
   return *customEvent;
 }
 
@@ -60,30 +100,27 @@ BaseEvent& createEvent(OLD_Event* oldEvent) {
   }
 }
 
-OLD_Event* EventConverter::convert(const UserEventImpl& userEvent) const {
-  OLD_Event* oldEvent = new OLD_Event{ .user={
+std::optional<OLD_Event> EventConverter::convert(const UserEventImpl& userEvent) const {
+  return OLD_Event { .user={
     OLD_USEREVENT,
     static_cast<UserEvent*>(userEvent._baseEvent)->userNumber
   }};
-  return oldEvent;
 }
 
-OLD_Event* EventConverter::convert(const SystemEventImpl& systemEvent) const {
-  OLD_Event* oldEvent = new OLD_Event{ .system={
+std::optional<OLD_Event> EventConverter::convert(const SystemEventImpl& systemEvent) const {
+  return OLD_Event { .system={
     OLD_SYSTEMEVENT,
     static_cast<SystemEvent*>(systemEvent._baseEvent)->systemNumber
   }};
-  return oldEvent;
 }
 
-OLD_Event* EventConverter::convert(const CustomEventImpl& customEventImpl) const {
+std::optional<OLD_Event> EventConverter::convert(const CustomEventImpl& customEventImpl) const {
   auto& customEvent = static_cast<CustomEvent&>(*customEventImpl._baseEvent);
-  OLD_Event* oldEvent = new OLD_Event{ .custom={
+  return OLD_Event { .custom={
     OLD_CUSTOMEVENT,
     customEvent.customEventNumber,
-    static_cast<void *>(&customEvent.clone())
+    queueClone(customEvent)
   }};
-  return oldEvent;
 }
 
 BaseEvent& getEvent() {
@@ -95,8 +132,53 @@ BaseEvent& getEvent() {
 };
 
 void pushEvent(const BaseEvent& event) {
+  if(!event._impl) throw std::logic_error("pushEvent: events from drainEvents go back through pushEvents.");
   EventConverter eventConverter {};
-  OLD_Event* oldEvent = event._impl->acceptConverter(eventConverter);
-  pushOldEvent(oldEvent);
-  delete oldEvent;
+  std::optional<OLD_Event> oldEvent = event._impl->acceptConverter(eventConverter);
+  if(oldEvent) pushOldEvent(&*oldEvent);
 };
+
+std::size_t drainEvents(std::span<EventVariant> events) {
+  std::size_t count = 0;
+  // from the back, as waitForOldEvent takes them
+  for(; count < events.size() && !oldEvents.empty(); ++count) {
+    const OLD_Event& oldEvent = oldEvents.back();
+    switch(oldEvent.eventType) {
+      case OLD_USEREVENT:
+        events[count].emplace<UserEvent>(oldEvent.user.userNumber);
+        break;
+      case OLD_SYSTEMEVENT:
+        events[count].emplace<SystemEvent>(oldEvent.system.systemNumber);
+        break;
+      case OLD_CUSTOMEVENT:
+        if(CustomEvent* clone = takeClone(oldEvent.custom)) {
+          events[count].emplace<CustomEvent>(std::unique_ptr<CustomEvent> { clone });
+        } else {
+          events[count].emplace<CustomEvent>(oldEvent.custom.customEventNumber, oldEvent.custom.payload);
+        }
+        break;
+      default:
+        throw UnknownEventException("Unknown Event");
+    }
+    oldEvents.pop_back();
+  }
+  return count;
+}
+
+void pushEvents(std::span<const EventVariant> events) {
+  for(const EventVariant& event : events) {
+    OLD_Event oldEvent = std::visit([](const auto& concreteEvent) -> OLD_Event {
+      using EventClass = std::decay_t<decltype(concreteEvent)>;
+      if constexpr (std::is_same_v<EventClass, UserEvent>) {
+        return { .user = { OLD_USEREVENT, concreteEvent.userNumber } };
+      } else if constexpr (std::is_same_v<EventClass, SystemEvent>) {
+        return { .system = { OLD_SYSTEMEVENT, concreteEvent.systemNumber } };
+      } else {
+        const CustomEvent* queuedEvent = concreteEvent.getQueuedEvent();
+        void* payload = queuedEvent != nullptr ? queueClone(*queuedEvent) : concreteEvent.payload;
+        return { .custom = { OLD_CUSTOMEVENT, concreteEvent.customEventNumber, payload } };
+      }
+    }, event);
+    pushOldEvent(&oldEvent);
+  }
+}
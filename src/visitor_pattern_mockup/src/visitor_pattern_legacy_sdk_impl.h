@@ -1,6 +1,8 @@
 #ifndef __VISITOR_PATTERN_LEGACY_SDK_IMPL_H__
 #define __VISITOR_PATTERN_LEGACY_SDK_IMPL_H__
 
+#include <optional>
+
 #include "visitor_pattern_legacy_sdk.h"
 #include "legacy_sdk.h"
 
@@ -13,15 +15,15 @@ template<class EventClass>
 class Converter {
   public:
     virtual ~Converter() {};
-    virtual OLD_Event* convert(const EventClass& event) const = 0;
+    virtual std::optional<OLD_Event> convert(const EventClass& event) const = 0;
 };
 
 template<class EventClass>
-OLD_Event* castConverter(const EventClass& event, const BaseConverter& baseConverter){
+std::optional<OLD_Event> castConverter(const EventClass& event, const BaseConverter& baseConverter){
   try {
     const Converter<EventClass> &eventConverter = dynamic_cast<const Converter<EventClass>&>(baseConverter);
     return eventConverter.convert(event);
-  } catch (std::bad_cast &e) { return nullptr; } // bad cast just means this handler can't handle this event
+  } catch (std::bad_cast &e) { return std::nullopt; } // bad cast just means this handler can't handle this event
 }
 
 class EventConverter;
@@ -31,7 +33,7 @@ class BaseEventImpl {
   public:
     BaseEventImpl(BaseEvent* baseEvent) : _baseEvent { baseEvent } {};
     virtual ~BaseEventImpl() {};
-    virtual OLD_Event* acceptConverter(const BaseConverter& baseConverter) const = 0;
+    virtual std::optional<OLD_Event> acceptConverter(const BaseConverter& baseConverter) const = 0;
   protected:
     BaseEvent* _baseEvent;
 };
@@ -41,9 +43,8 @@ class UserEventImpl : public BaseEventImpl {
   using BaseEventImpl::BaseEventImpl;
   friend EventConverter;
   public:
-    virtual OLD_Event* acceptConverter(const BaseConverter& baseConverter) const { 
-      OLD_Event* event = castConverter(*this, baseConverter);
-      return event;
+    virtual std::optional<OLD_Event> acceptConverter(const BaseConverter& baseConverter) const { 
+      return castConverter(*this, baseConverter);
     };
 };
 
@@ -52,20 +53,19 @@ class SystemEventImpl : public BaseEventImpl {
   friend EventConverter;
   public:
     SystemEventImpl(std::unique_ptr<SystemEventImpl, void(*) (SystemEventImpl *)>& impl);
-    virtual OLD_Event* acceptConverter(const BaseConverter& baseConverter) const { 
-      OLD_Event* event = castConverter(*this, baseConverter);
-      return event;
+    virtual std::optional<OLD_Event> acceptConverter(const BaseConverter& baseConverter) const { 
+      return castConverter(*this, baseConverter);
     };
 };
 
 class CustomEventImpl : public BaseEventImpl {
   using BaseEventImpl::BaseEventImpl;
+  friend CustomEvent;
   friend EventConverter;
   public:
     CustomEventImpl(std::unique_ptr<CustomEventImpl, void(*) (CustomEventImpl *)>& impl);
-    virtual OLD_Event* acceptConverter(const BaseConverter& baseConverter) const { 
-      OLD_Event* event = castConverter(*this, baseConverter);
-      return event;
+    virtual std::optional<OLD_Event> acceptConverter(const BaseConverter& baseConverter) const { 
+      return castConverter(*this, baseConverter);
     };
     CustomEventImpl* clone() const;
 };
@@ -75,9 +75,9 @@ class EventConverter : public BaseConverter,
   public Converter<SystemEventImpl>,
   public Converter<CustomEventImpl> {
   public:
-   virtual OLD_Event* convert(const UserEventImpl& event) const override;
-   virtual OLD_Event* convert(const SystemEventImpl& event) const override;
-   virtual OLD_Event* convert(const CustomEventImpl& event) const override;
+   virtual std::optional<OLD_Event> convert(const UserEventImpl& event) const override;
+   virtual std::optional<OLD_Event> convert(const SystemEventImpl& event) const override;
+   virtual std::optional<OLD_Event> convert(const CustomEventImpl& event) const override;
 };
 
 #endif